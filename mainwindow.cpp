@@ -10,6 +10,28 @@
 #include "src/chunk_test.h"
 #include "src/queue_test.h"
 #include "src/typed_pool_test.h"
+#include "src/executor_test.h"
+#include "src/zero_alloc_test.h"
+#include "src/ttl_test.h"
+#include "src/window_stats_test.h"
+#include "src/remote_alloc_test.h"
+#include "src/history_test.h"
+#include "src/scan_test.h"
+#include "src/observer_test.h"
+#include "src/packed_test.h"
+#include "src/graveyard_test.h"
+#include "src/tune_test.h"
+#include "src/duplex_test.h"
+#include "src/delay_test.h"
+#include "src/spread_test.h"
+#include "src/flight_test.h"
+#include "src/mesh_test.h"
+#include "src/load_test.h"
+#include "src/record_test.h"
+#include "src/micro_test.h"
+#include "src/budget_test.h"
+#include "src/snapshot_par_test.h"
+#include "src/layout_test.h"
 
 
 MainWindow::MainWindow(QWidget *parent)
@@ -42,6 +64,72 @@ MainWindow::MainWindow(QWidget *parent)
     qDebug() << "\n" << "typed_pool test";
     run_tst_typed_pool_api_paranoid(-1, nullptr);
 
+    qDebug() << "\n" << "executor test";
+    run_tst_executor_api_paranoid(-1, nullptr);
+
+    qDebug() << "\n" << "zero_alloc test";
+    run_tst_zero_alloc_api_paranoid(-1, nullptr);
+
+    qDebug() << "\n" << "ttl test";
+    run_tst_ttl_api_paranoid(-1, nullptr);
+
+    qDebug() << "\n" << "window_stats test";
+    run_tst_window_stats_api_paranoid(-1, nullptr);
+
+    qDebug() << "\n" << "remote_alloc test";
+    run_tst_remote_alloc_api_paranoid(-1, nullptr);
+
+    qDebug() << "\n" << "history test";
+    run_tst_history_api_paranoid(-1, nullptr);
+
+    qDebug() << "\n" << "scan test";
+    run_tst_scan_api_paranoid(-1, nullptr);
+
+    qDebug() << "\n" << "observer test";
+    run_tst_observer_api_paranoid(-1, nullptr);
+
+    qDebug() << "\n" << "packed test";
+    run_tst_packed_api_paranoid(-1, nullptr);
+
+    qDebug() << "\n" << "graveyard test";
+    run_tst_graveyard_api_paranoid(-1, nullptr);
+
+    qDebug() << "\n" << "tune test";
+    run_tst_tune_api_paranoid(-1, nullptr);
+
+    qDebug() << "\n" << "duplex test";
+    run_tst_duplex_api_paranoid(-1, nullptr);
+
+    qDebug() << "\n" << "delay test";
+    run_tst_delay_api_paranoid(-1, nullptr);
+
+    qDebug() << "\n" << "spread test";
+    run_tst_spread_api_paranoid(-1, nullptr);
+
+    qDebug() << "\n" << "flight test";
+    run_tst_flight_api_paranoid(-1, nullptr);
+
+    qDebug() << "\n" << "mesh test";
+    run_tst_mesh_api_paranoid(-1, nullptr);
+
+    qDebug() << "\n" << "load test";
+    run_tst_load_api_paranoid(-1, nullptr);
+
+    qDebug() << "\n" << "record test";
+    run_tst_record_api_paranoid(-1, nullptr);
+
+    qDebug() << "\n" << "micro test";
+    run_tst_micro_api_paranoid(-1, nullptr);
+
+    qDebug() << "\n" << "budget test";
+    run_tst_budget_api_paranoid(-1, nullptr);
+
+    qDebug() << "\n" << "snapshot_par test";
+    run_tst_snapshot_par_api_paranoid(-1, nullptr);
+
+    qDebug() << "\n" << "layout test";
+    run_tst_layout_api_paranoid(-1, nullptr);
+
 
 }
 
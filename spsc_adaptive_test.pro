@@ -0,0 +1,23 @@
+QT += testlib
+QT -= gui
+CONFIG += console c++17
+CONFIG -= app_bundle
+TEMPLATE = app
+
+# The adaptive suite builds SPSCbase with SPSC_SHADOW_REFRESH_ADAPTIVE=1 and a
+# trace sink (src/adaptive_test_config.h). Every translation unit of this
+# target sees the same config, so it cannot be linked into spsc_test (ODR).
+DEFINES += SPSC_CONFIG_USER_HEADER=\\\"adaptive_test_config.h\\\"
+
+include(src/spsc/spsc.pri)
+
+INCLUDEPATH += $$PWD $$PWD/src
+
+SOURCES += \
+    src/adaptive_main.cpp \
+    src/adaptive_test.cpp
+
+HEADERS += \
+    basic_types.h \
+    src/adaptive_test.h \
+    src/adaptive_test_config.h
@@ -17,26 +17,70 @@ SOURCES += \
     main.cpp \
     mainwindow.cpp \
     src/chunk_test.cpp \
+    src/executor_test.cpp \
     src/latest_test.cpp \
     src/pool_view_test.cpp \
     src/fifo_test.cpp \
     src/fifo_view_test.cpp \
     src/pool_test.cpp \
     src/queue_test.cpp \
-    src/typed_pool_test.cpp
+    src/typed_pool_test.cpp \
+    src/zero_alloc_test.cpp \
+    src/ttl_test.cpp \
+    src/window_stats_test.cpp \
+    src/remote_alloc_test.cpp \
+    src/history_test.cpp \
+    src/scan_test.cpp \
+    src/observer_test.cpp \
+    src/packed_test.cpp \
+    src/graveyard_test.cpp \
+    src/tune_test.cpp \
+    src/duplex_test.cpp \
+    src/delay_test.cpp \
+    src/spread_test.cpp \
+    src/flight_test.cpp \
+    src/mesh_test.cpp \
+    src/load_test.cpp \
+    src/record_test.cpp \
+    src/micro_test.cpp \
+    src/budget_test.cpp \
+    src/snapshot_par_test.cpp \
+    src/layout_test.cpp
 
 HEADERS += \
     mainwindow.h \
     basic_types.h \
     macro.h \
     src/chunk_test.h \
+    src/executor_test.h \
     src/queue_test.h \
     src/latest_test.h \
     src/pool_view_test.h \
     src/fifo_test.h \
     src/fifo_view_test.h \
     src/pool_test.h \
-    src/typed_pool_test.h
+    src/typed_pool_test.h \
+    src/zero_alloc_test.h \
+    src/ttl_test.h \
+    src/window_stats_test.h \
+    src/remote_alloc_test.h \
+    src/history_test.h \
+    src/scan_test.h \
+    src/observer_test.h \
+    src/packed_test.h \
+    src/graveyard_test.h \
+    src/tune_test.h \
+    src/duplex_test.h \
+    src/delay_test.h \
+    src/spread_test.h \
+    src/flight_test.h \
+    src/mesh_test.h \
+    src/load_test.h \
+    src/record_test.h \
+    src/micro_test.h \
+    src/budget_test.h \
+    src/snapshot_par_test.h \
+    src/layout_test.h
 
 FORMS += \
     mainwindow.ui
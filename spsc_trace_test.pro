@@ -0,0 +1,23 @@
+QT += testlib
+QT -= gui
+CONFIG += console c++17
+CONFIG -= app_bundle
+TEMPLATE = app
+
+# The trace suite routes every SPSC_TRACE site into a test sink
+# (src/trace_test_config.h). Every translation unit of this target sees the
+# same sink, so it cannot be linked into spsc_test (ODR).
+DEFINES += SPSC_CONFIG_USER_HEADER=\\\"trace_test_config.h\\\"
+
+include(src/spsc/spsc.pri)
+
+INCLUDEPATH += $$PWD $$PWD/src
+
+SOURCES += \
+    src/trace_main.cpp \
+    src/trace_test.cpp
+
+HEADERS += \
+    basic_types.h \
+    src/trace_test.h \
+    src/trace_test_config.h
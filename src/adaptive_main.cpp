@@ -0,0 +1,11 @@
+// adaptive_main.cpp
+// Entry point of spsc_adaptive_test.pro (see adaptive_test_config.h).
+
+#include <QCoreApplication>
+
+#include "adaptive_test.h"
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+    return run_tst_adaptive_api_paranoid(argc, argv);
+}
@@ -0,0 +1,274 @@
+// adaptive_test.cpp
+// Paranoid API/contract test for the adaptive shadow refresh
+// (base/spsc_adaptive.hpp, SPSCbase with SPSC_SHADOW_REFRESH_ADAPTIVE=1).
+//
+// Goals:
+//  - refresh_controller: starts at SPSC_SHADOW_REFRESH_FRAC_SHIFT, moves only at
+//    window boundaries, converges in the right direction and never leaves
+//    [kMinShift, kOffShift].
+//  - on_refresh(): a hit needs at least one threshold of room gained; while
+//    off, mandatory refreshes with large gains turn early refresh back on.
+//  - A nearly-full bulk ring stops refreshing on every call.
+//  - A two-thread claim_write/claim_read pipeline keeps strict FIFO order.
+//
+// Notes:
+//  - Built by spsc_adaptive_test.pro, not spsc_test: adaptive_test_config.h
+//    turns on SPSC_SHADOW_REFRESH_ADAPTIVE and routes SPSC_TRACE_USER into
+//    adaptive_trace_hit() for the whole target.
+
+#include <QtTest/QtTest>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#if !defined(SPSC_ASSERT) && !defined(NDEBUG)
+#  define SPSC_ASSERT(expr) do { if(!(expr)) { std::abort(); } } while(0)
+#endif
+
+#include "adaptive_test.h"
+#include "base/spsc_adaptive.hpp"
+#include "fifo.hpp"
+
+#if !SPSC_SHADOW_REFRESH_ADAPTIVE || !SPSC_TRACE_ENABLED
+#  error "adaptive_test.cpp must be built by spsc_adaptive_test.pro"
+#endif
+
+namespace {
+
+int g_refresh_tail = 0;
+
+} // namespace
+
+void adaptive_trace_hit(const char* name) noexcept {
+    g_refresh_tail += (std::strcmp(name, "refresh_tail") == 0) ? 1 : 0;
+}
+
+namespace {
+
+using spsc::adapt::refresh_controller;
+
+#if defined(NDEBUG)
+constexpr std::uint32_t kItems = 2000000u;
+#else
+constexpr std::uint32_t kItems = 200000u;
+#endif
+
+template <class Ctl>
+static void feed_probes(Ctl& c, const unsigned n, const bool hit) {
+    for (unsigned i = 0; i < n; ++i) {
+        c.on_probe(hit);
+    }
+}
+
+using adaptive_policy = ::spsc::policy::A<>;
+
+static_assert(sizeof(refresh_controller) <= SPSC_CACHELINE_BYTES - sizeof(reg),
+              "controller must fit the shadow line");
+
+class tst_adaptive_api_paranoid : public QObject {
+    Q_OBJECT
+
+private slots:
+    void refresh_initial_state() {
+        refresh_controller c;
+        QCOMPARE(c.shift(), refresh_controller::kInitShift);
+        QVERIFY(c.shift() >= refresh_controller::kMinShift);
+        QVERIFY(c.shift() <= refresh_controller::kMaxShift);
+        QCOMPARE(c.threshold(1024u), reg(1024u >> c.shift()));
+        QCOMPARE(c.decisions(), reg(0u));
+    }
+
+    void refresh_moves_only_on_window_boundary() {
+        refresh_controller c;
+        const auto s0 = c.shift();
+        feed_probes(c, refresh_controller::kWindow - 1u, false);
+        QCOMPARE(c.shift(), s0);
+        QCOMPARE(c.decisions(), reg(0u));
+        c.on_probe(false);
+        QCOMPARE(c.decisions(), reg(1u));
+        QCOMPARE(c.shift(), std::uint8_t(s0 + 1u)); // kInitShift <= kMaxShift < kOffShift
+    }
+
+    void refresh_wasted_probes_shrink_threshold() {
+        refresh_controller c;
+        for (int w = 0; w < 64; ++w) {
+            feed_probes(c, refresh_controller::kWindow, false);
+            QVERIFY(c.shift() <= refresh_controller::kOffShift);
+        }
+        QCOMPARE(c.shift(), refresh_controller::kOffShift);
+        QCOMPARE(c.threshold(4096u), reg(0u)); // early refresh off
+    }
+
+    void refresh_useful_probes_grow_threshold() {
+        refresh_controller c;
+        for (int w = 0; w < 64; ++w) {
+            feed_probes(c, refresh_controller::kWindow, true);
+            QVERIFY(c.shift() >= refresh_controller::kMinShift);
+        }
+        QCOMPARE(c.shift(), refresh_controller::kMinShift);
+    }
+
+    void refresh_mixed_rate_is_stable() {
+        refresh_controller c;
+        const auto s0 = c.shift();
+        for (int w = 0; w < 16; ++w) {
+            for (unsigned i = 0; i < refresh_controller::kWindow; ++i) {
+                c.on_probe((i & 1u) != 0u); // 50% hit rate: inside the dead band
+            }
+        }
+        QCOMPARE(c.shift(), s0);
+        QCOMPARE(c.decisions(), reg(16u));
+
+        c.reset();
+        QCOMPARE(c.shift(), refresh_controller::kInitShift);
+        QCOMPARE(c.decisions(), reg(0u));
+    }
+
+    void on_refresh_scores_room_gained() {
+        refresh_controller c;
+        const reg cap = 1024u;
+        const reg thr = c.threshold(cap);
+        QVERIFY(thr != 0u);
+
+        // Optional refreshes that gain less than one threshold are misses,
+        // even though the peer moved.
+        for (unsigned i = 0; i < refresh_controller::kWindow; ++i) {
+            c.on_refresh(thr / 2u, thr / 2u + 1u, cap);
+        }
+        QCOMPARE(c.decisions(), reg(1u));
+        QCOMPARE(c.shift(), std::uint8_t(refresh_controller::kInitShift + 1u));
+
+        // Gaining a full threshold is a hit.
+        const reg thr2 = c.threshold(cap);
+        for (unsigned i = 0; i < refresh_controller::kWindow; ++i) {
+            c.on_refresh(1u, 1u + thr2, cap);
+        }
+        QCOMPARE(c.shift(), refresh_controller::kInitShift);
+
+        // Mandatory refreshes are not probes while early refresh is on.
+        for (unsigned i = 0; i < 4u * refresh_controller::kWindow; ++i) {
+            c.on_refresh(0u, 1u, cap);
+        }
+        QCOMPARE(c.decisions(), reg(2u));
+    }
+
+    void off_state_recovers() {
+        refresh_controller c;
+        const reg cap = 1024u;
+        for (int w = 0; w < 64; ++w) {
+            for (unsigned i = 0; i < refresh_controller::kWindow; ++i) {
+                c.on_refresh(1u, 2u, cap);
+            }
+        }
+        QCOMPARE(c.shift(), refresh_controller::kOffShift);
+        QCOMPARE(c.threshold(cap), reg(0u));
+
+        // Small mandatory gains keep it off; a peer that catches up turns it on.
+        for (unsigned i = 0; i < refresh_controller::kWindow; ++i) {
+            c.on_refresh(0u, 2u, cap);
+        }
+        QCOMPARE(c.shift(), refresh_controller::kOffShift);
+        for (unsigned i = 0; i < refresh_controller::kWindow; ++i) {
+            c.on_refresh(0u, cap >> refresh_controller::kMaxShift, cap);
+        }
+        QCOMPARE(c.shift(), refresh_controller::kMaxShift);
+        QCOMPARE(c.threshold(cap), reg(cap >> refresh_controller::kMaxShift));
+    }
+
+    void nearly_full_ring_stops_refreshing_every_call() {
+        constexpr reg kCap   = 1024u;
+        constexpr reg kSlack = 8u;
+        constexpr int kIters = 8192;
+        ::spsc::fifo<std::uint32_t, kCap, adaptive_policy> q;
+
+        std::uint32_t next = 0u;
+        std::uint32_t expect = 0u;
+        for (reg i = 0; i < kCap - kSlack; ++i) {
+            QVERIFY(q.try_push(next++));
+        }
+
+        // Producer sizes each write with write_size(); the consumer lags one
+        // element behind.
+        g_refresh_tail = 0;
+        for (int i = 0; i < kIters; ++i) {
+            QVERIFY(q.write_size() != 0u);
+            auto r = q.claim_write(::spsc::unsafe, 1u);
+            QCOMPARE(r.total, reg(1u));
+            r.first.ptr[0] = next++;
+            q.publish(1u);
+            QCOMPARE(*q.try_front(), expect++);
+            q.pop();
+        }
+
+        // A threshold-driven refresh on every call would be kIters events;
+        // once off, the producer refreshes only when its shadow shows no room.
+        QVERIFY2(g_refresh_tail < kIters / 4, "early refresh never switched off");
+        QVERIFY(g_refresh_tail > 0);
+        QCOMPARE(q.size(), kCap - kSlack);
+    }
+
+    void threaded_pipeline_keeps_order() {
+        using Fifo = ::spsc::fifo<std::uint32_t, 1024u, adaptive_policy>;
+        Fifo q;
+        std::atomic<bool> ok{true};
+
+        std::thread consumer([&]() {
+            std::uint32_t expect = 0u;
+            reg want = 1u;
+            while (expect < kItems) {
+                auto r = q.claim_read(::spsc::unsafe, want);
+                want = (want == 64u) ? 1u : static_cast<reg>(want * 2u);
+                if (r.total == 0u) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                bool good = true;
+                for (reg i = 0; i < r.first.count; ++i) {
+                    good = good && (r.first.ptr[i] == expect++);
+                }
+                for (reg i = 0; i < r.second.count; ++i) {
+                    good = good && (r.second.ptr[i] == expect++);
+                }
+                if (!good) {
+                    ok.store(false, std::memory_order_relaxed);
+                }
+                q.pop(r.total);
+            }
+        });
+
+        std::uint32_t next = 0u;
+        reg want = 3u;
+        while (next < kItems) {
+            const reg n = (want < (kItems - next)) ? want : static_cast<reg>(kItems - next);
+            want = (want >= 96u) ? 3u : static_cast<reg>(want + 5u);
+            auto r = q.claim_write(::spsc::unsafe, n);
+            if (r.total == 0u) {
+                std::this_thread::yield();
+                continue;
+            }
+            for (reg i = 0; i < r.first.count; ++i) {
+                r.first.ptr[i] = next++;
+            }
+            for (reg i = 0; i < r.second.count; ++i) {
+                r.second.ptr[i] = next++;
+            }
+            q.publish(r.total);
+        }
+
+        consumer.join();
+        QVERIFY(ok.load());
+        QVERIFY(q.empty());
+    }
+};
+
+} // namespace
+
+int run_tst_adaptive_api_paranoid(int argc, char** argv) {
+    tst_adaptive_api_paranoid tc;
+    return QTest::qExec(&tc, argc, argv);
+}
+
+#include "adaptive_test.moc"
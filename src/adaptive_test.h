@@ -0,0 +1,6 @@
+#ifndef ADAPTIVE_TEST_H_
+#define ADAPTIVE_TEST_H_
+
+int run_tst_adaptive_api_paranoid(int argc, char** argv);
+
+#endif /* ADAPTIVE_TEST_H_ */
@@ -0,0 +1,17 @@
+#ifndef ADAPTIVE_TEST_CONFIG_H_
+#define ADAPTIVE_TEST_CONFIG_H_
+
+/*
+ * SPSC_CONFIG_USER_HEADER of spsc_adaptive_test.pro.
+ * Every translation unit of that target builds SPSCbase with the adaptive
+ * shadow refresh and routes the trace sites into adaptive_trace_hit()
+ * (adaptive_test.cpp), so all inline definitions agree.
+ */
+
+#define SPSC_SHADOW_REFRESH_ADAPTIVE 1
+
+void adaptive_trace_hit(const char* name) noexcept;
+
+#define SPSC_TRACE_USER(name, ring, a, b) adaptive_trace_hit(#name)
+
+#endif /* ADAPTIVE_TEST_CONFIG_H_ */
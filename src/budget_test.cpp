@@ -0,0 +1,193 @@
+// budget_test.cpp
+// Paranoid API/contract test for the shared memory budget
+// (base/spsc_budget.hpp).
+//
+// Goals:
+//  - memory_budget: reserve/release accounting, limit, headroom, peak and
+//    denial counters, set_limit() never reclaims.
+//  - Concurrent reservations never push used() past the limit.
+//  - fifo/queue/pool built with budget_alloc: growth past the budget fails
+//    softly and leaves the ring intact; shrink/destroy return the bytes.
+//  - keep_headroom<Pct> rings stop growing early; grow_any rings can still
+//    use the reserved headroom.
+
+#include <QtTest/QtTest>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#if !defined(SPSC_ASSERT) && !defined(NDEBUG)
+#  define SPSC_ASSERT(expr) do { if(!(expr)) { std::abort(); } } while(0)
+#endif
+
+#include "budget_test.h"
+#include "fifo.hpp"
+#include "pool.hpp"
+#include "queue.hpp"
+#include "base/spsc_budget.hpp"
+
+namespace {
+
+namespace al = ::spsc::alloc;
+
+template<std::size_t Limit, int Id>
+struct test_budget {
+    static al::memory_budget& budget() noexcept {
+        static al::memory_budget b{Limit};
+        return b;
+    }
+};
+
+using ring_budget  = test_budget<4096u, 0>;
+using share_budget = test_budget<4096u, 1>;
+using pool_budget  = test_budget<1u << 20, 2>;
+
+template<class Tag, class Grow = al::grow_any>
+using budget_fifo = ::spsc::fifo<std::uint32_t, 0, ::spsc::policy::A<>, al::budget_alloc<Tag, Grow>>;
+
+template<class Tag>
+using budget_queue = ::spsc::queue<std::uint32_t, 0, ::spsc::policy::A<>, al::budget_alloc<Tag>>;
+
+class tst_budget_api_paranoid : public QObject {
+    Q_OBJECT
+
+private slots:
+    void budget_accounting() {
+        al::memory_budget b{1000u};
+        QCOMPARE(b.limit(), std::size_t(1000u));
+        QCOMPARE(b.available(), std::size_t(1000u));
+
+        QVERIFY(b.try_reserve(600u));
+        QVERIFY(!b.try_reserve(500u));
+        QVERIFY(b.try_reserve(300u, 100u)); // exactly at limit - headroom
+        QVERIFY(!b.try_reserve(1u, 100u));
+        QVERIFY(!b.try_reserve(2000u));
+        QCOMPARE(b.used(), std::size_t(900u));
+        QCOMPARE(b.available(), std::size_t(100u));
+        QCOMPARE(b.denied(), std::size_t(3u));
+
+        b.release(600u);
+        QCOMPARE(b.used(), std::size_t(300u));
+        QCOMPARE(b.peak(), std::size_t(900u));
+
+        b.set_limit(200u); // already over: nothing reclaimed, growth stops
+        QCOMPARE(b.used(), std::size_t(300u));
+        QCOMPARE(b.available(), std::size_t(0u));
+        QVERIFY(!b.try_reserve(1u));
+        b.release(300u);
+        QVERIFY(b.try_reserve(200u));
+        b.release(200u);
+        QCOMPARE(b.used(), std::size_t(0u));
+
+        QCOMPARE(al::keep_headroom<25>::headroom(1000u), std::size_t(250u));
+        QCOMPARE(al::keep_headroom<50>::headroom(4097u), std::size_t(2048u));
+        QCOMPARE(al::keep_headroom<100>::headroom(7u), std::size_t(7u));
+        QCOMPARE(al::grow_any::headroom(1000u), std::size_t(0u));
+    }
+
+    void concurrent_reservations() {
+        al::memory_budget b{10u * 64u};
+        std::atomic<bool> over{false};
+        std::vector<std::thread> th;
+        for (int t = 0; t < 4; ++t) {
+            th.emplace_back([&b, &over] {
+                for (int i = 0; i < 20000; ++i) {
+                    if (b.try_reserve(64u)) {
+                        if (b.used() > b.limit()) {
+                            over.store(true, std::memory_order_relaxed);
+                        }
+                        b.release(64u);
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (auto& x : th) {
+            x.join();
+        }
+        QVERIFY(!over.load());
+        QVERIFY(b.peak() <= b.limit());
+        QCOMPARE(b.used(), std::size_t(0u));
+    }
+
+    void fifo_queue_growth_capped() {
+        al::memory_budget& b = ring_budget::budget();
+        QCOMPARE(b.used(), std::size_t(0u));
+        {
+            budget_fifo<ring_budget> a;
+            budget_queue<ring_budget> q;
+
+            QVERIFY(a.resize(256u)); // 1 KiB
+            QCOMPARE(b.used(), std::size_t(1024u));
+            QVERIFY(a.try_push(7u));
+
+            QVERIFY(!q.resize(1024u)); // 4 KiB: over budget
+            QCOMPARE(q.capacity(), 0u);
+            QCOMPARE(b.used(), std::size_t(1024u));
+
+            QVERIFY(q.resize(512u)); // 2 KiB fits
+            QCOMPARE(b.used(), std::size_t(3072u));
+
+            QVERIFY(!a.reserve(1024u)); // growth needs the new buffer before the old one goes
+            QCOMPARE(a.capacity(), 256u);
+            QCOMPARE(a.size(), 1u);
+            QCOMPARE(*a.try_front(), 7u);
+
+            QVERIFY(q.resize(0u)); // shrink to zero returns the bytes
+            QCOMPARE(b.used(), std::size_t(1024u));
+            QVERIFY(a.resize(512u)); // 1 KiB + 2 KiB during migration, then 2 KiB
+            QCOMPARE(b.used(), std::size_t(2048u));
+            QCOMPARE(a.size(), 1u);
+            QVERIFY(b.peak() <= b.limit());
+        }
+        QCOMPARE(b.used(), std::size_t(0u)); // destructors return everything
+    }
+
+    void pool_budget_charged() {
+        al::memory_budget& b = pool_budget::budget();
+        {
+            ::spsc::pool<0, ::spsc::policy::A<>, al::budget_alloc<pool_budget>> p(8u, 256u);
+            QVERIFY(p.capacity() != 0u);
+            QVERIFY(b.used() >= std::size_t(8u * 256u)); // buffers + slot table
+            QVERIFY(p.try_push(std::uint32_t(5u)));
+
+            b.set_limit(b.used());
+            QVERIFY(!p.resize(64u, 256u));
+            QVERIFY(p.capacity() != 0u);
+            QCOMPARE(p.size(), 1u);
+            b.set_limit(std::size_t(1u) << 20);
+        }
+        QCOMPARE(b.used(), std::size_t(0u));
+    }
+
+    void headroom_policy() {
+        al::memory_budget& b = share_budget::budget();
+        {
+            budget_fifo<share_budget, al::keep_headroom<50>> bulk;
+            budget_fifo<share_budget> hot;
+
+            QVERIFY(bulk.resize(256u));  // 1 KiB, 3 KiB free
+            QVERIFY(!bulk.resize(512u)); // would leave 1 KiB < 2 KiB headroom
+            QCOMPARE(bulk.capacity(), 256u);
+
+            QVERIFY(hot.resize(512u)); // hot ring may use the headroom
+            QCOMPARE(b.used(), std::size_t(3072u));
+            QVERIFY(b.denied() >= 1u);
+        }
+        QCOMPARE(b.used(), std::size_t(0u));
+    }
+};
+
+} // namespace
+
+int run_tst_budget_api_paranoid(int argc, char** argv) {
+    tst_budget_api_paranoid tc;
+    return QTest::qExec(&tc, argc, argv);
+}
+
+#include "budget_test.moc"
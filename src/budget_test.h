@@ -0,0 +1,6 @@
+#ifndef BUDGET_TEST_H_
+#define BUDGET_TEST_H_
+
+int run_tst_budget_api_paranoid(int argc, char** argv);
+
+#endif /* BUDGET_TEST_H_ */
@@ -0,0 +1,162 @@
+// delay_test.cpp
+// Paranoid API/contract test for spsc::delay (playout delay / jitter buffer).
+//
+// Goals:
+//  - try_front() hides elements until key + delay <= now, on fifo and queue.
+//  - next_due() reports the front's due time; count_due()/pop_due() across the
+//    wrap split, capped by max.
+//  - Delay 0 treats stamps as due times.
+//  - wait_front() with std::chrono stamps sleeps until the due time (never
+//    returns early) and honours the deadline.
+//  - Concurrent producer/consumer: every element is released in order and never
+//    before its due time (lateness is measured by tools/spsc_bench).
+
+#include <QtTest/QtTest>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+
+#if !defined(SPSC_ASSERT) && !defined(NDEBUG)
+#  define SPSC_ASSERT(expr) do { if(!(expr)) { std::abort(); } } while(0)
+#endif
+
+#include "delay.hpp"
+#include "fifo.hpp"
+#include "queue.hpp"
+
+namespace {
+
+using Item = spsc::ttl::stamped<std::uint32_t, std::uint64_t>;
+
+using steady = std::chrono::steady_clock;
+using Stamp  = steady::duration;
+using TItem  = spsc::ttl::stamped<std::uint32_t, Stamp>;
+
+#if defined(NDEBUG)
+constexpr std::uint32_t kItems = 2000u;
+#else
+constexpr std::uint32_t kItems = 500u;
+#endif
+
+class tst_delay_api_paranoid : public QObject {
+    Q_OBJECT
+
+private slots:
+    void front_hidden_until_due() {
+        spsc::fifo<Item, 16> q;
+        spsc::delay::playout<> po(100u);
+        QCOMPARE(po.delay(), std::uint64_t(100u));
+        QVERIFY(po.try_front(q, 1000u) == nullptr); // empty
+
+        q.push(Item{10u, 1u});
+        q.push(Item{20u, 2u});
+        QVERIFY(po.try_front(q, 109u) == nullptr);
+        QVERIFY(po.try_front(q, 110u) != nullptr);
+        QCOMPARE(po.try_front(q, 110u)->value, 1u);
+
+        std::uint64_t due = 0u;
+        QVERIFY(po.next_due(q, due));
+        QCOMPARE(due, std::uint64_t(110u));
+        q.pop();
+        QVERIFY(po.try_front(q, 110u) == nullptr); // second one is due at 120
+        QVERIFY(po.next_due(q, due));
+        QCOMPARE(due, std::uint64_t(120u));
+        q.pop();
+        QVERIFY(!po.next_due(q, due));
+
+        po.set_delay(0u); // stamps are due times
+        q.push(Item{500u, 3u});
+        QVERIFY(po.try_front(q, 499u) == nullptr);
+        QVERIFY(po.try_front(q, 500u) != nullptr);
+    }
+
+    void count_and_pop_due_across_wrap() {
+        spsc::queue<Item, 16> q;
+        for (unsigned i = 0; i < 11; ++i) {
+            QVERIFY(q.try_emplace(Item{0u, 0u}) != nullptr);
+        }
+        q.pop(reg(11u));
+        for (std::uint32_t i = 0; i < 12; ++i) { // wraps after 5 elements
+            QVERIFY(q.try_emplace(Item{std::uint64_t(100u + i), i}) != nullptr);
+        }
+        spsc::delay::playout<> po(50u);
+        QCOMPARE(po.count_due(q, 149u), reg(0u));
+        QCOMPARE(po.count_due(q, 152u), reg(3u));  // boundary in first region
+        QCOMPARE(po.count_due(q, 158u), reg(9u));  // boundary in second region
+        QCOMPARE(po.count_due(q, 999u), reg(12u)); // everything due
+
+        QCOMPARE(po.pop_due(q, 158u, 4u), reg(4u)); // capped
+        QCOMPARE(q.front().value, 4u);
+        QCOMPARE(po.pop_due(q, 158u, 100u), reg(5u));
+        QCOMPARE(q.front().value, 9u);
+        QCOMPARE(po.pop_due(q, 158u, 100u), reg(0u));
+        QCOMPARE(q.size(), reg(3u));
+    }
+
+    void wait_front_sleeps_until_due() {
+        spsc::fifo<TItem, 8> q;
+        spsc::delay::playout<Stamp> po(std::chrono::milliseconds(5));
+        const auto t0 = steady::now();
+
+        // Empty ring: returns at the deadline.
+        QVERIFY(po.wait_front(q, t0 + std::chrono::milliseconds(2)) == nullptr);
+        QVERIFY(steady::now() >= t0 + std::chrono::milliseconds(2));
+
+        const auto stamp = steady::now().time_since_epoch();
+        q.push(TItem{stamp, 7u});
+        // Deadline before the due time: nullptr, element stays.
+        QVERIFY(po.wait_front(q, steady::now() + std::chrono::milliseconds(1)) == nullptr);
+        QCOMPARE(q.size(), reg(1u));
+
+        TItem* p = po.wait_front(q, steady::now() + std::chrono::seconds(5));
+        QVERIFY(p != nullptr);
+        QCOMPARE(p->value, 7u);
+        QVERIFY(steady::now().time_since_epoch() >= stamp + std::chrono::milliseconds(5));
+        q.pop();
+    }
+
+    void concurrent_playout_order_and_due() {
+        using Q = spsc::fifo<TItem, 64, spsc::policy::A<>>;
+        Q q;
+        const auto delay = std::chrono::milliseconds(2);
+        spsc::delay::playout<Stamp> po(delay);
+
+        std::thread producer([&]() {
+            for (std::uint32_t i = 0; i < kItems; ++i) {
+                const TItem it{steady::now().time_since_epoch(), i};
+                while (!q.try_push(it)) {
+                    std::this_thread::yield();
+                }
+                if ((i & 15u) == 0u) {
+                    std::this_thread::sleep_for(std::chrono::microseconds(200)); // bursty input
+                }
+            }
+        });
+
+        bool ok = true;
+        for (std::uint32_t i = 0; i < kItems; ++i) {
+            TItem* p = po.wait_front(q, steady::now() + std::chrono::seconds(10));
+            if (!p) {
+                ok = false;
+                break;
+            }
+            const auto now = steady::now().time_since_epoch();
+            ok = ok && (p->value == i) && (now >= p->stamp + delay);
+            q.pop();
+        }
+        producer.join();
+        QVERIFY(ok);
+    }
+};
+
+} // namespace
+
+int run_tst_delay_api_paranoid(int argc, char** argv) {
+    tst_delay_api_paranoid tc;
+    return QTest::qExec(&tc, argc, argv);
+}
+
+#include "delay_test.moc"
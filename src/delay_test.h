@@ -0,0 +1,6 @@
+#ifndef DELAY_TEST_H_
+#define DELAY_TEST_H_
+
+int run_tst_delay_api_paranoid(int argc, char** argv);
+
+#endif /* DELAY_TEST_H_ */
@@ -0,0 +1,180 @@
+// duplex_test.cpp
+// Paranoid API/contract test for spsc::duplex.
+//
+// Goals:
+//  - try_call / try_request / reply / try_result / release round trip, the reply
+//    lives in the request's slot.
+//  - Capacity calls may be in flight; one more is refused; tickets can be
+//    released out of order.
+//  - Non-trivial payloads are constructed/destroyed exactly once (also on
+//    destruction with calls still in flight).
+//  - Threaded ping-pong (round-trip latency lives in tools/spsc_bench).
+
+#include <QtTest/QtTest>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+#if !defined(SPSC_ASSERT) && !defined(NDEBUG)
+#  define SPSC_ASSERT(expr) do { if(!(expr)) { std::abort(); } } while(0)
+#endif
+
+#include "duplex.hpp"
+
+namespace {
+
+#if defined(NDEBUG)
+constexpr std::uint32_t kCalls = 200000u;
+#else
+constexpr std::uint32_t kCalls = 20000u;
+#endif
+
+std::atomic<int> g_live{0};
+
+struct Tracked {
+    std::string text;
+    explicit Tracked(std::string s) : text(std::move(s)) { g_live.fetch_add(1, std::memory_order_relaxed); }
+    Tracked(const Tracked& o) : text(o.text) { g_live.fetch_add(1, std::memory_order_relaxed); }
+    Tracked(Tracked&& o) noexcept : text(std::move(o.text)) { g_live.fetch_add(1, std::memory_order_relaxed); }
+    Tracked& operator=(Tracked&& o) noexcept { text = std::move(o.text); return *this; }
+    ~Tracked() { g_live.fetch_sub(1, std::memory_order_relaxed); }
+};
+
+struct Req { std::uint32_t a; std::uint32_t b; };
+struct Resp { std::uint64_t sum; };
+
+class tst_duplex_api_paranoid : public QObject {
+    Q_OBJECT
+
+private slots:
+    void single_round_trip() {
+        spsc::duplex<Req, Resp, 4> d;
+        QVERIFY(d.try_request() == nullptr);
+
+        auto t = d.try_call(Req{2u, 3u});
+        QVERIFY(static_cast<bool>(t));
+        QCOMPARE(d.in_flight(), reg(1u));
+        QVERIFY(d.try_result(t) == nullptr);
+
+        Req* r = d.try_request();
+        QVERIFY(r != nullptr);
+        QCOMPARE(r->a + r->b, 5u);
+        const void* req_addr = r;
+        d.reply(Resp{std::uint64_t(r->a) + r->b});
+        QVERIFY(d.try_request() == nullptr);
+        QCOMPARE(d.served(), reg(1u));
+
+        Resp* out = d.try_result(t);
+        QVERIFY(out != nullptr);
+        QCOMPARE(out->sum, std::uint64_t(5u));
+        QCOMPARE(static_cast<const void*>(out), req_addr); // in-slot reply
+        d.release(t);
+        QVERIFY(!t);
+        QCOMPARE(d.in_flight(), reg(0u));
+    }
+
+    void capacity_and_out_of_order_release() {
+        spsc::duplex<Req, Resp, 4> d;
+        decltype(d)::ticket t[4];
+        for (std::uint32_t i = 0; i < 4; ++i) {
+            t[i] = d.try_call(Req{i, 0u});
+            QVERIFY(static_cast<bool>(t[i]));
+        }
+        QVERIFY(!d.try_call(Req{9u, 9u}));
+        QCOMPARE(d.serve([](Req& q) { return Resp{q.a * 10u}; }), reg(4u));
+
+        d.release(t[2]);
+        d.release(t[1]);
+        QVERIFY(!d.try_call(Req{9u, 9u})); // head slot (t[0]) still held
+        QCOMPARE(d.try_result(t[3])->sum, std::uint64_t(30u));
+        d.release(t[3]);
+        QCOMPARE(d.try_result(t[0])->sum, std::uint64_t(0u));
+        d.release(t[0]);
+        QCOMPARE(d.in_flight(), reg(0u));
+
+        // Wraps around cleanly.
+        for (std::uint32_t i = 0; i < 10; ++i) {
+            auto x = d.try_call(Req{i, i});
+            QVERIFY(static_cast<bool>(x));
+            QVERIFY(d.serve_one([](Req& q) { return Resp{std::uint64_t(q.a) + q.b}; }));
+            QCOMPARE(d.try_result(x)->sum, std::uint64_t(2u * i));
+            d.release(x);
+        }
+    }
+
+    void nontrivial_payload_lifetime() {
+        {
+            spsc::duplex<Tracked, Tracked, 8> d;
+            auto t = d.try_call(std::string("hello, a string long enough to allocate"));
+            QCOMPARE(g_live.load(), 1);
+            QVERIFY(d.serve_one([](Tracked& q) { return Tracked(q.text + "!"); }));
+            QCOMPARE(g_live.load(), 1); // request destroyed, response alive
+            QCOMPARE(d.try_result(t)->text, std::string("hello, a string long enough to allocate!"));
+            d.release(t);
+            QCOMPARE(g_live.load(), 0);
+
+            QVERIFY(static_cast<bool>(d.try_call(std::string("answered, never released"))));
+            QVERIFY(static_cast<bool>(d.try_call(std::string("never answered"))));
+            QVERIFY(d.serve_one([](Tracked& q) { return Tracked(q.text); }));
+            QCOMPARE(g_live.load(), 2);
+        }
+        QCOMPARE(g_live.load(), 0); // destructor cleaned up both states
+    }
+
+    void threaded_ping_pong() {
+        spsc::duplex<Req, Resp, 8> d;
+        std::atomic<bool> stop{false};
+        std::thread callee([&]() {
+            unsigned idle = 0u;
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (d.serve([](Req& q) { return Resp{std::uint64_t(q.a) * q.b}; }) != 0u) {
+                    idle = 0u;
+                } else if (++idle > 64u) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        bool ok = true;
+        // Synchronous calls.
+        for (std::uint32_t i = 0; i < kCalls; ++i) {
+            Resp out{};
+            ok = ok && d.call(out, Req{i, 3u}) && out.sum == std::uint64_t(i) * 3u;
+        }
+        // Pipelined calls: keep the ring full, release in order.
+        decltype(d)::ticket t[8];
+        std::uint32_t sent = 0u;
+        std::uint32_t done = 0u;
+        while (done < kCalls) {
+            while (sent < kCalls && sent - done < 8u) {
+                t[sent & 7u] = d.try_call(Req{sent, 7u});
+                ok = ok && static_cast<bool>(t[sent & 7u]);
+                ++sent;
+            }
+            auto& x = t[done & 7u];
+            if (Resp* r = d.try_result(x)) {
+                ok = ok && r->sum == std::uint64_t(done) * 7u;
+                d.release(x);
+                ++done;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        stop.store(true, std::memory_order_relaxed);
+        callee.join();
+        QVERIFY(ok);
+        QCOMPARE(d.served(), reg(2u * kCalls));
+    }
+};
+
+} // namespace
+
+int run_tst_duplex_api_paranoid(int argc, char** argv) {
+    tst_duplex_api_paranoid tc;
+    return QTest::qExec(&tc, argc, argv);
+}
+
+#include "duplex_test.moc"
@@ -0,0 +1,6 @@
+#ifndef DUPLEX_TEST_H_
+#define DUPLEX_TEST_H_
+
+int run_tst_duplex_api_paranoid(int argc, char** argv);
+
+#endif /* DUPLEX_TEST_H_ */
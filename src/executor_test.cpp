@@ -0,0 +1,271 @@
+// executor_test.cpp
+// Paranoid API/contract test for spsc::executor.
+//
+// Goals:
+//  - Verify every accepted task runs exactly once (single and multi submitter).
+//  - Verify stop() drains late submissions and in-flight steal replies.
+//  - Verify idle workers actually steal from a pinned (overloaded) worker.
+//  - Verify a late steal reply fits a thief whose backlog was refilled meanwhile.
+//
+// Notes:
+//  - Stealing depends on the host scheduler. Assertions only check
+//    exactly-once execution. Throughput against a mutex + condvar pool is
+//    measured by tools/spsc_bench.
+
+#include <QtTest/QtTest>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#if !defined(SPSC_ASSERT) && !defined(NDEBUG)
+#  define SPSC_ASSERT(expr) do { if(!(expr)) { std::abort(); } } while(0)
+#endif
+
+#include "executor.hpp"
+
+namespace {
+
+#if defined(NDEBUG)
+constexpr int kTasks = 400000;
+#else
+constexpr int kTasks = 50000;
+#endif
+
+constexpr reg kWorkers = 4u;
+
+// Per-task hit counters: detects both lost and duplicated tasks.
+struct HitBoard {
+    explicit HitBoard(const std::size_t n) : hits(new std::atomic<std::uint8_t>[n]), size(n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            hits[i].store(0u, std::memory_order_relaxed);
+        }
+    }
+
+    bool exactly_once() const noexcept {
+        for (std::size_t i = 0; i < size; ++i) {
+            if (hits[i].load(std::memory_order_relaxed) != 1u) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::unique_ptr<std::atomic<std::uint8_t>[]> hits;
+    std::size_t size;
+};
+
+struct HitTask {
+    HitBoard* board{nullptr};
+    std::uint32_t id{0u};
+    std::uint32_t spin{0u};
+
+    void operator()() const noexcept {
+        volatile std::uint32_t sink = 0u;
+        for (std::uint32_t i = 0; i < spin; ++i) {
+            sink = sink + i;
+        }
+        (void)sink;
+        board->hits[id].fetch_add(1u, std::memory_order_relaxed);
+    }
+};
+
+using Exec = spsc::executor<HitTask, 256u, 1024u, 32u>;
+
+// Blocks until *gate opens (if set), then records its hit.
+struct GateTask {
+    HitBoard* board{nullptr};
+    std::atomic<bool>* gate{nullptr};
+    std::uint32_t id{0u};
+
+    void operator()() const noexcept {
+        while (gate && !gate->load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+        board->hits[id].fetch_add(1u, std::memory_order_relaxed);
+    }
+};
+
+// Small backlog, so a late steal reply meets a saturated thief.
+using GateExec = spsc::executor<GateTask, 64u, 8u, 4u>;
+
+template <class E, class T>
+static void submit_spin(E& ex, const reg submitter, T&& t) {
+    while (!ex.try_submit(submitter, t)) {
+        std::this_thread::yield();
+    }
+}
+
+class tst_executor_api_paranoid : public QObject {
+    Q_OBJECT
+
+private slots:
+    void start_rejects_invalid() {
+        Exec ex;
+        QVERIFY(!ex.running());
+        QVERIFY(!ex.start(0u, 1u));
+        QVERIFY(!ex.start(1u, 0u));
+        QVERIFY(ex.start(2u, 1u));
+        QVERIFY(ex.running());
+        QVERIFY(!ex.start(2u, 1u));
+        QCOMPARE(ex.workers(), reg(2u));
+        QCOMPARE(ex.submitters(), reg(1u));
+        ex.stop();
+        QVERIFY(!ex.running());
+        ex.stop(); // idempotent
+    }
+
+    void single_worker_exactly_once() {
+        HitBoard board(kTasks);
+        Exec ex(1u, 1u);
+        QVERIFY(ex.running());
+
+        for (int i = 0; i < kTasks; ++i) {
+            submit_spin(ex, 0u, HitTask{&board, static_cast<std::uint32_t>(i), 0u});
+        }
+        ex.stop();
+
+        QVERIFY(board.exactly_once());
+        QCOMPARE(ex.executed(), reg(kTasks));
+        QCOMPARE(ex.stolen(0u), reg(0u));
+    }
+
+    void multi_submitter_exactly_once() {
+        constexpr reg kSubs = 3u;
+        HitBoard board(static_cast<std::size_t>(kTasks) * kSubs);
+        Exec ex(kWorkers, kSubs);
+        QVERIFY(ex.running());
+
+        std::vector<std::thread> subs;
+        for (reg s = 0; s < kSubs; ++s) {
+            subs.emplace_back([&, s]() {
+                for (int i = 0; i < kTasks; ++i) {
+                    const auto id = static_cast<std::uint32_t>(s * kTasks + i);
+                    submit_spin(ex, s, HitTask{&board, id, 0u});
+                }
+            });
+        }
+        for (auto& t : subs) {
+            t.join();
+        }
+        ex.stop();
+
+        QVERIFY(board.exactly_once());
+        QCOMPARE(ex.executed(), reg(kTasks) * kSubs);
+    }
+
+    void pinned_load_is_stolen() {
+        HitBoard board(kTasks);
+        Exec ex(kWorkers, 1u);
+        QVERIFY(ex.running());
+
+        // Everything goes to worker 0; the others can only get work by stealing.
+        for (int i = 0; i < kTasks; ++i) {
+            const HitTask t{&board, static_cast<std::uint32_t>(i), 200u};
+            while (!ex.try_submit_to(0u, 0u, t)) {
+                std::this_thread::yield();
+            }
+        }
+        ex.stop();
+
+        QVERIFY(board.exactly_once());
+        QCOMPARE(ex.executed(), reg(kTasks));
+
+        reg stolen = 0u;
+        for (reg w = 0; w < kWorkers; ++w) {
+            stolen += ex.stolen(w);
+        }
+        if (std::thread::hardware_concurrency() < 2u) {
+            QSKIP("Steal progress needs at least 2 hardware threads.");
+        }
+        QVERIFY2(stolen > 0u, "idle workers never stole from the pinned worker");
+    }
+
+    void late_reply_into_saturated_backlog() {
+        constexpr std::uint32_t kVictim = 7u;
+        constexpr std::uint32_t kThief  = 40u;
+        HitBoard board(4u + kVictim + kThief);
+        std::atomic<bool> gate[4] = {{false}, {false}, {false}, {false}};
+        std::uint32_t id = 0u;
+
+        GateExec ex(2u, 1u);
+        QVERIFY(ex.running());
+
+        auto sleep = [] { std::this_thread::sleep_for(std::chrono::milliseconds(20)); };
+        auto pin = [&](const reg w, std::atomic<bool>* g) {
+            QVERIFY(ex.try_submit_to(0u, w, GateTask{&board, g, id++}));
+        };
+
+        // Both workers blocked; worker 0 gets a full backlog headed by a second blocker.
+        pin(1u, &gate[0]);
+        pin(0u, &gate[1]);
+        sleep();
+        pin(0u, &gate[2]);
+        for (std::uint32_t i = 0; i < kVictim; ++i) {
+            pin(0u, nullptr);
+        }
+        gate[1].store(true, std::memory_order_release);
+        sleep();
+
+        // Worker 1 goes idle and posts a steal request the slow victim cannot answer.
+        gate[0].store(true, std::memory_order_release);
+        sleep();
+
+        // Saturate worker 1 and hold it in its first task.
+        pin(1u, &gate[3]);
+        for (std::uint32_t i = 0; i < kThief; ++i) {
+            pin(1u, nullptr);
+        }
+        sleep();
+
+        // The victim answers late; the thief refills its backlog, then collects the reply.
+        gate[2].store(true, std::memory_order_release);
+        sleep();
+        gate[3].store(true, std::memory_order_release);
+
+        while (ex.executed() != reg(id)) {
+            std::this_thread::yield();
+        }
+        ex.stop();
+
+        QVERIFY(board.exactly_once());
+        QCOMPARE(ex.executed(), reg(id));
+    }
+
+    void stop_without_submissions() {
+        Exec ex(kWorkers, 2u);
+        QVERIFY(ex.running());
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        ex.stop();
+        QCOMPARE(ex.executed(), reg(0u));
+    }
+
+    void restart_after_stop() {
+        HitBoard board(2u * 1000u);
+        Exec ex(2u, 1u);
+        for (std::uint32_t i = 0; i < 1000u; ++i) {
+            submit_spin(ex, 0u, HitTask{&board, i, 0u});
+        }
+        ex.stop();
+        QVERIFY(ex.start(3u, 1u));
+        for (std::uint32_t i = 1000u; i < 2000u; ++i) {
+            submit_spin(ex, 0u, HitTask{&board, i, 0u});
+        }
+        ex.stop();
+        QVERIFY(board.exactly_once());
+    }
+};
+
+} // namespace
+
+int run_tst_executor_api_paranoid(int argc, char** argv) {
+    tst_executor_api_paranoid tc;
+    return QTest::qExec(&tc, argc, argv);
+}
+
+#include "executor_test.moc"
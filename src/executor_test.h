@@ -0,0 +1,6 @@
+#ifndef EXECUTOR_TEST_H_
+#define EXECUTOR_TEST_H_
+
+int run_tst_executor_api_paranoid(int argc, char** argv);
+
+#endif /* EXECUTOR_TEST_H_ */
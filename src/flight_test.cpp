@@ -0,0 +1,321 @@
+// flight_test.cpp
+// Paranoid API/contract test for spsc::fr (flight recorder + crash dump).
+//
+// Goals:
+//  - record() overwrites the oldest record when full; sequence numbers keep
+//    counting; payloads are truncated to the record payload.
+//  - dump(fd) writes the header and both wrap halves oldest first; the decoder
+//    reads it back in sequence and rejects malformed images.
+//  - crash_dump: a child process that dies on SIGSEGV leaves a decodable dump
+//    of every registered recorder (POSIX only).
+//  - A second thread faulting during the dump waits; the dump completes.
+//  - dump_all() racing add()/remove() never calls one entry's dump function
+//    with another entry's object.
+
+#include <QtTest/QtTest>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#if !defined(_WIN32)
+#  include <ctime>
+#  include <fcntl.h>
+#  include <sys/wait.h>
+#  include <unistd.h>
+#endif
+
+#if !defined(SPSC_ASSERT) && !defined(NDEBUG)
+#  define SPSC_ASSERT(expr) do { if(!(expr)) { std::abort(); } } while(0)
+#endif
+
+#include "flight_recorder.hpp"
+
+namespace {
+
+#if !defined(_WIN32)
+template <class Rec>
+static std::vector<unsigned char> dump_to_image(const Rec& rec) {
+    std::FILE* f = std::tmpfile();
+    if (!f) {
+        return {};
+    }
+    const int fd = ::fileno(f);
+    std::vector<unsigned char> img;
+    if (rec.dump(fd)) {
+        const off_t n = ::lseek(fd, 0, SEEK_END);
+        img.resize(static_cast<std::size_t>(n));
+        if (::pread(fd, img.data(), img.size(), 0) != n) {
+            img.clear();
+        }
+    }
+    std::fclose(f);
+    return img;
+}
+
+static std::vector<unsigned char> read_file(const char* path) {
+    std::vector<unsigned char> img;
+    const int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        return img;
+    }
+    unsigned char buf[4096];
+    ::ssize_t got = 0;
+    while ((got = ::read(fd, buf, sizeof(buf))) > 0) {
+        img.insert(img.end(), buf, buf + got);
+    }
+    ::close(fd);
+    return img;
+}
+
+std::atomic<bool> g_dump_started{false};
+
+// Dump entry that flags the dump as started and then takes a while.
+struct slow_dump {
+    static bool dump_thunk(const void*, int) noexcept {
+        g_dump_started.store(true, std::memory_order_release);
+        const ::timespec ts{0, 100L * 1000L * 1000L};
+        (void)::nanosleep(&ts, nullptr);
+        return true;
+    }
+};
+#endif
+
+std::atomic<unsigned> g_foreign_obj{0u};
+
+// Dump entry that checks it is handed an object of its own type.
+template <std::uint32_t Magic>
+struct tagged_dump {
+    std::uint32_t magic{Magic};
+
+    static bool dump_thunk(const void* self, int) noexcept {
+        if (static_cast<const tagged_dump*>(self)->magic != Magic) {
+            g_foreign_obj.fetch_add(1u, std::memory_order_relaxed);
+        }
+        return true;
+    }
+};
+
+class tst_flight_api_paranoid : public QObject {
+    Q_OBJECT
+
+private slots:
+    void overwrite_keeps_newest() {
+        spsc::fr::recorder<64, 8> rec(3u);
+        QCOMPARE(rec.capacity(), reg(8u));
+        QCOMPARE(rec.tag(), 3u);
+        QCOMPARE(rec.kPayload, reg(40u));
+        for (std::uint32_t i = 0; i < 5u; ++i) {
+            rec.record_value(i, i * 10u);
+        }
+        QCOMPARE(rec.size(), reg(5u));
+        for (std::uint32_t i = 5; i < 21u; ++i) {
+            rec.record_value(i, i * 10u);
+        }
+        QCOMPARE(rec.size(), reg(8u)); // full, oldest dropped
+        QCOMPARE(rec.next_seq(), std::uint64_t(21u));
+
+        char big[100];
+        std::memset(big, 'x', sizeof(big));
+        rec.record(99u, big, sizeof(big), 7u); // truncated
+        QCOMPARE(rec.size(), reg(8u));
+        rec.clear();
+        QCOMPARE(rec.size(), reg(0u));
+        QCOMPARE(rec.next_seq(), std::uint64_t(22u));
+    }
+
+    void dump_and_decode_wrap_halves() {
+#if defined(_WIN32)
+        QSKIP("POSIX only");
+#else
+        spsc::fr::recorder<32, 8> rec(11u);
+        for (std::uint32_t i = 0; i < 13u; ++i) { // wraps: tail at index 5
+            rec.record(i, &i, sizeof(i), 1000u + i);
+        }
+        const std::vector<unsigned char> img = dump_to_image(rec);
+        QCOMPARE(img.size(), sizeof(spsc::fr::file_header) + 8u * 32u);
+
+        spsc::fr::decoder dec(img.data(), img.size());
+        spsc::fr::section s;
+        QVERIFY(dec.next(s));
+        QCOMPARE(s.header.thread_tag, 11u);
+        QCOMPARE(s.header.capacity, 8u);
+        QCOMPARE(s.header.record_bytes, 32u);
+        QCOMPARE(s.header.head, std::uint64_t(13u));
+        QCOMPARE(s.header.count, 8u);
+        for (std::uint32_t i = 0; i < 8u; ++i) {
+            const auto r = spsc::fr::decoder::at(s, i);
+            QVERIFY(r.in_sequence);
+            QCOMPARE(r.hdr.seq, std::uint64_t(5u + i));
+            QCOMPARE(r.hdr.id, 5u + i);
+            QCOMPARE(r.hdr.stamp, std::uint64_t(1005u + i));
+            QCOMPARE(r.hdr.len, 4u);
+            std::uint32_t v = 0u;
+            std::memcpy(&v, r.data, sizeof(v));
+            QCOMPARE(v, 5u + i);
+        }
+        QVERIFY(!dec.next(s));
+        QVERIFY(!dec.error());
+
+        // Empty recorder: header only. Truncated / corrupted images are rejected.
+        spsc::fr::recorder<32, 4> empty;
+        const std::vector<unsigned char> e = dump_to_image(empty);
+        QCOMPARE(e.size(), sizeof(spsc::fr::file_header));
+        spsc::fr::decoder de(e.data(), e.size());
+        QVERIFY(de.next(s));
+        QCOMPARE(s.header.count, 0u);
+        QVERIFY(!de.next(s) && !de.error());
+
+        spsc::fr::decoder dt(img.data(), img.size() - 1u);
+        QVERIFY(!dt.next(s) && dt.error());
+        std::vector<unsigned char> bad = img;
+        bad[0] = 'X';
+        spsc::fr::decoder db(bad.data(), bad.size());
+        QVERIFY(!db.next(s) && db.error());
+
+        // A stale record in the middle is flagged.
+        bad = img;
+        bad[sizeof(spsc::fr::file_header) + 3u * 32u] ^= 0x40u;
+        spsc::fr::decoder ds(bad.data(), bad.size());
+        QVERIFY(ds.next(s));
+        QVERIFY(spsc::fr::decoder::at(s, 2u).in_sequence);
+        QVERIFY(!spsc::fr::decoder::at(s, 3u).in_sequence);
+#endif
+    }
+
+    void crash_dump_from_signal_handler() {
+#if defined(_WIN32)
+        QSKIP("POSIX only");
+#else
+        char path[] = "/tmp/spsc_flight_XXXXXX";
+        const int fd = ::mkstemp(path);
+        QVERIFY(fd >= 0);
+
+        const ::pid_t pid = ::fork();
+        QVERIFY(pid >= 0);
+        if (pid == 0) {
+            static spsc::fr::recorder<64, 16> a(1u);
+            static spsc::fr::recorder<32, 4> b(2u);
+            spsc::fr::crash_dump::add(a);
+            spsc::fr::crash_dump::add(b);
+            spsc::fr::crash_dump::install(fd);
+            for (std::uint32_t i = 0; i < 20u; ++i) {
+                a.record_value(i, i);
+            }
+            b.record_value(7u, std::uint64_t(0xdeadbeefu));
+            std::raise(SIGSEGV);
+            ::_exit(0); // not reached
+        }
+        int status = 0;
+        QCOMPARE(::waitpid(pid, &status, 0), pid);
+        ::close(fd);
+        QVERIFY(WIFSIGNALED(status));
+        QCOMPARE(WTERMSIG(status), SIGSEGV); // re-raised with the default action
+
+        const std::vector<unsigned char> img = read_file(path);
+        ::unlink(path);
+        spsc::fr::decoder dec(img.data(), img.size());
+        spsc::fr::section s;
+        QVERIFY(dec.next(s));
+        QCOMPARE(s.header.thread_tag, 1u);
+        QCOMPARE(s.header.count, 16u);
+        QCOMPARE(spsc::fr::decoder::at(s, 0u).hdr.id, 4u);
+        QCOMPARE(spsc::fr::decoder::at(s, 15u).hdr.id, 19u);
+        QVERIFY(dec.next(s));
+        QCOMPARE(s.header.thread_tag, 2u);
+        QCOMPARE(s.header.count, 1u);
+        QCOMPARE(spsc::fr::decoder::at(s, 0u).hdr.id, 7u);
+        QVERIFY(!dec.next(s) && !dec.error());
+#endif
+    }
+
+    void second_fault_waits_for_dump() {
+#if defined(_WIN32)
+        QSKIP("POSIX only");
+#else
+        char path[] = "/tmp/spsc_flight_XXXXXX";
+        const int fd = ::mkstemp(path);
+        QVERIFY(fd >= 0);
+
+        const ::pid_t pid = ::fork();
+        QVERIFY(pid >= 0);
+        if (pid == 0) {
+            static slow_dump slow;
+            static spsc::fr::recorder<64, 16> a(1u);
+            spsc::fr::crash_dump::add(slow);
+            spsc::fr::crash_dump::add(a);
+            spsc::fr::crash_dump::install(fd);
+            a.record_value(5u, 5u);
+            std::thread other([]() {
+                while (!g_dump_started.load(std::memory_order_acquire)) {
+                }
+                std::raise(SIGSEGV); // faults while the main thread dumps
+            });
+            std::raise(SIGSEGV);
+            ::_exit(0); // not reached
+        }
+        int status = 0;
+        QCOMPARE(::waitpid(pid, &status, 0), pid);
+        ::close(fd);
+        QVERIFY(WIFSIGNALED(status));
+        QCOMPARE(WTERMSIG(status), SIGSEGV);
+
+        // The recorder after the slow entry made it into the image.
+        const std::vector<unsigned char> img = read_file(path);
+        ::unlink(path);
+        spsc::fr::decoder dec(img.data(), img.size());
+        spsc::fr::section s;
+        QVERIFY(dec.next(s));
+        QCOMPARE(s.header.thread_tag, 1u);
+        QCOMPARE(s.header.count, 1u);
+        QCOMPARE(spsc::fr::decoder::at(s, 0u).hdr.id, 5u);
+        QVERIFY(!dec.next(s) && !dec.error());
+#endif
+    }
+
+    void registry_pairs_stay_consistent() {
+        constexpr int kRounds = 20000;
+        static tagged_dump<0x11111111u> one;
+        static tagged_dump<0x22222222u> two;
+        std::atomic<int> running{2};
+        g_foreign_obj.store(0u);
+
+        auto churn = [&](auto& obj) {
+            for (int i = 0; i < kRounds; ++i) {
+                (void)spsc::fr::crash_dump::add(obj);
+                spsc::fr::crash_dump::remove(obj);
+            }
+            running.fetch_sub(1);
+        };
+        std::thread a([&]() { churn(one); });
+        std::thread b([&]() { churn(two); });
+        while (running.load() != 0) {
+            (void)spsc::fr::crash_dump::dump_all(-1);
+        }
+        a.join();
+        b.join();
+
+        QCOMPARE(g_foreign_obj.load(), 0u);
+        QCOMPARE(spsc::fr::crash_dump::dump_all(-1), 0u);
+    }
+
+    void registry_add_remove() {
+        spsc::fr::recorder<32, 4> r;
+        QVERIFY(spsc::fr::crash_dump::add(r));
+        spsc::fr::crash_dump::remove(r);
+        QCOMPARE(spsc::fr::crash_dump::dump_all(-1), 0u); // nothing registered
+    }
+};
+
+} // namespace
+
+int run_tst_flight_api_paranoid(int argc, char** argv) {
+    tst_flight_api_paranoid tc;
+    return QTest::qExec(&tc, argc, argv);
+}
+
+#include "flight_test.moc"
@@ -0,0 +1,6 @@
+#ifndef FLIGHT_TEST_H_
+#define FLIGHT_TEST_H_
+
+int run_tst_flight_api_paranoid(int argc, char** argv);
+
+#endif /* FLIGHT_TEST_H_ */
@@ -0,0 +1,197 @@
+// graveyard_test.cpp
+// Paranoid API/contract test for spsc::graveyard.
+//
+// Goals:
+//  - pop_from() works for queue and typed_pool; the element is destroyed exactly
+//    once, on the reaper side (live-object counter returns to zero).
+//  - Full graveyard ring falls back to inline destruction; nothing leaks.
+//  - stop() / destructor drain leftovers.
+//  - Threaded pipeline producer -> consumer -> reaper with heavy objects, with
+//    and without offload (pop time is measured by tools/spsc_bench).
+
+#include <QtTest/QtTest>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#if !defined(SPSC_ASSERT) && !defined(NDEBUG)
+#  define SPSC_ASSERT(expr) do { if(!(expr)) { std::abort(); } } while(0)
+#endif
+
+#include "graveyard.hpp"
+#include "queue.hpp"
+#include "typed_pool.hpp"
+
+namespace {
+
+#if defined(NDEBUG)
+constexpr std::uint32_t kMsgs = 200000u;
+#else
+constexpr std::uint32_t kMsgs = 20000u;
+#endif
+
+std::atomic<int> g_live{0};
+std::atomic<std::thread::id> g_last_dtor{};
+
+// Heavy payload: a vector of many small heap nodes.
+struct Heavy {
+    std::vector<std::unique_ptr<std::uint32_t>> nodes;
+    std::uint32_t seq{0u};
+
+    Heavy() noexcept = default;
+    Heavy(std::uint32_t s, std::uint32_t n) : seq(s) {
+        nodes.reserve(n);
+        for (std::uint32_t i = 0; i < n; ++i) {
+            nodes.emplace_back(new std::uint32_t(s + i));
+        }
+        g_live.fetch_add(1, std::memory_order_relaxed);
+    }
+    Heavy(Heavy&& o) noexcept : nodes(std::move(o.nodes)), seq(o.seq) {}
+    Heavy& operator=(Heavy&& o) noexcept {
+        nodes = std::move(o.nodes);
+        seq = o.seq;
+        return *this;
+    }
+    ~Heavy() {
+        if (!nodes.empty()) { // owns real payload (not a moved-from shell)
+            g_live.fetch_sub(1, std::memory_order_relaxed);
+            g_last_dtor.store(std::this_thread::get_id(), std::memory_order_relaxed);
+        }
+    }
+};
+
+class tst_graveyard_api_paranoid : public QObject {
+    Q_OBJECT
+
+private slots:
+    void queue_pop_from_defers() {
+        {
+            spsc::queue<Heavy, 16> q;
+            spsc::graveyard<Heavy, 16> g;
+            for (std::uint32_t i = 0; i < 5; ++i) {
+                QVERIFY(q.try_emplace(i, 8u) != nullptr);
+            }
+            QCOMPARE(g_live.load(), 5);
+            QVERIFY(g.pop_from(q));
+            QCOMPARE(g.pop_from(q, 10u), reg(4u));
+            QVERIFY(!g.pop_from(q));
+            QVERIFY(q.empty());
+            QCOMPARE(g_live.load(), 5); // nothing destroyed yet
+            QCOMPARE(g.pending(), reg(5u));
+
+            QCOMPARE(g.collect(3u), reg(3u));
+            QCOMPARE(g_live.load(), 2);
+            QCOMPARE(g.collect_all(), reg(2u));
+            QCOMPARE(g_live.load(), 0);
+            QCOMPARE(g.buried(), reg(5u));
+            QCOMPARE(g.collected(), reg(5u));
+        }
+        QCOMPARE(g_live.load(), 0);
+    }
+
+    void typed_pool_pop_from() {
+        spsc::typed_pool<Heavy, 8> p;
+        spsc::graveyard<Heavy, 8> g;
+        for (std::uint32_t i = 0; i < 3; ++i) {
+            QVERIFY(p.try_emplace(i, 4u));
+        }
+        QCOMPARE(g.pop_from(p, 3u), reg(3u));
+        QVERIFY(p.empty());
+        QCOMPARE(g_live.load(), 3);
+        g.stop(); // no helper: just drains
+        QCOMPARE(g_live.load(), 0);
+    }
+
+    void full_ring_destroys_inline() {
+        spsc::queue<Heavy, 8> q;
+        spsc::graveyard<Heavy, 2> g;
+        for (std::uint32_t i = 0; i < 5; ++i) {
+            QVERIFY(q.try_emplace(i, 2u) != nullptr);
+        }
+        QCOMPARE(g.pop_from(q, 5u), reg(5u));
+        QCOMPARE(g.buried(), reg(2u));
+        QCOMPARE(g.inline_destroyed(), reg(3u));
+        QCOMPARE(g_live.load(), 2);
+        QCOMPARE(g.collect_all(), reg(2u));
+        QCOMPARE(g_live.load(), 0);
+    }
+
+    void destructor_drains() {
+        {
+            spsc::graveyard<Heavy, 16> g;
+            Heavy h(1u, 3u);
+            g.bury(std::move(h));
+            QCOMPARE(g_live.load(), 1);
+        }
+        QCOMPARE(g_live.load(), 0);
+    }
+
+    void threaded_pipeline_offloads() {
+        auto run = [](bool offload) {
+            spsc::queue<Heavy, 256, spsc::policy::CA<>> q;
+            spsc::graveyard<Heavy, 4096> g;
+            if (offload) {
+                (void)g.start();
+            }
+            std::thread producer([&]() {
+                for (std::uint32_t i = 0; i < kMsgs; ++i) {
+                    while (!q.try_emplace(i, 32u)) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+
+            bool ok = true;
+            for (std::uint32_t i = 0; i < kMsgs; ++i) {
+                Heavy* h = nullptr;
+                while (!(h = q.try_front())) {
+                    std::this_thread::yield();
+                }
+                ok = ok && (h->seq == i) && (*h->nodes.back() == i + 31u);
+                if (offload) {
+                    (void)g.pop_from(q);
+                } else {
+                    q.pop();
+                }
+            }
+            producer.join();
+            g.stop();
+            return ok && g_live.load() == 0;
+        };
+
+        QVERIFY(run(false));
+        QVERIFY(run(true));
+    }
+
+    void helper_thread_destroys() {
+        spsc::queue<Heavy, 64> q;
+        spsc::graveyard<Heavy, 64> g;
+        QVERIFY(g.start());
+        QVERIFY(!g.start());
+        QVERIFY(g.running());
+        for (std::uint32_t i = 0; i < 32; ++i) {
+            QVERIFY(q.try_emplace(i, 2u) != nullptr);
+            QVERIFY(g.pop_from(q));
+        }
+        while (g.collected() < 32u) {
+            std::this_thread::yield();
+        }
+        QCOMPARE(g_live.load(), 0);
+        QVERIFY(g_last_dtor.load() != std::this_thread::get_id());
+        g.stop();
+        QVERIFY(!g.running());
+    }
+};
+
+} // namespace
+
+int run_tst_graveyard_api_paranoid(int argc, char** argv) {
+    tst_graveyard_api_paranoid tc;
+    return QTest::qExec(&tc, argc, argv);
+}
+
+#include "graveyard_test.moc"
@@ -0,0 +1,6 @@
+#ifndef GRAVEYARD_TEST_H_
+#define GRAVEYARD_TEST_H_
+
+int run_tst_graveyard_api_paranoid(int argc, char** argv);
+
+#endif /* GRAVEYARD_TEST_H_ */
@@ -0,0 +1,6 @@
+#ifndef HISTORY_TEST_H_
+#define HISTORY_TEST_H_
+
+int run_tst_history_api_paranoid(int argc, char** argv);
+
+#endif /* HISTORY_TEST_H_ */
@@ -0,0 +1,220 @@
+// layout_test.cpp
+// Paranoid API/contract test for the cache-line layout inspector
+// (base/spsc_layout.hpp).
+//
+// Goals:
+//  - report: offsets, line numbers (relative to the object's first line),
+//    misalignment, line_count(), line_writers() and same_line() on a
+//    hand-built object at a known address.
+//  - CA<> fifo/queue/pool: head, tail and both shadows on four different
+//    lines, nothing written by both sides, inline storage on its own line.
+//  - P / A<> rings: shared_lines() flags head and tail (and the consumer
+//    shadow) on one line.
+//  - edge_exposed(): a plain ring placed off a line boundary shares its
+//    hot lines with its neighbours; a CA<> ring never does.
+//  - Every container reports its geometry/storage fields inside the object.
+
+#include <QtTest/QtTest>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#if !defined(SPSC_ASSERT) && !defined(NDEBUG)
+#  define SPSC_ASSERT(expr) do { if(!(expr)) { std::abort(); } } while(0)
+#endif
+
+#include "layout_test.h"
+#include "fifo.hpp"
+#include "fifo_view.hpp"
+#include "pool.hpp"
+#include "pool_view.hpp"
+#include "queue.hpp"
+#include "typed_pool.hpp"
+#include "base/spsc_layout.hpp"
+
+namespace {
+
+namespace lay = ::spsc::layout;
+
+constexpr std::size_t kLine = SPSC_CACHELINE_BYTES;
+
+// Any type with describe_layout() can be inspected.
+struct fake_ring {
+    std::uint32_t head;
+    std::uint32_t tail;
+    std::uint32_t cap;
+
+    void describe_layout(lay::report& r) const noexcept {
+        r.add("head", &head, sizeof(head), lay::writer::producer);
+        r.add("tail", &tail, sizeof(tail), lay::writer::consumer);
+        r.add("cap", &cap, sizeof(cap), lay::writer::setup);
+    }
+};
+
+// Constructs T at byte 'offset' of a line-aligned buffer.
+template<class T, std::size_t Offset>
+struct placed {
+    alignas(kLine) unsigned char buf[Offset + sizeof(T) + kLine];
+    T* obj;
+
+    template<class... Args>
+    explicit placed(Args&&... args) : obj(::new (static_cast<void*>(buf + Offset)) T(args...)) {}
+    ~placed() { obj->~T(); }
+
+    placed(const placed&)            = delete;
+    placed& operator=(const placed&) = delete;
+};
+
+template<class Ring>
+void verify_split(const Ring& q) {
+    const auto r = lay::inspect(q);
+    QCOMPARE(r.shared_lines(), std::size_t(0u));
+    QVERIFY(!r.same_line("head", "tail"));
+    if (r.find("prod_shadow_tail") != nullptr) {
+        QVERIFY(!r.same_line("prod_shadow_tail", "cons_shadow_head"));
+        QVERIFY(!r.same_line("prod_shadow_tail", "tail"));
+        QVERIFY(!r.same_line("cons_shadow_head", "head"));
+    }
+    QVERIFY(!r.edge_exposed());
+    for (std::size_t i = 0; i < r.size(); ++i) {
+        QVERIFY(r[i].offset + r[i].size <= r.object_size());
+    }
+}
+
+class tst_layout_api_paranoid : public QObject {
+    Q_OBJECT
+
+private slots:
+    void report_mechanics() {
+        placed<fake_ring, kLine - 4u> p;
+        const auto r = lay::inspect(*p.obj);
+
+        QCOMPARE(r.size(), std::size_t(3u));
+        QCOMPARE(r.object_size(), sizeof(fake_ring));
+        QCOMPARE(r.line_bytes(), kLine);
+        QCOMPARE(r.misalignment(), kLine - 4u);
+        QCOMPARE(r.line_count(), std::size_t(2u));
+
+        QCOMPARE(r.find("head")->offset, std::size_t(0u));
+        QCOMPARE(r.find("head")->first_line, std::size_t(0u));
+        QCOMPARE(r.find("tail")->offset, std::size_t(4u));
+        QCOMPARE(r.find("tail")->first_line, std::size_t(1u));
+        QCOMPARE(r.find("cap")->last_line, std::size_t(1u));
+        QVERIFY(r.find("nope") == nullptr);
+
+        QVERIFY(r.line_writers(0u) == lay::writer::producer);
+        QVERIFY(r.line_writers(1u) == lay::writer::consumer);
+        QCOMPARE(r.shared_lines(), std::size_t(0u));
+        QVERIFY(r.same_line("tail", "cap"));
+        QVERIFY(!r.same_line("head", "tail"));
+        QVERIFY(r.edge_exposed()); // head on a line shared with the bytes before
+
+        placed<fake_ring, 0u> q;
+        const auto s = lay::inspect(*q.obj);
+        QCOMPARE(s.misalignment(), std::size_t(0u));
+        QCOMPARE(s.line_count(), std::size_t(1u));
+        QVERIFY(s.line_writers(0u) == lay::writer::both);
+        QCOMPARE(s.shared_lines(), std::size_t(1u));
+
+        // Smaller line size on the same instance: each field on its own line.
+        const auto t = lay::inspect(*q.obj, 4u);
+        QCOMPARE(t.line_count(), std::size_t(3u));
+        QCOMPARE(t.shared_lines(), std::size_t(0u));
+        QVERIFY(!t.edge_exposed());
+    }
+
+    void cache_aligned_rings_split() {
+        ::spsc::fifo<int, 16, ::spsc::policy::CA<>> a;
+        ::spsc::fifo<int, 0, ::spsc::policy::CA<>> b(16u);
+        ::spsc::queue<int, 16, ::spsc::policy::CA<>> c;
+        ::spsc::pool<8, ::spsc::policy::CA<>> d(32u);
+        ::spsc::fifo_view<int, 0, ::spsc::policy::CA<>> e;
+        verify_split(a);
+        verify_split(b);
+        verify_split(c);
+        verify_split(d);
+        verify_split(e);
+
+        // Inline storage starts on a line of its own after the counters.
+        const auto r = lay::inspect(a);
+        const lay::field* st = r.find("storage");
+        QVERIFY(st != nullptr);
+        QVERIFY(st->by == lay::writer::producer);
+        QCOMPARE(st->size, sizeof(int) * 16u);
+        QVERIFY(st->first_line > r.find("tail")->last_line);
+        QCOMPARE(r.find("head")->offset % kLine, std::size_t(0u));
+        QCOMPARE(r.find("tail")->offset % kLine, std::size_t(0u));
+
+        // Dynamic geometry is setup-only and never shares a written line.
+        const auto g = lay::inspect(b);
+        QVERIFY(g.find("cap") != nullptr && g.find("mask") != nullptr);
+        QVERIFY(g.find("cap")->by == lay::writer::setup);
+        QVERIFY(g.find("storage")->by == lay::writer::setup);
+        QVERIFY(!g.same_line("cap", "head") && !g.same_line("mask", "tail"));
+    }
+
+    void plain_rings_flagged() {
+        placed<::spsc::fifo<int, 8, ::spsc::policy::P>, 0u> p;
+        const auto r = lay::inspect(*p.obj);
+        QVERIFY(r.same_line("head", "tail"));
+        QVERIFY(r.shared_lines() >= 1u);
+        QVERIFY(r.line_writers(r.find("head")->first_line) == lay::writer::both);
+        QVERIFY(r.find("prod_shadow_tail") == nullptr); // plain counters: no shadows
+        QVERIFY(r.find("cap") == nullptr);              // static geometry: no bytes
+
+        // A<>: padded shadows, but the consumer shadow shares the index line.
+        placed<::spsc::pool<0, ::spsc::policy::A<>>, 0u> q(4u, 32u);
+        const auto s = lay::inspect(*q.obj);
+        QVERIFY(s.shared_lines() >= 1u);
+        if (s.find("cons_shadow_head") != nullptr) {
+            QVERIFY(!s.same_line("prod_shadow_tail", "cons_shadow_head"));
+            QVERIFY(s.same_line("cons_shadow_head", "head"));
+        }
+
+        ::spsc::typed_pool<int, 8, ::spsc::policy::P> t;
+        const auto u = lay::inspect(t);
+        QVERIFY(u.find("allocated") != nullptr && u.find("slots") != nullptr);
+        QVERIFY(u.same_line("head", "tail"));
+
+        ::spsc::pool_view<0, ::spsc::policy::A<>> v;
+        const auto w = lay::inspect(v);
+        QVERIFY(w.find("slots") != nullptr && w.find("buffer_size") != nullptr);
+    }
+
+    void neighbour_exposure() {
+        using plain = ::spsc::fifo<int, 8, ::spsc::policy::P>;
+        placed<plain, 8u> off;
+        const auto r = lay::inspect(*off.obj);
+        QCOMPARE(r.misalignment(), std::size_t(8u));
+        QVERIFY(r.edge_exposed());
+        QCOMPARE(r.find("head")->first_line, std::size_t(0u));
+
+        // The same type on a line boundary is exposed only through its end.
+        placed<plain, 0u> on;
+        const auto s = lay::inspect(*on.obj);
+        QCOMPARE(s.misalignment(), std::size_t(0u));
+        QCOMPARE(s.edge_exposed(), (sizeof(plain) % kLine) != 0u);
+
+        // CA<> rings are line-aligned and line-sized wherever they are placed.
+        struct user_state {
+            char                                        tag;
+            ::spsc::fifo<int, 16, ::spsc::policy::CA<>> q;
+            char                                        after;
+        } u{};
+        const auto t = lay::inspect(u.q);
+        QCOMPARE(t.misalignment(), std::size_t(0u));
+        QCOMPARE(t.object_size() % kLine, std::size_t(0u));
+        QVERIFY(!t.edge_exposed());
+    }
+};
+
+} // namespace
+
+int run_tst_layout_api_paranoid(int argc, char** argv) {
+    tst_layout_api_paranoid tc;
+    return QTest::qExec(&tc, argc, argv);
+}
+
+#include "layout_test.moc"
@@ -0,0 +1,6 @@
+#ifndef LAYOUT_TEST_H_
+#define LAYOUT_TEST_H_
+
+int run_tst_layout_api_paranoid(int argc, char** argv);
+
+#endif /* LAYOUT_TEST_H_ */
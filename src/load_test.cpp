@@ -0,0 +1,163 @@
+// load_test.cpp
+// Paranoid API/contract test for the spsc_load open-loop generator
+// (tools/spsc_load/load_gen.hpp).
+//
+// Goals:
+//  - Schedules: constant spacing, Poisson mean gap, bursts; all deterministic
+//    for a seed and with the same mean rate.
+//  - Histogram: bucket bounds, percentiles within bucket precision, merge.
+//  - Open loop: a consumer stall shows up as latency of every message intended
+//    during the stall (no coordinated omission); all messages arrive in order.
+//  - Sweep stops at the first saturated point; result lines round-trip.
+
+#include <QtTest/QtTest>
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if !defined(SPSC_ASSERT) && !defined(NDEBUG)
+#  define SPSC_ASSERT(expr) do { if(!(expr)) { std::abort(); } } while(0)
+#endif
+
+#include "fifo.hpp"
+#include "../tools/spsc_load/load_gen.hpp"
+
+namespace {
+
+namespace ld = ::spsc::load;
+
+class tst_load_api_paranoid : public QObject {
+    Q_OBJECT
+
+private slots:
+    void schedules() {
+        ld::schedule_config c;
+        c.rate = 1e6; // 1 us gap
+        ld::schedule cst(c);
+        for (std::uint64_t i = 0; i < 100u; ++i) {
+            QCOMPARE(cst.next(), i * 1000u);
+        }
+
+        c.shape = ld::pattern::poisson;
+        ld::schedule p1(c);
+        ld::schedule p2(c);
+        std::uint64_t last = 0u;
+        bool same = true;
+        bool monotonic = true;
+        constexpr unsigned kN = 50000u;
+        for (unsigned i = 0; i < kN; ++i) {
+            const std::uint64_t a = p1.next();
+            same = same && (a == p2.next());
+            monotonic = monotonic && (a >= last);
+            last = a;
+        }
+        QVERIFY(same && monotonic);
+        const double mean_gap = double(last) / (kN - 1u);
+        QVERIFY(std::fabs(mean_gap - 1000.0) < 30.0);
+
+        c.shape = ld::pattern::burst;
+        c.burst = 8u;
+        ld::schedule b(c);
+        for (unsigned k = 0; k < 3u; ++k) {
+            for (unsigned i = 0; i < 8u; ++i) {
+                QCOMPARE(b.next(), std::uint64_t(k) * 8000u);
+            }
+        }
+
+        ld::pattern p{};
+        QVERIFY(ld::parse_pattern("poisson", p) && p == ld::pattern::poisson);
+        QVERIFY(!ld::parse_pattern("uniform", p));
+    }
+
+    void histogram_percentiles() {
+        ld::histogram h;
+        QCOMPARE(h.percentile(0.5), std::uint64_t(0u));
+        for (std::uint64_t v = 1; v <= 100000u; ++v) {
+            h.record(v);
+        }
+        QCOMPARE(h.count(), std::uint64_t(100000u));
+        QCOMPARE(h.max(), std::uint64_t(100000u));
+        QVERIFY(std::fabs(h.mean() - 50000.5) < 1e-6);
+        for (const double q : {0.5, 0.9, 0.99, 0.999}) {
+            const double exact = q * 100000.0;
+            const double got = double(h.percentile(q));
+            QVERIFY(got >= exact && got <= exact * 1.04);
+        }
+        QCOMPARE(h.percentile(1.0), std::uint64_t(100000u));
+
+        for (const std::uint64_t v : {0ull, 31ull, 32ull, 33ull, 1000ull, 123456789ull, ~0ull}) {
+            const unsigned i = ld::histogram::index_of(v);
+            QVERIFY(i < ld::histogram::kBuckets);
+            QVERIFY(ld::histogram::upper_of(i) >= v);
+            QVERIFY(i == 0u || ld::histogram::upper_of(i - 1u) < v);
+        }
+
+        ld::histogram a;
+        ld::histogram b;
+        a.record(10u);
+        b.record(5000u);
+        a.merge(b);
+        QCOMPARE(a.count(), std::uint64_t(2u));
+        QCOMPARE(a.max(), std::uint64_t(5000u));
+    }
+
+    void stall_is_charged_to_messages() {
+        spsc::fifo<std::uint64_t, 64, spsc::policy::A<>> q;
+        ld::run_config cfg;
+        cfg.sched.rate = 20000.0; // 50 us gap
+        cfg.duration = std::chrono::milliseconds(100);
+        cfg.on_consume = [](std::uint64_t i) {
+            if (i == 10u) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            }
+        };
+        const ld::point pt = ld::run_open_loop(q, cfg);
+        QCOMPARE(pt.received, pt.sent);
+        QVERIFY(pt.sent >= 1900u && pt.sent <= 2000u);
+        QVERIFY(pt.in_order);
+        // ~400 of ~2000 messages were intended during the stall: p90 must see it.
+        QVERIFY(pt.max >= 15000000u);
+        QVERIFY(pt.p90 >= 1000000u);
+    }
+
+    void sweep_stops_at_saturation_and_lines_round_trip() {
+        using Ring = spsc::fifo<std::uint64_t, 256, spsc::policy::A<>>;
+        ld::run_config cfg;
+        cfg.duration = std::chrono::milliseconds(20);
+        const auto pts = ld::sweep([]() { return std::make_unique<Ring>(); }, cfg, {10000.0, 1e10, 1e11});
+        QVERIFY(!pts.empty() && pts.size() <= 2u);
+        QVERIFY(!pts.front().saturated);
+        QCOMPARE(pts.front().received, pts.front().sent);
+        if (pts.size() == 2u) {
+            QVERIFY(pts.back().saturated);
+        }
+
+        const std::string line = ld::format_line("fifo/A", ld::pattern::constant, pts.front());
+        ld::result_line r;
+        QVERIFY(ld::parse_line(line, r));
+        QCOMPARE(r.label, std::string("fifo/A"));
+        QCOMPARE(r.pattern, std::string("constant"));
+        QCOMPARE(r.pt.p99, pts.front().p99);
+        QVERIFY(!ld::parse_line("R A 8 64 1.0", r));
+
+        std::vector<ld::result_line> base{r};
+        QVERIFY(ld::find_baseline(base, r) != nullptr);
+        r.pattern = "burst";
+        QVERIFY(ld::find_baseline(base, r) == nullptr);
+    }
+};
+
+} // namespace
+
+int run_tst_load_api_paranoid(int argc, char** argv) {
+    tst_load_api_paranoid tc;
+    return QTest::qExec(&tc, argc, argv);
+}
+
+#include "load_test.moc"
@@ -0,0 +1,6 @@
+#ifndef LOAD_TEST_H_
+#define LOAD_TEST_H_
+
+int run_tst_load_api_paranoid(int argc, char** argv);
+
+#endif /* LOAD_TEST_H_ */
@@ -0,0 +1,6 @@
+#ifndef MESH_TEST_H_
+#define MESH_TEST_H_
+
+int run_tst_mesh_api_paranoid(int argc, char** argv);
+
+#endif /* MESH_TEST_H_ */
@@ -0,0 +1,163 @@
+// micro_test.cpp
+// Paranoid API/contract test for the spsc_micro codegen model
+// (tools/spsc_micro/micro_model.hpp).
+//
+// Goals:
+//  - Fence classification for x86 (mfence, lock, xchg with memory) and
+//    AArch64 (dmb, acquire/release loads/stores); padding is not counted.
+//  - objdump parsing: only prefixed functions, with or without raw bytes.
+//  - compare(): extra fence, growth past tolerance and missing functions
+//    fail; new functions and growth within tolerance pass.
+//  - B/C result lines round-trip.
+
+#include <QtTest/QtTest>
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#if !defined(SPSC_ASSERT) && !defined(NDEBUG)
+#  define SPSC_ASSERT(expr) do { if(!(expr)) { std::abort(); } } while(0)
+#endif
+
+#include "../tools/spsc_micro/micro_model.hpp"
+
+namespace {
+
+namespace mc = ::spsc::micro;
+
+const char* const kX86 =
+    "\n"
+    "spsc_micro_bench.bin:     file format elf64-x86-64\n"
+    "\n"
+    "Disassembly of section .text:\n"
+    "\n"
+    "0000000000001180 <main>:\n"
+    "    1180:\tpush   %rbp\n"
+    "    1181:\tmfence\n"
+    "\n"
+    "00000000000013a0 <spsc_micro_push_A>:\n"
+    "    13a0:\tmov    0x8(%rdi),%rax\n"
+    "    13a4:\tand    0x10(%rdi),%rax\n"
+    "    13a8:\tmov    %rsi,0x18(%rdi,%rax,8)\n"
+    "    13ad:\tlock addq $0x1,0x8(%rdi)\n"
+    "    13b3:\tret\n"
+    "    13b4:\tdata16 cs nopw 0x0(%rax,%rax,1)\n"
+    "    13bf:\tnop\n"
+    "\n"
+    "00000000000013c0 <spsc_micro_pop_P>:\n"
+    "    13c0:\t48 83 07 01          \taddq   $0x1,(%rdi)\n"
+    "    13c4:\tc3                   \tret\n"
+    "    13c5:\t66 66 2e 0f 1f 84 00 \tdata16 cs nopw 0x0(%rax,%rax,1)\n"
+    "    13cc:\t00 00 00 00 \n"
+    "\n"
+    "00000000000013d0 <spsc_micro_publish_X>:\n"
+    "    13d0:\txchg   %rax,(%rdi)\n"
+    "    13d3:\txchg   %rax,%rdx\n"
+    "    13d6:\tmfence\n"
+    "    13d9:\tret\n";
+
+const char* const kA64 =
+    "0000000000400600 <spsc_micro_try_push_A>:\n"
+    "  400600:\tc8dffc01 \tldar\tx1, [x0]\n"
+    "  400604:\tldr\tx2, [x0, #8]\n"
+    "  400608:\tstlr\tx1, [x0]\n"
+    "  40060c:\tdmb\tish\n"
+    "  400610:\tret\n";
+
+class tst_micro_api_paranoid : public QObject {
+    Q_OBJECT
+
+private slots:
+    void fence_classification() {
+        QVERIFY(mc::is_fence("mfence"));
+        QVERIFY(mc::is_fence("lock cmpxchg %rdx,(%rdi)"));
+        QVERIFY(mc::is_fence("xchg   %rax,(%rdi)"));
+        QVERIFY(mc::is_fence("xchg   QWORD PTR [rdi],rax"));
+        QVERIFY(!mc::is_fence("xchg   %rax,%rdx"));
+        QVERIFY(!mc::is_fence("mov    %rsi,0x18(%rdi)"));
+        QVERIFY(mc::is_fence("dmb\tish"));
+        QVERIFY(mc::is_fence("ldapr\tx1, [x0]"));
+        QVERIFY(mc::is_fence("stlxr\tw3, x1, [x0]"));
+        QVERIFY(!mc::is_fence("ldr\tx2, [x0, #8]"));
+
+        QVERIFY(mc::is_padding("nop"));
+        QVERIFY(mc::is_padding("nopl   0x0(%rax)"));
+        QVERIFY(mc::is_padding("data16 cs nopw 0x0(%rax,%rax,1)"));
+        QVERIFY(mc::is_padding("int3"));
+        QVERIFY(!mc::is_padding("ret"));
+    }
+
+    void objdump_parsing() {
+        const auto v = mc::parse_objdump(kX86, "spsc_micro_");
+        QCOMPARE(v.size(), std::size_t(3u));
+
+        QCOMPARE(v[0].fn, std::string("spsc_micro_push_A"));
+        QCOMPARE(v[0].insns, 5u);
+        QCOMPARE(v[0].fences, 1u);
+
+        QCOMPARE(v[1].fn, std::string("spsc_micro_pop_P")); // raw-byte column
+        QCOMPARE(v[1].insns, 2u);
+        QCOMPARE(v[1].fences, 0u);
+
+        QCOMPARE(v[2].fn, std::string("spsc_micro_publish_X"));
+        QCOMPARE(v[2].insns, 4u);
+        QCOMPARE(v[2].fences, 2u);
+
+        const auto a = mc::parse_objdump(kA64, "spsc_micro_");
+        QCOMPARE(a.size(), std::size_t(1u));
+        QCOMPARE(a[0].insns, 5u);
+        QCOMPARE(a[0].fences, 3u);
+
+        QVERIFY(mc::parse_objdump(kX86, "nothing_").empty());
+        QVERIFY(mc::parse_objdump("", "spsc_micro_").empty());
+    }
+
+    void regression_check() {
+        const std::vector<mc::codegen> base{{"f_push", 10u, 1u}, {"f_pop", 4u, 0u}, {"f_gone", 3u, 0u}};
+
+        std::vector<mc::codegen> cur{{"f_push", 11u, 1u}, {"f_pop", 4u, 0u}, {"f_gone", 3u, 0u},
+                                     {"f_new", 99u, 9u}};
+        QVERIFY(mc::compare(base, cur, 10u).empty());
+
+        cur[0].insns = 12u; // past 10 %
+        cur[1].fences = 1u; // new fence
+        cur.erase(cur.begin() + 2);
+        const auto r = mc::compare(base, cur, 10u);
+        QCOMPARE(r.size(), std::size_t(3u));
+        QCOMPARE(std::string(r[0].what), std::string("insns"));
+        QCOMPARE(r[0].fn, std::string("f_push"));
+        QCOMPARE(std::string(r[1].what), std::string("fences"));
+        QCOMPARE(std::string(r[2].what), std::string("missing"));
+
+        QCOMPARE(mc::compare(base, cur, 20u).size(), std::size_t(2u));
+    }
+
+    void lines_round_trip() {
+        mc::codegen c{"spsc_micro_pop_CA", 2u, 1u};
+        mc::codegen c2;
+        QVERIFY(mc::parse_codegen(mc::format_codegen(c), c2));
+        QCOMPARE(c2.fn, c.fn);
+        QCOMPARE(c2.insns, 2u);
+        QCOMPARE(c2.fences, 1u);
+        QVERIFY(!mc::parse_codegen("# c++ -std=c++17 -O2", c2));
+        QVERIFY(!mc::parse_codegen("C f 0 0", c2));
+
+        mc::bench_line b{"CA", "try_push", 40.75};
+        mc::bench_line b2;
+        QVERIFY(mc::parse_bench(mc::format_bench(b), b2));
+        QCOMPARE(b2.policy, std::string("CA"));
+        QCOMPARE(b2.primitive, std::string("try_push"));
+        QVERIFY(b2.cycles > 40.7 && b2.cycles < 40.8);
+        QVERIFY(!mc::parse_bench("C spsc_micro_pop_CA 2 1", b2));
+    }
+};
+
+} // namespace
+
+int run_tst_micro_api_paranoid(int argc, char** argv) {
+    tst_micro_api_paranoid tc;
+    return QTest::qExec(&tc, argc, argv);
+}
+
+#include "micro_test.moc"
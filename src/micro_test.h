@@ -0,0 +1,6 @@
+#ifndef MICRO_TEST_H_
+#define MICRO_TEST_H_
+
+int run_tst_micro_api_paranoid(int argc, char** argv);
+
+#endif /* MICRO_TEST_H_ */
@@ -0,0 +1,153 @@
+// observer_test.cpp
+// Paranoid API/contract test for fifo::try_copy_out / fifo_view::try_copy_out.
+//
+// Goals:
+//  - Copies unread elements oldest-first across the wrap, bounded by max.
+//  - Never consumes: size(), front() and later pops are unaffected.
+//  - Invalid (dynamic, unallocated) rings report 0.
+//  - Atomic policies only (observe_copy() static_asserts on P / V).
+//  - Third thread copying while producer and consumer run: every successful
+//    copy is a gap-free run of the producer's sequence (no torn/overwritten slot).
+
+#include <QtTest/QtTest>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+
+#if !defined(SPSC_ASSERT) && !defined(NDEBUG)
+#  define SPSC_ASSERT(expr) do { if(!(expr)) { std::abort(); } } while(0)
+#endif
+
+#include "fifo.hpp"
+#include "fifo_view.hpp"
+
+namespace {
+
+#if defined(NDEBUG)
+constexpr std::uint64_t kItems = 4000000u;
+#else
+constexpr std::uint64_t kItems = 400000u;
+#endif
+
+struct Sample {
+    std::uint64_t seq{0u};
+    std::uint64_t check{0u}; // ~seq: detects a slot copied half-old/half-new
+};
+
+class tst_observer_api_paranoid : public QObject {
+    Q_OBJECT
+
+private slots:
+    void copies_without_consuming() {
+        spsc::fifo<int, 8, spsc::policy::A<>> q;
+        int out[8]{};
+        QCOMPARE(q.try_copy_out(out, 8u), reg(0u)); // empty
+
+        for (int i = 0; i < 6; ++i) {
+            q.push(i);
+        }
+        q.pop(reg(4u));
+        for (int i = 6; i < 12; ++i) { // wraps: tail at 4, head at 12
+            q.push(i);
+        }
+        QCOMPARE(q.try_copy_out(out, 8u), reg(8u));
+        for (int i = 0; i < 8; ++i) {
+            QCOMPARE(out[i], 4 + i);
+        }
+        QCOMPARE(q.size(), reg(8u));
+        QCOMPARE(q.front(), 4);
+
+        int small[3]{};
+        QCOMPARE(q.try_copy_out(small, 3u), reg(3u));
+        QCOMPARE(small[2], 6);
+        QCOMPARE(q.try_copy_out(small, 0u), reg(0u));
+    }
+
+    void invalid_and_dynamic() {
+        spsc::fifo<int, 0, spsc::policy::A<>> q;
+        int out[4]{};
+        QVERIFY(!q.is_valid());
+        QCOMPARE(q.try_copy_out(out, 4u), reg(0u));
+
+        QVERIFY(q.resize(16u));
+        q.push(7);
+        QCOMPARE(q.try_copy_out(out, 4u), reg(1u));
+        QCOMPARE(out[0], 7);
+    }
+
+    void fifo_view_backend() {
+        std::array<std::uint16_t, 4> storage{};
+        spsc::fifo_view<std::uint16_t, 4, spsc::policy::CA<>> v(storage);
+        v.push(1u);
+        v.push(2u);
+        v.pop();
+        v.push(3u);
+        v.push(4u);
+        v.push(5u); // wraps
+        std::uint16_t out[4]{};
+        QCOMPARE(v.try_copy_out(out, 4u), reg(4u));
+        QCOMPARE(out[0], std::uint16_t(2u));
+        QCOMPARE(out[3], std::uint16_t(5u));
+        QCOMPARE(v.size(), reg(4u));
+    }
+
+    void observer_during_live_traffic() {
+        using Q = spsc::fifo<Sample, 64, spsc::policy::A<>>;
+        Q q;
+        std::atomic<bool> done{false};
+        std::atomic<bool> torn{false};
+
+        std::thread producer([&]() {
+            for (std::uint64_t i = 0; i < kItems; ++i) {
+                while (!q.try_push(Sample{i, ~i})) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        std::thread observer([&]() {
+            Sample buf[64];
+            while (!done.load(std::memory_order_acquire)) {
+                const reg n = q.try_copy_out(buf, 64u);
+                for (reg i = 0; i < n; ++i) {
+                    if (buf[i].check != ~buf[i].seq || (i != 0u && buf[i].seq != buf[i - 1u].seq + 1u)) {
+                        torn.store(true, std::memory_order_relaxed);
+                    }
+                }
+                std::this_thread::yield();
+            }
+        });
+
+        std::uint64_t expect = 0u;
+        while (expect < kItems) {
+            const Sample* s = q.try_front();
+            if (!s) {
+                std::this_thread::yield();
+                continue;
+            }
+            if (s->seq != expect) {
+                torn.store(true, std::memory_order_relaxed);
+            }
+            q.pop();
+            ++expect;
+        }
+        done.store(true, std::memory_order_release);
+        producer.join();
+        observer.join();
+
+        QVERIFY(!torn.load());
+        QVERIFY(q.empty());
+    }
+};
+
+} // namespace
+
+int run_tst_observer_api_paranoid(int argc, char** argv) {
+    tst_observer_api_paranoid tc;
+    return QTest::qExec(&tc, argc, argv);
+}
+
+#include "observer_test.moc"
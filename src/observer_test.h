@@ -0,0 +1,6 @@
+#ifndef OBSERVER_TEST_H_
+#define OBSERVER_TEST_H_
+
+int run_tst_observer_api_paranoid(int argc, char** argv);
+
+#endif /* OBSERVER_TEST_H_ */
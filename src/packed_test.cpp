@@ -0,0 +1,231 @@
+// packed_test.cpp
+// Paranoid API/contract test for spsc::packed_chunk / spsc::packed_fifo.
+//
+// Goals:
+//  - Round-trip is bit-exact for every integral T (signed/unsigned, 8..32 bit),
+//    including full-range jumps that wrap modulo 2^bits(T).
+//  - pack() stores the longest prefix that fits; noisy input just gives
+//    shorter chunks, nothing is lost.
+//  - Slowly varying signals reach the configured ratio (>= 2x samples per byte).
+//  - packed_fifo write()/read() over wrap-around and a concurrent pipeline;
+//    read() takes nothing below front_size() and progresses at min_read_size().
+
+#include <QtTest/QtTest>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <thread>
+#include <vector>
+
+#if !defined(SPSC_ASSERT) && !defined(NDEBUG)
+#  define SPSC_ASSERT(expr) do { if(!(expr)) { std::abort(); } } while(0)
+#endif
+
+#include "packed_fifo.hpp"
+
+namespace {
+
+#if defined(NDEBUG)
+constexpr std::uint32_t kSamples = 20000000u;
+#else
+constexpr std::uint32_t kSamples = 1000000u;
+#endif
+
+// Slowly varying ADC-like signal: sine + small noise.
+template <class T>
+static std::vector<T> adc_signal(std::size_t n, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> noise(-3, 3);
+    std::vector<T> v(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const double s = 1000.0 * std::sin(static_cast<double>(i) * 0.001);
+        v[i] = static_cast<T>(static_cast<long long>(s) + noise(rng));
+    }
+    return v;
+}
+
+template <class T, reg N, reg Bytes>
+static bool round_trip_all(const std::vector<T>& in) {
+    spsc::packed_chunk<T, N, Bytes> c;
+    std::vector<T> out(N);
+    std::size_t pos = 0u;
+    while (pos < in.size()) {
+        const reg k = c.pack(in.data() + pos, static_cast<reg>(in.size() - pos));
+        if (k == 0u || c.unpack(out.data()) != k) {
+            return false;
+        }
+        for (reg i = 0; i < k; ++i) {
+            if (out[i] != in[pos + i]) {
+                return false;
+            }
+        }
+        pos += k;
+    }
+    return true;
+}
+
+template <class T>
+static bool random_round_trip(unsigned seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<T> v(4096);
+    for (int mode = 0; mode < 4; ++mode) {
+        T x{};
+        for (auto& e : v) {
+            switch (mode) {
+            case 0: e = static_cast<T>(rng()); break;                      // full range
+            case 1: x = static_cast<T>(x + static_cast<T>(rng() % 3u)); e = x; break;
+            case 2: e = (rng() & 1u) ? std::numeric_limits<T>::min()
+                                     : std::numeric_limits<T>::max(); break; // worst jumps
+            default: e = T{7}; break;                                     // constant
+            }
+        }
+        if (!round_trip_all<T, 256, 128>(v) || !round_trip_all<T, 64, 8>(v)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+class tst_packed_api_paranoid : public QObject {
+    Q_OBJECT
+
+private slots:
+    void round_trip_every_type() {
+        QVERIFY(random_round_trip<std::int8_t>(1u));
+        QVERIFY(random_round_trip<std::uint8_t>(2u));
+        QVERIFY(random_round_trip<std::int16_t>(3u));
+        QVERIFY(random_round_trip<std::uint16_t>(4u));
+        QVERIFY(random_round_trip<std::int32_t>(5u));
+        QVERIFY(random_round_trip<std::uint32_t>(6u));
+    }
+
+    void prefix_fits_budget() {
+        spsc::packed_chunk<std::int16_t, 64, 16> c; // 128 bits of deltas
+        const std::int16_t flat[64]{};
+        QCOMPARE(c.pack(flat, 64u), reg(64u));
+        QCOMPARE(c.bits(), 0u);
+        QCOMPARE(c.packed_size(), reg(0u));
+
+        std::int16_t ramp[64];
+        for (int i = 0; i < 64; ++i) {
+            ramp[i] = static_cast<std::int16_t>(i * 3); // zigzag(3) = 6 -> 3 bits
+        }
+        QCOMPARE(c.pack(ramp, 64u), reg(43u)); // 42 deltas * 3 bits <= 128
+        QCOMPARE(c.bits(), 3u);
+
+        std::int16_t noisy[64];
+        for (int i = 0; i < 64; ++i) {
+            noisy[i] = static_cast<std::int16_t>((i & 1) ? 30000 : -30000);
+        }
+        QCOMPARE(c.pack(noisy, 64u), reg(10u)); // +-60000 wraps to +-5536: 9 deltas * 14 bits <= 128
+        QCOMPARE(c.bits(), 14u);
+        std::int16_t out[64];
+        QCOMPARE(c.unpack(out), reg(10u));
+        QCOMPARE(out[9], std::int16_t(30000));
+
+        QCOMPARE(c.pack(noisy, 0u), reg(0u));
+        QVERIFY(c.empty());
+        QCOMPARE(c.pack(noisy, 1u), reg(1u));
+    }
+
+    void adc_signal_ratio() {
+        using Chunk = spsc::packed_chunk<std::int16_t, 512, 256>; // 4x budget
+        const auto sig = adc_signal<std::int16_t>(1u << 16, 9u);
+        QVERIFY((round_trip_all<std::int16_t, 512, 256>(sig)));
+
+        Chunk c;
+        std::size_t pos = 0u;
+        std::size_t chunks = 0u;
+        while (pos < sig.size()) {
+            pos += c.pack(sig.data() + pos, static_cast<reg>(sig.size() - pos));
+            ++chunks;
+        }
+        const double raw    = double(sig.size()) * sizeof(std::int16_t);
+        const double packed = double(chunks) * sizeof(Chunk);
+        QVERIFY(raw / packed >= 2.0);
+    }
+
+    void fifo_write_read_wrap() {
+        spsc::packed_fifo<std::int32_t, 32, 32, 4> q;
+        const auto sig = adc_signal<std::int32_t>(5000u, 2u);
+        std::vector<std::int32_t> got;
+        std::vector<std::int32_t> buf(100);
+        std::size_t pos = 0u;
+        while (got.size() < sig.size()) {
+            pos += q.write(sig.data() + pos, static_cast<reg>(std::min<std::size_t>(sig.size() - pos, 70u)));
+            const reg before = q.front_size();
+            const reg n = q.read(buf.data(), static_cast<reg>(buf.size()));
+            QVERIFY(before == 0u || n >= before);
+            got.insert(got.end(), buf.begin(), buf.begin() + static_cast<std::ptrdiff_t>(n));
+        }
+        QVERIFY(got == sig);
+        QVERIFY(q.empty());
+
+        // read() never splits a chunk: a too-small destination takes nothing.
+        QCOMPARE(q.write(sig.data(), 32u), reg(32u));
+        QCOMPARE(q.front_size(), reg(32u));
+        QCOMPARE(q.read(buf.data(), q.front_size() - 1u), reg(0u));
+        QCOMPARE(q.size(), reg(1u));
+
+        // min_read_size() samples always take the front chunk.
+        QCOMPARE(q.min_read_size(), reg(32u));
+        QCOMPARE(q.read(buf.data(), q.min_read_size()), reg(32u));
+        QVERIFY(q.empty());
+        QVERIFY(std::equal(sig.begin(), sig.begin() + 32, buf.begin()));
+    }
+
+    void concurrent_pipeline() {
+        using Q = spsc::packed_fifo<std::uint16_t, 256, 128, 64, spsc::policy::A<>>;
+        Q q;
+        std::thread producer([&]() {
+            std::vector<std::uint16_t> block(1000);
+            std::uint32_t next = 0u;
+            while (next < kSamples) {
+                const std::uint32_t n = std::min<std::uint32_t>(1000u, kSamples - next);
+                for (std::uint32_t i = 0; i < n; ++i) {
+                    block[i] = static_cast<std::uint16_t>((next + i) / 4u);
+                }
+                std::uint32_t off = 0u;
+                while (off < n) {
+                    const reg w = q.write(block.data() + off, n - off);
+                    off += static_cast<std::uint32_t>(w);
+                    if (w == 0u) {
+                        std::this_thread::yield();
+                    }
+                }
+                next += n;
+            }
+        });
+
+        std::vector<std::uint16_t> buf(4096);
+        std::uint32_t seen = 0u;
+        bool ok = true;
+        while (seen < kSamples) {
+            const reg n = q.read(buf.data(), static_cast<reg>(buf.size()));
+            if (n == 0u) {
+                std::this_thread::yield();
+                continue;
+            }
+            for (reg i = 0; i < n; ++i) {
+                ok = ok && (buf[i] == static_cast<std::uint16_t>((seen + i) / 4u));
+            }
+            seen += static_cast<std::uint32_t>(n);
+        }
+        producer.join();
+        QVERIFY(ok);
+        QCOMPARE(seen, kSamples);
+    }
+};
+
+} // namespace
+
+int run_tst_packed_api_paranoid(int argc, char** argv) {
+    tst_packed_api_paranoid tc;
+    return QTest::qExec(&tc, argc, argv);
+}
+
+#include "packed_test.moc"
@@ -0,0 +1,6 @@
+#ifndef PACKED_TEST_H_
+#define PACKED_TEST_H_
+
+int run_tst_packed_api_paranoid(int argc, char** argv);
+
+#endif /* PACKED_TEST_H_ */
@@ -26,6 +26,7 @@
 #include <cstdint>
 #include <cstring>
 #include <deque>
+#include <limits>
 #include <random>
 #include <thread>
 #include <type_traits>
@@ -713,6 +714,128 @@ static void test_raw_push_truncation(Q& q) {
     }
 }
 
+static inline std::byte chain_byte(reg seq, reg i) noexcept {
+    return static_cast<std::byte>((seq * 131u + i * 7u) & 0xFFu);
+}
+
+template <class Q>
+static void test_chained_messages(Q& q) {
+    using view = typename Q::chain_view;
+
+    q.consume_all();
+    QVERIFY(q.empty());
+
+    const reg bs     = q.buffer_size();
+    const reg head_n = static_cast<reg>(bs - Q::chain_header_size);
+    QVERIFY(bs > Q::chain_header_size);
+
+    QCOMPARE(q.chain_slots(0u), reg{1u});
+    QCOMPARE(q.chain_slots(head_n), reg{1u});
+    QCOMPARE(q.chain_slots(static_cast<reg>(head_n + 1u)), reg{2u});
+    QCOMPARE(q.chain_slots(static_cast<reg>(head_n + bs)), reg{2u});
+    QCOMPARE(q.chain_slots(static_cast<reg>(head_n + bs + 1u)), reg{3u});
+    QCOMPARE(q.max_chain_bytes(), static_cast<reg>(q.capacity() * bs - Q::chain_header_size));
+    QCOMPARE(q.chain_slots(q.max_chain_bytes()), static_cast<reg>(q.capacity()));
+
+    // Oversized requests never wrap into a small slot count.
+    const reg huge = std::numeric_limits<reg>::max();
+    QCOMPARE(q.chain_slots(static_cast<reg>(q.max_chain_bytes() + 1u)), reg{0u});
+    QCOMPARE(q.chain_slots(huge), reg{0u});
+    QCOMPARE(q.chain_slots(static_cast<reg>(huge - bs + 2u)), reg{0u});
+    QVERIFY(!q.try_claim_chain(huge));
+    QVERIFY(!q.try_claim_chain(static_cast<reg>(huge - bs + 2u)));
+
+    // Move the ring position so chains straddle the wrap.
+    const reg shift = static_cast<reg>(q.capacity() - 3u);
+    for (reg i = 0; i < shift; ++i) {
+        QVERIFY(q.try_push(std::uint32_t{0u}));
+    }
+    q.pop(shift);
+
+    std::vector<std::byte> msg(static_cast<std::size_t>(head_n + 2u * bs + 5u));
+    for (std::size_t i = 0; i < msg.size(); ++i) {
+        msg[i] = chain_byte(1u, static_cast<reg>(i));
+    }
+    const reg n = q.chain_slots(static_cast<reg>(msg.size()));
+    QCOMPARE(n, reg{4u});
+
+    QVERIFY(!q.try_front_chain());
+    QVERIFY(!q.try_pop_chain());
+    QVERIFY(!q.try_push_chain(nullptr, reg{1u}));
+    QVERIFY(q.try_push_chain(msg.data(), static_cast<reg>(msg.size())));
+    QCOMPARE(q.size(), n);
+
+    // Zero-copy producer path.
+    {
+        const reg bytes = static_cast<reg>(head_n + 10u);
+        view w = q.try_claim_chain(bytes);
+        QVERIFY(w);
+        QCOMPARE(w.segments(), reg{2u});
+        QCOMPARE(q.size(), n); // not visible yet
+        reg off = 0u;
+        for (reg s = 0; s < w.segments(); ++s) {
+            const auto seg = w.segment(s);
+            for (reg i = 0; i < seg.size; ++i) {
+                seg.ptr[i] = chain_byte(2u, off++);
+            }
+        }
+        QCOMPARE(off, bytes);
+        q.publish_chain(w);
+        QCOMPARE(q.size(), static_cast<reg>(n + 2u));
+    }
+
+    // Too large for the ring / for the free space: refused, never truncated.
+    QVERIFY(!q.try_push_chain(msg.data(), static_cast<reg>(q.max_chain_bytes() + 1u)));
+    QVERIFY(!q.try_claim_chain(static_cast<reg>(q.free() * bs)));
+    QCOMPARE(q.size(), static_cast<reg>(n + 2u));
+
+    // Consumer: scatter list + gather.
+    {
+        const view r = q.try_front_chain();
+        QVERIFY(r);
+        QCOMPARE(r.bytes(), static_cast<reg>(msg.size()));
+        QCOMPARE(r.segments(), n);
+        QCOMPARE(r.segment(0u).size, head_n);
+        QCOMPARE(r.segment(n - 1u).size, reg{5u});
+        QVERIFY((reinterpret_cast<std::uintptr_t>(r.segment(0u).ptr) % alignof(std::max_align_t)) == 0u);
+
+        std::vector<std::byte> out(msg.size());
+        QCOMPARE(r.copy_to(out.data(), static_cast<reg>(out.size())), static_cast<reg>(msg.size()));
+        QVERIFY(out == msg);
+
+        std::array<std::byte, 8> small{};
+        QCOMPARE(r.copy_to(small.data(), reg{8u}), reg{8u});
+        QCOMPARE(std::memcmp(small.data(), msg.data(), 8u), 0);
+#if SPSC_HAS_SPAN
+        QCOMPARE(r.segment(1u).span().size(), static_cast<std::size_t>(bs));
+#endif
+        q.pop_chain(r);
+    }
+    {
+        const view r = q.try_front_chain();
+        QVERIFY(r);
+        QCOMPARE(r.bytes(), static_cast<reg>(head_n + 10u));
+        bool ok = true;
+        reg off = 0u;
+        for (reg s = 0; s < r.segments(); ++s) {
+            const auto seg = r.segment(s);
+            for (reg i = 0; i < seg.size; ++i) {
+                ok = ok && (seg.ptr[i] == chain_byte(2u, off++));
+            }
+        }
+        QVERIFY(ok);
+        QVERIFY(q.try_pop_chain());
+    }
+    QVERIFY(q.empty());
+
+    // Small payloads still cost exactly one slot.
+    QVERIFY(q.try_push_chain(msg.data(), reg{3u}));
+    QCOMPARE(q.size(), reg{1u});
+    QCOMPARE(q.try_front_chain().bytes(), reg{3u});
+    QVERIFY(q.try_pop_chain());
+    QVERIFY(q.empty());
+}
+
 template <class Q>
 static void test_iteration_and_indexing(Q& q) {
     std::mt19937 rng(0xFEEDu);
@@ -2138,6 +2261,55 @@ static inline void backoff_step(std::uint32_t& spins) noexcept {
     }
 }
 
+template <class Q>
+static void test_two_thread_chains(Q& q, const reg iters = kThreadIters / 4u) {
+    // Producer pushes chains of 1..max_chain_bytes()/2 bytes; consumer checks every byte.
+    const reg max_bytes = static_cast<reg>(q.max_chain_bytes() / 2u);
+    std::atomic<bool> bad{false};
+
+    std::thread consumer([&] {
+        std::uint32_t spins = 0u;
+        std::vector<std::byte> out(max_bytes);
+        for (reg seq = 0u; seq < iters && !bad.load(std::memory_order_relaxed);) {
+            const auto r = q.try_front_chain();
+            if (!r) {
+                backoff_step(spins);
+                continue;
+            }
+            const reg want = static_cast<reg>(1u + (seq * 37u) % max_bytes);
+            if (r.bytes() != want || r.copy_to(out.data(), max_bytes) != want) {
+                bad.store(true, std::memory_order_relaxed);
+                break;
+            }
+            for (reg i = 0; i < want; ++i) {
+                if (out[i] != chain_byte(seq, i)) {
+                    bad.store(true, std::memory_order_relaxed);
+                    break;
+                }
+            }
+            q.pop_chain(r);
+            ++seq;
+        }
+    });
+
+    std::uint32_t spins = 0u;
+    std::vector<std::byte> msg(max_bytes);
+    for (reg seq = 0u; seq < iters && !bad.load(std::memory_order_relaxed); ++seq) {
+        const reg n = static_cast<reg>(1u + (seq * 37u) % max_bytes);
+        for (reg i = 0; i < n; ++i) {
+            msg[i] = chain_byte(seq, i);
+        }
+        while (!q.try_push_chain(msg.data(), n)) {
+            if (bad.load(std::memory_order_relaxed)) { break; }
+            backoff_step(spins);
+        }
+    }
+    consumer.join();
+
+    QVERIFY(!bad.load());
+    QVERIFY(q.empty());
+}
+
 template <class Q>
 static void test_two_thread_spsc(Q& q, const reg iters = kThreadIters, const int timeout_ms = kThreadTimeoutMs) {
     // This is a real 2-thread SPSC stress: producer writes slots, consumer reads slots.
@@ -2504,6 +2676,7 @@ void tst_pool_api_paranoid::static_plain_P() {
         fill_and_drain_basic(q);
         test_claim_publish_path(q);
         test_raw_push_truncation(q);
+        test_chained_messages(q);
         test_iteration_and_indexing(q);
         test_snapshot_contracts(q);
         test_zero_count_contracts(q);
@@ -2620,6 +2793,7 @@ void tst_pool_api_paranoid::dynamic_plain_P() {
     fill_and_drain_basic(q);
     test_claim_publish_path(q);
     test_raw_push_truncation(q);
+    test_chained_messages(q);
     test_iteration_and_indexing(q);
     test_snapshot_contracts(q);
     test_zero_count_contracts(q);
@@ -2747,6 +2921,7 @@ void tst_pool_api_paranoid::threaded_cached_CA() {
         Qs q;
         ensure_valid(q);
         test_two_thread_spsc(q);
+        test_two_thread_chains(q);
         verify_invariants(q, "threaded cached (static)");
     }
 
@@ -2755,6 +2930,7 @@ void tst_pool_api_paranoid::threaded_cached_CA() {
         Qd q;
         ensure_valid(q);
         test_two_thread_spsc(q);
+        test_two_thread_chains(q);
         verify_invariants(q, "threaded cached (dynamic)");
     }
 }
@@ -0,0 +1,243 @@
+// record_test.cpp
+// Paranoid API/contract test for spsc::record_fifo (inline fixed-stride records).
+//
+// Goals:
+//  - Stride = record size rounded up to Align; every record is aligned and
+//    sits at data() + index * stride() (one allocation, no indirection).
+//  - Invalid ring refuses producer/consumer ops; try_push truncates to record_size().
+//  - claim_write()/claim_read() stride regions across the wrap split.
+//  - resize(): grow-only, keeps queued records in order, depth/record 0 releases.
+//  - Static depth variant.
+//  - Concurrent producer/consumer with a runtime record size keeps every byte
+//    (throughput vs pool: tools/spsc_bench).
+
+#include <QtTest/QtTest>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#if !defined(SPSC_ASSERT) && !defined(NDEBUG)
+#  define SPSC_ASSERT(expr) do { if(!(expr)) { std::abort(); } } while(0)
+#endif
+
+#include "record_fifo.hpp"
+
+namespace {
+
+#if defined(NDEBUG)
+constexpr std::uint32_t kRecords = 2000000u;
+#else
+constexpr std::uint32_t kRecords = 200000u;
+#endif
+
+static void fill(std::byte* p, reg n, std::uint32_t seq) {
+    for (reg i = 0; i < n; ++i) {
+        p[i] = static_cast<std::byte>((seq * 31u + i) & 0xffu);
+    }
+}
+
+static bool check(const std::byte* p, reg n, std::uint32_t seq) {
+    for (reg i = 0; i < n; ++i) {
+        if (p[i] != static_cast<std::byte>((seq * 31u + i) & 0xffu)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <class Ring>
+static void run_pair(Ring& q, reg bytes) {
+    std::thread consumer([&]() {
+        std::uint32_t expect = 0u;
+        unsigned spins = 0u;
+        while (expect < kRecords) {
+            auto* p = q.try_front();
+            if (!p) {
+                if (++spins > 64u) {
+                    spins = 0u;
+                    std::this_thread::yield();
+                }
+                continue;
+            }
+            std::uint32_t v = 0u;
+            std::memcpy(&v, p, sizeof(v));
+            if (v != expect || !check(static_cast<const std::byte*>(static_cast<const void*>(p)) + 4u, bytes - 4u, v)) {
+                std::abort();
+            }
+            q.pop();
+            ++expect;
+        }
+    });
+    unsigned spins = 0u;
+    for (std::uint32_t i = 0; i < kRecords; ++i) {
+        void* p = nullptr;
+        while ((p = q.try_claim()) == nullptr) {
+            if (++spins > 64u) {
+                spins = 0u;
+                std::this_thread::yield();
+            }
+        }
+        std::memcpy(p, &i, sizeof(i));
+        fill(static_cast<std::byte*>(p) + 4u, bytes - 4u, i);
+        q.publish();
+    }
+    consumer.join();
+}
+
+class tst_record_api_paranoid : public QObject {
+    Q_OBJECT
+
+private slots:
+    void stride_layout_and_invalid() {
+        spsc::record_fifo<> bad;
+        QVERIFY(!bad.is_valid());
+        QVERIFY(bad.empty() && bad.full());
+        QVERIFY(bad.try_claim() == nullptr);
+        QVERIFY(!bad.try_push(std::uint32_t(1u)));
+        QVERIFY(bad.claim_read(spsc::unsafe).empty());
+
+        spsc::record_fifo<0, spsc::policy::P, 16> q(5u, 20u); // depth -> 8
+        QVERIFY(q.is_valid());
+        QCOMPARE(q.capacity(), reg(8u));
+        QCOMPARE(q.record_size(), reg(20u));
+        QCOMPARE(q.stride(), reg(32u));
+        QCOMPARE(spsc::record_fifo<>::stride_for(1u), reg(alignof(std::max_align_t)));
+        QCOMPARE((reinterpret_cast<std::uintptr_t>(q.data()) % 16u), std::uintptr_t(0u));
+
+        for (std::uint32_t i = 0; i < 8u; ++i) {
+            std::byte* p = q.try_claim();
+            QVERIFY(p == q.data() + i * 32u);
+            fill(p, 20u, i);
+            q.publish();
+        }
+        QVERIFY(q.full());
+        QVERIFY(q.try_claim() == nullptr);
+        QVERIFY(q[3] == q.data() + 3u * 32u);
+        for (std::uint32_t i = 0; i < 5u; ++i) {
+            QVERIFY(check(q.front(), 20u, i));
+            q.pop();
+        }
+
+        const char big[64] = "0123456789abcdefghijklmnopqrstuvwxyz";
+        QVERIFY(q.try_push(big, sizeof(big))); // truncated to 20 bytes, wraps to slot 0
+        QVERIFY(q[3] == q.data());
+        QVERIFY(std::memcmp(q[3], big, 20u) == 0);
+
+        struct alignas(8) pair64 { std::uint64_t a, b; };
+        QVERIFY(q.try_push(pair64{7u, 9u}));
+        struct too_big { char c[21]; };
+        QVERIFY(!q.try_push(too_big{}));
+        QVERIFY(q.front_as<too_big>() == nullptr);
+    }
+
+    void stride_regions_wrap() {
+        spsc::record_fifo<> q(8u, 24u);
+        const reg st = q.stride();
+        for (std::uint32_t i = 0; i < 6u; ++i) {
+            QVERIFY(q.try_push(i));
+        }
+        q.pop(reg(6u));
+
+        auto w = q.claim_write(spsc::unsafe, 5u);
+        QCOMPARE(w.total, reg(5u));
+        QCOMPARE(w.first.count, reg(2u));   // slots 6, 7
+        QCOMPARE(w.second.count, reg(3u));  // slots 0..2
+        QCOMPARE(w.first.stride, st);
+        QCOMPARE(w.first.size, reg(24u));
+        QVERIFY(w.first.ptr == q.data() + 6u * st);
+        QVERIFY(w.second.ptr == q.data());
+        std::uint32_t seq = 100u;
+        for (reg i = 0; i < w.first.count; ++i) { fill(w.first.record(i), 24u, seq++); }
+        for (reg i = 0; i < w.second.count; ++i) { fill(w.second.record(i), 24u, seq++); }
+        q.publish(w.total);
+        QCOMPARE(q.size(), reg(5u));
+
+        const auto& cq = q;
+        auto r = cq.claim_read(spsc::unsafe);
+        QCOMPARE(r.total, reg(5u));
+        seq = 100u;
+        bool ok = true;
+        for (reg i = 0; i < r.first.count; ++i) { ok = ok && check(r.first.record(i), 24u, seq++); }
+        for (reg i = 0; i < r.second.count; ++i) { ok = ok && check(r.second.record(i), 24u, seq++); }
+        QVERIFY(ok);
+#if SPSC_HAS_SPAN
+        QCOMPARE(r.first.bytes().size(), std::size_t(2u * st));
+        QCOMPARE(r.first.span(1u).size(), std::size_t(24u));
+        QCOMPARE(q.span().size(), std::size_t(24u));
+#endif
+        q.pop(r.total);
+        QVERIFY(q.empty());
+        QVERIFY(q.claim_read(spsc::unsafe, 3u).empty());
+    }
+
+    void resize_keeps_records() {
+        spsc::record_fifo<> q(4u, 8u);
+        for (std::uint32_t i = 0; i < 3u; ++i) {
+            QVERIFY(q.try_push(std::uint64_t(i)));
+        }
+        q.pop();
+        QVERIFY(q.try_push(std::uint64_t(3u)));
+        QVERIFY(q.try_push(std::uint64_t(4u))); // wrapped: 1, 2, 3, 4
+        QVERIFY(q.full());
+
+        QVERIFY(q.resize(16u, 40u));
+        QCOMPARE(q.capacity(), reg(16u));
+        QCOMPARE(q.record_size(), reg(40u));
+        QCOMPARE(q.size(), reg(4u));
+        for (std::uint64_t i = 1; i <= 4u; ++i) {
+            QCOMPARE(*q.front_as<std::uint64_t>(), i);
+            q.pop();
+        }
+
+        QVERIFY(q.resize(2u, 8u)); // never shrinks
+        QCOMPARE(q.capacity(), reg(16u));
+        QCOMPARE(q.record_size(), reg(40u));
+
+        QVERIFY(q.resize(0u, 8u));
+        QVERIFY(!q.is_valid());
+        QCOMPARE(q.capacity(), reg(0u));
+    }
+
+    void static_depth() {
+        spsc::record_fifo<32, spsc::policy::P> q(100u);
+        QVERIFY(q.is_valid());
+        QCOMPARE(q.capacity(), reg(32u));
+        QCOMPARE(q.stride(), spsc::record_fifo<32>::stride_for(100u));
+        for (std::uint32_t i = 0; i < 40u; ++i) {
+            std::byte* p = q.try_claim();
+            if (!p) {
+                q.pop(reg(16u));
+                p = q.claim();
+            }
+            fill(p, 100u, i);
+            q.publish();
+        }
+        QCOMPARE(q.size(), reg(24u));
+        QVERIFY(check(q.front(), 100u, 16u));
+        QVERIFY(q.resize(200u));
+        QCOMPARE(q.size(), reg(24u));
+        QVERIFY(check(q.front(), 100u, 16u));
+        QVERIFY(check(q[23], 100u, 39u));
+    }
+
+    void concurrent_runtime_record_size() {
+        using A = spsc::policy::CA<>;
+        const reg bytes = 40u; // chosen at runtime
+        spsc::record_fifo<0, A> rq(1024u, bytes);
+        QVERIFY(rq.is_valid());
+        run_pair(rq, bytes);
+        QVERIFY(rq.empty());
+    }
+};
+
+} // namespace
+
+int run_tst_record_api_paranoid(int argc, char** argv) {
+    tst_record_api_paranoid tc;
+    return QTest::qExec(&tc, argc, argv);
+}
+
+#include "record_test.moc"
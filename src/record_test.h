@@ -0,0 +1,6 @@
+#ifndef RECORD_TEST_H_
+#define RECORD_TEST_H_
+
+int run_tst_record_api_paranoid(int argc, char** argv);
+
+#endif /* RECORD_TEST_H_ */
@@ -0,0 +1,244 @@
+// remote_alloc_test.cpp
+// Paranoid API/contract test for spsc::alloc::remote_heap.
+//
+// Goals:
+//  - Size classes, alignment and large-block fallback; MinBlock below kAlign
+//    still yields kAlign-aligned payloads.
+//  - Local free/alloc reuses blocks (no new slabs in steady state).
+//  - Remote frees travel home through return rings and are reclaimed in batches.
+//  - Full return rings park blocks on the freeing thread and flush later.
+//  - Producer -> consumer pipeline over spsc::queue<T*>: memory stays bounded,
+//    every block is returned, counters add up.
+
+#include <QtTest/QtTest>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#if !defined(SPSC_ASSERT) && !defined(NDEBUG)
+#  define SPSC_ASSERT(expr) do { if(!(expr)) { std::abort(); } } while(0)
+#endif
+
+#include "queue.hpp"
+#include "remote_alloc.hpp"
+
+namespace {
+
+#if defined(NDEBUG)
+constexpr std::uint32_t kMsgs = 2000000u;
+#else
+constexpr std::uint32_t kMsgs = 200000u;
+#endif
+
+struct Msg {
+    std::uint64_t seq{0u};
+    std::uint8_t  payload[40]{};
+
+    explicit Msg(const std::uint64_t s) noexcept : seq(s) {
+        std::memset(payload, static_cast<int>(s & 0xFFu), sizeof(payload));
+    }
+};
+
+using Heap = spsc::alloc::remote_heap<>;
+
+template <class Q, class T>
+static void push_spin(Q& q, T v) {
+    while (!q.try_push(v)) {
+        std::this_thread::yield();
+    }
+}
+
+class tst_remote_alloc_api_paranoid : public QObject {
+    Q_OBJECT
+
+private slots:
+    void init_rejects_invalid() {
+        Heap h;
+        QVERIFY(!h.is_valid());
+        QVERIFY(!h.init(0u));
+        QVERIFY(h.init(2u));
+        QVERIFY(h.is_valid());
+        QCOMPARE(h.threads(), reg(2u));
+        QVERIFY(!h.init(3u)); // already initialized
+
+        QCOMPARE(Heap::kClasses, reg(9u)); // 16 .. 4096
+        QCOMPARE(Heap::class_size(0u), reg(16u));
+        QCOMPARE(Heap::class_size(Heap::kClasses - 1u), reg(4096u));
+    }
+
+    void alignment_and_classes() {
+        Heap h(1u);
+        for (reg bytes : {1u, 8u, 16u, 17u, 100u, 1000u, 4096u, 5000u, 100000u}) {
+            void* p = h.allocate(0u, bytes);
+            QVERIFY(p != nullptr);
+            QCOMPARE(reinterpret_cast<std::uintptr_t>(p) % Heap::kAlign, std::uintptr_t(0u));
+            std::memset(p, 0xA5, bytes); // whole requested size is usable
+            h.deallocate(0u, p);
+        }
+        h.deallocate(0u, nullptr); // no-op
+    }
+
+    void min_block_size_keeps_alignment() {
+        // MinBlock == sizeof(void*) is below kAlign: the slab stride is
+        // rounded up, so every carved payload stays kAlign-aligned.
+        using Small = spsc::alloc::remote_heap<sizeof(void*), 64u, 16u, 4096u>;
+        Small h(2u);
+        QCOMPARE(Small::class_size(0u), reg(sizeof(void*)));
+
+        std::vector<void*> blocks;
+        for (int i = 0; i < 600; ++i) {
+            void* p = h.allocate(0u, static_cast<reg>(1u + (i % sizeof(void*))));
+            QVERIFY(p != nullptr);
+            QCOMPARE(reinterpret_cast<std::uintptr_t>(p) % Small::kAlign, std::uintptr_t(0u));
+            std::memset(p, i & 0xFF, sizeof(void*));
+            blocks.push_back(p);
+        }
+        QVERIFY(h.slabs(0u) > 1u); // several slabs carved
+        for (int i = 0; i < 600; ++i) {
+            const auto* b = static_cast<const unsigned char*>(blocks[i]);
+            QCOMPARE(int(b[0]), i & 0xFF); // no block overlaps its neighbour
+            QCOMPARE(int(b[sizeof(void*) - 1u]), i & 0xFF);
+        }
+
+        for (void* p : blocks) {
+            h.deallocate(1u, p);
+        }
+        reg back = 0u;
+        for (int guard = 0; guard < 1000 && back < 600u; ++guard) {
+            back += h.reclaim(0u);
+            (void)h.flush(1u);
+        }
+        QCOMPARE(back, reg(600u));
+    }
+
+    void local_reuse_does_not_grow() {
+        Heap h(1u);
+        std::vector<void*> blocks;
+        for (int round = 0; round < 50; ++round) {
+            for (int i = 0; i < 500; ++i) {
+                blocks.push_back(h.allocate(0u, 48u));
+                QVERIFY(blocks.back() != nullptr);
+            }
+            for (void* p : blocks) {
+                h.deallocate(0u, p);
+            }
+            blocks.clear();
+        }
+        QCOMPARE(h.slabs(0u), reg(1u)); // 500 x 80B fit into one 64 KiB slab
+        QCOMPARE(h.local_frees(0u), reg(50u * 500u));
+        QCOMPARE(h.remote_frees(0u), reg(0u));
+    }
+
+    void remote_free_returns_home() {
+        Heap h(2u);
+        std::vector<void*> blocks;
+        for (int i = 0; i < 100; ++i) {
+            blocks.push_back(h.allocate(0u, 32u));
+        }
+        for (void* p : blocks) {
+            h.deallocate(1u, p); // thread 1 frees thread 0's blocks
+        }
+        QCOMPARE(h.remote_frees(1u), reg(100u));
+        QCOMPARE(h.flush(1u), reg(0u));
+        QCOMPARE(h.reclaim(0u), reg(100u));
+        QCOMPARE(h.reclaimed(0u), reg(100u));
+        QCOMPARE(h.reclaim(0u), reg(0u));
+
+        // Reclaimed blocks are served again before any new slab.
+        const reg slabs = h.slabs(0u);
+        for (int i = 0; i < 100; ++i) {
+            blocks[i] = h.allocate(0u, 32u);
+        }
+        QCOMPARE(h.slabs(0u), slabs);
+        for (void* p : blocks) {
+            h.deallocate(0u, p);
+        }
+    }
+
+    void full_ring_parks_and_flushes() {
+        spsc::alloc::remote_heap<16u, 256u, 4u, 4096u> h(2u);
+        std::vector<void*> blocks;
+        for (int i = 0; i < 64; ++i) {
+            blocks.push_back(h.allocate(0u, 64u));
+        }
+        for (void* p : blocks) {
+            h.deallocate(1u, p); // ring holds 4, the rest is parked on thread 1
+        }
+        QCOMPARE(h.flush(1u), reg(60u));
+
+        reg back = 0u;
+        for (int guard = 0; guard < 100 && back < 64u; ++guard) {
+            back += h.reclaim(0u);
+            (void)h.flush(1u);
+        }
+        QCOMPARE(back, reg(64u));
+        QCOMPARE(h.flush(1u), reg(0u));
+    }
+
+    void large_blocks_any_thread() {
+        Heap h(2u);
+        void* p = h.allocate(0u, 1u << 20);
+        QVERIFY(p != nullptr);
+        std::memset(p, 1, 1u << 20);
+        h.deallocate(1u, p); // freed directly, no ring
+        QCOMPARE(h.remote_frees(1u), reg(0u));
+    }
+
+    void pipeline_bounded_and_exact() {
+        Heap h(2u);
+        spsc::queue<Msg*, 1024, spsc::policy::CA<>> q;
+        std::atomic<bool> ok{true};
+
+        std::thread consumer([&]() {
+            for (std::uint32_t i = 0; i < kMsgs; ++i) {
+                Msg* const* pp = nullptr;
+                while (!(pp = q.try_front())) {
+                    std::this_thread::yield();
+                }
+                Msg* m = *pp;
+                q.pop();
+                if (m->seq != i || m->payload[0] != static_cast<std::uint8_t>(i & 0xFFu)) {
+                    ok.store(false, std::memory_order_relaxed);
+                }
+                h.destroy(1u, m);
+            }
+        });
+
+        for (std::uint32_t i = 0; i < kMsgs; ++i) {
+            Msg* m = nullptr;
+            while (!(m = h.make<Msg>(0u, i))) {
+                std::this_thread::yield();
+            }
+            push_spin(q, m);
+        }
+        consumer.join();
+
+        QVERIFY(ok.load());
+        QCOMPARE(h.remote_frees(1u), reg(kMsgs));
+
+        // Consumer is gone: this thread may act as index 1 to flush its parked tail.
+        for (int guard = 0; guard < 100000; ++guard) {
+            (void)h.reclaim(0u);
+            if (h.flush(1u) == 0u) {
+                break;
+            }
+        }
+        (void)h.reclaim(0u);
+        QCOMPARE(h.reclaimed(0u), reg(kMsgs));
+        // Live set is bounded by ring sizes, not by kMsgs.
+        QVERIFY2(h.slabs(0u) <= 16u, "arena kept growing: remote frees not recycled");
+    }
+};
+
+} // namespace
+
+int run_tst_remote_alloc_api_paranoid(int argc, char** argv) {
+    tst_remote_alloc_api_paranoid tc;
+    return QTest::qExec(&tc, argc, argv);
+}
+
+#include "remote_alloc_test.moc"
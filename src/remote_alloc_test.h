@@ -0,0 +1,6 @@
+#ifndef REMOTE_ALLOC_TEST_H_
+#define REMOTE_ALLOC_TEST_H_
+
+int run_tst_remote_alloc_api_paranoid(int argc, char** argv);
+
+#endif /* REMOTE_ALLOC_TEST_H_ */
@@ -0,0 +1,237 @@
+// scan_test.cpp
+// Paranoid API/contract test for spsc::scan (byte ring scanners).
+//
+// Goals:
+//  - find_byte / find_any_of / find_pattern agree with a byte-by-byte
+//    reference on every tail position (wrap point moved through the buffer).
+//  - Patterns and length prefixes split across the wrap are found / read.
+//  - claim_read regions, snapshots and plain ranges give identical results.
+//  - Frame loop: pop(off + 1) consumes exactly one frame.
+
+#include <QtTest/QtTest>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#if !defined(SPSC_ASSERT) && !defined(NDEBUG)
+#  define SPSC_ASSERT(expr) do { if(!(expr)) { std::abort(); } } while(0)
+#endif
+
+#include "chunk_fifo.hpp"
+#include "fifo.hpp"
+#include "scan.hpp"
+
+namespace {
+
+template <class Q>
+static void push_bytes(Q& q, const std::vector<std::uint8_t>& v) {
+    for (const std::uint8_t b : v) {
+        q.push(b);
+    }
+}
+
+// Reference: contents of the ring as a vector (tail first).
+template <class Q>
+static std::vector<std::uint8_t> linear(Q& q) {
+    std::vector<std::uint8_t> out;
+    for (auto it = q.begin(); it != q.end(); ++it) {
+        out.push_back(*it);
+    }
+    return out;
+}
+
+static std::size_t ref_find_pattern(const std::vector<std::uint8_t>& h, const std::uint8_t* p,
+                                    std::size_t m, std::size_t from) {
+    for (std::size_t i = from; i + m <= h.size(); ++i) {
+        if (std::equal(p, p + m, h.begin() + static_cast<std::ptrdiff_t>(i))) {
+            return i;
+        }
+    }
+    return h.size();
+}
+
+class tst_scan_api_paranoid : public QObject {
+    Q_OBJECT
+
+private slots:
+    void empty_and_bounds() {
+        spsc::fifo<std::uint8_t, 16> q;
+        const auto r = q.claim_read(spsc::unsafe);
+        QCOMPARE(spsc::scan::find_byte(r, '\n'), reg(0u));
+        QCOMPARE(spsc::scan::find_any_of(r, {'\r', '\n'}), reg(0u));
+        const std::uint8_t pat[] = {1u, 2u};
+        QCOMPARE(spsc::scan::find_pattern(r, pat, 2u), reg(0u));
+
+        push_bytes(q, {5u, 6u, 7u});
+        const auto r2 = q.claim_read(spsc::unsafe);
+        QCOMPARE(spsc::scan::find_byte(r2, 9u), reg(3u));      // not found == total
+        QCOMPARE(spsc::scan::find_byte(r2, 7u, 5u), reg(3u));  // from past the end
+        QCOMPARE(spsc::scan::find_pattern(r2, pat, 0u, 1u), reg(1u)); // empty pattern
+
+        std::uint8_t tmp[4]{};
+        QVERIFY(!spsc::scan::peek_bytes(r2, 2u, tmp, 2u));
+        QVERIFY(spsc::scan::peek_bytes(r2, 1u, tmp, 2u));
+        QCOMPARE(tmp[0], std::uint8_t(6u));
+        QCOMPARE(tmp[1], std::uint8_t(7u));
+    }
+
+    void matches_reference_at_every_wrap() {
+        std::mt19937 rng(3u);
+        constexpr reg kCap = 64u;
+        spsc::fifo<std::uint8_t, kCap> q;
+        const spsc::scan::byte_set set{0x7Eu, '\n', 0x00u};
+        const spsc::scan::byte_set big{1u, 2u, 3u, 4u, 5u, 6u, 7u, 8u, 9u, 10u}; // table path
+
+        for (reg shift = 0u; shift < kCap; ++shift) {
+            while (!q.empty()) {
+                q.pop();
+            }
+            for (reg i = 0u; i < shift; ++i) { // move the tail to `shift`
+                q.push(0u);
+                q.pop();
+            }
+            const reg n = 1u + static_cast<reg>(rng() % kCap);
+            for (reg i = 0u; i < n && !q.full(); ++i) {
+                q.push(static_cast<std::uint8_t>(rng() % 24u)); // dense hits
+            }
+            const auto h = linear(q);
+            const auto r = q.claim_read(spsc::unsafe);
+            const auto snap = q.make_snapshot();
+
+            for (std::size_t from = 0u; from <= h.size(); ++from) {
+                for (std::uint8_t b = 0u; b < 24u; ++b) {
+                    std::size_t e = from;
+                    while (e < h.size() && h[e] != b) {
+                        ++e;
+                    }
+                    QCOMPARE(static_cast<std::size_t>(spsc::scan::find_byte(r, b, from)), e);
+                    QCOMPARE(static_cast<std::size_t>(spsc::scan::find_byte(snap, b, from)), e);
+                }
+
+                std::size_t e1 = from;
+                while (e1 < h.size() && !set.contains(h[e1])) {
+                    ++e1;
+                }
+                QCOMPARE(static_cast<std::size_t>(spsc::scan::find_any_of(r, set, from)), e1);
+                std::size_t e2 = from;
+                while (e2 < h.size() && !big.contains(h[e2])) {
+                    ++e2;
+                }
+                QCOMPARE(static_cast<std::size_t>(spsc::scan::find_any_of(snap, big, from)), e2);
+
+                if (h.size() >= 3u && from + 3u <= h.size()) {
+                    // A pattern that surely exists (taken from the data) + a random one.
+                    const std::size_t at = from + rng() % (h.size() - from - 2u);
+                    const std::uint8_t pat[3] = {h[at], h[at + 1u], h[at + 2u]};
+                    QCOMPARE(static_cast<std::size_t>(spsc::scan::find_pattern(r, pat, 3u, from)),
+                             ref_find_pattern(h, pat, 3u, from));
+                    const std::uint8_t rnd[2] = {static_cast<std::uint8_t>(rng() % 24u),
+                                                 static_cast<std::uint8_t>(rng() % 24u)};
+                    QCOMPARE(static_cast<std::size_t>(spsc::scan::find_pattern(snap, rnd, 2u, from)),
+                             ref_find_pattern(h, rnd, 2u, from));
+                }
+            }
+        }
+    }
+
+    void delimiter_split_across_wrap() {
+        spsc::fifo<char, 16> q;
+        for (int i = 0; i < 13; ++i) {
+            q.push('x');
+            q.pop();
+        }
+        for (char c : {'a', 'b', '\r', '\n', 'c'}) { // "\r\n" sits on slots 15 and 0
+            q.push(c);
+        }
+        const auto r = q.claim_read(spsc::unsafe);
+        QCOMPARE(r.first.count, reg(3u));
+        QCOMPARE(r.second.count, reg(2u));
+        QCOMPARE(spsc::scan::find_pattern(r, "\r\n", 2u), reg(2u));
+        QCOMPARE(spsc::scan::find_byte(r, '\n'), reg(3u));
+
+        // Big-endian 16-bit length prefix split by the wrap.
+        spsc::fifo<std::uint8_t, 8> b;
+        for (int i = 0; i < 7; ++i) {
+            b.push(0u);
+            b.pop();
+        }
+        for (std::uint8_t v : {0x01u, 0x02u, 0xAAu}) {
+            b.push(v);
+        }
+        std::uint8_t len[2]{};
+        QVERIFY(spsc::scan::peek_bytes(b.claim_read(spsc::unsafe), 0u, len, 2u));
+        QCOMPARE(static_cast<unsigned>((len[0] << 8) | len[1]), 0x0102u);
+    }
+
+    void frame_loop_pops_exact_frames() {
+        spsc::fifo<std::uint8_t, 32> q;
+        std::mt19937 rng(11u);
+        std::uint32_t next_frame = 0u;
+        std::uint32_t got_frame  = 0u;
+        std::uint32_t partial    = 0u; // bytes of the current frame already pushed
+        for (int step = 0; step < 20000; ++step) {
+            // Producer: frames are [id, payload..., 0x7E], payload never contains 0x7E.
+            const reg room = q.free();
+            for (reg i = 0u; i < room && (rng() & 1u); ++i) {
+                const std::uint32_t len = 3u + (next_frame % 5u);
+                std::uint8_t v = 0u;
+                if (partial == 0u) {
+                    v = static_cast<std::uint8_t>(next_frame & 0x3Fu);
+                } else if (partial + 1u == len) {
+                    v = 0x7Eu;
+                } else {
+                    v = static_cast<std::uint8_t>(0x40u + partial);
+                }
+                q.push(v);
+                if (++partial == len) {
+                    partial = 0u;
+                    ++next_frame;
+                }
+            }
+            // Consumer: one frame per delimiter.
+            for (;;) {
+                const auto r = q.claim_read(spsc::unsafe);
+                const reg off = spsc::scan::find_byte(r, 0x7Eu);
+                if (off == r.total) {
+                    break;
+                }
+                std::uint8_t id = 0xFFu;
+                QVERIFY(spsc::scan::peek_bytes(r, 0u, &id, 1u));
+                QCOMPARE(id, static_cast<std::uint8_t>(got_frame & 0x3Fu));
+                QCOMPARE(off + 1u, reg(3u + (got_frame % 5u)));
+                q.pop(static_cast<reg>(off + 1u));
+                ++got_frame;
+            }
+        }
+        QVERIFY(got_frame > 1000u);
+        QVERIFY(got_frame + 1u >= next_frame);
+    }
+
+    void chunk_payload_range() {
+        spsc::chunk_fifo<std::byte, 64, 4> q;
+        auto& c = q.claim();
+        const char msg[] = "GET / HTTP/1.1\r\nHost: x\r\n\r\nbody";
+        for (std::size_t i = 0; i + 1u < sizeof(msg); ++i) {
+            QVERIFY(c.try_push(static_cast<std::byte>(msg[i])));
+        }
+        q.publish();
+
+        const auto& f = q.front();
+        const auto s = spsc::scan::segments_of(f.data(), f.size());
+        QCOMPARE(spsc::scan::find_pattern(s, "\r\n\r\n", 4u), std::size_t(23u));
+        QCOMPARE(spsc::scan::find_byte(s, std::byte{':'}), std::size_t(20u));
+        QCOMPARE(spsc::scan::find_any_of(s, {'\r', '\n'}, 17u), std::size_t(23u));
+    }
+};
+
+} // namespace
+
+int run_tst_scan_api_paranoid(int argc, char** argv) {
+    tst_scan_api_paranoid tc;
+    return QTest::qExec(&tc, argc, argv);
+}
+
+#include "scan_test.moc"
@@ -0,0 +1,6 @@
+#ifndef SCAN_TEST_H_
+#define SCAN_TEST_H_
+
+int run_tst_scan_api_paranoid(int argc, char** argv);
+
+#endif /* SCAN_TEST_H_ */
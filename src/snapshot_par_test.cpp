@@ -0,0 +1,257 @@
+// snapshot_par_test.cpp
+// Paranoid API/contract test for random-access ring iterators and parallel
+// snapshot processing (base/spsc_snapshot.hpp, snapshot_par.hpp).
+//
+// Goals:
+//  - ring_iterator is random access: +, -, [], ordering and distance are
+//    O(1) and wrap-safe, also across the index counter overflow.
+//  - std::lower_bound works on a wrapped fifo snapshot; std::nth_element /
+//    std::sort work on a wrapped mutable snapshot_view.
+//  - split(): parts are contiguous, cover the snapshot and differ by <= 1.
+//  - for_each_part() (threads and executor) sees every element exactly once;
+//    process_and_consume() releases the snapshot with one try_consume().
+
+#include <QtTest/QtTest>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#if !defined(SPSC_ASSERT) && !defined(NDEBUG)
+#  define SPSC_ASSERT(expr) do { if(!(expr)) { std::abort(); } } while(0)
+#endif
+
+#include "snapshot_par_test.h"
+#include "executor.hpp"
+#include "fifo.hpp"
+#include "snapshot_par.hpp"
+
+namespace {
+
+using small_fifo = ::spsc::fifo<int, 8, ::spsc::policy::P>;
+using big_fifo   = ::spsc::fifo<std::uint64_t, 0, ::spsc::policy::A<>>;
+
+static_assert(std::is_same_v<std::iterator_traits<small_fifo::snapshot::iterator>::iterator_category,
+                             std::random_access_iterator_tag>,
+              "snapshot iterators must be random access");
+#if defined(__cpp_lib_ranges)
+static_assert(std::random_access_iterator<small_fifo::snapshot::iterator>);
+static_assert(std::random_access_iterator<small_fifo::const_snapshot::const_iterator>);
+#endif
+
+// Ring with tail index 6, so 8 elements wrap the storage.
+void fill_wrapped(small_fifo& q, const int* v, const int n) {
+    for (int i = 0; i < 6; ++i) {
+        QVERIFY(q.try_push(-1));
+    }
+    q.pop(6u);
+    for (int i = 0; i < n; ++i) {
+        QVERIFY(q.try_push(v[i]));
+    }
+}
+
+std::uint64_t serial_sum(const std::uint64_t n) { return n * (n - 1u) / 2u; }
+
+class tst_snapshot_par_api_paranoid : public QObject {
+    Q_OBJECT
+
+private slots:
+    void iterator_arithmetic() {
+        small_fifo q;
+        const int v[8] = {10, 11, 12, 13, 14, 15, 16, 17};
+        fill_wrapped(q, v, 8);
+
+        auto s = q.make_snapshot();
+        const auto b = s.begin();
+        const auto e = s.end();
+        QCOMPARE(e - b, std::ptrdiff_t(8));
+        QCOMPARE(b - e, std::ptrdiff_t(-8));
+        QCOMPARE(std::distance(b, e), std::ptrdiff_t(8));
+
+        QCOMPARE(*(b + 3), 13);
+        QCOMPARE(*(3 + b), 13);
+        QCOMPARE(*(e - 1), 17);
+        QCOMPARE(b[7], 17);
+        QCOMPARE(s[2], 12);
+
+        auto it = b;
+        it += 5;
+        QCOMPARE(*it, 15);
+        it -= 4;
+        QCOMPARE(*it, 11);
+        QVERIFY(b < it && it < e && b <= b && e >= it && e > b);
+        QVERIFY(!(it < b));
+
+        const small_fifo::snapshot::const_iterator cb = b;
+        QVERIFY(cb == b && cb < e && (e - cb) == 8);
+
+        std::reverse_iterator<small_fifo::snapshot::iterator> rb(e);
+        QCOMPARE(*rb, 17);
+        QCOMPARE(rb[2], 15);
+
+        const auto cs = static_cast<const small_fifo&>(q).make_snapshot();
+        QCOMPARE(cs[0], 10);
+        QCOMPARE(cs[7], 17);
+    }
+
+    void iterator_index_overflow() {
+        int storage[4] = {0, 1, 2, 3};
+        using it = ::spsc::detail::ring_iterator<int, std::uint32_t, false>;
+        const it a(storage, 3u, 0xFFFFFFFEu); // two before the counter wraps
+        const it b = a + 4;
+        QCOMPARE(b.index(), 2u);
+        QCOMPARE(b - a, std::ptrdiff_t(4));
+        QVERIFY(a < b);
+        QCOMPARE(a[1], 3);
+        QCOMPARE(a[2], 0);
+        QCOMPARE(*(b - 3), 3);
+
+        using it8 = ::spsc::detail::ring_iterator<int, std::uint8_t, true>;
+        const it8 c(storage, 3u, 254u);
+        const it8 d = c + 3;
+        QCOMPARE(int(d.index()), 1);
+        QCOMPARE(d - c, std::ptrdiff_t(3));
+        QCOMPARE(c - d, std::ptrdiff_t(-3));
+    }
+
+    void algorithms_on_wrapped_snapshot() {
+        small_fifo q;
+        const int sorted[8] = {1, 3, 5, 7, 9, 11, 13, 15};
+        fill_wrapped(q, sorted, 8);
+        {
+            const auto s = static_cast<const small_fifo&>(q).make_snapshot();
+            const auto lb = std::lower_bound(s.begin(), s.end(), 8);
+            QCOMPARE(lb - s.begin(), std::ptrdiff_t(4));
+            QCOMPARE(*lb, 9);
+            QVERIFY(std::binary_search(s.begin(), s.end(), 13));
+        }
+        QVERIFY(q.try_consume(q.make_snapshot()));
+        QVERIFY(q.empty());
+
+        // Container snapshots are read-only; a mutable view over the same
+        // ring layout (tail index 6 of 8) can be reordered in place.
+        int storage[8] = {80, 30, 60, 50, 0, 0, 40, 10};
+        using it = ::spsc::detail::ring_iterator<int, std::uint32_t, false>;
+        ::spsc::snapshot_view<int, std::uint32_t> v(it(storage, 7u, 6u), it(storage, 7u, 12u));
+        QCOMPARE(v.size(), 6u);
+        std::nth_element(v.begin(), v.begin() + 2, v.end());
+        QCOMPARE(v[2], 40); // {40, 10, 80, 30, 60, 50}
+        std::sort(v.begin(), v.end());
+        QVERIFY(std::is_sorted(v.begin(), v.end()));
+        QCOMPARE(v[0], 10);
+        QCOMPARE(v[5], 80);
+        QCOMPARE(storage[6], 10); // sorted data starts at the wrapped tail
+        QCOMPARE(storage[3], 80);
+    }
+
+    void split_covers_snapshot() {
+        QCOMPARE(::spsc::par::part_count(0u, 4u), std::size_t(0u));
+        QCOMPARE(::spsc::par::part_count(3u, 8u), std::size_t(3u));
+        QCOMPARE(::spsc::par::part_count(100u, 8u, 40u), std::size_t(2u));
+        QCOMPARE(::spsc::par::part_count(10u, 8u, 40u), std::size_t(1u));
+
+        big_fifo q(64u);
+        for (std::uint64_t n = 1u; n <= 50u; ++n) {
+            q.clear();
+            for (std::uint64_t i = 0; i < n; ++i) {
+                QVERIFY(q.try_push(i));
+            }
+            auto s = q.make_snapshot();
+            for (std::size_t parts = 1u; parts <= 9u; ++parts) {
+                const std::size_t used = ::spsc::par::part_count(n, parts);
+                std::size_t next = 0u;
+                std::size_t lo = ~std::size_t(0);
+                std::size_t hi = 0u;
+                for (std::size_t i = 0; i < used; ++i) {
+                    const auto p = ::spsc::par::split(s, used, i);
+                    QCOMPARE(p.offset, next);
+                    QCOMPARE(p.first - s.begin(), std::ptrdiff_t(next));
+                    QCOMPARE(*p.first, std::uint64_t(next));
+                    next += p.size();
+                    lo = std::min(lo, p.size());
+                    hi = std::max(hi, p.size());
+                }
+                QCOMPARE(next, std::size_t(n));
+                QVERIFY(hi - lo <= 1u);
+            }
+        }
+    }
+
+    void threads_process_and_consume() {
+        constexpr std::uint64_t kN = 1u << 16;
+        big_fifo q(kN);
+        for (int round = 0; round < 2; ++round) {
+            for (std::uint64_t i = 0; i < kN - 3u; ++i) {
+                QVERIFY(q.try_push(i));
+            }
+            std::atomic<std::uint64_t> sum{0u};
+            std::atomic<std::size_t> calls{0u};
+            const bool ok = ::spsc::par::process_and_consume(q, 4u, [&](const auto& p) {
+                std::uint64_t local = 0u;
+                for (auto it = p.first; it != p.last; ++it) {
+                    local += *it;
+                }
+                sum.fetch_add(local, std::memory_order_relaxed);
+                calls.fetch_add(1u, std::memory_order_relaxed);
+            });
+            QVERIFY(ok);
+            QCOMPARE(calls.load(), std::size_t(4u));
+            QCOMPARE(sum.load(), serial_sum(kN - 3u));
+            QVERIFY(q.empty()); // the next round wraps the storage
+        }
+
+        QVERIFY(!::spsc::par::process_and_consume(q, 4u, [](const auto&) {}));
+    }
+
+    void executor_process_and_consume() {
+        ::spsc::executor<> ex;
+        QVERIFY(ex.start(3u));
+
+        constexpr std::uint64_t kN = 50000u;
+        big_fifo q(kN);
+        for (std::uint64_t i = 0; i < kN; ++i) {
+            QVERIFY(q.try_push(i));
+        }
+
+        std::vector<std::uint64_t> partial(6u, 0u);
+        std::atomic<std::size_t> calls{0u};
+        QVERIFY(::spsc::par::process_and_consume(q, ex, 0u, 6u, [&](const auto& p) {
+            std::uint64_t local = 0u;
+            for (std::size_t i = 0; i < p.size(); ++i) {
+                local += p.first[static_cast<std::ptrdiff_t>(i)];
+            }
+            partial[p.index] = local;
+            calls.fetch_add(1u, std::memory_order_relaxed);
+        }));
+        QCOMPARE(calls.load(), std::size_t(6u));
+        std::uint64_t sum = 0u;
+        for (const auto x : partial) {
+            sum += x;
+        }
+        QCOMPARE(sum, serial_sum(kN));
+        QVERIFY(q.empty());
+
+        // Stopped executor: every part runs on the caller.
+        ex.stop();
+        QVERIFY(q.try_push(7u));
+        auto s = q.make_snapshot();
+        std::size_t seen = 0u;
+        QCOMPARE(::spsc::par::for_each_part(s, ex, 0u, 4u, [&](const auto& p) { seen += p.size(); }),
+                 std::size_t(1u));
+        QCOMPARE(seen, std::size_t(1u));
+    }
+};
+
+} // namespace
+
+int run_tst_snapshot_par_api_paranoid(int argc, char** argv) {
+    tst_snapshot_par_api_paranoid tc;
+    return QTest::qExec(&tc, argc, argv);
+}
+
+#include "snapshot_par_test.moc"
@@ -0,0 +1,6 @@
+#ifndef SNAPSHOT_PAR_TEST_H_
+#define SNAPSHOT_PAR_TEST_H_
+
+int run_tst_snapshot_par_api_paranoid(int argc, char** argv);
+
+#endif /* SNAPSHOT_PAR_TEST_H_ */
@@ -0,0 +1,204 @@
+// spread_test.cpp
+// Paranoid API/contract test for spsc::spread_fifo (slot-index rotation).
+//
+// Goals:
+//  - slot_of() is a bijection on [0, Capacity) and puts every run of kSpread
+//    consecutive sequence numbers on distinct cache lines.
+//  - Spread = false and elements of at least half a line keep the identity map.
+//  - FIFO semantics across wrap-around: push/pop, write()/read() batches,
+//    claim_read()/claim_write() degrade to one element.
+//  - Concurrent near-empty ping-pong keeps order, spread and identity layout
+//    (latency vs. fifo: tools/spsc_bench).
+
+#include <QtTest/QtTest>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <set>
+#include <thread>
+#include <vector>
+
+#if !defined(SPSC_ASSERT) && !defined(NDEBUG)
+#  define SPSC_ASSERT(expr) do { if(!(expr)) { std::abort(); } } while(0)
+#endif
+
+#include "spread_fifo.hpp"
+
+namespace {
+
+#if defined(NDEBUG)
+constexpr std::uint32_t kMsgs = 2000000u;
+#else
+constexpr std::uint32_t kMsgs = 200000u;
+#endif
+
+template <class Q>
+static bool check_map() {
+    using T = typename Q::value_type;
+    const reg cap = Q{}.capacity();
+    std::set<reg> seen;
+    for (reg i = 0; i < cap; ++i) {
+        seen.insert(Q::slot_of(i));
+    }
+    if (seen.size() != cap || *seen.rbegin() != cap - 1u) {
+        return false;
+    }
+    for (reg i = 0; i < cap; ++i) {
+        std::set<reg> lines;
+        for (reg k = 0; k < Q::kSpread; ++k) {
+            lines.insert(Q::slot_of(i + k) * sizeof(T) / SPSC_CACHELINE_BYTES);
+        }
+        if (lines.size() != Q::kSpread) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <class Q>
+static bool ping_pong_in_order() {
+    Q q;
+    std::atomic<std::uint32_t> acked{0u};
+    std::atomic<bool> ok{true};
+    std::thread consumer([&]() {
+        std::uint32_t expect = 0u;
+        while (expect < kMsgs) {
+            auto* p = q.try_front();
+            if (!p) {
+                std::this_thread::yield();
+                continue;
+            }
+            if (*p != expect) {
+                ok.store(false, std::memory_order_relaxed);
+            }
+            q.pop();
+            ++expect;
+            acked.store(expect, std::memory_order_release);
+        }
+    });
+    for (std::uint32_t i = 0; i < kMsgs; ++i) {
+        while (!q.try_push(static_cast<std::uint32_t>(i))) {
+            std::this_thread::yield();
+        }
+        // Keep the ring nearly empty: at most two in flight.
+        while (i >= acked.load(std::memory_order_acquire) + 2u) {
+            std::this_thread::yield();
+        }
+    }
+    consumer.join();
+    return ok.load() && q.empty();
+}
+
+class tst_spread_api_paranoid : public QObject {
+    Q_OBJECT
+
+private slots:
+    void map_is_bijective_and_spread() {
+        using Q4   = spsc::spread_fifo<std::uint32_t, 1024>; // >= L*L
+        using Q8   = spsc::spread_fifo<std::uint64_t, 64>;
+        using QSm  = spsc::spread_fifo<std::uint32_t, 64>; // smaller than L*L
+        using QOne = spsc::spread_fifo<std::uint32_t, 16>; // one cache line
+        QVERIFY(Q4::kSpread > 1u);
+        QCOMPARE(Q4::kSpread, reg(SPSC_CACHELINE_BYTES / 4u));
+        QVERIFY(check_map<Q4>());
+        QVERIFY(check_map<Q8>());
+        QVERIFY(check_map<QSm>());
+        QVERIFY(QSm::kSpread > 1u && QSm::kSpread < Q4::kSpread);
+        QCOMPARE(QOne::kSpread, reg(1u));
+        QVERIFY(Q4::slot_of(0u) != Q4::slot_of(1u));
+    }
+
+    void identity_when_disabled_or_large() {
+        using Off = spsc::spread_fifo<std::uint32_t, 64, spsc::policy::P, false>;
+        struct Big { unsigned char b[SPSC_CACHELINE_BYTES]; };
+        using Large = spsc::spread_fifo<Big, 16>;
+        QCOMPARE(Off::kSpread, reg(1u));
+        QCOMPARE(Large::kSpread, reg(1u));
+        for (reg i = 0; i < 64u; ++i) {
+            QCOMPARE(Off::slot_of(i), i);
+        }
+        QCOMPARE(Large::slot_of(5u), reg(5u));
+    }
+
+    void fifo_semantics_wrap() {
+        spsc::spread_fifo<std::uint32_t, 64> q;
+        QVERIFY(q.empty());
+        QCOMPARE(q.capacity(), reg(64u));
+        std::uint32_t next_in = 0u;
+        std::uint32_t next_out = 0u;
+        for (int round = 0; round < 50; ++round) {
+            while (q.try_push(next_in)) {
+                ++next_in;
+                if ((next_in % 37u) == 0u) {
+                    break;
+                }
+            }
+            QCOMPARE(q[0], next_out);
+            const reg k = q.size() / 2u + 1u;
+            for (reg i = 0; i < k && !q.empty(); ++i) {
+                QCOMPARE(q.front(), next_out);
+                q.pop();
+                ++next_out;
+            }
+        }
+        while (auto* p = q.try_front()) {
+            QCOMPARE(*p, next_out++);
+            q.pop();
+        }
+        QCOMPARE(next_out, next_in);
+        QVERIFY(!q.try_pop());
+    }
+
+    void batch_write_read() {
+        spsc::spread_fifo<std::uint16_t, 32> q;
+        std::vector<std::uint16_t> src(100), dst(100);
+        for (std::size_t i = 0; i < src.size(); ++i) {
+            src[i] = static_cast<std::uint16_t>(i * 7u);
+        }
+        std::size_t in = 0u;
+        std::size_t out = 0u;
+        while (out < src.size()) {
+            in += q.write(src.data() + in, static_cast<reg>(std::min<std::size_t>(src.size() - in, 23u)));
+            out += q.read(dst.data() + out, 17u);
+        }
+        QVERIFY(src == dst);
+        QCOMPARE(q.write(src.data(), 100u), reg(32u));
+        QVERIFY(q.full());
+        QCOMPARE(q.read(dst.data(), 100u), reg(32u));
+    }
+
+    void regions_degrade_to_one() {
+        spsc::spread_fifo<std::uint32_t, 64> q;
+        auto w = q.claim_write(spsc::unsafe, 10u);
+        QCOMPARE(w.total, reg(1u));
+        QCOMPARE(w.first.count, reg(1u));
+        *w.first.ptr = 42u;
+        q.publish(w.total);
+        QCOMPARE(q.front(), 42u);
+        auto r = q.claim_read(spsc::unsafe);
+        QCOMPARE(r.total, reg(1u));
+        QCOMPARE(*r.first.ptr, 42u);
+        q.pop(r.total);
+        QVERIFY(q.claim_read(spsc::unsafe).empty());
+
+        // Identity layout keeps contiguous regions.
+        spsc::spread_fifo<std::uint32_t, 64, spsc::policy::P, false> p;
+        QCOMPARE(p.claim_write(spsc::unsafe, 10u).total, reg(10u));
+    }
+
+    void near_empty_ping_pong_keeps_order() {
+        using A = spsc::policy::CA<>;
+        QVERIFY((ping_pong_in_order<spsc::spread_fifo<std::uint32_t, 256, A, true>>()));
+        QVERIFY((ping_pong_in_order<spsc::spread_fifo<std::uint32_t, 256, A, false>>()));
+    }
+};
+
+} // namespace
+
+int run_tst_spread_api_paranoid(int argc, char** argv) {
+    tst_spread_api_paranoid tc;
+    return QTest::qExec(&tc, argc, argv);
+}
+
+#include "spread_test.moc"
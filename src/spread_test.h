@@ -0,0 +1,6 @@
+#ifndef SPREAD_TEST_H_
+#define SPREAD_TEST_H_
+
+int run_tst_spread_api_paranoid(int argc, char** argv);
+
+#endif /* SPREAD_TEST_H_ */
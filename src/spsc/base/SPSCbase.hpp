@@ -25,6 +25,10 @@
  *   - SPSC_SHADOW_REFRESH_FRAC_SHIFT (default: 2)
  *       Threshold = capacity() >> shift. Example: shift=2 -> 1/4 capacity.
  *
+ *   - SPSC_SHADOW_REFRESH_ADAPTIVE (default: 0)
+ *       1 -> threshold shift tuned per side from the refresh hit rate
+ *            (spsc::adapt::refresh_controller, bounded by SPSC_ADAPTIVE_SHIFT_MIN/MAX)
+ *
  * Threading contract (when shadows enabled):
  *   - prod_shadow_tail is updated ONLY by producer-side methods.
  *   - cons_shadow_head is updated ONLY by consumer-side methods.
@@ -38,11 +42,16 @@
 #ifndef SPSC_RING_BASE_HPP_
 #define SPSC_RING_BASE_HPP_
 
+#include <atomic>      // std::atomic_thread_fence
+#include <cstring>     // std::memcpy
 #include <limits>
 #include <type_traits>
 
+#include "spsc_adaptive.hpp"      // ::spsc::adapt::refresh_controller
 #include "spsc_capacity_ctrl.hpp" // ::spsc::cap::CapacityCtrl<C, PolicyT>
+#include "spsc_layout.hpp"        // ::spsc::layout::report
 #include "spsc_tools.hpp"         // RB_FORCEINLINE / RB_UNLIKELY (+ core macros)
+#include "spsc_trace.hpp"         // SPSC_TRACE (optional USDT probes)
 
 #ifndef SPSC_ENABLE_SHADOW_INDICES
 #  define SPSC_ENABLE_SHADOW_INDICES 1
@@ -60,6 +69,10 @@
 #  define SPSC_SHADOW_REFRESH_FRAC_SHIFT 2
 #endif /* SPSC_SHADOW_REFRESH_FRAC_SHIFT */
 
+#ifndef SPSC_SHADOW_REFRESH_ADAPTIVE
+#  define SPSC_SHADOW_REFRESH_ADAPTIVE 0
+#endif /* SPSC_SHADOW_REFRESH_ADAPTIVE */
+
 namespace spsc {
 
 
@@ -78,24 +91,41 @@ inline constexpr bool is_atomic_counter_backend_v = T::counter_type::is_atomic;
  * Threading contract (when enabled):
  *   - prod_shadow_tail is updated ONLY by producer-side methods.
  *   - cons_shadow_head is updated ONLY by consumer-side methods.
+ *
+ * 'Adaptive' follows SPSC_SHADOW_REFRESH_ADAPTIVE, so a translation unit
+ * built with the toggle gets a distinct shadow type (no ODR clash with the
+ * default layout).
  */
-template<bool Enabled>
+template<bool Enabled, bool Adaptive = (SPSC_SHADOW_REFRESH_ADAPTIVE != 0)>
 struct rb_shadow_indices {
     // Empty base when disabled (EBO).
 };
 
 template<>
-struct SPSC_ALIGNED(SPSC_CACHELINE_BYTES) rb_shadow_indices<true> {
+struct SPSC_ALIGNED(SPSC_CACHELINE_BYTES) rb_shadow_indices<true, false> {
+    alignas(SPSC_CACHELINE_BYTES) mutable reg prod_shadow_tail{0u};
+    alignas(SPSC_CACHELINE_BYTES) mutable reg cons_shadow_head{0u};
+};
+
+template<>
+struct SPSC_ALIGNED(SPSC_CACHELINE_BYTES) rb_shadow_indices<true, true> {
     alignas(SPSC_CACHELINE_BYTES) mutable reg prod_shadow_tail{0u};
+    mutable ::spsc::adapt::refresh_controller prod_refresh{}; // same line as prod_shadow_tail
     alignas(SPSC_CACHELINE_BYTES) mutable reg cons_shadow_head{0u};
+    mutable ::spsc::adapt::refresh_controller cons_refresh{}; // same line as cons_shadow_head
 };
 
 // Paranoid compile-time guarantees.
-static_assert(alignof(rb_shadow_indices<true>) >= SPSC_CACHELINE_BYTES, "Shadow struct must be cacheline-aligned");
-static_assert((offsetof(rb_shadow_indices<true>, prod_shadow_tail) % SPSC_CACHELINE_BYTES) == 0, "prod_shadow_tail not cacheline-aligned");
-static_assert((offsetof(rb_shadow_indices<true>, cons_shadow_head) % SPSC_CACHELINE_BYTES) == 0, "cons_shadow_head not cacheline-aligned");
-static_assert(offsetof(rb_shadow_indices<true>, cons_shadow_head) >= SPSC_CACHELINE_BYTES, "Shadows must be on different cache lines");
-static_assert((sizeof(rb_shadow_indices<true>) % SPSC_CACHELINE_BYTES) == 0, "Size should be a multiple of cache line");
+using rb_shadow_plain    = rb_shadow_indices<true, false>;
+using rb_shadow_adaptive = rb_shadow_indices<true, true>;
+static_assert(alignof(rb_shadow_plain) >= SPSC_CACHELINE_BYTES, "Shadow struct must be cacheline-aligned");
+static_assert((offsetof(rb_shadow_plain, prod_shadow_tail) % SPSC_CACHELINE_BYTES) == 0, "prod_shadow_tail not cacheline-aligned");
+static_assert((offsetof(rb_shadow_plain, cons_shadow_head) % SPSC_CACHELINE_BYTES) == 0, "cons_shadow_head not cacheline-aligned");
+static_assert(offsetof(rb_shadow_plain, cons_shadow_head) >= SPSC_CACHELINE_BYTES, "Shadows must be on different cache lines");
+static_assert((sizeof(rb_shadow_plain) % SPSC_CACHELINE_BYTES) == 0, "Size should be a multiple of cache line");
+static_assert((offsetof(rb_shadow_adaptive, cons_shadow_head) % SPSC_CACHELINE_BYTES) == 0, "cons_shadow_head not cacheline-aligned");
+static_assert(offsetof(rb_shadow_adaptive, prod_refresh) < SPSC_CACHELINE_BYTES, "prod_refresh must share the producer shadow line");
+static_assert((sizeof(rb_shadow_adaptive) % SPSC_CACHELINE_BYTES) == 0, "Size should be a multiple of cache line");
 
 template <class PolicyT>
 inline constexpr bool rb_use_shadow_v =
@@ -127,6 +157,11 @@ class SPSCbase
                   "[SPSCbase]: SPSC_SHADOW_REFRESH_FRAC_SHIFT must be < bits(reg) to avoid UB shift");
 #endif /* SPSC_SHADOW_REFRESH_HEURISTIC */
 
+#if SPSC_SHADOW_REFRESH_ADAPTIVE
+    static_assert(static_cast<unsigned>(SPSC_ADAPTIVE_SHIFT_MAX) < kBits,
+                  "[SPSCbase]: SPSC_ADAPTIVE_SHIFT_MAX must be < bits(reg) to avoid UB shift");
+#endif /* SPSC_SHADOW_REFRESH_ADAPTIVE */
+
     using Base = ::spsc::cap::CapacityCtrl<C, PolicyT>;
     using Cnt  = typename PolicyT::counter_type;
 
@@ -177,6 +212,7 @@ protected:
         const bool ok = Base::init(cap);
         clear(); // non-concurrent hard sync
         sync_cache();
+        SPSC_TRACE(resize, this, capacity(), reg(0u));
         return ok;
     }
 
@@ -200,6 +236,7 @@ protected:
         set_head(initial_head);
         set_tail(initial_tail);
         sync_cache();
+        SPSC_TRACE(resize, this, capacity(), used);
         return true;
     }
 
@@ -218,6 +255,7 @@ protected:
         set_head(initial_head);
         set_tail(initial_tail);
         sync_cache();
+        SPSC_TRACE(resize, this, capacity(), used);
         return true;
     }
 
@@ -282,6 +320,29 @@ protected:
     RB_FORCEINLINE void set_head(const reg) noexcept;
     RB_FORCEINLINE void set_tail(const reg) noexcept;
 
+    // Observer copy (any thread): loads head/tail only, never writes indices or shadows.
+    // Atomic backends only: with plain/volatile counters the loads race the owners.
+    template<class T>
+    [[nodiscard]] reg observe_copy(const T *buf, T *dst, const reg max) const noexcept;
+
+    // Layout hook: adds geometry, shadows and indices to 'r' (containers add their storage).
+    void describe_layout(::spsc::layout::report &r) const noexcept {
+        using ::spsc::layout::writer;
+        Base::describe_geometry(r);
+        if constexpr (kUseShadow) {
+            r.add("prod_shadow_tail", &this->prod_shadow_tail, sizeof(this->prod_shadow_tail), writer::producer);
+#if SPSC_SHADOW_REFRESH_ADAPTIVE
+            r.add("prod_refresh", &this->prod_refresh, sizeof(this->prod_refresh), writer::producer);
+#endif /* SPSC_SHADOW_REFRESH_ADAPTIVE */
+            r.add("cons_shadow_head", &this->cons_shadow_head, sizeof(this->cons_shadow_head), writer::consumer);
+#if SPSC_SHADOW_REFRESH_ADAPTIVE
+            r.add("cons_refresh", &this->cons_refresh, sizeof(this->cons_refresh), writer::consumer);
+#endif /* SPSC_SHADOW_REFRESH_ADAPTIVE */
+        }
+        r.add("head", &_head, sizeof(_head), writer::producer);
+        r.add("tail", &_tail, sizeof(_tail), writer::consumer);
+    }
+
 private:
     Cnt _head{};
     Cnt _tail{};
@@ -394,6 +455,7 @@ RB_FORCEINLINE bool SPSCbase<C, PolicyT>::empty() const noexcept {
             h = _head.load();
             this->cons_shadow_head = h;
             av = static_cast<reg>(h - t);
+            SPSC_TRACE(refresh_head, this, h, av);
         }
 
         return (av == 0u) || RB_UNLIKELY(av > cap);
@@ -433,6 +495,7 @@ RB_FORCEINLINE bool SPSCbase<C, PolicyT>::full() const noexcept {
         t = _tail.load();
         this->prod_shadow_tail = t;
         used = static_cast<reg>(h - t);
+        SPSC_TRACE(refresh_tail, this, t, used);
 
         return (used == cap) || RB_UNLIKELY(used > cap);
     }
@@ -519,6 +582,7 @@ RB_FORCEINLINE bool SPSCbase<C, PolicyT>::can_write(const reg n) const noexcept
         t = _tail.load();
         this->prod_shadow_tail = t;
         used = static_cast<reg>(h - t);
+        SPSC_TRACE(refresh_tail, this, t, used);
 
         if (RB_UNLIKELY(used > cap)) {
             return false;
@@ -568,6 +632,7 @@ RB_FORCEINLINE bool SPSCbase<C, PolicyT>::can_read(const reg n) const noexcept {
             h = _head.load();
             this->cons_shadow_head = h;
             av = static_cast<reg>(h - t);
+            SPSC_TRACE(refresh_head, this, h, av);
 
             if (RB_UNLIKELY(av > cap)) {
                 return false;
@@ -646,6 +711,18 @@ RB_FORCEINLINE reg SPSCbase<C, PolicyT>::write_size() const noexcept {
         // Compute free space conservatively (0 on full/invalid).
         reg fr = (used < cap) ? static_cast<reg>(cap - used) : 0u;
 
+#if SPSC_SHADOW_REFRESH_ADAPTIVE
+        const reg thr = this->prod_refresh.threshold(cap);
+        if ((fr == 0u) || ((thr != 0u) && (fr < thr))) {
+            const reg fr_shadow = fr;
+            t = _tail.load();
+            this->prod_shadow_tail = t;
+            used = static_cast<reg>(h - t);
+            fr = (used < cap) ? static_cast<reg>(cap - used) : 0u;
+            SPSC_TRACE(refresh_tail, this, t, used);
+            this->prod_refresh.on_refresh(fr_shadow, fr, cap);
+        }
+#else
 #if SPSC_SHADOW_REFRESH_HEURISTIC
         const reg thr = static_cast<reg>(cap >> SPSC_SHADOW_REFRESH_FRAC_SHIFT);
         if ((fr == 0u) || ((thr != 0u) && (fr < thr))) {
@@ -656,7 +733,9 @@ RB_FORCEINLINE reg SPSCbase<C, PolicyT>::write_size() const noexcept {
             this->prod_shadow_tail = t;
             used = static_cast<reg>(h - t);
             fr = (used < cap) ? static_cast<reg>(cap - used) : 0u;
+            SPSC_TRACE(refresh_tail, this, t, used);
         }
+#endif /* SPSC_SHADOW_REFRESH_ADAPTIVE */
 
         if (fr == 0u) {
             return 0u;
@@ -709,6 +788,22 @@ RB_FORCEINLINE reg SPSCbase<C, PolicyT>::read_size() const noexcept {
         // Clamp availability to 0 on empty/invalid; used only to decide refresh.
         reg av_ok = ((av != 0u) && (av <= cap)) ? av : 0u;
 
+#if SPSC_SHADOW_REFRESH_ADAPTIVE
+        const reg thr = this->cons_refresh.threshold(cap);
+        if ((av_ok == 0u) || ((thr != 0u) && (av_ok < thr))) {
+            const reg av_shadow = av_ok;
+            h = _head.load();
+            this->cons_shadow_head = h;
+            av = static_cast<reg>(h - t);
+            SPSC_TRACE(refresh_head, this, h, av);
+
+            av_ok = ((av != 0u) && (av <= cap)) ? av : 0u;
+            this->cons_refresh.on_refresh(av_shadow, av_ok, cap);
+            if (av_ok == 0u) {
+                return 0u;
+            }
+        }
+#else
 #if SPSC_SHADOW_REFRESH_HEURISTIC
         const reg thr = static_cast<reg>(cap >> SPSC_SHADOW_REFRESH_FRAC_SHIFT);
         if ((av_ok == 0u) || ((thr != 0u) && (av_ok < thr))) {
@@ -718,12 +813,14 @@ RB_FORCEINLINE reg SPSCbase<C, PolicyT>::read_size() const noexcept {
             h = _head.load();
             this->cons_shadow_head = h;
             av = static_cast<reg>(h - t);
+            SPSC_TRACE(refresh_head, this, h, av);
 
             if ((av == 0u) || (av > cap)) {
                 return 0u;
             }
             av_ok = av;
         }
+#endif /* SPSC_SHADOW_REFRESH_ADAPTIVE */
 
         const reg r2e = static_cast<reg>(cap - (t & m));
         return rb_min_(r2e, av_ok);
@@ -850,6 +947,50 @@ RB_FORCEINLINE void SPSCbase<C, PolicyT>::swap_base(SPSCbase &other) noexcept {
     other.sync_cache();
 }
 
+template<reg C, typename PolicyT>
+template<class T>
+reg SPSCbase<C, PolicyT>::observe_copy(const T *buf, T *dst, const reg max) const noexcept {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "[SPSCbase]: observe_copy() requires trivially copyable T");
+    static_assert(kAtomicBackend,
+                  "[SPSCbase]: observe_copy() requires an atomic policy (A<> / CA<>); "
+                  "plain/volatile counters give a third thread no ordering");
+
+    const reg cap = capacity();
+    if (RB_UNLIKELY(cap == 0u || buf == nullptr || max == 0u)) {
+        return 0u;
+    }
+
+    for (unsigned attempt = 0u; attempt < static_cast<unsigned>(SPSC_OBSERVER_RETRIES); ++attempt) {
+        const reg t0   = _tail.load();
+        const reg h    = _head.load();
+        const reg used = static_cast<reg>(h - t0);
+        if (RB_UNLIKELY(used > cap)) {
+            continue; // torn head/tail pair
+        }
+
+        const reg n = rb_min_(used, max);
+        if (n == 0u) {
+            return 0u;
+        }
+
+        const reg idx    = static_cast<reg>(t0 & mask());
+        const reg first  = rb_min_(n, static_cast<reg>(cap - idx));
+        std::memcpy(dst, buf + idx, static_cast<std::size_t>(first) * sizeof(T));
+        if (first != n) {
+            std::memcpy(dst + first, buf, static_cast<std::size_t>(n - first) * sizeof(T));
+        }
+
+        // Slot [t0 + k] can only be rewritten after the consumer passed it:
+        // an unchanged tail proves the copy was not overwritten (seqlock-style).
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (_tail.load() == t0) {
+            return n;
+        }
+    }
+    return 0u;
+}
+
 
 } // namespace spsc
 
@@ -0,0 +1,127 @@
+/*
+ * spsc_adaptive.hpp
+ *
+ * Per-instance adaptive tuning for SPSC rings.
+ *
+ * Exposes:
+ *   - refresh_controller : tunes the shadow refresh threshold (cap >> shift)
+ *                          from the room each refresh actually gained.
+ *
+ * The controller is single-owner state (producer OR consumer side), uses
+ * plain integers only and never allocates. Decisions are taken once per
+ * observation window and are always clamped to [min, off] bounds, so a
+ * pathological workload can at worst pin a controller at one of its bounds.
+ *
+ * Build toggles (see spsc_config.hpp):
+ *   - SPSC_SHADOW_REFRESH_ADAPTIVE   : SPSCbase uses refresh_controller
+ *   - SPSC_ADAPTIVE_SHIFT_MIN / MAX  : bounds of the refresh shift (past MAX: off)
+ *   - SPSC_ADAPTIVE_WINDOW           : observations per decision
+ */
+
+#ifndef SPSC_ADAPTIVE_HPP_
+#define SPSC_ADAPTIVE_HPP_
+
+#include <cstdint>
+
+#include "basic_types.h"    // reg
+#include "spsc_config.hpp"  // SPSC_ADAPTIVE_*, SPSC_SHADOW_REFRESH_FRAC_SHIFT
+#include "spsc_tools.hpp"   // RB_FORCEINLINE / RB_NOINLINE / RB_UNLIKELY
+
+namespace spsc::adapt {
+
+static_assert(SPSC_ADAPTIVE_SHIFT_MIN >= 0,
+              "[spsc::adapt]: SPSC_ADAPTIVE_SHIFT_MIN must be non-negative");
+static_assert(SPSC_ADAPTIVE_SHIFT_MIN <= SPSC_ADAPTIVE_SHIFT_MAX,
+              "[spsc::adapt]: SPSC_ADAPTIVE_SHIFT_MIN must be <= SPSC_ADAPTIVE_SHIFT_MAX");
+static_assert(SPSC_ADAPTIVE_SHIFT_MAX < 32,
+              "[spsc::adapt]: SPSC_ADAPTIVE_SHIFT_MAX is unreasonably large");
+static_assert(SPSC_ADAPTIVE_WINDOW >= 4 && SPSC_ADAPTIVE_WINDOW <= 0xFFFF,
+              "[spsc::adapt]: SPSC_ADAPTIVE_WINDOW must be in [4, 65535]");
+
+/* =======================================================================
+ * refresh_controller
+ *
+ * An "optional" refresh is one taken only because the shadow suggests we
+ * are close to the boundary (0 < room < threshold), not because the ring
+ * looks full/empty. It costs a cross-core cache-line pull; it is a "hit"
+ * when it gained at least one threshold of room/data, i.e. the pull is
+ * amortized over at least as many elements as the zone it was taken in.
+ * A ring that stays near its boundary (nearly full for the producer, nearly
+ * empty for the consumer) gains a few slots per refresh: it misses, and
+ * its threshold shrinks until early refreshes are off (threshold 0).
+ *
+ * Per window:
+ *   - hit rate >= 3/4 : refreshing early pays off -> shift-- (larger threshold)
+ *   - hit rate <= 1/4 : refreshes are wasted      -> shift++ (smaller threshold,
+ *                                                    kOffShift = early refresh off)
+ * While off, mandatory refreshes (room == 0) are the probes: one that gains
+ * at least cap >> kMaxShift is a hit, so a ring whose peer catches up turns
+ * early refreshes back on.
+ * ======================================================================= */
+class refresh_controller {
+public:
+    static constexpr std::uint8_t kMinShift = static_cast<std::uint8_t>(SPSC_ADAPTIVE_SHIFT_MIN);
+    static constexpr std::uint8_t kMaxShift = static_cast<std::uint8_t>(SPSC_ADAPTIVE_SHIFT_MAX);
+    static constexpr std::uint16_t kWindow  = static_cast<std::uint16_t>(SPSC_ADAPTIVE_WINDOW);
+
+    static constexpr std::uint8_t kOffShift = static_cast<std::uint8_t>(kMaxShift + 1u);
+
+    static constexpr std::uint8_t kInitShift =
+        (SPSC_SHADOW_REFRESH_FRAC_SHIFT < SPSC_ADAPTIVE_SHIFT_MIN) ? kMinShift :
+        (SPSC_SHADOW_REFRESH_FRAC_SHIFT > SPSC_ADAPTIVE_SHIFT_MAX) ? kMaxShift :
+        static_cast<std::uint8_t>(SPSC_SHADOW_REFRESH_FRAC_SHIFT);
+
+    [[nodiscard]] RB_FORCEINLINE reg threshold(const reg cap) const noexcept {
+        return (shift_ > kMaxShift) ? reg(0u) : static_cast<reg>(cap >> shift_);
+    }
+
+    /* One shadow refresh: 'before' is the room/data the shadow showed
+     * (0 = mandatory refresh), 'after' what the fresh index shows. */
+    RB_FORCEINLINE void on_refresh(const reg before, const reg after, const reg cap) noexcept {
+        const reg gained = (after > before) ? static_cast<reg>(after - before) : reg(0u);
+        const reg thr    = threshold(cap);
+        if (before != 0u) {
+            if (thr != 0u) {
+                on_probe(gained >= thr);
+            }
+        } else if (RB_UNLIKELY(shift_ > kMaxShift)) {
+            on_probe(gained >= static_cast<reg>(cap >> kMaxShift));
+        }
+    }
+
+    RB_FORCEINLINE void on_probe(const bool hit) noexcept {
+        ++probes_;
+        hits_ = static_cast<std::uint16_t>(hits_ + (hit ? 1u : 0u));
+        if (RB_UNLIKELY(probes_ >= kWindow)) {
+            decide_();
+        }
+    }
+
+    void reset() noexcept { *this = refresh_controller{}; }
+
+    [[nodiscard]] std::uint8_t shift() const noexcept { return shift_; }
+    [[nodiscard]] reg decisions() const noexcept { return decisions_; }
+
+private:
+    RB_NOINLINE void decide_() noexcept {
+        const unsigned p = probes_;
+        const unsigned h = hits_;
+        if ((4u * h >= 3u * p) && (shift_ > kMinShift)) {
+            --shift_;
+        } else if ((4u * h <= p) && (shift_ < kOffShift)) {
+            ++shift_;
+        }
+        probes_ = 0u;
+        hits_   = 0u;
+        ++decisions_;
+    }
+
+    std::uint8_t  shift_{kInitShift};
+    std::uint16_t probes_{0u};
+    std::uint16_t hits_{0u};
+    reg           decisions_{0u};
+};
+
+} // namespace spsc::adapt
+
+#endif /* SPSC_ADAPTIVE_HPP_ */
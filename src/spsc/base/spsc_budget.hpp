@@ -0,0 +1,220 @@
+/*
+ * spsc_budget.hpp
+ *
+ * Process-level memory budget for dynamic rings.
+ *
+ * Every dynamic container grows on its own, so one runaway stream can take
+ * all host memory. A memory_budget is a shared byte counter with a limit.
+ * budget_allocator reserves bytes from it before each allocation and returns
+ * them on deallocation, so resize()/reserve() of any container built with it
+ * fail softly (return false) once the budget is spent, and shrink / destroy
+ * give the bytes back.
+ *
+ * Containers construct their allocators by value (allocator_type{}), so the
+ * allocator is stateless and names its budget through a tag type:
+ *
+ *   struct net_budget {
+ *       static spsc::alloc::memory_budget& budget() noexcept {
+ *           static spsc::alloc::memory_budget b{64u << 20};
+ *           return b;
+ *       }
+ *   };
+ *   spsc::fifo<Msg, 0, spsc::policy::A<>, spsc::alloc::budget_alloc<net_budget>> hot;
+ *   spsc::fifo<Log, 0, spsc::policy::A<>,
+ *              spsc::alloc::budget_alloc<net_budget, spsc::alloc::keep_headroom<25>>> bulk;
+ *
+ * Grow policies decide which rings may take the last bytes:
+ *   - grow_any          : any request that fits the limit.
+ *   - keep_headroom<Pct>: only if Pct % of the limit stays free afterwards,
+ *                         so low-priority rings cannot starve the hot ones.
+ *
+ * The reservation is one lock-free CAS loop on the used counter; limit and
+ * headroom are checked inside it, so concurrent growers never overshoot.
+ * Only the allocation path touches the budget; push/pop do not.
+ */
+
+#ifndef SPSC_BUDGET_HPP_
+#define SPSC_BUDGET_HPP_
+
+#include <atomic>      // std::atomic
+#include <cstddef>     // std::size_t, std::byte, std::ptrdiff_t
+#include <limits>      // std::numeric_limits
+#include <memory>      // std::allocator_traits
+#include <type_traits> // std::true_type
+#include <utility>     // std::declval
+
+#include "spsc_alloc.hpp" // ::spsc::alloc::default_alloc
+#include "spsc_tools.hpp" // RB_UNLIKELY
+
+namespace spsc::alloc {
+
+// ------------------------------------------------------------------------------------------
+// memory_budget
+// ------------------------------------------------------------------------------------------
+class memory_budget {
+public:
+    explicit memory_budget(const std::size_t limit_bytes) noexcept : limit_(limit_bytes) {}
+
+    memory_budget(const memory_budget&)            = delete;
+    memory_budget& operator=(const memory_budget&) = delete;
+
+    /*
+     * try_reserve(bytes, headroom)
+     * Takes 'bytes' if used + bytes + headroom <= limit. Lock-free; safe from
+     * any thread. Returns false (and counts a denial) otherwise.
+     */
+    [[nodiscard]] bool try_reserve(const std::size_t bytes, const std::size_t headroom = 0u) noexcept {
+        const std::size_t lim = limit_.load(std::memory_order_relaxed);
+        std::size_t cur = used_.load(std::memory_order_relaxed);
+        for (;;) {
+            if (RB_UNLIKELY((bytes > lim) || (headroom > (lim - bytes)) || (cur > (lim - bytes - headroom)))) {
+                denied_.fetch_add(1u, std::memory_order_relaxed);
+                return false;
+            }
+            if (used_.compare_exchange_weak(cur, cur + bytes, std::memory_order_acq_rel,
+                                            std::memory_order_relaxed)) {
+                break;
+            }
+        }
+
+        const std::size_t now = cur + bytes;
+        std::size_t pk = peak_.load(std::memory_order_relaxed);
+        while ((pk < now) && !peak_.compare_exchange_weak(pk, now, std::memory_order_relaxed)) {
+        }
+        return true;
+    }
+
+    void release(const std::size_t bytes) noexcept {
+        const std::size_t prev = used_.fetch_sub(bytes, std::memory_order_acq_rel);
+        SPSC_ASSERT(prev >= bytes && "memory_budget::release(): more bytes than reserved");
+        static_cast<void>(prev);
+    }
+
+    // A lower limit does not reclaim memory; it only stops further growth.
+    void set_limit(const std::size_t limit_bytes) noexcept {
+        limit_.store(limit_bytes, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] std::size_t limit() const noexcept { return limit_.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::size_t used() const noexcept { return used_.load(std::memory_order_acquire); }
+    [[nodiscard]] std::size_t peak() const noexcept { return peak_.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::size_t denied() const noexcept { return denied_.load(std::memory_order_relaxed); }
+
+    [[nodiscard]] std::size_t available() const noexcept {
+        const std::size_t lim = limit();
+        const std::size_t u   = used();
+        return (u < lim) ? (lim - u) : 0u;
+    }
+
+private:
+    std::atomic<std::size_t> limit_;
+    std::atomic<std::size_t> used_{0u};
+    std::atomic<std::size_t> peak_{0u};
+    std::atomic<std::size_t> denied_{0u};
+};
+
+// ------------------------------------------------------------------------------------------
+// Grow policies
+// ------------------------------------------------------------------------------------------
+struct grow_any {
+    [[nodiscard]] static constexpr std::size_t headroom(const std::size_t /*limit*/) noexcept { return 0u; }
+};
+
+template<unsigned Pct>
+struct keep_headroom {
+    static_assert(Pct <= 100u, "[spsc::alloc::keep_headroom]: Pct must be <= 100");
+
+    [[nodiscard]] static constexpr std::size_t headroom(const std::size_t limit) noexcept {
+        return (limit / 100u) * Pct + ((limit % 100u) * Pct) / 100u;
+    }
+};
+
+// ------------------------------------------------------------------------------------------
+// budget_allocator<T, Tag, Grow, Base>
+// ------------------------------------------------------------------------------------------
+/*
+ * Tag::budget() returns the shared memory_budget&. Base is the allocator
+ * that does the real work (rebound to T). A denied reservation returns
+ * nullptr even when Base would throw: running out of budget is an expected
+ * condition, and every container already handles a null buffer.
+ */
+template<class T, class Tag, class Grow = grow_any, class Base = default_alloc>
+class budget_allocator {
+    using base_type   = typename std::allocator_traits<Base>::template rebind_alloc<T>;
+    using base_traits = std::allocator_traits<base_type>;
+
+public:
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal                        = std::true_type;
+
+    static_assert(base_traits::is_always_equal::value,
+                  "[spsc::alloc::budget_allocator]: Base must be stateless (is_always_equal)");
+
+    budget_allocator() noexcept = default;
+
+    template<class U>
+    budget_allocator(const budget_allocator<U, Tag, Grow, Base>&) noexcept {}
+
+    [[nodiscard]] T* allocate(const size_type n) noexcept(
+        noexcept(base_traits::allocate(std::declval<base_type&>(), size_type{1}))) {
+        if (RB_UNLIKELY((n == 0u) || (n > (std::numeric_limits<size_type>::max() / sizeof(T))))) {
+            return nullptr;
+        }
+
+        memory_budget& b = Tag::budget();
+        const size_type bytes = n * sizeof(T);
+        if (!b.try_reserve(bytes, Grow::headroom(b.limit()))) {
+            return nullptr;
+        }
+
+        base_type a{};
+        T* p = nullptr;
+        SPSC_TRY { p = base_traits::allocate(a, n); }
+        SPSC_CATCH_ALL {
+            b.release(bytes);
+            SPSC_RETHROW;
+        }
+        if (RB_UNLIKELY(p == nullptr)) {
+            b.release(bytes);
+        }
+        return p;
+    }
+
+    void deallocate(T* p, const size_type n) noexcept {
+        if (RB_UNLIKELY(p == nullptr)) {
+            return;
+        }
+        base_type a{};
+        base_traits::deallocate(a, p, n);
+        Tag::budget().release(n * sizeof(T));
+    }
+
+    template<class U>
+    struct rebind {
+        using other = budget_allocator<U, Tag, Grow, Base>;
+    };
+};
+
+template<class T1, class T2, class Tag, class Grow, class Base>
+inline bool operator==(const budget_allocator<T1, Tag, Grow, Base>&,
+                       const budget_allocator<T2, Tag, Grow, Base>&) noexcept {
+    return true;
+}
+
+template<class T1, class T2, class Tag, class Grow, class Base>
+inline bool operator!=(const budget_allocator<T1, Tag, Grow, Base>&,
+                       const budget_allocator<T2, Tag, Grow, Base>&) noexcept {
+    return false;
+}
+
+// Container-facing alias (containers rebind from std::byte).
+template<class Tag, class Grow = grow_any, class Base = default_alloc>
+using budget_alloc = budget_allocator<std::byte, Tag, Grow, Base>;
+
+} // namespace spsc::alloc
+
+#endif /* SPSC_BUDGET_HPP_ */
@@ -36,6 +36,7 @@
 #include <type_traits>
 #include <utility>              // std::declval
 
+#include "spsc_layout.hpp"      // spsc::layout::report
 #include "spsc_policy.hpp"      // spsc::policy::default_policy
 #include "spsc_tools.hpp"       // RB_FORCEINLINE
 
@@ -148,6 +149,9 @@ class CapacityCtrl
 public:
     [[nodiscard]] RB_FORCEINLINE static constexpr reg capacity() noexcept { return _cap; }
     [[nodiscard]] RB_FORCEINLINE static constexpr reg mask()     noexcept { return _mask; }
+
+    /* Layout hook: compile-time geometry occupies no bytes. */
+    static void describe_geometry(::spsc::layout::report&) noexcept {}
 };
 
 /* ====================== Dynamic capacity model: C == 0 ======================
@@ -203,6 +207,12 @@ public:
     [[nodiscard]] RB_FORCEINLINE reg mask() const noexcept {
         return static_cast<reg>(_mask.load());
     }
+
+    /* Layout hook: geometry is written only by init() (setup). */
+    void describe_geometry(::spsc::layout::report& r) const noexcept {
+        r.add("cap", &_cap, sizeof(_cap), ::spsc::layout::writer::setup);
+        r.add("mask", &_mask, sizeof(_mask), ::spsc::layout::writer::setup);
+    }
 };
 
 } // namespace spsc::cap
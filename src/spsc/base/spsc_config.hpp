@@ -25,7 +25,35 @@
  *
  *   - SPSC_SHADOW_REFRESH_FRAC_SHIFT (default: 2)
  *       Threshold = capacity() >> shift. Example: shift=2 -> 1/4 capacity.
+ *
+ *   - SPSC_SHADOW_REFRESH_ADAPTIVE (default: 0)
+ *       0 -> refresh threshold fixed by SPSC_SHADOW_REFRESH_FRAC_SHIFT (if heuristic enabled)
+ *       1 -> per-instance, per-side shift tuned at runtime from the room each refresh gained
+ *            (starts at SPSC_SHADOW_REFRESH_FRAC_SHIFT, see base/spsc_adaptive.hpp)
+ *
+ *   - SPSC_ADAPTIVE_SHIFT_MIN / SPSC_ADAPTIVE_SHIFT_MAX (default: 1 / 6)
+ *       Bounds of the adaptive shift: threshold stays within [cap >> MAX, cap >> MIN],
+ *       or 0 (early refresh off) when refreshes near the boundary keep gaining little.
+ *
+ *   - SPSC_ADAPTIVE_WINDOW (default: 64)
+ *       Refresh probes per adaptive decision.
+ *
+ *   - SPSC_OBSERVER_RETRIES (default: 4)
+ *       Attempts of try_copy_out() before it reports a raced copy (returns 0).
+ *
+ *   - SPSC_ENABLE_USDT (default: 0)
+ *       1 -> USDT probes (provider "spsc") at full/empty rejections, shadow refreshes,
+ *            resize and guard commit/cancel, if <sys/sdt.h> is available
+ *            (see base/spsc_trace.hpp). A NOP per site while no tracer is attached.
+ *
+ *   - SPSC_CONFIG_USER_HEADER (default: undefined)
+ *       Header included before any default below, e.g.
+ *       -DSPSC_CONFIG_USER_HEADER='"spsc_tuned_config.h"' (generated by tools/spsc_tune).
  */
+#if defined(SPSC_CONFIG_USER_HEADER)
+#  include SPSC_CONFIG_USER_HEADER
+#endif /* SPSC_CONFIG_USER_HEADER */
+
 #ifndef SPSC_ENABLE_SHADOW_INDICES
 #  define SPSC_ENABLE_SHADOW_INDICES 1
 #endif /* SPSC_ENABLE_SHADOW_INDICES */
@@ -42,6 +70,30 @@
 #  define SPSC_SHADOW_REFRESH_FRAC_SHIFT 2
 #endif /* SPSC_SHADOW_REFRESH_FRAC_SHIFT */
 
+#ifndef SPSC_SHADOW_REFRESH_ADAPTIVE
+#  define SPSC_SHADOW_REFRESH_ADAPTIVE 0
+#endif /* SPSC_SHADOW_REFRESH_ADAPTIVE */
+
+#ifndef SPSC_ADAPTIVE_SHIFT_MIN
+#  define SPSC_ADAPTIVE_SHIFT_MIN 1
+#endif /* SPSC_ADAPTIVE_SHIFT_MIN */
+
+#ifndef SPSC_ADAPTIVE_SHIFT_MAX
+#  define SPSC_ADAPTIVE_SHIFT_MAX 6
+#endif /* SPSC_ADAPTIVE_SHIFT_MAX */
+
+#ifndef SPSC_ADAPTIVE_WINDOW
+#  define SPSC_ADAPTIVE_WINDOW 64
+#endif /* SPSC_ADAPTIVE_WINDOW */
+
+#ifndef SPSC_OBSERVER_RETRIES
+#  define SPSC_OBSERVER_RETRIES 4
+#endif /* SPSC_OBSERVER_RETRIES */
+
+#ifndef SPSC_ENABLE_USDT
+#  define SPSC_ENABLE_USDT 0
+#endif /* SPSC_ENABLE_USDT */
+
 
 // assert ------------------------
 #ifndef SPSC_ASSERT
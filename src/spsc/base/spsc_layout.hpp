@@ -0,0 +1,204 @@
+/*
+ * spsc_layout.hpp
+ *
+ * Cache-line layout inspector for container instances.
+ *
+ * Which line a field lands on depends on the policy (padded or plain
+ * counters, shadows), on the capacity model (inline storage / geometry) and
+ * on where the object itself sits: a fifo<T, N, P> inside a user struct can
+ * share its first and last lines with the neighbouring members. report
+ * records every hot field of one instance with its byte offset, size, cache
+ * lines and the side that writes it:
+ *
+ *   spsc::fifo<int, 16, spsc::policy::CA<>> q;
+ *   const auto r = spsc::layout::inspect(q);
+ *   for (std::size_t i = 0; i < r.size(); ++i) {
+ *       printf("%-12s off %4zu line %zu\n", r[i].name, r[i].offset, r[i].first_line);
+ *   }
+ *   assert(r.shared_lines() == 0u && !r.edge_exposed());
+ *
+ * Writers:
+ *   - producer / consumer : written by that side on the hot path
+ *                           (head, producer shadow / tail, consumer shadow,
+ *                           inline storage slots, refresh controllers).
+ *   - setup               : written only by non-concurrent calls
+ *                           (geometry, storage pointer, slot tables); read by
+ *                           both sides.
+ *
+ * Checks:
+ *   - shared_lines() : lines written by both sides (false sharing).
+ *   - edge_exposed() : a producer/consumer field sits on a line the object
+ *                      does not own completely, so whatever the user places
+ *                      next to it can false-share with that field.
+ *
+ * Line numbers count from the line holding the object's first byte, so two
+ * instances of one type can report different lines. The report is filled by
+ * the container's describe_layout(report&) (fifo, queue, pool, typed_pool,
+ * fifo_view, pool_view). RAII guards live on the caller's stack and are not
+ * part of any container layout. Diagnostic only: nothing here is on a hot
+ * path, and reading the field addresses is safe from any thread.
+ */
+
+#ifndef SPSC_LAYOUT_HPP_
+#define SPSC_LAYOUT_HPP_
+
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uintptr_t
+#include <cstring> // std::strcmp
+
+#include "spsc_cacheline.hpp" // SPSC_CACHELINE_BYTES
+#include "spsc_tools.hpp"     // SPSC_ASSERT
+
+namespace spsc::layout {
+
+// Bit flags: both == producer | consumer.
+enum class writer : unsigned char {
+    setup    = 0u,
+    producer = 1u,
+    consumer = 2u,
+    both     = 3u,
+};
+
+[[nodiscard]] constexpr writer operator|(const writer a, const writer b) noexcept {
+    return static_cast<writer>(static_cast<unsigned>(a) | static_cast<unsigned>(b));
+}
+
+struct field {
+    const char* name{nullptr};
+    std::size_t offset{0u};     // bytes from the object start
+    std::size_t size{0u};       // bytes (including counter padding)
+    std::size_t first_line{0u}; // line of the first byte
+    std::size_t last_line{0u};  // line of the last byte
+    writer      by{writer::setup};
+};
+
+/* =======================================================================
+ * report: field table of one instance
+ * ======================================================================= */
+class report {
+public:
+    static constexpr std::size_t kMaxFields = 16u;
+
+    report(const void* object, const std::size_t object_size,
+           const std::size_t line_bytes = SPSC_CACHELINE_BYTES) noexcept
+        : base_(reinterpret_cast<std::uintptr_t>(object))
+        , object_size_(object_size)
+        , line_(line_bytes) {
+        SPSC_ASSERT(line_bytes != 0u && (line_bytes & (line_bytes - 1u)) == 0u);
+    }
+
+    // Records a field at address 'at' (inside the object). Fields past
+    // kMaxFields are dropped.
+    void add(const char* name, const void* at, const std::size_t size, const writer by) noexcept {
+        const std::uintptr_t p = reinterpret_cast<std::uintptr_t>(at);
+        SPSC_ASSERT(p >= base_ && (p - base_) + size <= object_size_ && size != 0u);
+        SPSC_ASSERT(count_ < kMaxFields && "layout::report: too many fields");
+        if (RB_UNLIKELY(count_ >= kMaxFields)) {
+            return;
+        }
+
+        field& f     = fields_[count_++];
+        f.name       = name;
+        f.offset     = static_cast<std::size_t>(p - base_);
+        f.size       = size;
+        f.first_line = line_of(f.offset);
+        f.last_line  = line_of(f.offset + size - 1u);
+        f.by         = by;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return count_; }
+    [[nodiscard]] const field& operator[](const std::size_t i) const noexcept {
+        SPSC_ASSERT(i < count_);
+        return fields_[i];
+    }
+
+    [[nodiscard]] const field* find(const char* name) const noexcept {
+        for (std::size_t i = 0u; i < count_; ++i) {
+            if (std::strcmp(fields_[i].name, name) == 0) {
+                return &fields_[i];
+            }
+        }
+        return nullptr;
+    }
+
+    [[nodiscard]] std::size_t object_size() const noexcept { return object_size_; }
+    [[nodiscard]] std::size_t line_bytes() const noexcept { return line_; }
+
+    // Offset of the object start inside its first line (0 = line-aligned).
+    [[nodiscard]] std::size_t misalignment() const noexcept {
+        return static_cast<std::size_t>(base_ & (line_ - 1u));
+    }
+
+    // Lines touched by the object.
+    [[nodiscard]] std::size_t line_count() const noexcept {
+        return (object_size_ == 0u) ? 0u : (line_of(object_size_ - 1u) + 1u);
+    }
+
+    // Union of the writers of every field on 'line'.
+    [[nodiscard]] writer line_writers(const std::size_t line) const noexcept {
+        writer w = writer::setup;
+        for (std::size_t i = 0u; i < count_; ++i) {
+            if ((fields_[i].first_line <= line) && (line <= fields_[i].last_line)) {
+                w = w | fields_[i].by;
+            }
+        }
+        return w;
+    }
+
+    // Number of lines written by both the producer and the consumer.
+    [[nodiscard]] std::size_t shared_lines() const noexcept {
+        std::size_t n = 0u;
+        for (std::size_t l = 0u, e = line_count(); l < e; ++l) {
+            n += (line_writers(l) == writer::both) ? 1u : 0u;
+        }
+        return n;
+    }
+
+    // True if fields 'a' and 'b' have at least one line in common.
+    [[nodiscard]] bool same_line(const char* a, const char* b) const noexcept {
+        const field* fa = find(a);
+        const field* fb = find(b);
+        return (fa != nullptr) && (fb != nullptr) && (fa->first_line <= fb->last_line) &&
+               (fb->first_line <= fa->last_line);
+    }
+
+    // True if a hot field sits on a first/last line the object shares with
+    // its neighbours.
+    [[nodiscard]] bool edge_exposed() const noexcept {
+        const std::size_t n = line_count();
+        if (n == 0u) {
+            return false;
+        }
+        const bool head_open = (misalignment() != 0u);
+        const bool tail_open = (((base_ + object_size_) & (line_ - 1u)) != 0u);
+        return (head_open && (line_writers(0u) != writer::setup)) ||
+               (tail_open && (line_writers(n - 1u) != writer::setup));
+    }
+
+private:
+    [[nodiscard]] std::size_t line_of(const std::size_t offset) const noexcept {
+        return static_cast<std::size_t>(((base_ + offset) / line_) - (base_ / line_));
+    }
+
+    std::uintptr_t base_{0u};
+    std::size_t    object_size_{0u};
+    std::size_t    line_{SPSC_CACHELINE_BYTES};
+    std::size_t    count_{0u};
+    field          fields_[kMaxFields]{};
+};
+
+/*
+ * inspect(c, line_bytes)
+ * Layout report of container instance 'c' (any type with
+ * describe_layout(report&) const).
+ */
+template<class Container>
+[[nodiscard]] report inspect(const Container& c, const std::size_t line_bytes = SPSC_CACHELINE_BYTES) noexcept {
+    report r(static_cast<const void*>(&c), sizeof(Container), line_bytes);
+    c.describe_layout(r);
+    return r;
+}
+
+} // namespace spsc::layout
+
+#endif /* SPSC_LAYOUT_HPP_ */
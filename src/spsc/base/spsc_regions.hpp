@@ -120,6 +120,40 @@ struct slot_region {
 template <class ElemPtr, class SizeT>
 using slot_regions = region_pair<slot_region<ElemPtr, SizeT>, SizeT>;
 
+// ---------------------------------------------------------------------------------------------
+// Fixed-stride record region: used by record_fifo.
+// `count` records of `size` bytes each, `stride` bytes apart (stride >= size).
+// ---------------------------------------------------------------------------------------------
+template <class BytePtr, class SizeT>
+struct stride_region {
+    static_assert(std::is_pointer_v<BytePtr>, "spsc::bulk::stride_region expects a byte pointer type");
+
+    BytePtr ptr{nullptr};
+    SizeT   count{0u};
+    SizeT   stride{0u};
+    SizeT   size{0u};
+
+    [[nodiscard]] constexpr bool empty() const noexcept { return count == 0u; }
+
+    [[nodiscard]] BytePtr record(const SizeT i) const noexcept {
+        return ptr + static_cast<std::size_t>(i) * static_cast<std::size_t>(stride);
+    }
+
+#if SPSC_HAS_SPAN
+    using span_value_type = std::remove_pointer_t<BytePtr>;
+    // Whole region as one byte span (records + padding), e.g. for a single memcpy/DMA.
+    [[nodiscard]] std::span<span_value_type> bytes() const noexcept {
+        return {ptr, static_cast<std::size_t>(count) * static_cast<std::size_t>(stride)};
+    }
+    [[nodiscard]] std::span<span_value_type> span(const SizeT i) const noexcept {
+        return {record(i), static_cast<std::size_t>(size)};
+    }
+#endif /* SPSC_HAS_SPAN */
+};
+
+template <class BytePtr, class SizeT>
+using stride_regions = region_pair<stride_region<BytePtr, SizeT>, SizeT>;
+
 } // namespace bulk
 } // namespace spsc
 
@@ -4,7 +4,7 @@
  * Lightweight iteration and snapshot utilities for SPSC ring buffers.
  *
  * This header provides:
- *  - detail::ring_iterator<T, Size, Const>
+ *  - detail::ring_iterator<T, Size, Const>  (random access, wrap-safe indices)
  *  - snapshot_view<T, Size>        (mutable view)
  *  - const_snapshot_view<T, Size>  (read-only view)
  *  - snapshot_traits<T, Size>      (bundles types for containers)
@@ -13,9 +13,9 @@
 #ifndef SPSC_SNAPSHOT_HPP_
 #define SPSC_SNAPSHOT_HPP_
 
-#include <iterator>    // std::bidirectional_iterator_tag
+#include <iterator>    // std::random_access_iterator_tag
 #include <cstddef>     // std::ptrdiff_t
-#include <type_traits> // std::conditional_t, std::enable_if_t, std::is_unsigned_v
+#include <type_traits> // std::conditional_t, std::enable_if_t, std::is_unsigned_v, std::make_signed_t
 #include <memory>      // std::addressof
 #include <new>         // std::launder
 
@@ -34,7 +34,7 @@ public:
     using difference_type   = std::ptrdiff_t;
     using reference         = std::conditional_t<Const, const T&, T&>;
     using pointer           = std::conditional_t<Const, const T*, T*>;
-    using iterator_category = std::bidirectional_iterator_tag;
+    using iterator_category = std::random_access_iterator_tag;
 
     ring_iterator() noexcept = default;
 
@@ -82,6 +82,38 @@ public:
         return tmp;
     }
 
+    // Random access. Indices are free-running counters: a negative n wraps
+    // modulo Size, exactly like head/tail arithmetic.
+    ring_iterator& operator+=(const difference_type n) noexcept {
+        index_ = static_cast<Size>(index_ + static_cast<Size>(n));
+        return *this;
+    }
+
+    ring_iterator& operator-=(const difference_type n) noexcept {
+        index_ = static_cast<Size>(index_ - static_cast<Size>(n));
+        return *this;
+    }
+
+    [[nodiscard]] ring_iterator operator+(const difference_type n) const noexcept {
+        ring_iterator tmp(*this);
+        tmp += n;
+        return tmp;
+    }
+
+    [[nodiscard]] ring_iterator operator-(const difference_type n) const noexcept {
+        ring_iterator tmp(*this);
+        tmp -= n;
+        return tmp;
+    }
+
+    [[nodiscard]] friend ring_iterator operator+(const difference_type n, const ring_iterator& it) noexcept {
+        return it + n;
+    }
+
+    reference operator[](const difference_type n) const noexcept {
+        return *(*this + n);
+    }
+
 
     [[nodiscard]] pointer data() noexcept { return storage_; }
     [[nodiscard]] const T* data() const noexcept { return storage_; }
@@ -114,6 +146,44 @@ inline bool operator!=(const ring_iterator<T, Size, C1>& a,
     return !(a == b);
 }
 
+// Wrap-safe distance: valid while |a - b| fits the signed range of Size
+// (always true inside one snapshot, which never exceeds the capacity).
+template<class T, class Size, bool C1, bool C2>
+inline std::ptrdiff_t operator-(const ring_iterator<T, Size, C1>& a,
+                                const ring_iterator<T, Size, C2>& b) noexcept
+{
+    const Size d = static_cast<Size>(a.index() - b.index());
+    return static_cast<std::ptrdiff_t>(static_cast<std::make_signed_t<Size>>(d));
+}
+
+template<class T, class Size, bool C1, bool C2>
+inline bool operator<(const ring_iterator<T, Size, C1>& a,
+                      const ring_iterator<T, Size, C2>& b) noexcept
+{
+    return (a - b) < 0;
+}
+
+template<class T, class Size, bool C1, bool C2>
+inline bool operator>(const ring_iterator<T, Size, C1>& a,
+                      const ring_iterator<T, Size, C2>& b) noexcept
+{
+    return b < a;
+}
+
+template<class T, class Size, bool C1, bool C2>
+inline bool operator<=(const ring_iterator<T, Size, C1>& a,
+                       const ring_iterator<T, Size, C2>& b) noexcept
+{
+    return !(b < a);
+}
+
+template<class T, class Size, bool C1, bool C2>
+inline bool operator>=(const ring_iterator<T, Size, C1>& a,
+                       const ring_iterator<T, Size, C2>& b) noexcept
+{
+    return !(a < b);
+}
+
 } // namespace detail
 
 // ============================================================================
@@ -159,6 +229,14 @@ public:
         return (used <= cap) ? used : size_type{0};
     }
 
+    // i-th element from the tail (contract: i < size()).
+    typename iterator::reference operator[](const size_type i) noexcept {
+        return begin_[static_cast<typename iterator::difference_type>(i)];
+    }
+    typename const_iterator::reference operator[](const size_type i) const noexcept {
+        return const_iterator(begin_)[static_cast<typename const_iterator::difference_type>(i)];
+    }
+
     [[nodiscard]] size_type tail_index() const noexcept { return begin_.index(); }
     [[nodiscard]] size_type head_index() const noexcept { return end_.index(); }
 
@@ -217,6 +295,11 @@ public:
         return (used <= cap) ? used : size_type{0};
     }
 
+    // i-th element from the tail (contract: i < size()).
+    typename const_iterator::reference operator[](const size_type i) const noexcept {
+        return begin_[static_cast<typename const_iterator::difference_type>(i)];
+    }
+
     [[nodiscard]] size_type tail_index() const noexcept { return begin_.index(); }
     [[nodiscard]] size_type head_index() const noexcept { return end_.index(); }
 
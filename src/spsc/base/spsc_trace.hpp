@@ -0,0 +1,62 @@
+/*
+ * spsc_trace.hpp
+ *
+ * Optional static tracepoints at the slow-path transitions of the rings.
+ *
+ * With -DSPSC_ENABLE_USDT=1 and <sys/sdt.h> available (systemtap-sdt-dev /
+ * systemtap-sdt-devel), every SPSC_TRACE* site becomes a USDT probe of
+ * provider "spsc". An unattached probe is a single NOP in the code plus a
+ * note in .note.stapsdt; a tracer patches it at attach time:
+ *
+ *   bpftrace -e 'usdt:./app:spsc:full { @[arg0] = count(); }' -p <pid>
+ *
+ * Probes (arg0 is always the ring / container address):
+ *   spsc:full           (ring, n, cap)      a try_* producer call found no room for n slots
+ *   spsc:empty          (ring, n, cap)      a try_* consumer call found fewer than n slots
+ *   spsc:refresh_tail   (ring, tail, used)  producer reloaded its shadow of tail
+ *   spsc:refresh_head   (ring, head, avail) consumer reloaded its shadow of head
+ *   spsc:resize         (ring, cap, used)   init()/resize() installed a geometry
+ *   spsc:guard_commit   (ring, n, 0)        RAII guard published / popped n slots
+ *   spsc:guard_cancel   (ring, n, 0)        RAII guard dropped a claim of n slots
+ *
+ * Default (SPSC_ENABLE_USDT=0, or no <sys/sdt.h>): the macros expand to
+ * nothing and the arguments are not evaluated.
+ *
+ * SPSC_TRACE_USER(name, a, b, c) may be defined instead to route the same
+ * sites into a custom sink (tests, in-process counters). It has priority
+ * over USDT. Define it identically in every translation unit (ODR), e.g. in
+ * the SPSC_CONFIG_USER_HEADER of the whole build.
+ */
+
+#ifndef SPSC_TRACE_HPP_
+#define SPSC_TRACE_HPP_
+
+#include "spsc_config.hpp" // SPSC_ENABLE_USDT
+
+#if SPSC_ENABLE_USDT && defined(__has_include)
+#  if __has_include(<sys/sdt.h>)
+#    include <sys/sdt.h>
+#    define SPSC_USDT_ACTIVE 1
+#  endif
+#endif /* SPSC_ENABLE_USDT */
+
+#ifndef SPSC_USDT_ACTIVE
+#  define SPSC_USDT_ACTIVE 0
+#endif /* SPSC_USDT_ACTIVE */
+
+#if defined(SPSC_TRACE_USER)
+#  define SPSC_TRACE(name, a, b, c) SPSC_TRACE_USER(name, a, b, c)
+#elif SPSC_USDT_ACTIVE
+#  define SPSC_TRACE(name, a, b, c) DTRACE_PROBE3(spsc, name, a, b, c)
+#else
+#  define SPSC_TRACE(name, a, b, c) ((void)0)
+#endif /* SPSC_TRACE_USER */
+
+// 1 when SPSC_TRACE sites are compiled in (USDT or user sink).
+#if defined(SPSC_TRACE_USER) || SPSC_USDT_ACTIVE
+#  define SPSC_TRACE_ENABLED 1
+#else
+#  define SPSC_TRACE_ENABLED 0
+#endif
+
+#endif /* SPSC_TRACE_HPP_ */
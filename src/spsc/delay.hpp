@@ -0,0 +1,169 @@
+/*
+ * delay.hpp
+ *
+ * Delay-line / jitter-buffer mode for timestamped elements in fifo / fifo_view / queue.
+ *
+ * Model (same stamping as ttl.hpp):
+ * - The producer stamps each element before publishing it (ttl::stamped<T, Stamp>,
+ *   or any type + Key functor). The stamp is either the capture time or the
+ *   due time itself.
+ * - The consumer owns a playout<Stamp, Duration> object holding the playout
+ *   delay. An element is due when key(e) + delay <= now.
+ * - try_front(ring, now) only returns the front element once it is due; the
+ *   element after it is never released before it (FIFO order is kept).
+ *
+ * Instead of polling, the consumer can ask next_due() for the due time of the
+ * front element and sleep until then; wait_front() does this for
+ * std::chrono stamps.
+ *
+ * Contract:
+ * - Consumer-side only (same thread that calls front()/pop()).
+ * - Stamps must be non-decreasing in publish order (pop_due() relies on it).
+ * - Unsigned stamps must not wrap within the lifetime of the ring.
+ */
+
+#ifndef SPSC_DELAY_HPP_
+#define SPSC_DELAY_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <thread>      // std::this_thread::sleep_until
+#include <type_traits>
+
+#include "base/spsc_regions.hpp" // ::spsc::unsafe
+#include "base/spsc_tools.hpp"   // RB_FORCEINLINE
+#include "ttl.hpp"               // ::spsc::ttl::stamped, ::spsc::ttl::stamp_of, ::spsc::ttl::count_prefix
+
+namespace spsc::delay {
+
+namespace detail {
+
+template <class T>
+struct is_chrono_duration : std::false_type {};
+
+template <class Rep, class Period>
+struct is_chrono_duration<std::chrono::duration<Rep, Period>> : std::true_type {};
+
+} // namespace detail
+
+/* =======================================================================
+ * playout<Stamp, Duration, Key>
+ *
+ * Consumer-owned fixed playout delay.
+ * Stamp    : stamp type (integral ticks or std::chrono::duration since epoch).
+ * Duration : delay type (defaults to Stamp). 0 -> stamps are due times.
+ * Key      : extracts the stamp from a ring element.
+ * ======================================================================= */
+template <class Stamp = std::uint64_t, class Duration = Stamp, class Key = ::spsc::ttl::stamp_of>
+class playout {
+public:
+    using stamp_type    = Stamp;
+    using duration_type = Duration;
+    using key_type      = Key;
+
+    playout() = default;
+    explicit playout(const Duration delay, Key key = {}) noexcept : delay_(delay), key_(key) {}
+
+    [[nodiscard]] Duration delay() const noexcept { return delay_; }
+    void set_delay(const Duration delay) noexcept { delay_ = delay; }
+
+    template <class E>
+    [[nodiscard]] RB_FORCEINLINE Stamp due_of(const E &e) const noexcept {
+        return static_cast<Stamp>(key_(e) + delay_);
+    }
+
+    template <class E>
+    [[nodiscard]] RB_FORCEINLINE bool is_due(const E &e, const Stamp now) const noexcept {
+        return !(now < due_of(e));
+    }
+
+    // Front element if it is due at `now`, else nullptr (also when empty).
+    template <class Ring>
+    [[nodiscard]] RB_FORCEINLINE auto try_front(Ring &q, const Stamp now) const noexcept
+        -> decltype(q.try_front())
+    {
+        auto *p = q.try_front();
+        return (p && is_due(*p, now)) ? p : nullptr;
+    }
+
+    // Due time of the front element. Returns false if the ring is empty.
+    template <class Ring>
+    [[nodiscard]] bool next_due(Ring &q, Stamp &due) const noexcept {
+        const auto *p = q.try_front();
+        if (!p) {
+            return false;
+        }
+        due = due_of(*p);
+        return true;
+    }
+
+    // Number of due elements at the front of the readable range (no release).
+    template <class Ring>
+    [[nodiscard]] auto count_due(Ring &q, const Stamp now) const noexcept
+        -> typename Ring::size_type
+    {
+        const auto r = q.claim_read(::spsc::unsafe);
+        return ::spsc::ttl::count_prefix(r, [&](const auto &e) noexcept { return is_due(e, now); });
+    }
+
+    // Releases up to max due elements with one pop(n) (drop / after bulk read).
+    // Returns the number released.
+    template <class Ring>
+    auto pop_due(Ring &q, const Stamp now, const typename Ring::size_type max)
+        const noexcept(noexcept(q.pop(typename Ring::size_type{1u})))
+        -> typename Ring::size_type
+    {
+        auto n = count_due(q, now);
+        if (n > max) {
+            n = max;
+        }
+        if (n != 0u) {
+            q.pop(n);
+        }
+        return n;
+    }
+
+    /* Block until the front element is due or `deadline` passes.
+     * Stamp must be Clock::duration (time since Clock's epoch).
+     * Sleeps until the exact due time when an element is queued; while the
+     * ring is empty it re-checks every `idle` (a producer cannot wake us).
+     * Returns the due front element, or nullptr at the deadline.
+     */
+    template <class Clock = std::chrono::steady_clock, class Ring>
+    auto wait_front(Ring &q,
+                    const typename Clock::time_point deadline,
+                    const typename Clock::duration idle = std::chrono::microseconds(100)) const
+        -> decltype(q.try_front())
+    {
+        static_assert(detail::is_chrono_duration<Stamp>::value,
+                      "[spsc::delay]: wait_front() needs a std::chrono::duration Stamp");
+        using time_point = typename Clock::time_point;
+
+        for (;;) {
+            const time_point now = Clock::now();
+            const Stamp      t   = std::chrono::duration_cast<Stamp>(now.time_since_epoch());
+            if (auto *p = try_front(q, t)) {
+                return p;
+            }
+            if (!(now < deadline)) {
+                return nullptr;
+            }
+            Stamp due{};
+            time_point wake = (next_due(q, due))
+                                  ? time_point(std::chrono::ceil<typename Clock::duration>(due))
+                                  : now + idle;
+            if (deadline < wake) {
+                wake = deadline;
+            }
+            std::this_thread::sleep_until(wake);
+        }
+    }
+
+private:
+    Duration delay_{};
+    Key      key_{};
+};
+
+} // namespace spsc::delay
+
+#endif /* SPSC_DELAY_HPP_ */
@@ -0,0 +1,245 @@
+/*
+ * duplex.hpp
+ *
+ * Request/response channel with in-slot replies (one ring for both directions).
+ *
+ * Two queues (one per direction) cost four shared indices and two payload
+ * areas per call. duplex keeps one ring of cache-line slots; every slot
+ * carries its own state word, and the reply is constructed in the bytes that
+ * held the request:
+ *
+ *   caller :  try_call(args...)  -> construct Req, state = REQUEST   (release)
+ *   callee :  try_request()      -> state == REQUEST                 (acquire)
+ *             reply(args...)     -> ~Req, construct Resp, state = RESPONSE (release)
+ *   caller :  try_result(t)      -> state == RESPONSE                (acquire)
+ *             release(t)         -> ~Resp, state = FREE
+ *
+ * No index is shared: the caller's head and the callee's tail are private,
+ * so a round trip moves the slot's cache line once each way.
+ *
+ * Roles:
+ * - Caller side (one thread): try_call(), call(), try_result(), release().
+ * - Callee side (one thread): try_request(), reply(), serve_one(), serve().
+ *
+ * Several calls may be in flight (up to Capacity); the callee answers in
+ * order, the caller may release tickets in any order. A slot is reused only
+ * after its ticket has been released.
+ */
+
+#ifndef SPSC_DUPLEX_HPP_
+#define SPSC_DUPLEX_HPP_
+
+#include <algorithm>   // std::max
+#include <atomic>
+#include <cstdint>
+#include <new>         // placement new, std::launder
+#include <thread>      // std::this_thread::yield
+#include <type_traits>
+#include <utility>     // std::forward, std::move
+
+#include "base/spsc_cacheline.hpp"      // SPSC_ALIGNED, SPSC_CACHELINE_BYTES
+#include "base/spsc_capacity_ctrl.hpp"  // ::spsc::cap::rb_is_pow2
+#include "base/spsc_object.hpp"         // ::spsc::detail::destroy_at
+#include "base/spsc_tools.hpp"          // RB_FORCEINLINE, RB_LIKELY, RB_UNLIKELY
+
+namespace spsc {
+
+/* =======================================================================
+ * duplex<Req, Resp, Capacity>
+ *
+ * Req, Resp : payload types; both must be nothrow destructible.
+ *             sizeof(Req), sizeof(Resp) <= SPSC_CACHELINE_BYTES - 8 keeps a
+ *             slot (state + payload) on a single cache line.
+ * Capacity  : number of slots = max calls in flight (static, pow2, >= 2).
+ * ======================================================================= */
+template <class Req, class Resp, reg Capacity = 16u>
+class duplex {
+    static_assert(Capacity >= 2u && ::spsc::cap::rb_is_pow2(Capacity),
+                  "[spsc::duplex]: Capacity must be a power of two >= 2");
+    static_assert(std::is_nothrow_destructible_v<Req> && std::is_nothrow_destructible_v<Resp>,
+                  "[spsc::duplex]: Req and Resp must be nothrow destructible");
+
+    enum : std::uint32_t { kFree = 0u, kRequest = 1u, kResponse = 2u };
+
+    static constexpr reg kPayloadBytes = std::max(sizeof(Req), sizeof(Resp));
+    static constexpr reg kPayloadAlign = std::max(alignof(Req), alignof(Resp));
+
+    struct SPSC_ALIGNED(SPSC_CACHELINE_BYTES) slot {
+        std::atomic<std::uint32_t> state{kFree};
+        alignas(kPayloadAlign) unsigned char payload[kPayloadBytes];
+
+        RB_FORCEINLINE Req *req() noexcept { return std::launder(reinterpret_cast<Req *>(payload)); }
+        RB_FORCEINLINE Resp *resp() noexcept { return std::launder(reinterpret_cast<Resp *>(payload)); }
+    };
+
+public:
+    // ------------------------------------------------------------------------------------------
+    // Type Definitions
+    // ------------------------------------------------------------------------------------------
+    using request_type  = Req;
+    using response_type = Resp;
+    using size_type     = reg;
+
+    static constexpr size_type kCapacity = Capacity;
+
+    /* Handle of one call in flight (caller side). Default: invalid. */
+    class ticket {
+    public:
+        ticket() noexcept = default;
+        [[nodiscard]] explicit operator bool() const noexcept { return s_ != nullptr; }
+
+    private:
+        friend class duplex;
+        explicit ticket(slot *s) noexcept : s_(s) {}
+        slot *s_{nullptr};
+    };
+
+    duplex() = default;
+
+    duplex(const duplex &) = delete;
+    duplex &operator=(const duplex &) = delete;
+    duplex(duplex &&) = delete;
+    duplex &operator=(duplex &&) = delete;
+
+    /* Destroys whatever payload is still alive (no thread may use the channel). */
+    ~duplex() {
+        for (slot &s : slots_) {
+            switch (s.state.load(std::memory_order_acquire)) {
+            case kRequest:  ::spsc::detail::destroy_at(s.req()); break;
+            case kResponse: ::spsc::detail::destroy_at(s.resp()); break;
+            default: break;
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------------------------
+    // Caller side
+    // ------------------------------------------------------------------------------------------
+
+    /* Construct a request in the next slot and publish it.
+     * Returns an invalid ticket if all Capacity slots are still in flight.
+     */
+    template <class... Args>
+    [[nodiscard]] ticket try_call(Args &&...args) noexcept(std::is_nothrow_constructible_v<Req, Args &&...>) {
+        slot &s = slots_[caller_.head & kMask];
+        if (RB_UNLIKELY(s.state.load(std::memory_order_acquire) != kFree)) {
+            return ticket{};
+        }
+        ::new (static_cast<void *>(s.payload)) Req(std::forward<Args>(args)...);
+        s.state.store(kRequest, std::memory_order_release);
+        ++caller_.head;
+        ++caller_.in_flight;
+        return ticket{&s};
+    }
+
+    /* Response of t, or nullptr while the callee has not answered yet. */
+    [[nodiscard]] RB_FORCEINLINE Resp *try_result(const ticket &t) noexcept {
+        SPSC_ASSERT(t);
+        return (t.s_->state.load(std::memory_order_acquire) == kResponse) ? t.s_->resp() : nullptr;
+    }
+
+    /* Destroy the response of t and free its slot; t becomes invalid.
+     * Precondition: try_result(t) != nullptr.
+     */
+    void release(ticket &t) noexcept {
+        SPSC_ASSERT(t && t.s_->state.load(std::memory_order_acquire) == kResponse);
+        ::spsc::detail::destroy_at(t.s_->resp());
+        t.s_->state.store(kFree, std::memory_order_relaxed);
+        t.s_ = nullptr;
+        --caller_.in_flight;
+    }
+
+    /* Synchronous call: publish, spin (yielding) for the answer, move it into out.
+     * Returns false (nothing sent) if no slot is free.
+     */
+    template <class... Args>
+    bool call(Resp &out, Args &&...args) noexcept(std::is_nothrow_constructible_v<Req, Args &&...> &&
+                                                  std::is_nothrow_move_assignable_v<Resp>) {
+        ticket t = try_call(std::forward<Args>(args)...);
+        if (RB_UNLIKELY(!t)) {
+            return false;
+        }
+        unsigned spins = 0u;
+        Resp *r = nullptr;
+        while (!(r = try_result(t))) {
+            if (++spins > 64u) {
+                std::this_thread::yield();
+            }
+        }
+        out = std::move(*r);
+        release(t);
+        return true;
+    }
+
+    /* Calls published and not yet released (caller-owned). */
+    [[nodiscard]] size_type in_flight() const noexcept { return caller_.in_flight; }
+
+    // ------------------------------------------------------------------------------------------
+    // Callee side
+    // ------------------------------------------------------------------------------------------
+
+    /* Next unanswered request, or nullptr. */
+    [[nodiscard]] RB_FORCEINLINE Req *try_request() noexcept {
+        slot &s = slots_[callee_.tail & kMask];
+        return (s.state.load(std::memory_order_acquire) == kRequest) ? s.req() : nullptr;
+    }
+
+    /* Replace the current request (the one try_request() returned) by a response
+     * constructed from args, and hand the slot back to the caller.
+     * args must not refer into the request: it is destroyed first.
+     */
+    template <class... Args>
+    void reply(Args &&...args) noexcept(std::is_nothrow_constructible_v<Resp, Args &&...>) {
+        slot &s = slots_[callee_.tail & kMask];
+        SPSC_ASSERT(s.state.load(std::memory_order_relaxed) == kRequest);
+        ::spsc::detail::destroy_at(s.req());
+        ::new (static_cast<void *>(s.payload)) Resp(std::forward<Args>(args)...);
+        s.state.store(kResponse, std::memory_order_release);
+        ++callee_.tail;
+    }
+
+    /* Answer one request with f(Req&) -> Resp. Returns false if none is pending. */
+    template <class F>
+    bool serve_one(F &&f) {
+        Req *r = try_request();
+        if (!r) {
+            return false;
+        }
+        Resp tmp = f(*r); // materialized first: the request's bytes are reused
+        reply(std::move(tmp));
+        return true;
+    }
+
+    /* serve_one() up to max times; returns the number answered. */
+    template <class F>
+    size_type serve(F &&f, const size_type max = Capacity) {
+        size_type n = 0u;
+        while (n < max && serve_one(f)) {
+            ++n;
+        }
+        return n;
+    }
+
+    /* Requests answered so far (callee-owned). */
+    [[nodiscard]] size_type served() const noexcept { return callee_.tail; }
+
+private:
+    static constexpr size_type kMask = Capacity - 1u;
+
+    slot slots_[Capacity]{};
+
+    // Caller-owned.
+    struct SPSC_ALIGNED(SPSC_CACHELINE_BYTES) caller_state {
+        size_type head{0u};
+        size_type in_flight{0u};
+    } caller_{};
+
+    // Callee-owned.
+    struct SPSC_ALIGNED(SPSC_CACHELINE_BYTES) callee_state {
+        size_type tail{0u};
+    } callee_{};
+};
+
+} // namespace spsc
+
+#endif /* SPSC_DUPLEX_HPP_ */
@@ -0,0 +1,467 @@
+/*
+ * executor.hpp
+ *
+ * Small work-stealing task executor built only from SPSC rings.
+ *
+ * Topology (S submitters, W workers):
+ * - submit lanes : S x W  spsc::queue<Task>         (submitter s -> worker w)
+ * - request lanes: W x W  spsc::queue<size_type>    (thief t     -> victim v)
+ * - reply lanes  : W x W  spsc::queue<steal_batch>  (victim v    -> thief t)
+ * - backlog      : one private ring per worker (touched by its owner only)
+ *
+ * Every shared ring has exactly one producer thread and one consumer thread,
+ * so the hot path has no CAS loops, no locks and no MPMC contention.
+ *
+ * Work stealing ("private deques"):
+ * - A worker drains its submit lanes into its private backlog and runs tasks
+ *   from there.
+ * - An idle worker posts a steal request to one victim and keeps polling its
+ *   own lanes while waiting for the reply.
+ * - Victims service requests between tasks and answer every request, either
+ *   with up to half of their backlog or with an empty batch.
+ * - A thief has at most one outstanding request, so request/reply lanes of
+ *   capacity 2 can never overflow.
+ *
+ * Contract:
+ * - A submitter index must be used by one thread at a time.
+ * - Tasks must not throw (an escaping exception terminates the program).
+ * - stop() must not race with try_submit(). After stop() returns, every
+ *   accepted task has been executed exactly once.
+ */
+
+#ifndef SPSC_EXECUTOR_HPP_
+#define SPSC_EXECUTOR_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>      // std::unique_ptr
+#include <new>         // std::nothrow
+#include <thread>
+#include <type_traits>
+#include <utility>     // std::move
+
+#include "base/spsc_cacheline.hpp" // SPSC_ALIGNED, SPSC_CACHELINE_BYTES
+#include "base/spsc_policy.hpp"    // ::spsc::policy::CA
+#include "base/spsc_tools.hpp"     // RB_FORCEINLINE, RB_LIKELY, RB_UNLIKELY
+#include "queue.hpp"               // ::spsc::queue
+
+namespace spsc {
+
+/* =======================================================================
+ * task
+ *
+ * Default executor payload: plain function pointer + opaque context.
+ * Trivially copyable, so it moves through the rings as two words.
+ * ======================================================================= */
+struct task {
+    void (*fn)(void *) noexcept = nullptr;
+    void *ctx = nullptr;
+
+    RB_FORCEINLINE void operator()() const noexcept { fn(ctx); }
+};
+
+/* =======================================================================
+ * executor<Task, LaneCapacity, BacklogCapacity, StealBatch, Policy>
+ *
+ * Task            : default-constructible, nothrow-movable, invocable as t().
+ * LaneCapacity    : capacity of every submitter -> worker lane (pow2).
+ * BacklogCapacity : capacity of each worker's private backlog (pow2).
+ * StealBatch      : max tasks moved by a single steal reply.
+ * Policy          : counter policy of the shared lanes (must be atomic).
+ * ======================================================================= */
+template <class Task = ::spsc::task,
+         reg LaneCapacity = 256u,
+         reg BacklogCapacity = 1024u,
+         reg StealBatch = 32u,
+         typename Policy = ::spsc::policy::CA<>>
+class executor {
+public:
+    // ------------------------------------------------------------------------------------------
+    // Type Definitions
+    // ------------------------------------------------------------------------------------------
+    using value_type = Task;
+    using size_type  = reg;
+    using policy_type = Policy;
+
+    struct steal_batch {
+        size_type count{0u};
+        value_type tasks[StealBatch]{};
+    };
+
+    using submit_lane  = ::spsc::queue<value_type, LaneCapacity, Policy>;
+    using request_lane = ::spsc::queue<size_type, 2u, Policy>;
+    using reply_lane   = ::spsc::queue<steal_batch, 2u, Policy>;
+    using backlog_ring = ::spsc::queue<value_type, BacklogCapacity, ::spsc::policy::P>;
+
+    static constexpr size_type npos = static_cast<size_type>(~size_type(0));
+
+    // ------------------------------------------------------------------------------------------
+    // Static Assertions
+    // ------------------------------------------------------------------------------------------
+    static_assert(std::is_default_constructible_v<value_type>,
+                  "[spsc::executor]: Task must be default-constructible (steal batches).");
+    static_assert(std::is_nothrow_move_constructible_v<value_type> &&
+                      std::is_nothrow_move_assignable_v<value_type>,
+                  "[spsc::executor]: Task must be nothrow-movable.");
+    static_assert(std::is_invocable_v<value_type &>,
+                  "[spsc::executor]: Task must be invocable as t().");
+    static_assert(Policy::counter_type::is_atomic,
+                  "[spsc::executor]: lanes cross threads, Policy must be atomic-backed.");
+    static_assert(StealBatch >= 1u,
+                  "[spsc::executor]: StealBatch must be >= 1.");
+    static_assert(StealBatch <= BacklogCapacity,
+                  "[spsc::executor]: StealBatch must fit into the backlog.");
+
+    // ------------------------------------------------------------------------------------------
+    // Constructors / Destructor
+    // ------------------------------------------------------------------------------------------
+    executor() noexcept = default;
+
+    executor(const size_type workers, const size_type submitters = 1u) {
+        (void)start(workers, submitters);
+    }
+
+    executor(const executor &) = delete;
+    executor &operator=(const executor &) = delete;
+    executor(executor &&) = delete;
+    executor &operator=(executor &&) = delete;
+
+    ~executor() { stop(); }
+
+    // ------------------------------------------------------------------------------------------
+    // Lifecycle
+    // ------------------------------------------------------------------------------------------
+
+    /* Allocate all lanes and spawn the workers.
+     * Returns false on invalid arguments, allocation failure or when already
+     * running. All allocations happen here, never on the task path.
+     */
+    [[nodiscard]] bool start(const size_type workers, const size_type submitters = 1u) {
+        if (RB_UNLIKELY(running_ || workers == 0u || submitters == 0u)) {
+            return false;
+        }
+
+        const size_type nw = workers;
+        const size_type ns = submitters;
+
+        std::unique_ptr<submit_lane[]>  submit(new (std::nothrow) submit_lane[ns * nw]);
+        std::unique_ptr<request_lane[]> request(new (std::nothrow) request_lane[nw * nw]);
+        std::unique_ptr<reply_lane[]>   reply(new (std::nothrow) reply_lane[nw * nw]);
+        std::unique_ptr<worker_state[]> state(new (std::nothrow) worker_state[nw]);
+        std::unique_ptr<submitter_state[]> subs(new (std::nothrow) submitter_state[ns]);
+
+        if (RB_UNLIKELY(!submit || !request || !reply || !state || !subs)) {
+            return false;
+        }
+        for (size_type i = 0; i < ns * nw; ++i) {
+            if (RB_UNLIKELY(!submit[i].is_valid())) { return false; }
+        }
+        for (size_type i = 0; i < nw * nw; ++i) {
+            if (RB_UNLIKELY(!request[i].is_valid() || !reply[i].is_valid())) { return false; }
+        }
+        for (size_type i = 0; i < nw; ++i) {
+            if (RB_UNLIKELY(!state[i].backlog.is_valid())) { return false; }
+            state[i].next_victim = (i + 1u) % nw;
+        }
+
+        std::unique_ptr<std::thread[]> threads(new (std::nothrow) std::thread[nw]);
+        if (RB_UNLIKELY(!threads)) {
+            return false;
+        }
+
+        workers_    = nw;
+        submitters_ = ns;
+        submit_     = std::move(submit);
+        request_    = std::move(request);
+        reply_      = std::move(reply);
+        state_      = std::move(state);
+        subs_       = std::move(subs);
+        threads_    = std::move(threads);
+
+        stop_.store(false, std::memory_order_relaxed);
+        running_ = true;
+
+        for (size_type w = 0; w < nw; ++w) {
+            threads_[w] = std::thread([this, w]() noexcept { worker_loop_(w); });
+        }
+        return true;
+    }
+
+    /* Join all workers, then run every task still parked in a ring on the
+     * calling thread. Idempotent.
+     */
+    void stop() noexcept {
+        if (!running_) {
+            return;
+        }
+
+        stop_.store(true, std::memory_order_release);
+        for (size_type w = 0; w < workers_; ++w) {
+            if (threads_[w].joinable()) {
+                threads_[w].join();
+            }
+        }
+
+        // join() orders every worker write before us: rings are quiescent now.
+        for (size_type w = 0; w < workers_; ++w) {
+            worker_state &st = state_[w];
+            for (size_type t = 0; t < workers_; ++t) {
+                reply_lane &rl = reply_[t * workers_ + w];
+                while (steal_batch *b = rl.try_front()) {
+                    for (size_type i = 0; i < b->count; ++i) {
+                        run_(st, b->tasks[i]);
+                    }
+                    rl.pop();
+                }
+                request_[w * workers_ + t].consume_all();
+            }
+            for (size_type s = 0; s < submitters_; ++s) {
+                submit_lane &sl = submit_[s * workers_ + w];
+                while (value_type *p = sl.try_front()) {
+                    run_(st, *p);
+                    sl.pop();
+                }
+            }
+            while (value_type *p = st.backlog.try_front()) {
+                run_(st, *p);
+                st.backlog.pop();
+            }
+        }
+
+        running_ = false;
+    }
+
+    // ------------------------------------------------------------------------------------------
+    // Submission (submitter thread)
+    // ------------------------------------------------------------------------------------------
+
+    /* Round-robin over workers starting after the last accepted lane.
+     * Returns false only when every lane of this submitter is full.
+     */
+    template <class U, typename = std::enable_if_t<
+                          std::is_constructible_v<value_type, U &&>>>
+    [[nodiscard]] bool try_submit(const size_type submitter, U &&t) {
+        SPSC_ASSERT(running_ && submitter < submitters_);
+
+        submitter_state &ss = subs_[submitter];
+        size_type w = ss.cursor;
+        for (size_type i = 0; i < workers_; ++i) {
+            submit_lane &lane = submit_[submitter * workers_ + w];
+            if (RB_LIKELY(lane.try_push(std::forward<U>(t)))) {
+                ss.cursor = (w + 1u == workers_) ? 0u : w + 1u;
+                return true;
+            }
+            w = (w + 1u == workers_) ? 0u : w + 1u;
+        }
+        return false;
+    }
+
+    /* Pin a task to one worker (others may still steal it from there). */
+    template <class U, typename = std::enable_if_t<
+                          std::is_constructible_v<value_type, U &&>>>
+    [[nodiscard]] bool try_submit_to(const size_type submitter, const size_type worker, U &&t) {
+        SPSC_ASSERT(running_ && submitter < submitters_ && worker < workers_);
+        return submit_[submitter * workers_ + worker].try_push(std::forward<U>(t));
+    }
+
+    // ------------------------------------------------------------------------------------------
+    // Observers (any thread, relaxed)
+    // ------------------------------------------------------------------------------------------
+    [[nodiscard]] bool running() const noexcept { return running_; }
+    [[nodiscard]] size_type workers() const noexcept { return workers_; }
+    [[nodiscard]] size_type submitters() const noexcept { return submitters_; }
+
+    [[nodiscard]] size_type executed(const size_type worker) const noexcept {
+        SPSC_ASSERT(worker < workers_);
+        return state_[worker].executed.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] size_type stolen(const size_type worker) const noexcept {
+        SPSC_ASSERT(worker < workers_);
+        return state_[worker].stolen.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] size_type executed() const noexcept {
+        size_type n = 0u;
+        for (size_type w = 0; w < workers_; ++w) {
+            n += executed(w);
+        }
+        return n;
+    }
+
+private:
+    // Per-worker state. Only the owning worker writes it (except the relaxed
+    // statistics read by observers), so each block gets its own cache line.
+    struct SPSC_ALIGNED(SPSC_CACHELINE_BYTES) worker_state {
+        backlog_ring backlog{};
+        size_type next_victim{0u};
+        size_type pending_victim{npos};
+        std::atomic<size_type> executed{0u};
+        std::atomic<size_type> stolen{0u};
+    };
+
+    struct SPSC_ALIGNED(SPSC_CACHELINE_BYTES) submitter_state {
+        size_type cursor{0u};
+    };
+
+    static RB_FORCEINLINE void run_(worker_state &st, value_type &t) noexcept {
+        t();
+        st.executed.store(st.executed.load(std::memory_order_relaxed) + 1u,
+                          std::memory_order_relaxed);
+    }
+
+    // Move submitted tasks into the private backlog (bounded by its free space).
+    // While a steal request is outstanding, StealBatch slots stay reserved for
+    // the reply, so collect_reply_() always has room for it.
+    bool intake_(const size_type w, worker_state &st) noexcept {
+        const size_type reserve = (st.pending_victim != npos) ? size_type(StealBatch) : 0u;
+        bool any = false;
+        for (size_type s = 0; s < submitters_; ++s) {
+            submit_lane &lane = submit_[s * workers_ + w];
+            const size_type avail = st.backlog.free();
+            size_type room = (avail > reserve) ? (avail - reserve) : 0u;
+            while (room != 0u) {
+                value_type *p = lane.try_front();
+                if (!p) {
+                    break;
+                }
+                st.backlog.push(std::move(*p));
+                lane.pop();
+                --room;
+                any = true;
+            }
+        }
+        return any;
+    }
+
+    // Answer every pending steal request aimed at this worker.
+    void serve_requests_(const size_type w, worker_state &st) noexcept {
+        for (size_type t = 0; t < workers_; ++t) {
+            if (t == w) {
+                continue;
+            }
+            request_lane &req = request_[t * workers_ + w];
+            const size_type *want = req.try_front();
+            if (RB_LIKELY(!want)) {
+                continue;
+            }
+
+            reply_lane &rep = reply_[w * workers_ + t];
+            steal_batch *b = rep.try_claim();
+            SPSC_ASSERT(b != nullptr); // one outstanding request per thief
+            if (RB_UNLIKELY(!b)) {
+                continue; // keep the request; answer on the next pass
+            }
+            b = ::new (static_cast<void *>(b)) steal_batch{};
+
+            // Give away up to half of the backlog, keep at least one task.
+            size_type give = st.backlog.size() / 2u;
+            give = (give > *want) ? *want : give;
+            for (size_type i = 0; i < give; ++i) {
+                b->tasks[i] = std::move(st.backlog.front());
+                st.backlog.pop();
+            }
+            b->count = give;
+
+            rep.publish();
+            req.pop();
+        }
+    }
+
+    // Collect the reply to our outstanding steal request (if any arrived).
+    bool collect_reply_(const size_type w, worker_state &st) noexcept {
+        if (st.pending_victim == npos) {
+            return false;
+        }
+        reply_lane &rep = reply_[st.pending_victim * workers_ + w];
+        steal_batch *b = rep.try_front();
+        if (!b) {
+            return false;
+        }
+        SPSC_ASSERT(b->count <= st.backlog.free()); // reserved by intake_()
+        for (size_type i = 0; i < b->count; ++i) {
+            st.backlog.push(std::move(b->tasks[i]));
+        }
+        const size_type got = b->count;
+        rep.pop();
+        st.pending_victim = npos;
+
+        if (got != 0u) {
+            st.stolen.store(st.stolen.load(std::memory_order_relaxed) + got,
+                            std::memory_order_relaxed);
+        }
+        return got != 0u;
+    }
+
+    void post_request_(const size_type w, worker_state &st) noexcept {
+        if (workers_ < 2u || st.pending_victim != npos) {
+            return;
+        }
+        const size_type v = st.next_victim;
+        size_type nv = v + 1u;
+        nv = (nv == workers_) ? 0u : nv;
+        nv = (nv == w) ? ((nv + 1u == workers_) ? 0u : nv + 1u) : nv;
+        st.next_victim = nv;
+
+        // intake_() keeps StealBatch backlog slots free until the reply is collected.
+        if (request_[w * workers_ + v].try_push(size_type(StealBatch))) {
+            st.pending_victim = v;
+        }
+    }
+
+    void worker_loop_(const size_type w) noexcept {
+        worker_state &st = state_[w];
+        unsigned idle = 0u;
+
+        for (;;) {
+            bool progress = intake_(w, st);
+            serve_requests_(w, st);
+            progress |= collect_reply_(w, st);
+
+            // Run a short burst, servicing thieves in between tasks.
+            for (size_type burst = 0; burst < StealBatch; ++burst) {
+                value_type *p = st.backlog.try_front();
+                if (!p) {
+                    break;
+                }
+                value_type t(std::move(*p));
+                st.backlog.pop();
+                run_(st, t);
+                progress = true;
+                serve_requests_(w, st);
+            }
+
+            if (progress) {
+                idle = 0u;
+                continue;
+            }
+
+            if (RB_UNLIKELY(stop_.load(std::memory_order_acquire))) {
+                // Leftovers (late submissions, in-flight replies) are drained by stop().
+                return;
+            }
+
+            post_request_(w, st);
+            if (++idle > 64u) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    size_type workers_{0u};
+    size_type submitters_{0u};
+    bool running_{false};
+
+    std::unique_ptr<submit_lane[]>     submit_{};
+    std::unique_ptr<request_lane[]>    request_{};
+    std::unique_ptr<reply_lane[]>      reply_{};
+    std::unique_ptr<worker_state[]>    state_{};
+    std::unique_ptr<submitter_state[]> subs_{};
+    std::unique_ptr<std::thread[]>     threads_{};
+
+    alignas(SPSC_CACHELINE_BYTES) std::atomic<bool> stop_{false};
+};
+
+} // namespace spsc
+
+#endif /* SPSC_EXECUTOR_HPP_ */
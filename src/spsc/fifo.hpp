@@ -37,9 +37,11 @@
 // Base and utility includes
 #include "base/SPSCbase.hpp"      // ::spsc::SPSCbase<Capacity, Policy>, reg
 #include "base/spsc_alloc.hpp"    // ::spsc::alloc::default_alloc
+#include "base/spsc_layout.hpp"   // ::spsc::layout::report
 #include "base/spsc_snapshot.hpp" // ::spsc::snapshot_view, ::spsc::snapshot_traits
 #include "base/spsc_regions.hpp"  // ::spsc::bulk::region, ::spsc::bulk::regions
 #include "base/spsc_tools.hpp"    // RB_FORCEINLINE, RB_UNLIKELY, macros
+#include "base/spsc_trace.hpp"    // SPSC_TRACE (rejection / guard probes)
 
 namespace spsc {
 
@@ -345,6 +347,14 @@ public:
 
     [[nodiscard]] allocator_type get_allocator() const noexcept { return {}; }
 
+    // Cache-line layout of this instance (see base/spsc_layout.hpp).
+    // Inline storage (static capacity) is written by the producer.
+    void describe_layout(::spsc::layout::report& r) const noexcept {
+        Base::describe_layout(r);
+        r.add("storage", &storage_, sizeof(storage_),
+              kDynamic ? ::spsc::layout::writer::setup : ::spsc::layout::writer::producer);
+    }
+
     // ------------------------------------------------------------------------------------------
     // Iteration API (Consumer Side Only)
     // ------------------------------------------------------------------------------------------
@@ -459,6 +469,26 @@ public:
         return const_snapshot(it(data(), m, t), it(data(), m, h));
     }
 
+    // ------------------------------------------------------------------------------------------
+    // Observer (third thread, read-only)
+    // ------------------------------------------------------------------------------------------
+
+    /* Copy up to max unread elements (oldest first) into dst without consuming.
+     * Callable from a thread that is neither producer nor consumer: only head/tail
+     * are loaded, no index or shadow is written. The copy is retried if the consumer
+     * moved during it (copied slots may have been reused by the producer).
+     * Returns the number of elements copied; 0 if empty or every attempt
+     * (SPSC_OBSERVER_RETRIES) raced. Requires trivially copyable T and an atomic
+     * policy (A<> / CA<>): under P / V the observer's loads and copy are a data
+     * race, so the call does not compile.
+     */
+    [[nodiscard]] size_type try_copy_out(value_type *dst, const size_type max) const noexcept {
+        if (RB_UNLIKELY(!is_valid())) {
+            return 0u;
+        }
+        return static_cast<size_type>(Base::observe_copy(data(), dst, max));
+    }
+
     template <class Snap> void consume(const Snap &s) noexcept {
         SPSC_ASSERT(is_valid());
         SPSC_ASSERT(s.begin().data() == data());
@@ -665,6 +695,7 @@ public:
     [[nodiscard]] RB_FORCEINLINE bool
     try_push(U &&v) noexcept(std::is_nothrow_assignable_v<reference, U &&>) {
         if (RB_UNLIKELY(full())) {
+            SPSC_TRACE(full, this, size_type(1u), capacity());
             return false;
         }
         storage_[Base::write_index()] = std::forward<U>(v);
@@ -695,6 +726,7 @@ public:
         std::is_nothrow_constructible_v<value_type, Args &&...> &&
         std::is_nothrow_assignable_v<reference, value_type>) {
         if (RB_UNLIKELY(full())) {
+            SPSC_TRACE(full, this, size_type(1u), capacity());
             return nullptr;
         }
         const size_type wi = Base::write_index();
@@ -711,6 +743,7 @@ public:
 
     [[nodiscard]] RB_FORCEINLINE pointer try_claim() noexcept {
         if (RB_UNLIKELY(full())) {
+            SPSC_TRACE(full, this, size_type(1u), capacity());
             return nullptr;
         }
         return &storage_[Base::write_index()];
@@ -723,6 +756,7 @@ public:
 
     [[nodiscard]] RB_FORCEINLINE bool try_publish() noexcept {
         if (RB_UNLIKELY(full())) {
+            SPSC_TRACE(full, this, size_type(1u), capacity());
             return false;
         }
         Base::increment_head();
@@ -736,6 +770,7 @@ public:
 
     [[nodiscard]] RB_FORCEINLINE bool try_publish(const size_type n) noexcept {
         if (RB_UNLIKELY(!can_write(n))) {
+            SPSC_TRACE(full, this, n, capacity());
             return false;
         }
         Base::advance_head(n);
@@ -757,6 +792,7 @@ public:
 
     [[nodiscard]] RB_FORCEINLINE pointer try_front() noexcept {
         if (RB_UNLIKELY(empty())) {
+            SPSC_TRACE(empty, this, size_type(1u), capacity());
             return nullptr;
         }
         return &storage_[Base::read_index()];
@@ -764,6 +800,7 @@ public:
 
     [[nodiscard]] RB_FORCEINLINE const_pointer try_front() const noexcept {
         if (RB_UNLIKELY(empty())) {
+            SPSC_TRACE(empty, this, size_type(1u), capacity());
             return nullptr;
         }
         return &storage_[Base::read_index()];
@@ -776,6 +813,7 @@ public:
 
     [[nodiscard]] RB_FORCEINLINE bool try_pop() noexcept {
         if (RB_UNLIKELY(empty())) {
+            SPSC_TRACE(empty, this, size_type(1u), capacity());
             return false;
         }
         Base::increment_tail();
@@ -789,6 +827,7 @@ public:
 
     [[nodiscard]] RB_FORCEINLINE bool try_pop(const size_type n) noexcept {
         if (RB_UNLIKELY(!can_read(n))) {
+            SPSC_TRACE(empty, this, n, capacity());
             return false;
         }
         Base::advance_tail(n);
@@ -1051,6 +1090,9 @@ public:
         ~bulk_write_guard() noexcept {
             if (q_ != nullptr && written_ != 0u && publish_on_destroy_) {
                 q_->publish(written_);
+                SPSC_TRACE(guard_commit, q_, written_, 0u);
+            } else if (q_ != nullptr && regs_.total != 0u) {
+                SPSC_TRACE(guard_cancel, q_, regs_.total, 0u); // claim dropped
             }
         }
 
@@ -1124,11 +1166,17 @@ public:
         void commit() noexcept {
             if (q_ != nullptr && written_ != 0u) {
                 q_->publish(written_);
+                SPSC_TRACE(guard_commit, q_, written_, 0u);
             }
             reset_();
         }
 
-        void cancel() noexcept { reset_(); }
+        void cancel() noexcept {
+            if (q_ != nullptr) {
+                SPSC_TRACE(guard_cancel, q_, regs_.total, 0u);
+            }
+            reset_();
+        }
 
     private:
         [[nodiscard]] pointer slot_ptr_at_(const size_type i) const noexcept {
@@ -1180,6 +1228,7 @@ public:
         ~bulk_read_guard() noexcept {
             if (active_ && q_) {
                 q_->pop(regs_.total);
+                SPSC_TRACE(guard_commit, q_, regs_.total, 0u);
             }
         }
 
@@ -1193,11 +1242,16 @@ public:
         void commit() noexcept {
             if (active_ && q_) {
                 q_->pop(regs_.total);
+                SPSC_TRACE(guard_commit, q_, regs_.total, 0u);
+                active_ = false; // not a cancel
             }
             cancel();
         }
 
         void cancel() noexcept {
+            if (active_ && q_) {
+                SPSC_TRACE(guard_cancel, q_, regs_.total, 0u);
+            }
             active_ = false;
             q_ = nullptr;
             regs_ = {};
@@ -1233,6 +1287,9 @@ public:
         ~write_guard() noexcept {
             if (active_ && q_ && publish_on_destroy_) {
                 q_->publish();
+                SPSC_TRACE(guard_commit, q_, 1u, 0u);
+            } else if (active_ && q_) {
+                SPSC_TRACE(guard_cancel, q_, 1u, 0u); // claim dropped
             }
         }
 
@@ -1267,11 +1324,16 @@ public:
         void commit() noexcept {
             if (active_ && q_) {
                 q_->publish();
+                SPSC_TRACE(guard_commit, q_, 1u, 0u);
+                active_ = false; // not a cancel
             }
             cancel();
         }
 
         void cancel() noexcept {
+            if (active_ && q_) {
+                SPSC_TRACE(guard_cancel, q_, 1u, 0u);
+            }
             active_ = false;
             publish_on_destroy_ = false;
             q_ = nullptr;
@@ -1307,6 +1369,7 @@ public:
         ~read_guard() noexcept {
             if (active_ && q_) {
                 q_->pop();
+                SPSC_TRACE(guard_commit, q_, 1u, 0u);
             }
         }
 
@@ -1322,6 +1385,7 @@ public:
         void commit() noexcept {
             if (active_ && q_) {
                 q_->pop();
+                SPSC_TRACE(guard_commit, q_, 1u, 0u);
             }
 
             active_ = false;
@@ -1330,6 +1394,9 @@ public:
         }
 
         void cancel() noexcept {
+            if (active_ && q_) {
+                SPSC_TRACE(guard_cancel, q_, 1u, 0u);
+            }
             active_ = false;
             q_ = nullptr;
             ptr_ = nullptr;
@@ -23,9 +23,11 @@
 
 // Base and utility includes
 #include "base/SPSCbase.hpp"        // ::spsc::SPSCbase<Capacity, Policy>, reg
+#include "base/spsc_layout.hpp"     // ::spsc::layout::report
 #include "base/spsc_regions.hpp"    // ::spsc::unsafe_t / ::spsc::unsafe
 #include "base/spsc_snapshot.hpp"   // ::spsc::snapshot_view, ::spsc::snapshot_traits
 #include "base/spsc_tools.hpp"      // RB_FORCEINLINE, RB_UNLIKELY, macros
+#include "base/spsc_trace.hpp"      // SPSC_TRACE (rejection / guard probes)
 
 namespace spsc {
 
@@ -381,6 +383,12 @@ public:
         Base::clear();
     }
 
+    // Cache-line layout of this view (see base/spsc_layout.hpp).
+    void describe_layout(::spsc::layout::report& r) const noexcept {
+        Base::describe_layout(r);
+        r.add("storage", &storage_, sizeof(storage_), ::spsc::layout::writer::setup);
+    }
+
     // Explicit detach: makes the view invalid (does not touch external storage).
     void detach() noexcept {
         storage_ = nullptr;
@@ -584,6 +592,22 @@ public:
         return const_snapshot(it(data(), m, t), it(data(), m, h));
     }
 
+    // ------------------------------------------------------------------------------------------
+    // Observer (third thread, read-only)
+    // ------------------------------------------------------------------------------------------
+
+    /* Copy up to max unread elements (oldest first) into dst without consuming.
+     * Same contract as fifo::try_copy_out(): head/tail loads only, retried if the
+     * consumer moved during the copy, 0 if empty or every attempt raced.
+     * Atomic policies (A<> / CA<>) only.
+     */
+    [[nodiscard]] size_type try_copy_out(value_type* dst, const size_type max) const noexcept {
+        if (RB_UNLIKELY(!is_valid())) {
+            return 0u;
+        }
+        return static_cast<size_type>(Base::observe_copy(data(), dst, max));
+    }
+
     // Consume exactly s.size() elements from snapshot
     template<class Snap>
     void consume(const Snap& s) noexcept {
@@ -790,7 +814,7 @@ public:
         typename = std::enable_if_t<std::is_assignable_v<reference, U&&>>
         >
     [[nodiscard]] RB_FORCEINLINE bool try_push(U&& v) noexcept(std::is_nothrow_assignable_v<reference, U&&>) {
-        if (RB_UNLIKELY(full())) { return false; }
+        if (RB_UNLIKELY(full())) { SPSC_TRACE(full, this, size_type(1u), capacity()); return false; }
         storage_[Base::write_index()] = std::forward<U>(v);
         Base::increment_head();
         return true;
@@ -818,7 +842,7 @@ public:
         std::is_nothrow_constructible_v<value_type, Args&&...> &&
         std::is_nothrow_assignable_v<reference, value_type>
         ) {
-        if (RB_UNLIKELY(full())) { return nullptr; }
+        if (RB_UNLIKELY(full())) { SPSC_TRACE(full, this, size_type(1u), capacity()); return nullptr; }
         const size_type wi = Base::write_index();
         reference slot = storage_[wi];
         slot = value_type(std::forward<Args>(args)...);
@@ -832,7 +856,7 @@ public:
     }
 
     [[nodiscard]] RB_FORCEINLINE pointer try_claim() noexcept {
-        if (RB_UNLIKELY(full())) { return nullptr; }
+        if (RB_UNLIKELY(full())) { SPSC_TRACE(full, this, size_type(1u), capacity()); return nullptr; }
         return &storage_[Base::write_index()];
     }
 
@@ -842,7 +866,7 @@ public:
     }
 
     [[nodiscard]] RB_FORCEINLINE bool try_publish() noexcept {
-        if (RB_UNLIKELY(full())) { return false; }
+        if (RB_UNLIKELY(full())) { SPSC_TRACE(full, this, size_type(1u), capacity()); return false; }
         Base::increment_head();
         return true;
     }
@@ -853,7 +877,7 @@ public:
     }
 
     [[nodiscard]] RB_FORCEINLINE bool try_publish(const size_type n) noexcept {
-        if (RB_UNLIKELY(!can_write(n))) { return false; }
+        if (RB_UNLIKELY(!can_write(n))) { SPSC_TRACE(full, this, n, capacity()); return false; }
         Base::advance_head(n);
         return true;
     }
@@ -872,12 +896,12 @@ public:
     }
 
     [[nodiscard]] RB_FORCEINLINE pointer try_front() noexcept {
-        if (RB_UNLIKELY(empty())) { return nullptr; }
+        if (RB_UNLIKELY(empty())) { SPSC_TRACE(empty, this, size_type(1u), capacity()); return nullptr; }
         return &storage_[Base::read_index()];
     }
 
     [[nodiscard]] RB_FORCEINLINE const_pointer try_front() const noexcept {
-        if (RB_UNLIKELY(empty())) { return nullptr; }
+        if (RB_UNLIKELY(empty())) { SPSC_TRACE(empty, this, size_type(1u), capacity()); return nullptr; }
         return &storage_[Base::read_index()];
     }
 
@@ -887,7 +911,7 @@ public:
     }
 
     [[nodiscard]] RB_FORCEINLINE bool try_pop() noexcept {
-        if (RB_UNLIKELY(empty())) { return false; }
+        if (RB_UNLIKELY(empty())) { SPSC_TRACE(empty, this, size_type(1u), capacity()); return false; }
         Base::increment_tail();
         return true;
     }
@@ -898,7 +922,7 @@ public:
     }
 
     [[nodiscard]] RB_FORCEINLINE bool try_pop(const size_type n) noexcept {
-        if (RB_UNLIKELY(!can_read(n))) { return false; }
+        if (RB_UNLIKELY(!can_read(n))) { SPSC_TRACE(empty, this, n, capacity()); return false; }
         Base::advance_tail(n);
         return true;
     }
@@ -972,6 +996,9 @@ public:
         ~bulk_write_guard() noexcept {
             if (q_ != nullptr && written_ != 0u && publish_on_destroy_) {
                 q_->publish(written_);
+                SPSC_TRACE(guard_commit, q_, written_, 0u);
+            } else if (q_ != nullptr && regs_.total != 0u) {
+                SPSC_TRACE(guard_cancel, q_, regs_.total, 0u); // claim dropped
             }
         }
 
@@ -1045,11 +1072,17 @@ public:
         void commit() noexcept {
             if (q_ != nullptr && written_ != 0u) {
                 q_->publish(written_);
+                SPSC_TRACE(guard_commit, q_, written_, 0u);
             }
             reset_();
         }
 
-        void cancel() noexcept { reset_(); }
+        void cancel() noexcept {
+            if (q_ != nullptr) {
+                SPSC_TRACE(guard_cancel, q_, regs_.total, 0u);
+            }
+            reset_();
+        }
 
     private:
         [[nodiscard]] pointer slot_ptr_at_(const size_type i) const noexcept {
@@ -1102,6 +1135,7 @@ public:
         ~bulk_read_guard() noexcept {
             if (active_ && q_) {
                 q_->pop(regs_.total);
+                SPSC_TRACE(guard_commit, q_, regs_.total, 0u);
             }
         }
 
@@ -1113,11 +1147,16 @@ public:
         void commit() noexcept {
             if (active_ && q_) {
                 q_->pop(regs_.total);
+                SPSC_TRACE(guard_commit, q_, regs_.total, 0u);
+                active_ = false; // not a cancel
             }
             cancel();
         }
 
         void cancel() noexcept {
+            if (active_ && q_) {
+                SPSC_TRACE(guard_cancel, q_, regs_.total, 0u);
+            }
             active_ = false;
             q_ = nullptr;
             regs_ = {};
@@ -1151,7 +1190,12 @@ public:
         write_guard& operator=(write_guard&&) = delete;
 
         ~write_guard() noexcept {
-            if (active_ && q_ && publish_on_destroy_) { q_->publish(); }
+            if (active_ && q_ && publish_on_destroy_) {
+                q_->publish();
+                SPSC_TRACE(guard_commit, q_, 1u, 0u);
+            } else if (active_ && q_) {
+                SPSC_TRACE(guard_cancel, q_, 1u, 0u); // claim dropped
+            }
         }
 
         void publish_on_destroy() const noexcept {
@@ -1176,11 +1220,18 @@ public:
         explicit operator bool() const noexcept { return active_; }
 
         void commit() noexcept {
-            if (active_ && q_) { q_->publish(); }
+            if (active_ && q_) {
+                q_->publish();
+                SPSC_TRACE(guard_commit, q_, 1u, 0u);
+                active_ = false; // not a cancel
+            }
             cancel();
         }
 
         void cancel() noexcept {
+            if (active_ && q_) {
+                SPSC_TRACE(guard_cancel, q_, 1u, 0u);
+            }
             active_ = false;
             publish_on_destroy_ = false;
             q_ = nullptr;
@@ -1214,7 +1265,10 @@ public:
         read_guard& operator=(read_guard&&) = delete;
 
         ~read_guard() noexcept {
-            if (active_ && q_) { q_->pop(); }
+            if (active_ && q_) {
+                q_->pop();
+                SPSC_TRACE(guard_commit, q_, 1u, 0u);
+            }
         }
 
         [[nodiscard]] pointer   get()        const noexcept { return ptr_; }
@@ -1224,7 +1278,10 @@ public:
         explicit operator bool()             const noexcept { return active_; }
 
         void commit() noexcept {
-            if (active_ && q_) { q_->pop(); }
+            if (active_ && q_) {
+                q_->pop();
+                SPSC_TRACE(guard_commit, q_, 1u, 0u);
+            }
 
             active_ = false;
             q_ = nullptr;
@@ -1232,6 +1289,9 @@ public:
         }
 
         void cancel() noexcept {
+            if (active_ && q_) {
+                SPSC_TRACE(guard_cancel, q_, 1u, 0u);
+            }
             active_ = false;
             q_ = nullptr;
             ptr_ = nullptr;
@@ -0,0 +1,464 @@
+/*
+ * flight_recorder.hpp
+ *
+ * Always-on black-box recorder: per-thread overwrite ring of fixed-size
+ * records, dumped from a fatal-signal handler.
+ *
+ * - record(id, data, len): one memcpy into the head slot + index bump. When the
+ *   ring is full the oldest record is dropped (overwrite semantics on the
+ *   SPSCbase indices: the owner thread advances both head and tail).
+ * - dump(fd): async-signal-safe. Writes a file header and both wrap halves
+ *   (oldest first) with raw write(); no allocation, no locks, no stdio.
+ * - crash_dump: a fixed registry of recorders plus a SIGSEGV/SIGBUS/SIGILL/
+ *   SIGFPE/SIGABRT handler (sigaction) that dumps every registered recorder
+ *   to a pre-opened fd and then re-raises the signal with the default action.
+ *   Threads that fault while the dump runs wait for that re-raise.
+ * - fr::decoder: offline parser of a dump image (tools/flight_decode prints it).
+ *
+ * Dump image layout (native endianness):
+ *   [file_header][record x count]  per recorder, concatenated
+ *
+ * Contract:
+ * - One writer thread per recorder.
+ * - dump() from another thread (e.g. a crash on a different thread) may race
+ *   with the writer; the newest record(s) can be torn. Every record carries its
+ *   sequence number, and the decoder flags records that break the sequence.
+ */
+
+#ifndef SPSC_FLIGHT_RECORDER_HPP_
+#define SPSC_FLIGHT_RECORDER_HPP_
+
+#include <atomic>      // std::atomic_signal_fence
+#include <cerrno>      // errno, EINTR
+#include <chrono>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>     // std::memcpy, std::memcmp
+#include <type_traits>
+
+#if defined(_WIN32)
+#  include <io.h>      // _write
+#else
+#  include <signal.h>  // sigaction
+#  include <unistd.h>  // write, pause
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#  include <x86intrin.h> // __rdtsc
+#elif defined(_M_X64) || defined(_M_IX86)
+#  include <intrin.h>    // __rdtsc
+#endif
+
+#include "base/SPSCbase.hpp"       // ::spsc::SPSCbase<Capacity, Policy>, reg
+#include "base/spsc_policy.hpp"    // ::spsc::policy::P
+#include "base/spsc_tools.hpp"     // RB_FORCEINLINE, RB_UNLIKELY
+
+#ifndef SPSC_FR_MAX_RECORDERS
+#  define SPSC_FR_MAX_RECORDERS 64
+#endif /* SPSC_FR_MAX_RECORDERS */
+
+namespace spsc::fr {
+
+// ------------------------------------------------------------------------------------------
+// Time source
+// ------------------------------------------------------------------------------------------
+
+/* Cheapest monotonic-ish tick: TSC on x86, steady_clock elsewhere. */
+[[nodiscard]] RB_FORCEINLINE std::uint64_t now_ticks() noexcept {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    return static_cast<std::uint64_t>(__rdtsc());
+#else
+    return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+// ------------------------------------------------------------------------------------------
+// On-disk format
+// ------------------------------------------------------------------------------------------
+inline constexpr char kMagic[8] = {'S', 'P', 'S', 'C', 'F', 'R', '1', '\0'};
+
+struct file_header {
+    char          magic[8];
+    std::uint32_t record_bytes;  // sizeof(record_slot<...>)
+    std::uint32_t capacity;
+    std::uint64_t head;          // sequence number of the next record
+    std::uint32_t count;         // records that follow (oldest first)
+    std::uint32_t thread_tag;    // user tag given to the recorder
+};
+static_assert(sizeof(file_header) == 32u, "[spsc::fr]: file_header layout");
+
+struct record_header {
+    std::uint64_t seq;
+    std::uint64_t stamp;
+    std::uint32_t id;
+    std::uint32_t len;   // payload bytes used (<= payload capacity)
+};
+static_assert(sizeof(record_header) == 24u, "[spsc::fr]: record_header layout");
+
+template <reg RecordBytes>
+struct record_slot {
+    static_assert(RecordBytes >= 32u && (RecordBytes % 8u) == 0u,
+                  "[spsc::fr]: RecordBytes must be a multiple of 8 and >= 32");
+    static constexpr reg kPayload = RecordBytes - sizeof(record_header);
+
+    record_header hdr;
+    unsigned char data[kPayload];
+};
+
+namespace detail {
+
+/* write() until done; async-signal-safe. */
+inline bool write_all(const int fd, const void *p, std::size_t n) noexcept {
+    const char *c = static_cast<const char *>(p);
+    while (n != 0u) {
+#if defined(_WIN32)
+        const int w = ::_write(fd, c, static_cast<unsigned>(n));
+#else
+        const ::ssize_t w = ::write(fd, c, n);
+#endif
+        if (w < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        if (w == 0) {
+            return false;
+        }
+        c += w;
+        n -= static_cast<std::size_t>(w);
+    }
+    return true;
+}
+
+} // namespace detail
+
+/* =======================================================================
+ * recorder<RecordBytes, Capacity, Policy>
+ *
+ * RecordBytes : size of one record (header 24 B + payload), multiple of 8.
+ * Capacity    : records kept (static, pow2).
+ * Policy      : index policy; plain counters by default (single owner).
+ * ======================================================================= */
+template <reg RecordBytes = 64u, reg Capacity = 1024u, typename Policy = ::spsc::policy::P>
+class recorder : private ::spsc::SPSCbase<Capacity, Policy> {
+    using Base = ::spsc::SPSCbase<Capacity, Policy>;
+
+    static_assert(Capacity >= 2u && ::spsc::cap::rb_is_pow2(Capacity),
+                  "[spsc::fr::recorder]: Capacity must be a static power of two >= 2");
+
+public:
+    using record_type = record_slot<RecordBytes>;
+    using size_type   = reg;
+
+    static constexpr size_type kPayload = record_type::kPayload;
+
+    explicit recorder(const std::uint32_t thread_tag = 0u) noexcept : tag_(thread_tag) {}
+
+    recorder(const recorder &) = delete;
+    recorder &operator=(const recorder &) = delete;
+
+    using Base::capacity;
+
+    [[nodiscard]] size_type size() const noexcept { return Base::size(); }
+    [[nodiscard]] std::uint64_t next_seq() const noexcept { return static_cast<std::uint64_t>(Base::head()); }
+    [[nodiscard]] std::uint32_t tag() const noexcept { return tag_; }
+
+    // ------------------------------------------------------------------------------------------
+    // Writer (owner thread)
+    // ------------------------------------------------------------------------------------------
+
+    /* Append one record; payload is truncated to kPayload bytes. Never fails. */
+    RB_FORCEINLINE void record(const std::uint32_t id, const void *data, const std::uint32_t len,
+                               const std::uint64_t stamp = now_ticks()) noexcept {
+        if (RB_UNLIKELY(Base::full())) {
+            Base::increment_tail(); // overwrite: drop the oldest
+        }
+        record_type &r = slots_[Base::write_index()];
+        const std::uint32_t n = (len < kPayload) ? len : static_cast<std::uint32_t>(kPayload);
+        r.hdr.seq   = static_cast<std::uint64_t>(Base::head());
+        r.hdr.stamp = stamp;
+        r.hdr.id    = id;
+        r.hdr.len   = n;
+        if (n != 0u) {
+            std::memcpy(r.data, data, n);
+        }
+        std::atomic_signal_fence(std::memory_order_release); // visible to a handler on this thread
+        Base::increment_head();
+    }
+
+    /* Record a trivially copyable value. */
+    template <class T>
+    RB_FORCEINLINE void record_value(const std::uint32_t id, const T &v) noexcept {
+        static_assert(std::is_trivially_copyable_v<T>, "[spsc::fr]: value must be trivially copyable");
+        static_assert(sizeof(T) <= kPayload, "[spsc::fr]: value does not fit the record payload");
+        record(id, &v, static_cast<std::uint32_t>(sizeof(T)));
+    }
+
+    /* Drop everything (owner thread). */
+    void clear() noexcept { Base::sync_tail_to_head(); }
+
+    // ------------------------------------------------------------------------------------------
+    // Dump (async-signal-safe)
+    // ------------------------------------------------------------------------------------------
+
+    /* Write header + records oldest first. Returns false on a write error. */
+    bool dump(const int fd) const noexcept {
+        std::atomic_signal_fence(std::memory_order_acquire);
+        const size_type head = static_cast<size_type>(Base::head());
+        size_type tail = static_cast<size_type>(Base::tail());
+        if (static_cast<size_type>(head - tail) > Capacity) {
+            tail = static_cast<size_type>(head - Capacity); // racing writer: clamp
+        }
+        const size_type count = static_cast<size_type>(head - tail);
+
+        file_header h{};
+        std::memcpy(h.magic, kMagic, sizeof(kMagic));
+        h.record_bytes = static_cast<std::uint32_t>(sizeof(record_type));
+        h.capacity     = static_cast<std::uint32_t>(Capacity);
+        h.head         = static_cast<std::uint64_t>(head);
+        h.count        = static_cast<std::uint32_t>(count);
+        h.thread_tag   = tag_;
+        if (!detail::write_all(fd, &h, sizeof(h))) {
+            return false;
+        }
+
+        // Two wrap halves: [tail .. end) and [0 .. rest).
+        const size_type idx    = static_cast<size_type>(tail & (Capacity - 1u));
+        const size_type to_end = static_cast<size_type>(Capacity - idx);
+        const size_type first  = (count < to_end) ? count : to_end;
+        if (first != 0u && !detail::write_all(fd, &slots_[idx], first * sizeof(record_type))) {
+            return false;
+        }
+        const size_type second = static_cast<size_type>(count - first);
+        return (second == 0u) || detail::write_all(fd, &slots_[0], second * sizeof(record_type));
+    }
+
+    /* Type-erased dump entry for crash_dump. */
+    static bool dump_thunk(const void *self, const int fd) noexcept {
+        return static_cast<const recorder *>(self)->dump(fd);
+    }
+
+private:
+    record_type   slots_[Capacity]{};
+    std::uint32_t tag_{0u};
+};
+
+// ------------------------------------------------------------------------------------------
+// Crash-time dump
+// ------------------------------------------------------------------------------------------
+class crash_dump {
+public:
+    using dump_fn = bool (*)(const void *, int) noexcept;
+
+    /* Register a recorder (any thread). Returns false if the registry is full. */
+    template <class Recorder>
+    static bool add(const Recorder &r) noexcept {
+        for (auto &e : entries_()) {
+            if (e.obj.load(std::memory_order_acquire) != nullptr) {
+                continue;
+            }
+            const unsigned v = e.lock();
+            if (e.obj.load(std::memory_order_relaxed) == nullptr) {
+                e.fn.store(&Recorder::dump_thunk, std::memory_order_release);
+                e.obj.store(&r, std::memory_order_release);
+                e.unlock(v);
+                return true;
+            }
+            e.unlock(v);
+        }
+        return false;
+    }
+
+    /* Unregister (call before the recorder is destroyed). */
+    template <class Recorder>
+    static void remove(const Recorder &r) noexcept {
+        for (auto &e : entries_()) {
+            if (e.obj.load(std::memory_order_acquire) != &r) {
+                continue;
+            }
+            const unsigned v = e.lock();
+            if (e.obj.load(std::memory_order_relaxed) == &r) {
+                e.fn.store(nullptr, std::memory_order_release);
+                e.obj.store(nullptr, std::memory_order_release);
+            }
+            e.unlock(v);
+        }
+    }
+
+    /* Dump every registered recorder to fd (async-signal-safe). Returns the count.
+     * An entry that add()/remove() is rewriting is skipped, so fn is never
+     * called with another recorder's obj.
+     */
+    static unsigned dump_all(const int fd) noexcept {
+        unsigned n = 0u;
+        for (auto &e : entries_()) {
+            const unsigned v0 = e.ver.load(std::memory_order_acquire);
+            const dump_fn  f  = e.fn.load(std::memory_order_acquire);
+            const void    *o  = e.obj.load(std::memory_order_acquire);
+            if ((v0 & 1u) != 0u || e.ver.load(std::memory_order_relaxed) != v0) {
+                continue; // writer in progress
+            }
+            if (f && o && f(o, fd)) {
+                ++n;
+            }
+        }
+        return n;
+    }
+
+    /* Install the fatal-signal handler; fd must stay open (opened up front). */
+    static void install(const int fd) noexcept {
+        fd_().store(fd, std::memory_order_release);
+        for (const int sig : kSignals) {
+            set_handler_(sig, &on_fatal_);
+        }
+    }
+
+private:
+    static constexpr int kSignals[] = {SIGSEGV, SIGILL, SIGFPE, SIGABRT
+#if defined(SIGBUS)
+                                       , SIGBUS
+#endif
+    };
+
+    // {fn, obj} pair guarded by a sequence counter: odd while add()/remove()
+    // rewrite it. fn/obj stores are release and loads acquire, so a reader
+    // that sees a new value also sees the odd count on its re-check.
+    struct entry {
+        std::atomic<unsigned>    ver{0u};
+        std::atomic<dump_fn>     fn{nullptr};
+        std::atomic<const void*> obj{nullptr};
+
+        unsigned lock() noexcept {
+            unsigned v = ver.load(std::memory_order_relaxed);
+            for (;;) {
+                if ((v & 1u) == 0u &&
+                    ver.compare_exchange_weak(v, v + 1u, std::memory_order_acquire,
+                                              std::memory_order_relaxed)) {
+                    return v;
+                }
+                v = ver.load(std::memory_order_relaxed);
+            }
+        }
+
+        void unlock(const unsigned v) noexcept { ver.store(v + 2u, std::memory_order_release); }
+    };
+
+    static entry (&entries_() noexcept)[SPSC_FR_MAX_RECORDERS] {
+        static entry e[SPSC_FR_MAX_RECORDERS];
+        return e;
+    }
+
+    static std::atomic<int> &fd_() noexcept {
+        static std::atomic<int> fd{-1};
+        return fd;
+    }
+
+    static void set_handler_(const int sig, void (*handler)(int)) noexcept {
+#if defined(_WIN32)
+        std::signal(sig, handler);
+#else
+        // The other fatal signals stay blocked while the handler runs: a fault
+        // inside the dump then kills the process instead of re-entering it.
+        struct sigaction sa {};
+        sa.sa_handler = handler;
+        sigemptyset(&sa.sa_mask);
+        for (const int s : kSignals) {
+            sigaddset(&sa.sa_mask, s);
+        }
+        sa.sa_flags = 0;
+        (void)::sigaction(sig, &sa, nullptr);
+#endif
+    }
+
+    static void on_fatal_(const int sig) noexcept {
+        static std::atomic<bool> dumping{false};
+        if (dumping.exchange(true, std::memory_order_acq_rel)) {
+            // Another thread is dumping; its re-raise ends the process.
+            for (;;) {
+#if !defined(_WIN32)
+                (void)::pause();
+#endif
+                (void)dumping.load(std::memory_order_relaxed);
+            }
+        }
+        const int fd = fd_().load(std::memory_order_acquire);
+        if (fd >= 0) {
+            (void)dump_all(fd);
+        }
+        set_handler_(sig, SIG_DFL);
+        std::raise(sig);
+    }
+};
+
+// ------------------------------------------------------------------------------------------
+// Offline decoder
+// ------------------------------------------------------------------------------------------
+
+/* One recorder section of a dump image. */
+struct section {
+    file_header          header{};
+    const unsigned char *records{nullptr}; // header.count records of header.record_bytes
+};
+
+struct decoded_record {
+    record_header        hdr{};
+    const unsigned char *data{nullptr};
+    bool                 in_sequence{true}; // false: torn / overwritten during the dump
+};
+
+class decoder {
+public:
+    decoder(const void *image, const std::size_t bytes) noexcept
+        : p_(static_cast<const unsigned char *>(image)), n_(bytes) {}
+
+    /* Next recorder section; false at the end or on a malformed image (see error()). */
+    bool next(section &s) noexcept {
+        if (off_ == n_ || bad_) {
+            return false;
+        }
+        if (n_ - off_ < sizeof(file_header)) {
+            bad_ = true;
+            return false;
+        }
+        std::memcpy(&s.header, p_ + off_, sizeof(file_header));
+        if (std::memcmp(s.header.magic, kMagic, sizeof(kMagic)) != 0 ||
+            s.header.record_bytes < sizeof(record_header) || s.header.count > s.header.capacity) {
+            bad_ = true;
+            return false;
+        }
+        const std::size_t body = std::size_t(s.header.count) * s.header.record_bytes;
+        if (n_ - off_ - sizeof(file_header) < body) {
+            bad_ = true;
+            return false;
+        }
+        s.records = p_ + off_ + sizeof(file_header);
+        off_ += sizeof(file_header) + body;
+        return true;
+    }
+
+    [[nodiscard]] bool error() const noexcept { return bad_; }
+
+    /* i-th record of s (0 = oldest). */
+    [[nodiscard]] static decoded_record at(const section &s, const std::uint32_t i) noexcept {
+        decoded_record r{};
+        const unsigned char *base = s.records + std::size_t(i) * s.header.record_bytes;
+        std::memcpy(&r.hdr, base, sizeof(record_header));
+        r.data = base + sizeof(record_header);
+        const std::uint64_t expect = s.header.head - s.header.count + i;
+        const std::uint32_t cap_payload = s.header.record_bytes - static_cast<std::uint32_t>(sizeof(record_header));
+        r.in_sequence = (r.hdr.seq == expect) && (r.hdr.len <= cap_payload);
+        return r;
+    }
+
+private:
+    const unsigned char *p_{nullptr};
+    std::size_t          n_{0u};
+    std::size_t          off_{0u};
+    bool                 bad_{false};
+};
+
+} // namespace spsc::fr
+
+#endif /* SPSC_FLIGHT_RECORDER_HPP_ */
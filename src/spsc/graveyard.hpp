@@ -0,0 +1,201 @@
+/*
+ * graveyard.hpp
+ *
+ * Destruction offload for heavy popped objects.
+ *
+ * queue::pop() / typed_pool::pop() run ~T() on the consumer thread. For types
+ * that own large trees or vectors this (and the free() calls behind it)
+ * dominates consumer latency. graveyard<T> moves popped elements into its own
+ * SPSC ring and destroys them later, in batches, on a reaper thread:
+ *
+ *   consumer:  pop_from(q)  ->  move *front into the graveyard ring, q.pop()
+ *                               (only the moved-from shell is destroyed here)
+ *   reaper  :  collect()    ->  one pop(n) on the graveyard ring = n destructors
+ *
+ * Roles:
+ * - Consumer side (the thread that pops the source): bury(), pop_from().
+ * - Reaper side (one thread): collect(), or the built-in helper via start().
+ *
+ * If the graveyard ring is full, bury() destroys the element inline instead of
+ * blocking (counted by inline_destroyed()); size the ring for the burst.
+ */
+
+#ifndef SPSC_GRAVEYARD_HPP_
+#define SPSC_GRAVEYARD_HPP_
+
+#include <atomic>
+#include <thread>
+#include <type_traits>
+#include <utility>     // std::move
+
+#include "base/spsc_cacheline.hpp" // SPSC_ALIGNED, SPSC_CACHELINE_BYTES
+#include "base/spsc_policy.hpp"    // ::spsc::policy::CA
+#include "base/spsc_tools.hpp"     // RB_FORCEINLINE, RB_LIKELY, RB_UNLIKELY
+#include "queue.hpp"               // ::spsc::queue
+
+namespace spsc {
+
+/* =======================================================================
+ * graveyard<T, Capacity, Batch, Policy>
+ *
+ * T        : nothrow move-constructible (moved-from state must be cheap to destroy).
+ * Capacity : graveyard ring capacity (pow2).
+ * Batch    : max elements destroyed per collect() step.
+ * Policy   : counter policy of the ring (must be atomic when a reaper thread runs).
+ * ======================================================================= */
+template <class T,
+         reg Capacity = 1024u,
+         reg Batch = 64u,
+         typename Policy = ::spsc::policy::CA<>>
+class graveyard {
+    static_assert(std::is_nothrow_move_constructible_v<T>,
+                  "[spsc::graveyard]: T must be nothrow move-constructible");
+    static_assert(Batch > 0u, "[spsc::graveyard]: Batch must be > 0");
+
+public:
+    // ------------------------------------------------------------------------------------------
+    // Type Definitions
+    // ------------------------------------------------------------------------------------------
+    using value_type = T;
+    using size_type  = reg;
+    using ring_type  = ::spsc::queue<T, Capacity, Policy>;
+
+    static constexpr size_type kBatch = Batch;
+
+    graveyard() = default;
+
+    graveyard(const graveyard &) = delete;
+    graveyard &operator=(const graveyard &) = delete;
+    graveyard(graveyard &&) = delete;
+    graveyard &operator=(graveyard &&) = delete;
+
+    /* Joins the helper (if any) and destroys every element still buried. */
+    ~graveyard() { stop(); }
+
+    // ------------------------------------------------------------------------------------------
+    // Consumer side
+    // ------------------------------------------------------------------------------------------
+
+    /* Hand v over for deferred destruction. Never blocks. */
+    void bury(T &&v) noexcept {
+        if (RB_LIKELY(ring_.try_emplace(std::move(v)) != nullptr)) {
+            buried_.store(buried_.load(std::memory_order_relaxed) + 1u, std::memory_order_relaxed);
+            return;
+        }
+        // Ring full: fall back to destroying right here (v's owner does it).
+        inline_.store(inline_.load(std::memory_order_relaxed) + 1u, std::memory_order_relaxed);
+    }
+
+    /* Pop the front of q (queue / typed_pool / anything with try_front()+pop()),
+     * moving it into the graveyard first. Returns false if q is empty.
+     */
+    template <class Src>
+    bool pop_from(Src &q) noexcept {
+        auto *p = q.try_front();
+        if (!p) {
+            return false;
+        }
+        bury(std::move(*p)); // left intact if the graveyard is full
+        q.pop();             // destroys the moved-from shell (or the element itself)
+        return true;
+    }
+
+    /* pop_from() up to n times; returns the number popped. */
+    template <class Src>
+    size_type pop_from(Src &q, const size_type n) noexcept {
+        size_type k = 0u;
+        while (k < n && pop_from(q)) {
+            ++k;
+        }
+        return k;
+    }
+
+    // ------------------------------------------------------------------------------------------
+    // Reaper side
+    // ------------------------------------------------------------------------------------------
+
+    /* Destroy up to max buried elements with a single ring pop(n). */
+    size_type collect(const size_type max = kBatch) noexcept {
+        const size_type avail = ring_.size();
+        const size_type n = (avail < max) ? avail : max;
+        if (n != 0u) {
+            ring_.pop(n);
+            collected_.store(collected_.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        }
+        return n;
+    }
+
+    /* Collect until the ring is observed empty. */
+    size_type collect_all() noexcept {
+        size_type total = 0u;
+        while (const size_type n = collect(kBatch)) {
+            total += n;
+        }
+        return total;
+    }
+
+    /* Spawn the helper thread that runs collect() in a loop.
+     * Returns false if already running.
+     */
+    bool start() {
+        if (RB_UNLIKELY(running_)) {
+            return false;
+        }
+        stop_.store(false, std::memory_order_relaxed);
+        running_ = true;
+        reaper_ = std::thread([this]() noexcept { reaper_loop_(); });
+        return true;
+    }
+
+    /* Join the helper, then destroy leftovers on the calling thread. Idempotent. */
+    void stop() noexcept {
+        if (running_) {
+            stop_.store(true, std::memory_order_release);
+            if (reaper_.joinable()) {
+                reaper_.join();
+            }
+            running_ = false;
+        }
+        // After join() (or without a helper) the caller is the only reaper.
+        (void)collect_all();
+    }
+
+    [[nodiscard]] bool running() const noexcept { return running_; }
+
+    // ------------------------------------------------------------------------------------------
+    // Observers (any thread, relaxed)
+    // ------------------------------------------------------------------------------------------
+    [[nodiscard]] size_type pending() const noexcept { return ring_.size(); }
+    [[nodiscard]] size_type buried() const noexcept { return buried_.load(std::memory_order_relaxed); }
+    [[nodiscard]] size_type inline_destroyed() const noexcept { return inline_.load(std::memory_order_relaxed); }
+    [[nodiscard]] size_type collected() const noexcept { return collected_.load(std::memory_order_relaxed); }
+
+private:
+    void reaper_loop_() noexcept {
+        unsigned idle = 0u;
+        while (!stop_.load(std::memory_order_acquire)) {
+            if (collect(kBatch) != 0u) {
+                idle = 0u;
+            } else if (++idle > 64u) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    ring_type ring_{};
+
+    // Consumer-owned counters.
+    alignas(SPSC_CACHELINE_BYTES) std::atomic<size_type> buried_{0u};
+    std::atomic<size_type> inline_{0u};
+
+    // Reaper-owned counter.
+    alignas(SPSC_CACHELINE_BYTES) std::atomic<size_type> collected_{0u};
+
+    std::thread reaper_{};
+    bool running_{false};
+    alignas(SPSC_CACHELINE_BYTES) std::atomic<bool> stop_{false};
+};
+
+} // namespace spsc
+
+#endif /* SPSC_GRAVEYARD_HPP_ */
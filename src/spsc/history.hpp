@@ -0,0 +1,193 @@
+/*
+ * history.hpp
+ *
+ * Retransmission history window over a fifo / fifo_view (consumer side).
+ *
+ * history_reader<Ring> splits the consumer index in two:
+ * - read cursor : advanced by pop(); local to the consumer.
+ * - retire index: the ring's own tail; advanced by retire().
+ *
+ * The producer is gated by the ring tail as usual, which now trails behind
+ * the read cursor. Elements in [retire, cursor) are consumed but not retired:
+ * they stay in their ring slots and peek_history(seq) returns them zero-copy
+ * (e.g. to answer a NAK). Once acknowledged, retire() releases them to the
+ * producer with a single pop(n).
+ *
+ *   seq:   oldest_seq()        next_seq()               (unread)
+ *            |  history (retained) |  unread (published)  |  free  |
+ *            ^ ring tail           ^ read cursor          ^ ring head
+ *
+ * Sequence numbers are 64-bit and count every element ever read, starting at
+ * 0 when the reader is attached (or after reset()).
+ *
+ * Contract:
+ * - Consumer thread only. While attached, nothing else may pop the ring.
+ * - History costs ring capacity: the producer sees history_size() fewer free
+ *   slots until retire() is called.
+ * - Pointers from front()/peek_history() stay valid until that element is
+ *   retired.
+ */
+
+#ifndef SPSC_HISTORY_HPP_
+#define SPSC_HISTORY_HPP_
+
+#include <cstdint>
+
+#include "base/spsc_regions.hpp" // ::spsc::unsafe
+#include "base/spsc_tools.hpp"   // RB_FORCEINLINE, RB_UNLIKELY
+
+namespace spsc {
+
+/* =======================================================================
+ * history_reader<Ring>
+ *
+ * Ring : fifo / fifo_view (anything with claim_read(unsafe) + pop(n)).
+ * ======================================================================= */
+template <class Ring>
+class history_reader {
+public:
+    // ------------------------------------------------------------------------------------------
+    // Type Definitions
+    // ------------------------------------------------------------------------------------------
+    using ring_type  = Ring;
+    using value_type = typename Ring::value_type;
+    using pointer    = typename Ring::pointer;
+    using reference  = typename Ring::reference;
+    using size_type  = typename Ring::size_type;
+    using seq_type   = std::uint64_t;
+
+    // ------------------------------------------------------------------------------------------
+    // Constructors
+    // ------------------------------------------------------------------------------------------
+    explicit history_reader(Ring &q) noexcept : q_(&q) {}
+
+    history_reader(const history_reader &) = delete;
+    history_reader &operator=(const history_reader &) = delete;
+
+    /* Forget the history without retiring it (sequence numbers restart at 0).
+     * Everything still in the ring becomes unread again.
+     */
+    void reset() noexcept {
+        retired_ = 0u;
+        cursor_  = 0u;
+    }
+
+    [[nodiscard]] Ring &ring() noexcept { return *q_; }
+
+    // ------------------------------------------------------------------------------------------
+    // Reading (advances the read cursor only)
+    // ------------------------------------------------------------------------------------------
+
+    /* Next unread element, or nullptr. */
+    [[nodiscard]] pointer try_front() noexcept {
+        return at_(static_cast<size_type>(cursor_ - retired_));
+    }
+
+    /* Precondition: size() != 0. */
+    [[nodiscard]] reference front() noexcept {
+        pointer p = try_front();
+        SPSC_ASSERT(p != nullptr);
+        return *p;
+    }
+
+    /* Mark n unread elements as read; they move into the history.
+     * Precondition: n <= size().
+     */
+    RB_FORCEINLINE void pop(const size_type n = 1u) noexcept {
+        SPSC_ASSERT(n <= size());
+        cursor_ += n;
+    }
+
+    [[nodiscard]] bool try_pop(const size_type n = 1u) noexcept {
+        if (RB_UNLIKELY(n > size())) {
+            return false;
+        }
+        cursor_ += n;
+        return true;
+    }
+
+    /* Unread elements currently published. */
+    [[nodiscard]] size_type size() const noexcept {
+        const size_type total = q_->claim_read(::spsc::unsafe).total;
+        const size_type hist  = history_size();
+        return (total > hist) ? static_cast<size_type>(total - hist) : 0u;
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return size() == 0u; }
+
+    // ------------------------------------------------------------------------------------------
+    // History (consumed, not retired)
+    // ------------------------------------------------------------------------------------------
+    [[nodiscard]] size_type history_size() const noexcept {
+        return static_cast<size_type>(cursor_ - retired_);
+    }
+
+    [[nodiscard]] seq_type oldest_seq() const noexcept { return retired_; }
+    [[nodiscard]] seq_type next_seq() const noexcept { return cursor_; }
+
+    /* Zero-copy access to a consumed element; nullptr unless
+     * oldest_seq() <= seq < next_seq().
+     */
+    [[nodiscard]] pointer peek_history(const seq_type seq) noexcept {
+        if (RB_UNLIKELY(seq < retired_ || seq >= cursor_)) {
+            return nullptr;
+        }
+        return at_(static_cast<size_type>(seq - retired_));
+    }
+
+    /* Go-back-N: make [seq, next_seq()) unread again.
+     * Returns false if seq is outside the history.
+     */
+    [[nodiscard]] bool rewind(const seq_type seq) noexcept {
+        if (RB_UNLIKELY(seq < retired_ || seq > cursor_)) {
+            return false;
+        }
+        cursor_ = seq;
+        return true;
+    }
+
+    /* Release the n oldest history elements to the producer (one ring pop(n)).
+     * Precondition: n <= history_size().
+     */
+    void retire(const size_type n) noexcept {
+        SPSC_ASSERT(n <= history_size());
+        if (n != 0u) {
+            q_->pop(n);
+            retired_ += n;
+        }
+    }
+
+    /* Retire every element with sequence < seq (clamped to the history).
+     * Returns the number retired.
+     */
+    size_type retire_until(const seq_type seq) noexcept {
+        if (seq <= retired_) {
+            return 0u;
+        }
+        const seq_type end = (seq < cursor_) ? seq : cursor_;
+        const size_type n = static_cast<size_type>(end - retired_);
+        retire(n);
+        return n;
+    }
+
+    void retire_all() noexcept { retire(history_size()); }
+
+private:
+    // Element at offset k from the ring tail, or nullptr if not published.
+    [[nodiscard]] pointer at_(const size_type k) const noexcept {
+        const auto r = q_->claim_read(::spsc::unsafe);
+        if (k >= r.total) {
+            return nullptr;
+        }
+        return (k < r.first.count) ? (r.first.ptr + k)
+                                   : (r.second.ptr + (k - r.first.count));
+    }
+
+    Ring    *q_{nullptr};
+    seq_type retired_{0u};
+    seq_type cursor_{0u};
+};
+
+} // namespace spsc
+
+#endif /* SPSC_HISTORY_HPP_ */
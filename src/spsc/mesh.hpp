@@ -0,0 +1,381 @@
+/*
+ * mesh.hpp
+ *
+ * All-to-all N x M connectivity built only from SPSC lanes.
+ *
+ * Topology (N senders, M receivers):
+ * - lanes : N x M  spsc::queue<T>   (sender s -> receiver r)
+ * - ready : one bitmap per receiver, bit s set = lane (s, r) may hold data
+ *
+ * Placement:
+ * - Lanes are stored per receiver column (all inbound lanes of receiver r in
+ *   one allocation, next to its bitmap), so a poll walks one contiguous block.
+ * - placement::first_touch leaves the columns unallocated; each receiver calls
+ *   attach(r) from its own (pinned) thread, so first-touch puts the column on
+ *   that thread's NUMA node. try_send() to a column that is not attached yet
+ *   returns false.
+ *
+ * Readiness protocol (no lost wake-ups):
+ * - send : push into the lane, seq_cst fence, then set bit s only if it is
+ *          clear (the common "already set" case is one shared load).
+ * - poll : exchange the bitmap word with 0, seq_cst fence, drain every lane
+ *          of the word up to a per-lane budget; lanes left non-empty get
+ *          their bit set again.
+ * Either the receiver sees the new element, or the sender sees the bit clear
+ * and sets it.
+ *
+ * Contract:
+ * - A sender index is used by one thread at a time, a receiver index too.
+ * - Every hop is a plain SPSC queue: wait-free send/poll, no CAS loops on the
+ *   data path. The bitmap word is the only location shared by several senders.
+ * - init() / destruction must not race with send/poll.
+ */
+
+#ifndef SPSC_MESH_HPP_
+#define SPSC_MESH_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>      // std::unique_ptr
+#include <new>         // std::nothrow
+#include <type_traits>
+#include <utility>     // std::forward
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#  include <intrin.h>  // _BitScanForward64
+#endif
+
+#include "base/spsc_cacheline.hpp" // SPSC_ALIGNED, SPSC_CACHELINE_BYTES
+#include "base/spsc_policy.hpp"    // ::spsc::policy::CA
+#include "base/spsc_regions.hpp"   // ::spsc::unsafe
+#include "base/spsc_tools.hpp"     // RB_FORCEINLINE, RB_LIKELY, RB_UNLIKELY
+#include "queue.hpp"               // ::spsc::queue
+
+namespace spsc {
+
+namespace detail {
+
+[[nodiscard]] RB_FORCEINLINE unsigned mesh_lowest_bit(const std::uint64_t mask) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long idx = 0u;
+    _BitScanForward64(&idx, mask);
+    return static_cast<unsigned>(idx);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(mask));
+#endif
+}
+
+} // namespace detail
+
+/* =======================================================================
+ * mesh<T, LaneCapacity, Policy>
+ *
+ * T            : message type (anything spsc::queue accepts).
+ * LaneCapacity : capacity of every sender -> receiver lane (pow2).
+ * Policy       : counter policy of the lanes (must be atomic).
+ * ======================================================================= */
+template <class T, reg LaneCapacity = 256u, typename Policy = ::spsc::policy::CA<>>
+class mesh {
+public:
+    // ------------------------------------------------------------------------------------------
+    // Type Definitions
+    // ------------------------------------------------------------------------------------------
+    using value_type  = T;
+    using size_type   = reg;
+    using policy_type = Policy;
+    using lane_type   = ::spsc::queue<value_type, LaneCapacity, Policy>;
+
+    enum class placement : unsigned char {
+        eager,       // init() allocates every column
+        first_touch  // each receiver allocates its column in attach(r)
+    };
+
+    static_assert(LaneCapacity >= 2u, "[spsc::mesh]: LaneCapacity must be >= 2.");
+    static_assert(Policy::counter_type::is_atomic,
+                  "[spsc::mesh]: lanes cross threads, Policy must be atomic-backed.");
+
+    // ------------------------------------------------------------------------------------------
+    // Constructors / Destructor
+    // ------------------------------------------------------------------------------------------
+    mesh() noexcept = default;
+
+    mesh(const size_type senders, const size_type receivers, const placement p = placement::eager) {
+        (void)init(senders, receivers, p);
+    }
+
+    mesh(const mesh &) = delete;
+    mesh &operator=(const mesh &) = delete;
+    mesh(mesh &&) = delete;
+    mesh &operator=(mesh &&) = delete;
+
+    ~mesh() { release_(); }
+
+    // ------------------------------------------------------------------------------------------
+    // Lifecycle
+    // ------------------------------------------------------------------------------------------
+
+    /* Size the mesh. With placement::eager every column is allocated here.
+     * Returns false on invalid arguments or allocation failure (mesh stays empty).
+     */
+    [[nodiscard]] bool init(const size_type senders, const size_type receivers,
+                            const placement p = placement::eager) {
+        release_();
+        if (RB_UNLIKELY(senders == 0u || receivers == 0u)) {
+            return false;
+        }
+        std::unique_ptr<std::atomic<column *>[]> cols(new (std::nothrow) std::atomic<column *>[receivers]);
+        if (RB_UNLIKELY(!cols)) {
+            return false;
+        }
+        for (size_type r = 0; r < receivers; ++r) {
+            cols[r].store(nullptr, std::memory_order_relaxed);
+        }
+        senders_   = senders;
+        receivers_ = receivers;
+        words_     = static_cast<size_type>((senders + 63u) / 64u);
+        columns_   = std::move(cols);
+
+        if (p == placement::eager) {
+            for (size_type r = 0; r < receivers; ++r) {
+                if (RB_UNLIKELY(!attach(r))) {
+                    release_();
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /* Allocate (and first-touch) the inbound column of receiver r.
+     * Call from the receiver's thread. Idempotent; false on allocation failure.
+     */
+    [[nodiscard]] bool attach(const size_type r) {
+        SPSC_ASSERT(r < receivers_);
+        if (columns_[r].load(std::memory_order_acquire) != nullptr) {
+            return true;
+        }
+        std::unique_ptr<column> c(new (std::nothrow) column{});
+        if (RB_UNLIKELY(!c)) {
+            return false;
+        }
+        c->lanes.reset(new (std::nothrow) lane_type[senders_]);
+        c->ready.reset(new (std::nothrow) ready_word[words_]);
+        if (RB_UNLIKELY(!c->lanes || !c->ready)) {
+            return false;
+        }
+        for (size_type s = 0; s < senders_; ++s) {
+            if (RB_UNLIKELY(!c->lanes[s].is_valid())) {
+                return false;
+            }
+        }
+        columns_[r].store(c.release(), std::memory_order_release);
+        return true;
+    }
+
+    [[nodiscard]] bool is_valid() const noexcept { return columns_ != nullptr; }
+    [[nodiscard]] size_type senders() const noexcept { return senders_; }
+    [[nodiscard]] size_type receivers() const noexcept { return receivers_; }
+
+    [[nodiscard]] bool attached(const size_type r) const noexcept {
+        SPSC_ASSERT(r < receivers_);
+        return columns_[r].load(std::memory_order_acquire) != nullptr;
+    }
+
+    // ------------------------------------------------------------------------------------------
+    // Sender side (thread owning sender index s)
+    // ------------------------------------------------------------------------------------------
+
+    /* Push msg into lane (s, dst) and mark it ready.
+     * Returns false if the lane is full or dst is not attached.
+     */
+    template <class U, typename = std::enable_if_t<std::is_constructible_v<value_type, U &&>>>
+    [[nodiscard]] bool try_send(const size_type s, const size_type dst, U &&msg) {
+        if (RB_UNLIKELY(!try_post(s, dst, std::forward<U>(msg)))) {
+            return false;
+        }
+        notify(s, dst);
+        return true;
+    }
+
+    /* Push without touching the bitmap; follow a burst with one notify(s, dst). */
+    template <class U, typename = std::enable_if_t<std::is_constructible_v<value_type, U &&>>>
+    [[nodiscard]] bool try_post(const size_type s, const size_type dst, U &&msg) {
+        SPSC_ASSERT(s < senders_ && dst < receivers_);
+        column *c = columns_[dst].load(std::memory_order_acquire);
+        if (RB_UNLIKELY(c == nullptr)) {
+            return false;
+        }
+        return c->lanes[s].try_push(std::forward<U>(msg));
+    }
+
+    /* Mark lane (s, dst) ready (see the protocol in the file header). */
+    void notify(const size_type s, const size_type dst) noexcept {
+        SPSC_ASSERT(s < senders_ && dst < receivers_);
+        column *c = columns_[dst].load(std::memory_order_acquire);
+        if (RB_UNLIKELY(c == nullptr)) {
+            return;
+        }
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::atomic<std::uint64_t> &w = c->ready[s / 64u].bits;
+        const std::uint64_t bit = std::uint64_t(1u) << (s % 64u);
+        if (!(w.load(std::memory_order_relaxed) & bit)) {
+            w.fetch_or(bit, std::memory_order_release);
+        }
+    }
+
+    // ------------------------------------------------------------------------------------------
+    // Receiver side (thread owning receiver index r)
+    // ------------------------------------------------------------------------------------------
+
+    /* Drain the ready lanes of receiver r, at most `budget` messages per lane.
+     * fn(src, msg) is called for each message in lane order. Returns the count.
+     */
+    template <class Fn>
+    size_type poll(const size_type r, Fn &&fn, const size_type budget = LaneCapacity) {
+        SPSC_ASSERT(r < receivers_);
+        column *c = columns_[r].load(std::memory_order_acquire);
+        if (RB_UNLIKELY(c == nullptr)) {
+            return 0u;
+        }
+        size_type n = 0u;
+        for (size_type w = 0; w < words_; ++w) {
+            std::atomic<std::uint64_t> &word = c->ready[w].bits;
+            if (RB_LIKELY(word.load(std::memory_order_relaxed) == 0u)) {
+                continue;
+            }
+            std::uint64_t bits = word.exchange(0u, std::memory_order_acq_rel);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            while (bits != 0u) {
+                const unsigned b = detail::mesh_lowest_bit(bits);
+                bits &= bits - 1u;
+                const size_type s = static_cast<size_type>(w * 64u + b);
+                lane_type &lane = c->lanes[s];
+                n += drain_(lane, s, fn, budget);
+                if (!lane.empty()) {
+                    word.fetch_or(std::uint64_t(1u) << b, std::memory_order_relaxed); // budget hit
+                }
+            }
+        }
+        return n;
+    }
+
+    /* Drain every inbound lane of receiver r, ignoring the bitmap
+     * (shutdown, or senders that only use try_post()). */
+    template <class Fn>
+    size_type poll_all(const size_type r, Fn &&fn, const size_type budget = LaneCapacity) {
+        SPSC_ASSERT(r < receivers_);
+        column *c = columns_[r].load(std::memory_order_acquire);
+        if (RB_UNLIKELY(c == nullptr)) {
+            return 0u;
+        }
+        size_type n = 0u;
+        for (size_type s = 0; s < senders_; ++s) {
+            n += drain_(c->lanes[s], s, fn, budget);
+        }
+        return n;
+    }
+
+    /* Any ready bit set for receiver r (relaxed hint, e.g. before parking). */
+    [[nodiscard]] bool ready(const size_type r) const noexcept {
+        SPSC_ASSERT(r < receivers_);
+        const column *c = columns_[r].load(std::memory_order_acquire);
+        if (c == nullptr) {
+            return false;
+        }
+        for (size_type w = 0; w < words_; ++w) {
+            if (c->ready[w].bits.load(std::memory_order_relaxed) != 0u) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /* Raw lane (s, r), e.g. for claim/publish on the sender side. Null if not attached. */
+    [[nodiscard]] lane_type *lane(const size_type s, const size_type r) noexcept {
+        SPSC_ASSERT(s < senders_ && r < receivers_);
+        column *c = columns_[r].load(std::memory_order_acquire);
+        return (c != nullptr) ? &c->lanes[s] : nullptr;
+    }
+
+    // ------------------------------------------------------------------------------------------
+    // Ports (bind an index once, then send(dst, msg) / poll(fn))
+    // ------------------------------------------------------------------------------------------
+    class sender {
+    public:
+        sender(mesh &m, const size_type s) noexcept : m_(&m), s_(s) {}
+
+        template <class U>
+        [[nodiscard]] bool send(const size_type dst, U &&msg) { return m_->try_send(s_, dst, std::forward<U>(msg)); }
+        template <class U>
+        [[nodiscard]] bool post(const size_type dst, U &&msg) { return m_->try_post(s_, dst, std::forward<U>(msg)); }
+        void notify(const size_type dst) noexcept { m_->notify(s_, dst); }
+        [[nodiscard]] size_type index() const noexcept { return s_; }
+
+    private:
+        mesh     *m_;
+        size_type s_;
+    };
+
+    class receiver {
+    public:
+        receiver(mesh &m, const size_type r) noexcept : m_(&m), r_(r) {}
+
+        template <class Fn>
+        size_type poll(Fn &&fn, const size_type budget = LaneCapacity) { return m_->poll(r_, std::forward<Fn>(fn), budget); }
+        template <class Fn>
+        size_type poll_all(Fn &&fn, const size_type budget = LaneCapacity) { return m_->poll_all(r_, std::forward<Fn>(fn), budget); }
+        [[nodiscard]] bool ready() const noexcept { return m_->ready(r_); }
+        [[nodiscard]] size_type index() const noexcept { return r_; }
+
+    private:
+        mesh     *m_;
+        size_type r_;
+    };
+
+private:
+    struct SPSC_ALIGNED(SPSC_CACHELINE_BYTES) ready_word {
+        std::atomic<std::uint64_t> bits{0u};
+    };
+
+    // Inbound column of one receiver: its lanes and bitmap, allocated together.
+    struct column {
+        std::unique_ptr<lane_type[]>  lanes{};
+        std::unique_ptr<ready_word[]> ready{};
+    };
+
+    // Contiguous regions of the lane, one pop(n) at the end.
+    template <class Fn>
+    static size_type drain_(lane_type &lane, const size_type s, Fn &fn, const size_type budget) {
+        const auto rg = lane.claim_read(::spsc::unsafe, budget);
+        for (size_type i = 0; i < rg.first.count; ++i) {
+            fn(s, rg.first.ptr[i]);
+        }
+        for (size_type i = 0; i < rg.second.count; ++i) {
+            fn(s, rg.second.ptr[i]);
+        }
+        if (rg.total != 0u) {
+            lane.pop(rg.total);
+        }
+        return rg.total;
+    }
+
+    void release_() noexcept {
+        if (columns_) {
+            for (size_type r = 0; r < receivers_; ++r) {
+                delete columns_[r].load(std::memory_order_relaxed);
+            }
+        }
+        columns_.reset();
+        senders_ = receivers_ = words_ = 0u;
+    }
+
+    size_type senders_{0u};
+    size_type receivers_{0u};
+    size_type words_{0u};
+    std::unique_ptr<std::atomic<column *>[]> columns_{};
+};
+
+} // namespace spsc
+
+#endif /* SPSC_MESH_HPP_ */
@@ -0,0 +1,225 @@
+/*
+ * packed_chunk.hpp
+ *
+ * Delta + bit-packed chunk of integral samples (compressed chunk_fifo payload).
+ *
+ * Format (per chunk):
+ * - first sample stored verbatim,
+ * - every following sample as zigzag(x[i] - x[i-1]) (modulo 2^bits(T)),
+ * - all deltas packed with one common bit width b (0..bits(T)).
+ *
+ * The packed area has a fixed byte budget (PackedBytes). pack() stores the
+ * longest prefix of the input that fits, so a slowly varying signal fills the
+ * whole ChunkCapacity and a noisy one simply yields shorter chunks. Nothing is
+ * ever truncated or lost: the caller continues from the returned count.
+ *
+ * Decoding dispatches to a kernel compiled for the exact width b (shifts and
+ * masks are constants), followed by a prefix sum.
+ *
+ * Concurrency:
+ * - Not thread-safe. Building block for packed_fifo (packed_fifo.hpp).
+ */
+
+#ifndef SPSC_PACKED_CHUNK_HPP_
+#define SPSC_PACKED_CHUNK_HPP_
+
+#include <array>
+#include <cstdint>
+#include <cstring>      // std::memset
+#include <limits>
+#include <type_traits>
+#include <utility>      // std::index_sequence
+
+#include "basic_types.h"        // reg
+#include "base/spsc_tools.hpp"  // RB_FORCEINLINE, SPSC_ASSERT
+
+namespace spsc {
+
+namespace detail::packed {
+
+template <class T>
+using uword_t = std::conditional_t<(sizeof(T) <= 1u), std::uint8_t,
+                std::conditional_t<(sizeof(T) <= 2u), std::uint16_t, std::uint32_t>>;
+
+template <class T>
+inline constexpr unsigned kBits = static_cast<unsigned>(sizeof(T) * 8u);
+
+// Zigzag on bits(T): small signed deltas map to small unsigned codes.
+template <class T>
+[[nodiscard]] RB_FORCEINLINE std::uint32_t zigzag(const T prev, const T cur) noexcept {
+    using U = uword_t<T>;
+    const U d = static_cast<U>(static_cast<U>(cur) - static_cast<U>(prev));
+    const U sign = static_cast<U>(0u - static_cast<U>(d >> (kBits<T> - 1u)));
+    return static_cast<U>(static_cast<U>(d << 1u) ^ sign);
+}
+
+template <class T>
+[[nodiscard]] RB_FORCEINLINE uword_t<T> unzigzag(const std::uint32_t z) noexcept {
+    using U = uword_t<T>;
+    const U u = static_cast<U>(z);
+    return static_cast<U>(static_cast<U>(u >> 1u) ^ static_cast<U>(0u - static_cast<U>(u & 1u)));
+}
+
+[[nodiscard]] RB_FORCEINLINE unsigned bit_width(std::uint32_t v) noexcept {
+    unsigned b = 0u;
+    while (v != 0u) {
+        ++b;
+        v >>= 1u;
+    }
+    return b;
+}
+
+// Kernel for a compile-time width B: extract n codes, zigzag-decode, prefix-sum.
+template <class T, unsigned B>
+void unpack_fixed(const std::uint64_t *words, const reg n, const T first, T *dst) noexcept {
+    using U = uword_t<T>;
+    U acc = static_cast<U>(first);
+    dst[0] = first;
+    if constexpr (B == 0u) {
+        for (reg i = 1u; i < n; ++i) {
+            dst[i] = first;
+        }
+    } else {
+        constexpr std::uint64_t kMask = (B == 64u) ? ~std::uint64_t{0u} : ((std::uint64_t{1u} << B) - 1u);
+        for (reg i = 1u; i < n; ++i) {
+            const std::uint64_t bit = static_cast<std::uint64_t>(i - 1u) * B;
+            const std::uint64_t w   = bit >> 6u;
+            const unsigned      sh  = static_cast<unsigned>(bit & 63u);
+            std::uint64_t v = words[w] >> sh;
+            if (sh + B > 64u) {
+                v |= words[w + 1u] << (64u - sh);
+            }
+            acc = static_cast<U>(acc + unzigzag<T>(static_cast<std::uint32_t>(v & kMask)));
+            dst[i] = static_cast<T>(acc);
+        }
+    }
+}
+
+template <class T, std::size_t... B>
+constexpr auto make_unpack_table(std::index_sequence<B...>) noexcept {
+    using fn = void (*)(const std::uint64_t *, reg, T, T *) noexcept;
+    return std::array<fn, sizeof...(B)>{&unpack_fixed<T, static_cast<unsigned>(B)>...};
+}
+
+} // namespace detail::packed
+
+/* =======================================================================
+ * packed_chunk<T, ChunkCapacity, PackedBytes>
+ *
+ * T            : integral, sizeof(T) <= 4 (int8..int32 / uint8..uint32).
+ * ChunkCapacity: max samples per chunk.
+ * PackedBytes  : byte budget for the deltas (default: half the raw size).
+ * ======================================================================= */
+template <class T, reg ChunkCapacity,
+          reg PackedBytes = static_cast<reg>((ChunkCapacity * sizeof(T)) / 2u)>
+class packed_chunk {
+    static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>,
+                  "[spsc::packed_chunk]: T must be an integral type");
+    static_assert(sizeof(T) <= 4u,
+                  "[spsc::packed_chunk]: T must be at most 32 bits");
+    static_assert(ChunkCapacity > 0u, "[spsc::packed_chunk]: ChunkCapacity must be > 0");
+    static_assert(PackedBytes > 0u, "[spsc::packed_chunk]: PackedBytes must be > 0");
+
+    static constexpr reg kWords    = static_cast<reg>((PackedBytes + 7u) / 8u);
+    static constexpr reg kBitsCap  = static_cast<reg>(kWords * 64u);
+
+public:
+    using value_type = T;
+    using size_type  = reg;
+
+    static constexpr size_type kCapacity    = ChunkCapacity;
+    static constexpr size_type kPackedBytes = static_cast<size_type>(kWords * 8u);
+
+    packed_chunk() noexcept = default;
+
+    // --------------------------------------------------------------------------
+    // State
+    // --------------------------------------------------------------------------
+    [[nodiscard]] RB_FORCEINLINE size_type size() const noexcept { return count_; }
+    [[nodiscard]] RB_FORCEINLINE bool empty() const noexcept { return count_ == 0u; }
+    [[nodiscard]] static constexpr size_type capacity() noexcept { return kCapacity; }
+
+    /* Delta width chosen by the last pack(). */
+    [[nodiscard]] unsigned bits() const noexcept { return bits_; }
+
+    /* Bytes actually used by the packed deltas (excluding the header). */
+    [[nodiscard]] size_type packed_size() const noexcept {
+        const std::uint64_t nbits = (count_ > 1u) ? static_cast<std::uint64_t>(count_ - 1u) * bits_ : 0u;
+        return static_cast<size_type>((nbits + 7u) / 8u);
+    }
+
+    void clear() noexcept {
+        count_ = 0u;
+        bits_  = 0u;
+    }
+
+    // --------------------------------------------------------------------------
+    // Encode / decode
+    // --------------------------------------------------------------------------
+
+    /* Compress the longest prefix of src[0..n) that fits the budget (at most
+     * kCapacity samples, at least 1 if n != 0). Returns the number stored.
+     */
+    size_type pack(const T *src, const size_type n) noexcept {
+        clear();
+        if (n == 0u) {
+            return 0u;
+        }
+        const size_type limit = (n < kCapacity) ? n : kCapacity;
+
+        // Pass 1: longest prefix whose (k - 1) * width fits kBitsCap.
+        size_type k = 1u;
+        unsigned  b = 0u;
+        for (; k < limit; ++k) {
+            const unsigned w  = detail::packed::bit_width(detail::packed::zigzag<T>(src[k - 1u], src[k]));
+            const unsigned nb = (w > b) ? w : b;
+            if (static_cast<std::uint64_t>(k) * nb > kBitsCap) {
+                break;
+            }
+            b = nb;
+        }
+
+        // Pass 2: pack k - 1 deltas with width b.
+        first_ = src[0];
+        count_ = k;
+        bits_  = static_cast<std::uint8_t>(b);
+        if (b != 0u) {
+            const std::uint64_t used_words = (static_cast<std::uint64_t>(k - 1u) * b + 63u) / 64u;
+            std::memset(words_.data(), 0, static_cast<std::size_t>(used_words + 1u) * sizeof(std::uint64_t));
+            for (size_type i = 1u; i < k; ++i) {
+                const std::uint64_t v   = detail::packed::zigzag<T>(src[i - 1u], src[i]);
+                const std::uint64_t bit = static_cast<std::uint64_t>(i - 1u) * b;
+                const std::uint64_t w   = bit >> 6u;
+                const unsigned      sh  = static_cast<unsigned>(bit & 63u);
+                words_[w] |= v << sh;
+                if (sh + b > 64u) {
+                    words_[w + 1u] |= v >> (64u - sh);
+                }
+            }
+        }
+        return k;
+    }
+
+    /* Decompress all size() samples into dst. Returns size(). */
+    size_type unpack(T *dst) const noexcept {
+        if (count_ == 0u) {
+            return 0u;
+        }
+        static constexpr auto kTable = detail::packed::make_unpack_table<T>(
+            std::make_index_sequence<detail::packed::kBits<T> + 1u>{});
+        SPSC_ASSERT(bits_ <= detail::packed::kBits<T>);
+        kTable[bits_](words_.data(), count_, first_, dst);
+        return count_;
+    }
+
+private:
+    // +1 word: the two-word window of the last code never reads past the end.
+    std::array<std::uint64_t, kWords + 1u> words_{};
+    T                                      first_{};
+    size_type                              count_{0u};
+    std::uint8_t                           bits_{0u};
+};
+
+} // namespace spsc
+
+#endif /* SPSC_PACKED_CHUNK_HPP_ */
@@ -0,0 +1,139 @@
+/*
+ * packed_fifo.hpp
+ *
+ * SPSC FIFO of delta/bit-packed sample chunks (compressed chunk_fifo).
+ *
+ * - Producer: write(src, n) compresses samples into the next free chunk on
+ *   publish; returns how many samples were stored (loop until done).
+ * - Consumer: read(dst, max) decompresses whole chunks straight from the
+ *   claim_read() regions into dst, then pops them with one pop(n). Chunks are
+ *   never split: max must be at least front_size() to make progress, and
+ *   max >= min_read_size() (= ChunkCapacity) always does.
+ *
+ * RAM per chunk is sizeof(packed_chunk<...>) instead of ChunkCapacity * sizeof(T),
+ * so the same memory holds (raw / packed) times more samples whenever the
+ * signal is slowly varying. Noisy input never fails: chunks just carry fewer
+ * samples.
+ */
+
+#ifndef SPSC_PACKED_FIFO_HPP_
+#define SPSC_PACKED_FIFO_HPP_
+
+#include "fifo.hpp"            // ::spsc::fifo, ::spsc::policy::default_policy, reg
+#include "packed_chunk.hpp"    // ::spsc::packed_chunk
+
+namespace spsc {
+
+/* ========================================================================
+ * packed_fifo<T, ChunkCapacity, PackedBytes, FifoCapacity, Policy, Alloc>
+ *
+ * - Uses ::spsc::fifo<packed_chunk<T, ChunkCapacity, PackedBytes>, FifoCapacity, Policy, Alloc>.
+ * - Value-based producer API is hard-disabled (same rule as chunk_fifo);
+ *   use write() or claim() / pack() / publish().
+ * ======================================================================== */
+template<
+    class T,
+    reg   ChunkCapacity,
+    reg   PackedBytes   = static_cast<reg>((ChunkCapacity * sizeof(T)) / 2u),
+    reg   FifoCapacity  = 0,
+    typename Policy     = ::spsc::policy::default_policy,
+    typename Alloc      = ::spsc::alloc::default_alloc
+    >
+class packed_fifo
+    : public ::spsc::fifo<
+          ::spsc::packed_chunk<T, ChunkCapacity, PackedBytes>,
+          FifoCapacity,
+          Policy,
+          Alloc
+          >
+{
+    using ChunkT = ::spsc::packed_chunk<T, ChunkCapacity, PackedBytes>;
+    using Base   = ::spsc::fifo<ChunkT, FifoCapacity, Policy, Alloc>;
+
+public:
+    using value_type      = ChunkT;
+    using sample_type     = T;
+    using size_type       = typename Base::size_type;
+    using reference       = typename Base::reference;
+    using const_reference = typename Base::const_reference;
+
+    using Base::Base;   // inherit fifo constructors
+
+    // --------------------------------------------------------------------
+    // Hard ban on value-based producers.
+    // --------------------------------------------------------------------
+    template<class... Args>
+    void push(Args&&...) = delete;
+
+    template<class... Args>
+    [[nodiscard]] bool try_push(Args&&...) = delete;
+
+    template<class... Args>
+    reference emplace(Args&&...) = delete;
+
+    template<class... Args>
+    [[nodiscard]] value_type* try_emplace(Args&&...) = delete;
+
+    // --------------------------------------------------------------------
+    // Producer
+    // --------------------------------------------------------------------
+
+    /* Compress src[0..n) into as many free chunks as available.
+     * Returns the number of samples stored (< n only if the fifo ran full).
+     */
+    size_type write(const T* src, const size_type n) noexcept {
+        size_type done = 0u;
+        while (done < n) {
+            value_type* c = Base::try_claim();
+            if (!c) {
+                break;
+            }
+            done = static_cast<size_type>(done + c->pack(src + done, static_cast<size_type>(n - done)));
+            Base::publish();
+        }
+        return done;
+    }
+
+    // --------------------------------------------------------------------
+    // Consumer
+    // --------------------------------------------------------------------
+
+    /* Samples held by the next chunk (0 if empty). */
+    [[nodiscard]] size_type front_size() noexcept {
+        const value_type* c = Base::try_front();
+        return c ? c->size() : 0u;
+    }
+
+    /* Smallest max for which read() always makes progress on a non-empty fifo. */
+    [[nodiscard]] static constexpr size_type min_read_size() noexcept { return ChunkCapacity; }
+
+    /* Decompress whole chunks into dst while they fit into max samples.
+     * Returns the number of samples written; chunks are popped in one pop(n).
+     * A chunk is never split: if max < front_size(), nothing is read and 0 is
+     * returned (size dst for min_read_size() samples to avoid that).
+     */
+    size_type read(T* dst, const size_type max) noexcept {
+        const auto r = Base::claim_read(::spsc::unsafe);
+        size_type out    = 0u;
+        size_type chunks = 0u;
+        bool      room   = true;
+        for (const auto& seg : {r.first, r.second}) {
+            for (size_type i = 0u; room && i < seg.count; ++i) {
+                const value_type& c = seg.ptr[i];
+                room = (c.size() <= static_cast<size_type>(max - out));
+                if (room) {
+                    out = static_cast<size_type>(out + c.unpack(dst + out));
+                    ++chunks;
+                }
+            }
+        }
+        if (chunks != 0u) {
+            Base::pop(chunks);
+        }
+        return out;
+    }
+};
+
+} // namespace spsc
+
+#endif /* SPSC_PACKED_FIFO_HPP_ */
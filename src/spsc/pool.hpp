@@ -15,8 +15,14 @@
  *
  * Concurrency model:
  * - Single Producer / Single Consumer (wait-free / lock-free depends on Policy).
- * - Producer:    claim, publish, push (memcpy wrapper).
- * - Consumer:    front, pop, consume, claim_read.
+ * - Producer:    claim, publish, push (memcpy wrapper), push_chain/claim_chain.
+ * - Consumer:    front, pop, consume, claim_read, front_chain/pop_chain.
+ *
+ * CHAINED MESSAGES:
+ * - A payload larger than one buffer spans consecutive slots. The head slot
+ *   starts with a chain_header (payload bytes + slot count); the following
+ *   slots are pure payload. All slots of a chain are published at once.
+ * - A pool carries either chained or plain messages, not a mix.
  *
  * MEMORY LAYOUT NOTE:
  * - pop() does NOT free or destroy anything (buffers are persistent).
@@ -40,9 +46,11 @@
 // Base and utility includes
 #include "base/SPSCbase.hpp"        // ::spsc::SPSCbase<Capacity, Policy>, reg
 #include "base/spsc_alloc.hpp"      // ::spsc::alloc::default_alloc
+#include "base/spsc_layout.hpp"     // ::spsc::layout::report
 #include "base/spsc_snapshot.hpp"   // ::spsc::snapshot_view, ::spsc::snapshot_traits
 #include "base/spsc_regions.hpp"    // ::spsc::bulk::slot_region/slot_regions
 #include "base/spsc_tools.hpp"      // RB_FORCEINLINE, RB_UNLIKELY, SPSC_* macros (also handles <span>)
+#include "base/spsc_trace.hpp"      // SPSC_TRACE (rejection / guard probes)
 
 namespace spsc {
 
@@ -310,6 +318,13 @@ public:
     void clear() noexcept { Base::clear(); }
     [[nodiscard]] base_allocator_type get_allocator() const noexcept { return {}; }
 
+    // Cache-line layout of this instance (see base/spsc_layout.hpp).
+    void describe_layout(::spsc::layout::report& r) const noexcept {
+        Base::describe_layout(r);
+        r.add("slots", &slots_, sizeof(slots_), ::spsc::layout::writer::setup);
+        r.add("buffer_size", &bufferSize_, sizeof(bufferSize_), ::spsc::layout::writer::setup);
+    }
+
     // ------------------------------------------------------------------------------------------
     // Access to the ring of pointers (void**)
     // ------------------------------------------------------------------------------------------
@@ -596,7 +611,7 @@ public:
     template<class U>
     [[nodiscard]] RB_FORCEINLINE bool try_push(const U& v) noexcept {
         static_assert(std::is_trivially_copyable_v<U>, "[pool]: U must be trivially copyable");
-        if (RB_UNLIKELY(full())) { return false; }
+        if (RB_UNLIKELY(full())) { SPSC_TRACE(full, this, size_type(1u), capacity()); return false; }
         if (RB_UNLIKELY(sizeof(U) > bufferSize_.load())) { return false; }
 
         pointer dst = slots_[Base::write_index()];
@@ -611,7 +626,7 @@ public:
     }
 
     [[nodiscard]] RB_FORCEINLINE pointer try_claim() noexcept {
-        if (RB_UNLIKELY(full())) { return nullptr; }
+        if (RB_UNLIKELY(full())) { SPSC_TRACE(full, this, size_type(1u), capacity()); return nullptr; }
         return slots_[Base::write_index()];
     }
 
@@ -650,7 +665,7 @@ public:
     }
 
     [[nodiscard]] RB_FORCEINLINE bool try_publish() noexcept {
-        if (RB_UNLIKELY(full())) { return false; }
+        if (RB_UNLIKELY(full())) { SPSC_TRACE(full, this, size_type(1u), capacity()); return false; }
         Base::increment_head();
         return true;
     }
@@ -661,7 +676,7 @@ public:
     }
 
     [[nodiscard]] RB_FORCEINLINE bool try_publish(const size_type n) noexcept {
-        if (RB_UNLIKELY(!can_write(n))) { return false; }
+        if (RB_UNLIKELY(!can_write(n))) { SPSC_TRACE(full, this, n, capacity()); return false; }
         Base::advance_head(n);
         return true;
     }
@@ -699,7 +714,7 @@ public:
      * Returns false ONLY if the queue is full.
      */
     [[nodiscard]] RB_FORCEINLINE bool try_push(const void* data, const size_type size) noexcept {
-        if (RB_UNLIKELY(full())) { return false; }
+        if (RB_UNLIKELY(full())) { SPSC_TRACE(full, this, size_type(1u), capacity()); return false; }
 
         const size_type bufferSize = bufferSize_.load();
         // Clamp copy size to buffer capacity (saturation)
@@ -728,12 +743,12 @@ public:
     }
 
     [[nodiscard]] RB_FORCEINLINE pointer try_front() noexcept {
-        if (RB_UNLIKELY(empty())) { return nullptr; }
+        if (RB_UNLIKELY(empty())) { SPSC_TRACE(empty, this, size_type(1u), capacity()); return nullptr; }
         return slots_[Base::read_index()];
     }
 
     [[nodiscard]] RB_FORCEINLINE const_pointer try_front() const noexcept {
-        if (RB_UNLIKELY(empty())) { return nullptr; }
+        if (RB_UNLIKELY(empty())) { SPSC_TRACE(empty, this, size_type(1u), capacity()); return nullptr; }
         return slots_[Base::read_index()];
     }
 
@@ -753,7 +768,7 @@ public:
     }
 
     [[nodiscard]] RB_FORCEINLINE bool try_pop() noexcept {
-        if (RB_UNLIKELY(empty())) { return false; }
+        if (RB_UNLIKELY(empty())) { SPSC_TRACE(empty, this, size_type(1u), capacity()); return false; }
         Base::increment_tail();
         return true;
     }
@@ -764,7 +779,7 @@ public:
     }
 
     [[nodiscard]] RB_FORCEINLINE bool try_pop(const size_type n) noexcept {
-        if (RB_UNLIKELY(!can_read(n))) { return false; }
+        if (RB_UNLIKELY(!can_read(n))) { SPSC_TRACE(empty, this, n, capacity()); return false; }
         Base::advance_tail(n);
         return true;
     }
@@ -805,6 +820,194 @@ public:
     }
 #endif /* SPSC_HAS_SPAN */
 
+    // ------------------------------------------------------------------------------------------
+    // Chained Messages (payload > buffer_size())
+    // ------------------------------------------------------------------------------------------
+
+    // Stored at the start of the head slot of every chain.
+    struct chain_header {
+        size_type bytes; // payload bytes
+        size_type count; // slots used by the chain (>= 1)
+    };
+
+    // Payload offset in the head slot (keeps the payload max_align_t-aligned).
+    static constexpr size_type chain_header_size =
+        static_cast<size_type>((sizeof(chain_header) + alignof(std::max_align_t) - 1u) &
+                               ~(alignof(std::max_align_t) - 1u));
+
+    // One contiguous piece of a chained payload.
+    struct chain_segment {
+        std::byte* ptr  = nullptr;
+        size_type  size = 0u;
+
+#if SPSC_HAS_SPAN
+        [[nodiscard]] std::span<std::byte> span() const noexcept { return {ptr, size}; }
+#endif /* SPSC_HAS_SPAN */
+    };
+
+    /*
+     * chain_view
+     * Scatter list over the slots of one chain (zero-copy, no allocation).
+     * Producer side (claim_chain): fill the segments, then publish_chain().
+     * Consumer side (front_chain): read the segments, then pop_chain().
+     * Valid until the chain is published / popped.
+     */
+    class chain_view {
+    public:
+        chain_view() noexcept = default;
+
+        [[nodiscard]] bool      empty()    const noexcept { return slots_ == 0u; }
+        explicit operator bool()           const noexcept { return !empty(); }
+        [[nodiscard]] size_type bytes()    const noexcept { return bytes_; }
+        [[nodiscard]] size_type segments() const noexcept { return slots_; }
+
+        [[nodiscard]] chain_segment segment(const size_type i) const noexcept {
+            SPSC_ASSERT(i < slots_);
+            std::byte* p = static_cast<std::byte*>(ring_[(first_ + i) & mask_]);
+            const size_type head_n = bufferSize_ - chain_header_size;
+            if (i == 0u) {
+                return {p + chain_header_size, (bytes_ < head_n) ? bytes_ : head_n};
+            }
+            const size_type off  = head_n + (i - 1u) * bufferSize_;
+            const size_type left = bytes_ - off;
+            return {p, (left < bufferSize_) ? left : bufferSize_};
+        }
+
+        // Gather into contiguous memory; returns bytes copied (<= cap).
+        size_type copy_to(void* dst, const size_type cap) const noexcept {
+            SPSC_ASSERT((cap == 0u) || (dst != nullptr));
+            std::byte* out = static_cast<std::byte*>(dst);
+            size_type done = 0u;
+            for (size_type i = 0u; (i < slots_) && (done < cap); ++i) {
+                const chain_segment s = segment(i);
+                const size_type n = (s.size < (cap - done)) ? s.size : (cap - done);
+                std::memcpy(out + done, s.ptr, n);
+                done += n;
+            }
+            return done;
+        }
+
+        // Scatter from contiguous memory; returns bytes copied (<= bytes()).
+        size_type copy_from(const void* src, const size_type n) const noexcept {
+            SPSC_ASSERT((n == 0u) || (src != nullptr));
+            const std::byte* in = static_cast<const std::byte*>(src);
+            size_type done = 0u;
+            for (size_type i = 0u; (i < slots_) && (done < n); ++i) {
+                const chain_segment s = segment(i);
+                const size_type k = (s.size < (n - done)) ? s.size : (n - done);
+                std::memcpy(s.ptr, in + done, k);
+                done += k;
+            }
+            return done;
+        }
+
+    private:
+        friend class pool;
+
+        chain_view(pointer const* ring, size_type mask, size_type first,
+                   size_type count, size_type bytes, size_type buffer_size) noexcept
+            : ring_(ring), mask_(mask), first_(first), slots_(count),
+            bytes_(bytes), bufferSize_(buffer_size) {}
+
+        pointer const* ring_       = nullptr;
+        size_type      mask_       = 0u;
+        size_type      first_      = 0u;
+        size_type      slots_      = 0u;
+        size_type      bytes_      = 0u;
+        size_type      bufferSize_ = 0u;
+    };
+
+    // Slots needed for a chain of 'bytes' payload bytes (0 if buffers are too small
+    // for a header or bytes > max_chain_bytes(): such a chain never fits).
+    [[nodiscard]] size_type chain_slots(const size_type bytes) const noexcept {
+        const size_type bs = bufferSize_.load();
+        if (RB_UNLIKELY(bs <= chain_header_size)) { return 0u; }
+        const size_type head_n = bs - chain_header_size;
+        if (bytes <= head_n) { return 1u; }
+        if (RB_UNLIKELY(bytes > max_chain_bytes())) { return 0u; }
+        const size_type rest = static_cast<size_type>(bytes - head_n);
+        return static_cast<size_type>(1u + rest / bs + (((rest % bs) != 0u) ? 1u : 0u));
+    }
+
+    // Largest payload a single chain can carry (whole ring), saturated at the
+    // size_type range when capacity() * buffer_size() does not fit.
+    [[nodiscard]] size_type max_chain_bytes() const noexcept {
+        const size_type bs = bufferSize_.load();
+        if (!is_valid() || (bs <= chain_header_size)) { return 0u; }
+        const size_type cap = static_cast<size_type>(capacity());
+        constexpr size_type kMax = std::numeric_limits<size_type>::max();
+        const size_type total = (cap > (kMax / bs)) ? kMax : static_cast<size_type>(cap * bs);
+        return static_cast<size_type>(total - chain_header_size);
+    }
+
+    /*
+     * try_claim_chain(bytes)
+     * Reserves chain_slots(bytes) slots and writes the head header.
+     * Returns an empty view if the ring has no room (or never can:
+     * bytes > max_chain_bytes() is refused before any slot arithmetic).
+     * Nothing is visible to the consumer until publish_chain().
+     */
+    [[nodiscard]] chain_view try_claim_chain(const size_type bytes) noexcept {
+        if (RB_UNLIKELY(bytes > max_chain_bytes())) { SPSC_TRACE(full, this, size_type(0u), capacity()); return {}; }
+        const size_type n = chain_slots(bytes);
+        if (RB_UNLIKELY((n == 0u) || !can_write(n))) { SPSC_TRACE(full, this, n, capacity()); return {}; }
+        const size_type first = static_cast<size_type>(Base::write_index());
+        const chain_header h{bytes, n};
+        std::memcpy(slots_[first], &h, sizeof(h));
+        return chain_view(data(), static_cast<size_type>(Base::mask()), first, n, bytes, bufferSize_.load());
+    }
+
+    RB_FORCEINLINE void publish_chain(const chain_view& v) noexcept {
+        SPSC_ASSERT(!v.empty());
+        SPSC_ASSERT(v.first_ == static_cast<size_type>(Base::write_index()));
+        publish(v.segments());
+    }
+
+    /*
+     * try_push_chain(data, size)
+     * Copies the whole payload across as many slots as needed.
+     * Returns false if there is not enough room (never truncates).
+     */
+    [[nodiscard]] bool try_push_chain(const void* data, const size_type size) noexcept {
+        if (RB_UNLIKELY((size != 0u) && (data == nullptr))) { return false; }
+        const chain_view v = try_claim_chain(size);
+        if (RB_UNLIKELY(v.empty())) { return false; }
+        (void)v.copy_from(data, size);
+        Base::advance_head(v.segments());
+        return true;
+    }
+
+    /*
+     * try_front_chain()
+     * Scatter view over the oldest chain; empty view if the pool is empty.
+     * A corrupt header (plain message in a chained pool) yields an empty view.
+     */
+    [[nodiscard]] chain_view try_front_chain() const noexcept {
+        if (RB_UNLIKELY(empty())) { SPSC_TRACE(empty, this, size_type(1u), capacity()); return {}; }
+        const size_type first = static_cast<size_type>(Base::read_index());
+        chain_header h{};
+        std::memcpy(&h, slots_[first], sizeof(h));
+        const size_type bs = bufferSize_.load();
+        const bool sane = (h.count != 0u) && (h.count <= Base::size()) && (bs > chain_header_size) &&
+                          (h.count == chain_slots(h.bytes));
+        SPSC_ASSERT(sane);
+        if (RB_UNLIKELY(!sane)) { return {}; }
+        return chain_view(data(), static_cast<size_type>(Base::mask()), first, h.count, h.bytes, bs);
+    }
+
+    RB_FORCEINLINE void pop_chain(const chain_view& v) noexcept {
+        SPSC_ASSERT(!v.empty());
+        SPSC_ASSERT(v.first_ == static_cast<size_type>(Base::read_index()));
+        pop(v.segments());
+    }
+
+    [[nodiscard]] bool try_pop_chain() noexcept {
+        const chain_view v = try_front_chain();
+        if (RB_UNLIKELY(v.empty())) { return false; }
+        Base::advance_tail(v.segments());
+        return true;
+    }
+
     // ------------------------------------------------------------------------------------------
     // Resize / Destroy
     // ------------------------------------------------------------------------------------------
@@ -882,6 +1085,9 @@ public:
         ~bulk_write_guard() noexcept {
             if (p_ != nullptr && written_ != 0u && publish_on_destroy_) {
                 p_->publish(written_);
+                SPSC_TRACE(guard_commit, p_, written_, 0u);
+            } else if (p_ != nullptr && regs_.total != 0u) {
+                SPSC_TRACE(guard_cancel, p_, regs_.total, 0u); // claim dropped
             }
         }
 
@@ -958,11 +1164,17 @@ public:
         void commit() noexcept {
             if (p_ != nullptr && written_ != 0u) {
                 p_->publish(written_);
+                SPSC_TRACE(guard_commit, p_, written_, 0u);
             }
             reset_();
         }
 
-        void cancel() noexcept { reset_(); }
+        void cancel() noexcept {
+            if (p_ != nullptr) {
+                SPSC_TRACE(guard_cancel, p_, regs_.total, 0u);
+            }
+            reset_();
+        }
 
     private:
         [[nodiscard]] pointer slot_ptr_at_(const size_type i) const noexcept {
@@ -1040,6 +1252,7 @@ public:
         ~bulk_read_guard() noexcept {
             if (active_ && p_) {
                 p_->pop(regs_.total);
+                SPSC_TRACE(guard_commit, p_, regs_.total, 0u);
             }
         }
 
@@ -1058,11 +1271,16 @@ public:
         void commit() noexcept {
             if (active_ && p_) {
                 p_->pop(regs_.total);
+                SPSC_TRACE(guard_commit, p_, regs_.total, 0u);
+                active_ = false; // not a cancel
             }
             cancel();
         }
 
         void cancel() noexcept {
+            if (active_ && p_) {
+                SPSC_TRACE(guard_cancel, p_, regs_.total, 0u);
+            }
             active_ = false;
             p_ = nullptr;
             regs_ = {};
@@ -1098,6 +1316,9 @@ public:
             // Note: as<U>() arms automatically; get()/peek() do not.
             if (p_ && ptr_ && publish_on_destroy_) {
                 p_->publish();
+                SPSC_TRACE(guard_commit, p_, 1u, 0u);
+            } else if (p_ && ptr_) {
+                SPSC_TRACE(guard_cancel, p_, 1u, 0u); // claim dropped
             }
         }
 
@@ -1134,12 +1355,17 @@ public:
         void commit() noexcept {
             if (p_ && ptr_) {
                 p_->publish();
+                SPSC_TRACE(guard_commit, p_, 1u, 0u);
+                ptr_ = nullptr; // not a cancel
             }
             cancel();
         }
 
         // Cancel means: do NOT publish.
         void cancel() noexcept {
+            if (p_ && ptr_) {
+                SPSC_TRACE(guard_cancel, p_, 1u, 0u);
+            }
             publish_on_destroy_ = false;
             p_ = nullptr;
             ptr_ = nullptr;
@@ -1171,7 +1397,10 @@ public:
         read_guard& operator=(read_guard&&) = delete;
 
         ~read_guard() noexcept {
-            if (active_ && p_) { p_->pop(); }
+            if (active_ && p_) {
+                p_->pop();
+                SPSC_TRACE(guard_commit, p_, 1u, 0u);
+            }
         }
 
         [[nodiscard]] pointer get() const noexcept { return ptr_; }
@@ -1187,13 +1416,19 @@ public:
         }
 
         void commit() noexcept {
-            if (active_ && p_) { p_->pop(); }
+            if (active_ && p_) {
+                p_->pop();
+                SPSC_TRACE(guard_commit, p_, 1u, 0u);
+            }
             active_ = false;
             p_ = nullptr;
             ptr_ = nullptr;
         }
 
         void cancel() noexcept {
+            if (active_ && p_) {
+                SPSC_TRACE(guard_cancel, p_, 1u, 0u);
+            }
             active_ = false;
             p_ = nullptr;
             ptr_ = nullptr;
@@ -26,9 +26,11 @@
 
 // Base and utility includes
 #include "base/SPSCbase.hpp"        // ::spsc::SPSCbase<Capacity, Policy>, reg
+#include "base/spsc_layout.hpp"     // ::spsc::layout::report
 #include "base/spsc_snapshot.hpp"   // ::spsc::snapshot_view, ::spsc::snapshot_traits
 #include "base/spsc_regions.hpp"    // ::spsc::bulk::slot_region/slot_regions
 #include "base/spsc_tools.hpp"      // RB_FORCEINLINE, RB_UNLIKELY, SPSC_HAS_SPAN
+#include "base/spsc_trace.hpp"      // SPSC_TRACE (rejection / guard probes)
 
 namespace spsc {
 
@@ -325,6 +327,13 @@ public:
 
     void clear() noexcept { Base::clear(); }
 
+    // Cache-line layout of this view (see base/spsc_layout.hpp).
+    void describe_layout(::spsc::layout::report& r) const noexcept {
+        Base::describe_layout(r);
+        r.add("slots", &slots_, sizeof(slots_), ::spsc::layout::writer::setup);
+        r.add("buffer_size", &bufferSize_, sizeof(bufferSize_), ::spsc::layout::writer::setup);
+    }
+
     // Explicit detach: makes the view invalid (does not touch external storage).
     void detach() noexcept {
         slots_ = nullptr;
@@ -759,7 +768,7 @@ public:
     template<class U>
     [[nodiscard]] RB_FORCEINLINE bool try_push(const U& v) noexcept {
         static_assert(std::is_trivially_copyable_v<U>, "[pool_view]: U must be trivially copyable");
-        if (RB_UNLIKELY(full())) { return false; }
+        if (RB_UNLIKELY(full())) { SPSC_TRACE(full, this, size_type(1u), capacity()); return false; }
         if (RB_UNLIKELY(sizeof(U) > bufferSize_.load())) { return false; }
 
         pointer dst = slots_[Base::write_index()];
@@ -777,7 +786,7 @@ public:
     }
 
     [[nodiscard]] RB_FORCEINLINE pointer try_claim() noexcept {
-        if (RB_UNLIKELY(full())) { return nullptr; }
+        if (RB_UNLIKELY(full())) { SPSC_TRACE(full, this, size_type(1u), capacity()); return nullptr; }
         pointer p = slots_[Base::write_index()];
         if (RB_UNLIKELY(p == nullptr)) { return nullptr; }
         return p;
@@ -820,7 +829,7 @@ public:
     }
 
     [[nodiscard]] RB_FORCEINLINE bool try_publish() noexcept {
-        if (RB_UNLIKELY(full())) { return false; }
+        if (RB_UNLIKELY(full())) { SPSC_TRACE(full, this, size_type(1u), capacity()); return false; }
         if (RB_UNLIKELY(slots_[Base::write_index()] == nullptr)) { return false; }
         Base::increment_head();
         return true;
@@ -840,7 +849,7 @@ public:
     }
 
     [[nodiscard]] RB_FORCEINLINE bool try_publish(const size_type n) noexcept {
-        if (RB_UNLIKELY(!can_write(n))) { return false; }
+        if (RB_UNLIKELY(!can_write(n))) { SPSC_TRACE(full, this, n, capacity()); return false; }
         const size_type h = static_cast<size_type>(Base::head());
         const size_type m = Base::mask();
         for (size_type i = 0u; i < n; ++i) {
@@ -869,7 +878,7 @@ public:
     }
 
     [[nodiscard]] RB_FORCEINLINE bool try_push(const void* data, const size_type size) noexcept {
-        if (RB_UNLIKELY(full())) { return false; }
+        if (RB_UNLIKELY(full())) { SPSC_TRACE(full, this, size_type(1u), capacity()); return false; }
 
         const size_type bufferSize = bufferSize_.load();
         const size_type copy_n = (size < bufferSize) ? size : bufferSize;
@@ -902,14 +911,14 @@ public:
     }
 
     [[nodiscard]] RB_FORCEINLINE pointer try_front() noexcept {
-        if (RB_UNLIKELY(empty())) { return nullptr; }
+        if (RB_UNLIKELY(empty())) { SPSC_TRACE(empty, this, size_type(1u), capacity()); return nullptr; }
         pointer p = slots_[Base::read_index()];
         if (RB_UNLIKELY(p == nullptr)) { return nullptr; }
         return p;
     }
 
     [[nodiscard]] RB_FORCEINLINE const_pointer try_front() const noexcept {
-        if (RB_UNLIKELY(empty())) { return nullptr; }
+        if (RB_UNLIKELY(empty())) { SPSC_TRACE(empty, this, size_type(1u), capacity()); return nullptr; }
         const_pointer p = slots_[Base::read_index()];
         if (RB_UNLIKELY(p == nullptr)) { return nullptr; }
         return p;
@@ -931,7 +940,7 @@ public:
     }
 
     [[nodiscard]] RB_FORCEINLINE bool try_pop() noexcept {
-        if (RB_UNLIKELY(empty())) { return false; }
+        if (RB_UNLIKELY(empty())) { SPSC_TRACE(empty, this, size_type(1u), capacity()); return false; }
         Base::increment_tail();
         return true;
     }
@@ -942,7 +951,7 @@ public:
     }
 
     [[nodiscard]] RB_FORCEINLINE bool try_pop(const size_type n) noexcept {
-        if (RB_UNLIKELY(!can_read(n))) { return false; }
+        if (RB_UNLIKELY(!can_read(n))) { SPSC_TRACE(empty, this, n, capacity()); return false; }
         Base::advance_tail(n);
         return true;
     }
@@ -1021,6 +1030,9 @@ public:
         ~bulk_write_guard() noexcept {
             if (p_ != nullptr && written_ != 0u && publish_on_destroy_) {
                 p_->publish(written_);
+                SPSC_TRACE(guard_commit, p_, written_, 0u);
+            } else if (p_ != nullptr && regs_.total != 0u) {
+                SPSC_TRACE(guard_cancel, p_, regs_.total, 0u); // claim dropped
             }
         }
 
@@ -1102,11 +1114,17 @@ public:
         void commit() noexcept {
             if (p_ != nullptr && written_ != 0u) {
                 p_->publish(written_);
+                SPSC_TRACE(guard_commit, p_, written_, 0u);
             }
             reset_();
         }
 
-        void cancel() noexcept { reset_(); }
+        void cancel() noexcept {
+            if (p_ != nullptr) {
+                SPSC_TRACE(guard_cancel, p_, regs_.total, 0u);
+            }
+            reset_();
+        }
 
     private:
         [[nodiscard]] pointer slot_ptr_at_(const size_type i) const noexcept {
@@ -1186,6 +1204,7 @@ public:
         ~bulk_read_guard() noexcept {
             if (active_ && p_) {
                 p_->pop(regs_.total);
+                SPSC_TRACE(guard_commit, p_, regs_.total, 0u);
             }
         }
 
@@ -1204,11 +1223,16 @@ public:
         void commit() noexcept {
             if (active_ && p_) {
                 p_->pop(regs_.total);
+                SPSC_TRACE(guard_commit, p_, regs_.total, 0u);
+                active_ = false; // not a cancel
             }
             cancel();
         }
 
         void cancel() noexcept {
+            if (active_ && p_) {
+                SPSC_TRACE(guard_cancel, p_, regs_.total, 0u);
+            }
             active_ = false;
             p_ = nullptr;
             regs_ = {};
@@ -1242,6 +1266,9 @@ public:
         ~write_guard() noexcept {
             if (p_ && ptr_ && publish_on_destroy_) {
                 p_->publish();
+                SPSC_TRACE(guard_commit, p_, 1u, 0u);
+            } else if (p_ && ptr_) {
+                SPSC_TRACE(guard_cancel, p_, 1u, 0u); // claim dropped
             }
         }
 
@@ -1274,11 +1301,16 @@ public:
         void commit() noexcept {
             if (p_ && ptr_) {
                 p_->publish();
+                SPSC_TRACE(guard_commit, p_, 1u, 0u);
+                ptr_ = nullptr; // not a cancel
             }
             cancel();
         }
 
         void cancel() noexcept {
+            if (p_ && ptr_) {
+                SPSC_TRACE(guard_cancel, p_, 1u, 0u);
+            }
             publish_on_destroy_ = false;
             p_ = nullptr;
             ptr_ = nullptr;
@@ -1311,7 +1343,10 @@ public:
         read_guard& operator=(read_guard&&) = delete;
 
         ~read_guard() noexcept {
-            if (active_ && p_) { p_->pop(); }
+            if (active_ && p_) {
+                p_->pop();
+                SPSC_TRACE(guard_commit, p_, 1u, 0u);
+            }
         }
 
         [[nodiscard]] pointer get() const noexcept { return ptr_; }
@@ -1327,13 +1362,19 @@ public:
         }
 
         void commit() noexcept {
-            if (active_ && p_) { p_->pop(); }
+            if (active_ && p_) {
+                p_->pop();
+                SPSC_TRACE(guard_commit, p_, 1u, 0u);
+            }
             active_ = false;
             p_ = nullptr;
             ptr_ = nullptr;
         }
 
         void cancel() noexcept {
+            if (active_ && p_) {
+                SPSC_TRACE(guard_cancel, p_, 1u, 0u);
+            }
             active_ = false;
             p_ = nullptr;
             ptr_ = nullptr;
@@ -38,10 +38,12 @@
 // Base and utility includes
 #include "base/SPSCbase.hpp"      // ::spsc::SPSCbase<Capacity, Policy>
 #include "base/spsc_alloc.hpp"    // ::spsc::alloc::align_alloc
+#include "base/spsc_layout.hpp"   // ::spsc::layout::report
 #include "base/spsc_object.hpp"   // ::spsc::detail::destroy_at
 #include "base/spsc_regions.hpp"  // ::spsc::bulk::region/raw_region + regions
 #include "base/spsc_snapshot.hpp" // ::spsc::snapshot_view
 #include "base/spsc_tools.hpp"    // RB_FORCEINLINE, RB_UNLIKELY, macros
+#include "base/spsc_trace.hpp"    // SPSC_TRACE (rejection / guard probes)
 
 namespace spsc {
 
@@ -295,6 +297,15 @@ public:
 
     [[nodiscard]] allocator_type get_allocator() const noexcept { return {}; }
 
+    // Cache-line layout of this instance (see base/spsc_layout.hpp).
+    void describe_layout(::spsc::layout::report& r) const noexcept {
+        if constexpr (!kDynamic) {
+            r.add("allocated", &this->isAllocated_, sizeof(this->isAllocated_), ::spsc::layout::writer::setup);
+        }
+        Base::describe_layout(r);
+        r.add("storage", &storage_, sizeof(storage_), ::spsc::layout::writer::setup);
+    }
+
     // Raw storage pointer (WARNING: slots beyond size() are uninitialized).
     [[nodiscard]] pointer data() noexcept { return storage_; }
     [[nodiscard]] const_pointer data() const noexcept { return storage_; }
@@ -605,6 +616,7 @@ public:
                           std::is_constructible_v<value_type, U &&>>>
     [[nodiscard]] RB_FORCEINLINE bool try_push(U &&v) {
         if (RB_UNLIKELY(full())) {
+            SPSC_TRACE(full, this, size_type(1u), capacity());
             return false;
         }
         new (&storage_[Base::write_index()]) value_type(std::forward<U>(v));
@@ -627,6 +639,7 @@ public:
                                 std::is_constructible_v<value_type, Args &&...>>>
     [[nodiscard]] pointer try_emplace(Args &&...args) {
         if (RB_UNLIKELY(full())) {
+            SPSC_TRACE(full, this, size_type(1u), capacity());
             return nullptr;
         }
         pointer slot = &storage_[Base::write_index()];
@@ -645,6 +658,7 @@ public:
 
     [[nodiscard]] RB_FORCEINLINE pointer try_claim() noexcept {
         if (RB_UNLIKELY(full())) {
+            SPSC_TRACE(full, this, size_type(1u), capacity());
             return nullptr;
         }
         return &storage_[Base::write_index()];
@@ -657,6 +671,7 @@ public:
 
     [[nodiscard]] RB_FORCEINLINE bool try_publish() noexcept {
         if (RB_UNLIKELY(full())) {
+            SPSC_TRACE(full, this, size_type(1u), capacity());
             return false;
         }
         Base::increment_head();
@@ -670,6 +685,7 @@ public:
 
     [[nodiscard]] RB_FORCEINLINE bool try_publish(const size_type n) noexcept {
         if (RB_UNLIKELY(!can_write(n))) {
+            SPSC_TRACE(full, this, n, capacity());
             return false;
         }
         Base::advance_head(n);
@@ -691,6 +707,7 @@ public:
 
     [[nodiscard]] RB_FORCEINLINE pointer try_front() noexcept {
         if (RB_UNLIKELY(empty())) {
+            SPSC_TRACE(empty, this, size_type(1u), capacity());
             return nullptr;
         }
         return slot_ptr(Base::read_index());
@@ -698,6 +715,7 @@ public:
 
     [[nodiscard]] RB_FORCEINLINE const_pointer try_front() const noexcept {
         if (RB_UNLIKELY(empty())) {
+            SPSC_TRACE(empty, this, size_type(1u), capacity());
             return nullptr;
         }
         return slot_ptr(Base::read_index());
@@ -713,6 +731,7 @@ public:
 
     [[nodiscard]] RB_FORCEINLINE bool try_pop() noexcept {
         if (RB_UNLIKELY(empty())) {
+            SPSC_TRACE(empty, this, size_type(1u), capacity());
             return false;
         }
         if constexpr (!std::is_trivially_destructible_v<value_type>) {
@@ -748,6 +767,7 @@ public:
 
     [[nodiscard]] RB_FORCEINLINE bool try_pop(const size_type n) noexcept {
         if (RB_UNLIKELY(!can_read(n))) {
+            SPSC_TRACE(empty, this, n, capacity());
             return false;
         }
         pop(n);
@@ -1063,15 +1083,13 @@ public:
                 return;
             }
 
-            if (constructed_ == 0u) {
-                return;
-            }
-
-            if (publish_on_destroy_) {
+            if (constructed_ != 0u && publish_on_destroy_) {
                 q_->publish(constructed_);
+                SPSC_TRACE(guard_commit, q_, constructed_, 0u);
                 return;
             }
 
+            SPSC_TRACE(guard_cancel, q_, regs_.total, 0u); // claim dropped
             destroy_constructed_();
         }
 
@@ -1109,12 +1127,16 @@ public:
         void commit() noexcept {
             if (q_ && constructed_ != 0u) {
                 q_->publish(constructed_);
+                SPSC_TRACE(guard_commit, q_, constructed_, 0u);
             }
             // After publish, consumer owns destruction.
             reset_();
         }
 
         void cancel() noexcept {
+            if (q_ != nullptr) {
+                SPSC_TRACE(guard_cancel, q_, regs_.total, 0u);
+            }
             if (q_ && constructed_ != 0u) {
                 destroy_constructed_();
             }
@@ -1178,6 +1200,7 @@ public:
         ~bulk_read_guard() noexcept {
             if (active_ && q_) {
                 q_->pop(regs_.total);
+                SPSC_TRACE(guard_commit, q_, regs_.total, 0u);
             }
         }
 
@@ -1189,6 +1212,7 @@ public:
         void commit() noexcept {
             if (active_ && q_) {
                 q_->pop(regs_.total);
+                SPSC_TRACE(guard_commit, q_, regs_.total, 0u);
             }
             active_ = false;
             q_ = nullptr;
@@ -1196,6 +1220,9 @@ public:
         }
 
         void cancel() noexcept {
+            if (active_ && q_) {
+                SPSC_TRACE(guard_cancel, q_, regs_.total, 0u);
+            }
             active_ = false;
             q_ = nullptr;
             regs_ = {};
@@ -1234,9 +1261,12 @@ public:
 
             if (publish_on_destroy_ && constructed_) {
                 q_->publish();
+                SPSC_TRACE(guard_commit, q_, 1u, 0u);
                 return;
             }
 
+            SPSC_TRACE(guard_cancel, q_, 1u, 0u); // claim dropped
+
             // Constructed but not published: destroy to avoid leaking a live object
             // in an unclaimed slot.
             if (constructed_) {
@@ -1281,6 +1311,7 @@ public:
                 SPSC_ASSERT(constructed_ && "write_guard::commit() publishing an unconstructed slot");
                 if (constructed_) {
                     q_->publish();
+                    SPSC_TRACE(guard_commit, q_, 1u, 0u);
                 }
             }
 
@@ -1291,6 +1322,9 @@ public:
             ptr_ = nullptr;
         }
         void cancel() noexcept {
+            if (q_ && ptr_) {
+                SPSC_TRACE(guard_cancel, q_, 1u, 0u);
+            }
             if (q_ && ptr_ && constructed_) {
                 detail::destroy_at(std::launder(ptr_));
             }
@@ -1330,6 +1364,7 @@ public:
         ~read_guard() noexcept {
             if (active_ && q_) {
                 q_->pop();
+                SPSC_TRACE(guard_commit, q_, 1u, 0u);
             }
         }
 
@@ -1344,11 +1379,16 @@ public:
         void commit() noexcept {
             if (active_ && q_) {
                 q_->pop();
+                SPSC_TRACE(guard_commit, q_, 1u, 0u);
+                active_ = false; // not a cancel
             }
             cancel();
         }
 
         void cancel() noexcept {
+            if (active_ && q_) {
+                SPSC_TRACE(guard_cancel, q_, 1u, 0u);
+            }
             active_ = false;
             q_ = nullptr;
             ptr_ = nullptr;
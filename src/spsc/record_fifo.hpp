@@ -0,0 +1,446 @@
+/*
+ * record_fifo.hpp
+ *
+ * SPSC ring of fixed-stride byte records whose size is chosen at runtime.
+ *
+ * Sits between pool and array_fifo:
+ * - pool<Capacity>      : runtime buffer size, but one pointer load per slot
+ *                         and one allocation per buffer.
+ * - array_fifo<T, N>    : inline and contiguous, but N is a template argument.
+ * - record_fifo         : record size given to resize(), rounded up to
+ *                         Align (stride); all records inline in ONE allocation.
+ *
+ * Slot i lives at data() + (i & mask) * stride(): no indirection, neighbours
+ * are adjacent in memory (hardware prefetch works), and claim_read()/
+ * claim_write() hand out at most two contiguous stride_regions.
+ *
+ * Concurrency model:
+ * - Single Producer / Single Consumer (wait-free / lock-free depends on Policy).
+ * - Producer:    claim, publish, push (memcpy wrapper), claim_write.
+ * - Consumer:    front, pop, claim_read.
+ *
+ * MEMORY LAYOUT NOTE:
+ * - Records are raw bytes: pop() does not destroy anything.
+ * - resize(), destroy(), clear() are NOT concurrent with push/pop.
+ */
+
+#ifndef SPSC_RECORD_FIFO_HPP_
+#define SPSC_RECORD_FIFO_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>     // std::memcpy
+#include <limits>
+#include <memory>      // std::allocator_traits
+#include <type_traits>
+
+#include "base/SPSCbase.hpp"     // ::spsc::SPSCbase<Capacity, Policy>, reg
+#include "base/spsc_alloc.hpp"   // ::spsc::alloc::align_alloc
+#include "base/spsc_regions.hpp" // ::spsc::bulk::stride_region/stride_regions
+#include "base/spsc_tools.hpp"   // RB_FORCEINLINE, RB_UNLIKELY, SPSC_TRY (also handles <span>)
+
+namespace spsc {
+
+/* =======================================================================
+ * record_fifo<Capacity, Policy, Align, Alloc>
+ *
+ * Capacity : static depth (pow2) or 0 for a runtime depth.
+ * Align    : stride granularity and base alignment (pow2), default max_align_t.
+ * Alloc    : byte allocator (stateless).
+ *
+ * Invalid (unsized) ring behaves like a full+empty queue.
+ * ======================================================================= */
+template <reg Capacity = 0,
+         typename Policy = ::spsc::policy::default_policy,
+         reg Align = alignof(std::max_align_t),
+         typename Alloc = ::spsc::alloc::align_alloc<Align>>
+class record_fifo : private ::spsc::SPSCbase<Capacity, Policy> {
+    static constexpr bool kDynamic = (Capacity == 0);
+    using Base = ::spsc::SPSCbase<Capacity, Policy>;
+
+public:
+    // ------------------------------------------------------------------------------------------
+    // Type Definitions
+    // ------------------------------------------------------------------------------------------
+    using value_type    = std::byte;
+    using pointer       = std::byte *;
+    using const_pointer = const std::byte *;
+    using size_type     = reg;
+    using policy_type   = Policy;
+
+    using allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<std::byte>;
+    using alloc_traits   = std::allocator_traits<allocator_type>;
+
+    using region        = ::spsc::bulk::stride_region<pointer, size_type>;
+    using regions       = ::spsc::bulk::stride_regions<pointer, size_type>;
+    using const_region  = ::spsc::bulk::stride_region<const_pointer, size_type>;
+    using const_regions = ::spsc::bulk::stride_regions<const_pointer, size_type>;
+
+    static constexpr size_type kAlign = Align;
+
+    // ------------------------------------------------------------------------------------------
+    // Static Assertions
+    // ------------------------------------------------------------------------------------------
+    static_assert(::spsc::cap::rb_is_pow2(Align),
+                  "[spsc::record_fifo]: Align must be a power of two.");
+    static_assert(kDynamic || (Capacity >= 2u && ::spsc::cap::rb_is_pow2(Capacity)),
+                  "[spsc::record_fifo]: static Capacity must be a power of two >= 2.");
+    static_assert(kDynamic || (Capacity <= ::spsc::cap::RB_MAX_UNAMBIGUOUS),
+                  "[spsc::record_fifo]: static Capacity exceeds RB_MAX_UNAMBIGUOUS.");
+    static_assert(alloc_traits::is_always_equal::value,
+                  "[spsc::record_fifo]: allocator must be always_equal (stateless).");
+    static_assert(std::is_same_v<typename alloc_traits::pointer, std::byte *>,
+                  "[spsc::record_fifo]: allocator pointer type must be std::byte* (raw).");
+
+    // ------------------------------------------------------------------------------------------
+    // Constructors / Destructor
+    // ------------------------------------------------------------------------------------------
+    record_fifo() = default;
+
+    // Dynamic: request depth + record size.
+    template <size_type C = Capacity, typename = std::enable_if_t<C == 0>>
+    record_fifo(const size_type depth, const size_type record_bytes) {
+        (void)resize(depth, record_bytes);
+    }
+
+    // Static: request record size (depth is Capacity).
+    template <size_type C = Capacity, typename = std::enable_if_t<C != 0>>
+    explicit record_fifo(const size_type record_bytes) {
+        (void)resize(record_bytes);
+    }
+
+    record_fifo(const record_fifo &) = delete;
+    record_fifo &operator=(const record_fifo &) = delete;
+
+    ~record_fifo() noexcept { destroy(); }
+
+    // ------------------------------------------------------------------------------------------
+    // Validity & Introspection
+    // ------------------------------------------------------------------------------------------
+    [[nodiscard]] RB_FORCEINLINE bool is_valid() const noexcept { return storage_ != nullptr; }
+
+    [[nodiscard]] size_type capacity() const noexcept { return is_valid() ? Base::capacity() : 0u; }
+    [[nodiscard]] size_type size()     const noexcept { return is_valid() ? Base::size() : 0u; }
+    [[nodiscard]] bool      empty()    const noexcept { return !is_valid() || Base::empty(); }
+    [[nodiscard]] bool      full()     const noexcept { return !is_valid() || Base::full(); }
+    [[nodiscard]] size_type free()     const noexcept { return is_valid() ? Base::free() : 0u; }
+    [[nodiscard]] bool can_write(const size_type n = 1u) const noexcept { return is_valid() && Base::can_write(n); }
+    [[nodiscard]] bool can_read (const size_type n = 1u) const noexcept { return is_valid() && Base::can_read(n); }
+
+    /* Usable bytes per record (as requested) and distance between records. */
+    [[nodiscard]] size_type record_size() const noexcept { return recordSize_; }
+    [[nodiscard]] size_type stride() const noexcept { return stride_; }
+
+    /* Start of the record storage (capacity() * stride() bytes). */
+    [[nodiscard]] pointer data() noexcept { return storage_; }
+    [[nodiscard]] const_pointer data() const noexcept { return storage_; }
+
+    void clear() noexcept { Base::clear(); }
+
+    [[nodiscard]] static constexpr size_type stride_for(const size_type record_bytes) noexcept {
+        return static_cast<size_type>((record_bytes + (Align - 1u)) & ~(Align - 1u));
+    }
+
+    // ------------------------------------------------------------------------------------------
+    // Producer Operations
+    // ------------------------------------------------------------------------------------------
+    [[nodiscard]] RB_FORCEINLINE pointer claim() noexcept {
+        SPSC_ASSERT(!full());
+        return at_(Base::write_index());
+    }
+
+    [[nodiscard]] RB_FORCEINLINE pointer try_claim() noexcept {
+        if (RB_UNLIKELY(full())) { return nullptr; }
+        return at_(Base::write_index());
+    }
+
+    template <class U>
+    [[nodiscard]] RB_FORCEINLINE U *claim_as() noexcept {
+        static_assert(std::is_trivially_copyable_v<U>, "[spsc::record_fifo]: U must be trivially copyable");
+        static_assert(alignof(U) <= Align, "[spsc::record_fifo]: U is over-aligned for this ring");
+        if (RB_UNLIKELY(sizeof(U) > recordSize_)) { return nullptr; }
+        return reinterpret_cast<U *>(try_claim());
+    }
+
+    RB_FORCEINLINE void publish() noexcept {
+        SPSC_ASSERT(!full());
+        Base::increment_head();
+    }
+
+    [[nodiscard]] RB_FORCEINLINE bool try_publish() noexcept {
+        if (RB_UNLIKELY(full())) { return false; }
+        Base::increment_head();
+        return true;
+    }
+
+    RB_FORCEINLINE void publish(const size_type n) noexcept {
+        SPSC_ASSERT(can_write(n));
+        Base::advance_head(n);
+    }
+
+    [[nodiscard]] RB_FORCEINLINE bool try_publish(const size_type n) noexcept {
+        if (RB_UNLIKELY(!can_write(n))) { return false; }
+        Base::advance_head(n);
+        return true;
+    }
+
+    /*
+     * try_push(data, size)
+     * Copies up to record_size() bytes (truncates). Returns false only if full.
+     */
+    [[nodiscard]] RB_FORCEINLINE bool try_push(const void *data, const size_type size) noexcept {
+        if (RB_UNLIKELY(full())) { return false; }
+        const size_type n = (size < recordSize_) ? size : recordSize_;
+        if (RB_UNLIKELY((n != 0u) && (data == nullptr))) { return false; }
+        if (n != 0u) {
+            std::memcpy(at_(Base::write_index()), data, n);
+        }
+        Base::increment_head();
+        return true;
+    }
+
+    template <class U>
+    [[nodiscard]] RB_FORCEINLINE bool try_push(const U &v) noexcept {
+        static_assert(std::is_trivially_copyable_v<U>, "[spsc::record_fifo]: U must be trivially copyable");
+        if (RB_UNLIKELY(sizeof(U) > recordSize_)) { return false; }
+        return try_push(&v, static_cast<size_type>(sizeof(U)));
+    }
+
+    // ------------------------------------------------------------------------------------------
+    // Consumer Operations
+    // ------------------------------------------------------------------------------------------
+    [[nodiscard]] RB_FORCEINLINE pointer front() noexcept {
+        SPSC_ASSERT(!empty());
+        return at_(Base::read_index());
+    }
+
+    [[nodiscard]] RB_FORCEINLINE const_pointer front() const noexcept {
+        SPSC_ASSERT(!empty());
+        return at_(Base::read_index());
+    }
+
+    [[nodiscard]] RB_FORCEINLINE pointer try_front() noexcept {
+        if (RB_UNLIKELY(empty())) { return nullptr; }
+        return at_(Base::read_index());
+    }
+
+    [[nodiscard]] RB_FORCEINLINE const_pointer try_front() const noexcept {
+        if (RB_UNLIKELY(empty())) { return nullptr; }
+        return at_(Base::read_index());
+    }
+
+    template <class U>
+    [[nodiscard]] RB_FORCEINLINE U *front_as() noexcept {
+        static_assert(std::is_trivially_copyable_v<U>, "[spsc::record_fifo]: U must be trivially copyable");
+        static_assert(alignof(U) <= Align, "[spsc::record_fifo]: U is over-aligned for this ring");
+        if (RB_UNLIKELY(sizeof(U) > recordSize_)) { return nullptr; }
+        return reinterpret_cast<U *>(try_front());
+    }
+
+    RB_FORCEINLINE void pop() noexcept {
+        SPSC_ASSERT(!empty());
+        Base::increment_tail();
+    }
+
+    [[nodiscard]] RB_FORCEINLINE bool try_pop() noexcept {
+        if (RB_UNLIKELY(empty())) { return false; }
+        Base::increment_tail();
+        return true;
+    }
+
+    RB_FORCEINLINE void pop(const size_type n) noexcept {
+        SPSC_ASSERT(can_read(n));
+        Base::advance_tail(n);
+    }
+
+    [[nodiscard]] RB_FORCEINLINE bool try_pop(const size_type n) noexcept {
+        if (RB_UNLIKELY(!can_read(n))) { return false; }
+        Base::advance_tail(n);
+        return true;
+    }
+
+    /* i-th readable record (0 = front). */
+    [[nodiscard]] RB_FORCEINLINE pointer operator[](const size_type i) noexcept {
+        SPSC_ASSERT(i < size());
+        return at_(static_cast<size_type>((Base::tail() + i) & Base::mask()));
+    }
+
+    [[nodiscard]] RB_FORCEINLINE const_pointer operator[](const size_type i) const noexcept {
+        SPSC_ASSERT(i < size());
+        return at_(static_cast<size_type>((Base::tail() + i) & Base::mask()));
+    }
+
+#if SPSC_HAS_SPAN
+    /* Front record as a span of record_size() bytes (empty span if none). */
+    [[nodiscard]] std::span<std::byte> span() noexcept {
+        pointer p = try_front();
+        if (!p) { return {}; }
+        return {p, static_cast<std::size_t>(recordSize_)};
+    }
+#endif /* SPSC_HAS_SPAN */
+
+    // ------------------------------------------------------------------------------------------
+    // Bulk / Regions
+    // ------------------------------------------------------------------------------------------
+    [[nodiscard]] regions claim_write(const ::spsc::unsafe_t,
+                                      const size_type max_count = std::numeric_limits<size_type>::max()) noexcept {
+        if (RB_UNLIKELY(!is_valid())) { return {}; }
+        return make_regions_<regions>(storage_, Base::head(), Base::free(), max_count);
+    }
+
+    [[nodiscard]] regions claim_read(const ::spsc::unsafe_t,
+                                     const size_type max_count = std::numeric_limits<size_type>::max()) noexcept {
+        if (RB_UNLIKELY(!is_valid())) { return {}; }
+        return make_regions_<regions>(storage_, Base::tail(), Base::size(), max_count);
+    }
+
+    [[nodiscard]] const_regions claim_read(const ::spsc::unsafe_t,
+                                           const size_type max_count = std::numeric_limits<size_type>::max()) const noexcept {
+        if (RB_UNLIKELY(!is_valid())) { return {}; }
+        return make_regions_<const_regions>(static_cast<const_pointer>(storage_), Base::tail(), Base::size(), max_count);
+    }
+
+    // ------------------------------------------------------------------------------------------
+    // Resize / Destroy
+    // ------------------------------------------------------------------------------------------
+
+    /* Dynamic-only: (re)size to depth records of record_bytes each.
+     * Grow-only for a valid ring (depth and record size never shrink); queued
+     * records are kept in order. depth == 0 or record_bytes == 0 releases storage.
+     * Returns false on allocation failure (ring unchanged).
+     */
+    template <size_type C = Capacity, typename = std::enable_if_t<C == 0>>
+    [[nodiscard]] bool resize(const size_type depth, const size_type record_bytes) {
+        return reallocate_(depth, record_bytes);
+    }
+
+    /* Static-only: (re)allocate records of record_bytes (grow-only). */
+    template <size_type C = Capacity, typename = std::enable_if_t<C != 0>>
+    [[nodiscard]] bool resize(const size_type record_bytes) {
+        return reallocate_(Capacity, record_bytes);
+    }
+
+    void destroy() noexcept {
+        if (storage_ != nullptr) {
+            allocator_type a{};
+            alloc_traits::deallocate(a, storage_, bytes_());
+        }
+        storage_    = nullptr;
+        recordSize_ = 0u;
+        stride_     = 0u;
+        if constexpr (kDynamic) {
+            (void)Base::init(0u);
+        } else {
+            Base::clear();
+        }
+    }
+
+private:
+    [[nodiscard]] RB_FORCEINLINE pointer at_(const size_type idx) const noexcept {
+        return storage_ + static_cast<std::size_t>(idx) * static_cast<std::size_t>(stride_);
+    }
+
+    [[nodiscard]] std::size_t bytes_() const noexcept {
+        return static_cast<std::size_t>(Base::capacity()) * static_cast<std::size_t>(stride_);
+    }
+
+    template <class Regions, class Ptr>
+    [[nodiscard]] Regions make_regions_(Ptr base, const size_type seq, const size_type avail,
+                                        const size_type max_count) const noexcept {
+        const size_type total = (max_count < avail) ? max_count : avail;
+        if (RB_UNLIKELY(total == 0u)) {
+            return {};
+        }
+        const size_type cap    = Base::capacity();
+        const size_type idx    = static_cast<size_type>(seq & Base::mask());
+        const size_type to_end = static_cast<size_type>(cap - idx);
+        const size_type first  = (to_end < total) ? to_end : total;
+
+        Regions r{};
+        r.first.ptr     = base + static_cast<std::size_t>(idx) * stride_;
+        r.first.count   = first;
+        r.first.stride  = stride_;
+        r.first.size    = recordSize_;
+        r.second.count  = static_cast<size_type>(total - first);
+        r.second.ptr    = (r.second.count != 0u) ? base : nullptr;
+        r.second.stride = stride_;
+        r.second.size   = recordSize_;
+        r.total         = total;
+        return r;
+    }
+
+    [[nodiscard]] bool reallocate_(const size_type requested_depth, const size_type record_bytes) {
+        if (requested_depth == 0u || record_bytes == 0u) {
+            destroy();
+            return true;
+        }
+
+        size_type depth = requested_depth;
+        if (depth < 2u) { depth = 2u; }
+        if (depth > ::spsc::cap::RB_MAX_UNAMBIGUOUS) { depth = ::spsc::cap::RB_MAX_UNAMBIGUOUS; }
+        depth = ::spsc::cap::rb_next_power2(depth);
+        if constexpr (!kDynamic) {
+            depth = Capacity;
+        }
+
+        size_type rec = record_bytes;
+        const size_type old_cap = is_valid() ? static_cast<size_type>(Base::capacity()) : 0u;
+        if (is_valid()) {
+            depth = (depth < old_cap) ? old_cap : depth;
+            rec   = (rec < recordSize_) ? recordSize_ : rec;
+            if (depth == old_cap && rec == recordSize_) {
+                return true;
+            }
+        }
+        const size_type new_stride = stride_for(rec);
+        if (RB_UNLIKELY(new_stride == 0u ||
+                        new_stride > std::numeric_limits<std::size_t>::max() / depth)) {
+            return false;
+        }
+
+        allocator_type a{};
+        pointer fresh = nullptr;
+        SPSC_TRY {
+            fresh = alloc_traits::allocate(a, static_cast<std::size_t>(depth) * new_stride);
+        } SPSC_CATCH_ALL {
+            fresh = nullptr;
+        }
+        if (RB_UNLIKELY(fresh == nullptr)) {
+            return false;
+        }
+
+        // Migrate queued records to [0, used) (non-concurrent by contract).
+        size_type used = 0u;
+        if (is_valid()) {
+            used = static_cast<size_type>(Base::size());
+            const size_type tail = static_cast<size_type>(Base::tail());
+            for (size_type i = 0; i < used; ++i) {
+                std::memcpy(fresh + static_cast<std::size_t>(i) * new_stride,
+                            at_(static_cast<size_type>((tail + i) & Base::mask())), recordSize_);
+            }
+            alloc_traits::deallocate(a, storage_, bytes_());
+        }
+
+        storage_    = fresh;
+        recordSize_ = rec;
+        stride_     = new_stride;
+        if constexpr (kDynamic) {
+            const bool ok = Base::init(depth, used, 0u);
+            SPSC_ASSERT(ok);
+            (void)ok;
+        } else {
+            const bool ok = Base::init(used, 0u);
+            SPSC_ASSERT(ok);
+            (void)ok;
+        }
+        return true;
+    }
+
+    pointer   storage_{nullptr};
+    size_type recordSize_{0u};
+    size_type stride_{0u};
+};
+
+} // namespace spsc
+
+#endif /* SPSC_RECORD_FIFO_HPP_ */
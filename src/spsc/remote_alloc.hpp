@@ -0,0 +1,427 @@
+/*
+ * remote_alloc.hpp
+ *
+ * Thread-aware object heap with remote frees over SPSC return rings.
+ *
+ * Model (T registered threads, indices 0..T-1):
+ * - Every thread owns an arena: one intrusive free list per size class,
+ *   refilled from slabs that only the owner carves.
+ * - Every block remembers its owner. A free on the owner thread is a plain
+ *   free-list push. A free on another thread f is a push into the return ring
+ *   (f -> owner): one SPSC fifo per ordered thread pair.
+ * - The owner reclaims returned blocks in batches (claim_read + pop(n)) when a
+ *   size class runs dry, or explicitly via reclaim().
+ *
+ * No locks, no CAS: allocation and local free touch owner-only state; a remote
+ * free is a single wait-free ring push. If a return ring is full, the block is
+ * parked on a list private to the freeing thread and flushed on its next free
+ * or flush() call, so a remote free never waits for the owner.
+ *
+ * Requests larger than MaxBlock bypass the arenas (global aligned operator new) and
+ * can be freed from any thread.
+ *
+ * Contract:
+ * - A thread index is used by one thread at a time (like executor submitters).
+ * - All blocks must be freed (or abandoned) before the heap is destroyed;
+ *   destruction releases every slab at once.
+ * - Failure is reported as nullptr (no exceptions).
+ */
+
+#ifndef SPSC_REMOTE_ALLOC_HPP_
+#define SPSC_REMOTE_ALLOC_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>     // std::memcpy
+#include <memory>      // std::unique_ptr
+#include <new>         // std::nothrow, std::align_val_t, placement new
+#include <type_traits>
+#include <utility>     // std::forward
+
+#include "base/spsc_cacheline.hpp" // SPSC_ALIGNED, SPSC_CACHELINE_BYTES
+#include "base/spsc_policy.hpp"    // ::spsc::policy::CA
+#include "base/spsc_tools.hpp"     // RB_FORCEINLINE, RB_LIKELY, RB_UNLIKELY
+#include "fifo.hpp"                // ::spsc::fifo
+
+namespace spsc::alloc {
+
+/* =======================================================================
+ * remote_heap<MinBlock, MaxBlock, ReturnCapacity, SlabBytes>
+ *
+ * MinBlock       : smallest size class (pow2, >= sizeof(void*)); classes
+ *                  below kAlign still take a kAlign-multiple slab stride.
+ * MaxBlock       : largest size class (pow2); bigger requests go to operator new.
+ * ReturnCapacity : capacity of every (freeing thread -> owner) return ring.
+ * SlabBytes      : bytes requested from the system per arena refill.
+ * ======================================================================= */
+template <reg MinBlock = 16u,
+         reg MaxBlock = 4096u,
+         reg ReturnCapacity = 1024u,
+         reg SlabBytes = 64u * 1024u>
+class remote_heap {
+    static constexpr bool is_pow2_(const reg v) noexcept { return (v != 0u) && ((v & (v - 1u)) == 0u); }
+
+    static constexpr reg log2_(reg v) noexcept {
+        reg r = 0u;
+        while (v > 1u) {
+            v >>= 1u;
+            ++r;
+        }
+        return r;
+    }
+
+public:
+    // ------------------------------------------------------------------------------------------
+    // Type Definitions
+    // ------------------------------------------------------------------------------------------
+    using size_type   = reg;
+    using return_ring = ::spsc::fifo<void *, ReturnCapacity, ::spsc::policy::CA<>>;
+
+    static constexpr size_type npos      = static_cast<size_type>(~size_type(0));
+    static constexpr size_type kClasses  = log2_(MaxBlock) - log2_(MinBlock) + 1u;
+    static constexpr size_type kHeader   = 16u; // keeps payloads 16-byte aligned
+    static constexpr size_type kAlign    = kHeader;
+
+    // ------------------------------------------------------------------------------------------
+    // Static Assertions
+    // ------------------------------------------------------------------------------------------
+    static_assert(is_pow2_(MinBlock) && is_pow2_(MaxBlock),
+                  "[spsc::alloc::remote_heap]: MinBlock/MaxBlock must be pow2.");
+    static_assert(MinBlock >= sizeof(void *) && MinBlock <= MaxBlock,
+                  "[spsc::alloc::remote_heap]: need sizeof(void*) <= MinBlock <= MaxBlock.");
+    static_assert(is_pow2_(ReturnCapacity),
+                  "[spsc::alloc::remote_heap]: ReturnCapacity must be pow2.");
+    static_assert(SlabBytes >= MaxBlock + kHeader + sizeof(void *),
+                  "[spsc::alloc::remote_heap]: SlabBytes must hold at least one MaxBlock.");
+
+    // ------------------------------------------------------------------------------------------
+    // Constructors / Destructor
+    // ------------------------------------------------------------------------------------------
+    remote_heap() noexcept = default;
+
+    explicit remote_heap(const size_type threads) noexcept { (void)init(threads); }
+
+    remote_heap(const remote_heap &) = delete;
+    remote_heap &operator=(const remote_heap &) = delete;
+    remote_heap(remote_heap &&) = delete;
+    remote_heap &operator=(remote_heap &&) = delete;
+
+    ~remote_heap() { release_(); }
+
+    /* Allocate per-thread arenas and the T x T return rings.
+     * Returns false on invalid arguments, allocation failure or when already
+     * initialized. Non-concurrent.
+     */
+    [[nodiscard]] bool init(const size_type threads) noexcept {
+        if (RB_UNLIKELY(threads_ != 0u || threads == 0u)) {
+            return false;
+        }
+
+        std::unique_ptr<thread_state[]> st(new (std::nothrow) thread_state[threads]);
+        std::unique_ptr<return_ring[]>  rings(new (std::nothrow) return_ring[threads * threads]);
+        std::unique_ptr<void *[]>       parked(new (std::nothrow) void *[threads * threads]);
+        if (RB_UNLIKELY(!st || !rings || !parked)) {
+            return false;
+        }
+        for (size_type i = 0; i < threads * threads; ++i) {
+            if (RB_UNLIKELY(!rings[i].is_valid())) {
+                return false;
+            }
+            parked[i] = nullptr;
+        }
+
+        threads_ = threads;
+        state_   = std::move(st);
+        rings_   = std::move(rings);
+        parked_  = std::move(parked);
+        return true;
+    }
+
+    [[nodiscard]] bool is_valid() const noexcept { return threads_ != 0u; }
+    [[nodiscard]] size_type threads() const noexcept { return threads_; }
+
+    // ------------------------------------------------------------------------------------------
+    // Allocation (thread `self`)
+    // ------------------------------------------------------------------------------------------
+
+    /* 16-byte aligned block of at least `bytes`. nullptr on failure. */
+    [[nodiscard]] void *allocate(const size_type self, const size_type bytes) noexcept {
+        SPSC_ASSERT(self < threads_);
+        if (RB_UNLIKELY(bytes > MaxBlock)) {
+            return large_alloc_(bytes);
+        }
+
+        const size_type cls = class_of_(bytes);
+        thread_state &st = state_[self];
+
+        void *p = st.free[cls];
+        if (RB_UNLIKELY(!p)) {
+            (void)reclaim(self);
+            p = st.free[cls];
+            if (!p) {
+                if (RB_UNLIKELY(!carve_(self, cls))) {
+                    return nullptr;
+                }
+                p = st.free[cls];
+            }
+        }
+        st.free[cls] = next_of_(p);
+        return p;
+    }
+
+    /* Free from any registered thread `self`. Wait-free for remote frees. */
+    void deallocate(const size_type self, void *p) noexcept {
+        if (RB_UNLIKELY(!p)) {
+            return;
+        }
+        SPSC_ASSERT(self < threads_);
+
+        const header h = header_of_(p);
+        if (RB_UNLIKELY(h.owner == kLargeOwner)) {
+            ::operator delete(static_cast<std::byte *>(p) - kHeader, std::align_val_t(kAlign));
+            return;
+        }
+        SPSC_ASSERT(h.owner < threads_ && h.cls < kClasses);
+
+        thread_state &st = state_[self];
+        if (RB_LIKELY(h.owner == self)) {
+            push_free_(st, h.cls, p);
+            bump_(st.local_frees);
+            return;
+        }
+
+        bump_(st.remote_frees);
+        void *&park = parked_[self * threads_ + h.owner];
+        if (RB_UNLIKELY(park != nullptr)) {
+            flush_lane_(self, h.owner);
+        }
+        if (RB_UNLIKELY(park != nullptr || !rings_[h.owner * threads_ + self].try_push(p))) {
+            set_next_(p, park);
+            park = p;
+        }
+    }
+
+    /* Push every parked remote free of thread `self` into its return rings.
+     * Returns the number of blocks still parked (rings full).
+     */
+    size_type flush(const size_type self) noexcept {
+        SPSC_ASSERT(self < threads_);
+        size_type left = 0u;
+        for (size_type o = 0; o < threads_; ++o) {
+            if (parked_[self * threads_ + o]) {
+                flush_lane_(self, o);
+                for (void *q = parked_[self * threads_ + o]; q; q = next_of_(q)) {
+                    ++left;
+                }
+            }
+        }
+        return left;
+    }
+
+    /* Owner: drain every return ring into the local free lists (batched). */
+    size_type reclaim(const size_type self) noexcept {
+        SPSC_ASSERT(self < threads_);
+        thread_state &st = state_[self];
+        size_type n = 0u;
+        for (size_type f = 0; f < threads_; ++f) {
+            if (f == self) {
+                continue;
+            }
+            return_ring &ring = rings_[self * threads_ + f];
+            const auto r = ring.claim_read(::spsc::unsafe);
+            if (r.total == 0u) {
+                continue;
+            }
+            for (size_type i = 0; i < r.first.count; ++i) {
+                void *p = r.first.ptr[i];
+                push_free_(st, header_of_(p).cls, p);
+            }
+            for (size_type i = 0; i < r.second.count; ++i) {
+                void *p = r.second.ptr[i];
+                push_free_(st, header_of_(p).cls, p);
+            }
+            ring.pop(r.total);
+            n += r.total;
+        }
+        if (n != 0u) {
+            st.reclaimed.store(st.reclaimed.load(std::memory_order_relaxed) + n,
+                               std::memory_order_relaxed);
+        }
+        return n;
+    }
+
+    // ------------------------------------------------------------------------------------------
+    // Typed helpers
+    // ------------------------------------------------------------------------------------------
+    template <class T, class... Args>
+    [[nodiscard]] T *make(const size_type self, Args &&...args) noexcept(
+        std::is_nothrow_constructible_v<T, Args &&...>) {
+        static_assert(alignof(T) <= kAlign,
+                      "[spsc::alloc::remote_heap]: T is over-aligned for this heap.");
+        void *p = allocate(self, sizeof(T));
+        if (RB_UNLIKELY(!p)) {
+            return nullptr;
+        }
+        return ::new (p) T(std::forward<Args>(args)...);
+    }
+
+    template <class T>
+    void destroy(const size_type self, T *p) noexcept {
+        if (p) {
+            p->~T();
+            deallocate(self, p);
+        }
+    }
+
+    // ------------------------------------------------------------------------------------------
+    // Observers (any thread, relaxed)
+    // ------------------------------------------------------------------------------------------
+    [[nodiscard]] size_type local_frees(const size_type t) const noexcept { return stat_(t, &thread_state::local_frees); }
+    [[nodiscard]] size_type remote_frees(const size_type t) const noexcept { return stat_(t, &thread_state::remote_frees); }
+    [[nodiscard]] size_type reclaimed(const size_type t) const noexcept { return stat_(t, &thread_state::reclaimed); }
+    [[nodiscard]] size_type slabs(const size_type t) const noexcept { return stat_(t, &thread_state::slabs); }
+
+    [[nodiscard]] static constexpr size_type class_size(const size_type cls) noexcept {
+        return static_cast<size_type>(MinBlock << cls);
+    }
+
+private:
+    static constexpr std::uint32_t kLargeOwner = 0xFFFFFFFFu;
+
+    struct header {
+        std::uint32_t owner;
+        std::uint32_t cls;
+    };
+    static_assert(sizeof(header) <= kHeader, "[spsc::alloc::remote_heap]: header too large");
+
+    // Header + block, rounded up so every payload in a slab stays kAlign-aligned.
+    // Slabs and large blocks come from operator new(n, align_val_t(kAlign)), so
+    // this holds even where __STDCPP_DEFAULT_NEW_ALIGNMENT__ is below kAlign.
+    static constexpr size_type stride_(const size_type cls) noexcept {
+        return static_cast<size_type>((class_size(cls) + kHeader + kAlign - 1u) & ~(kAlign - 1u));
+    }
+    static_assert(stride_(0u) % kAlign == 0u && kHeader % kAlign == 0u,
+                  "[spsc::alloc::remote_heap]: slab stride breaks payload alignment.");
+
+    // Owner-only state (statistics are relaxed atomics for observers).
+    struct SPSC_ALIGNED(SPSC_CACHELINE_BYTES) thread_state {
+        void *free[kClasses]{};
+        void *slab_list{nullptr};
+        std::atomic<size_type> local_frees{0u};
+        std::atomic<size_type> remote_frees{0u};
+        std::atomic<size_type> reclaimed{0u};
+        std::atomic<size_type> slabs{0u};
+    };
+
+    static RB_FORCEINLINE size_type class_of_(const size_type bytes) noexcept {
+        size_type cls = 0u;
+        size_type sz = MinBlock;
+        while (sz < bytes) {
+            sz <<= 1u;
+            ++cls;
+        }
+        return cls;
+    }
+
+    static RB_FORCEINLINE header header_of_(void *p) noexcept {
+        header h;
+        std::memcpy(&h, static_cast<std::byte *>(p) - kHeader, sizeof(h));
+        return h;
+    }
+
+    static RB_FORCEINLINE void *next_of_(void *p) noexcept {
+        void *n;
+        std::memcpy(&n, p, sizeof(n));
+        return n;
+    }
+
+    static RB_FORCEINLINE void set_next_(void *p, void *n) noexcept { std::memcpy(p, &n, sizeof(n)); }
+
+    static RB_FORCEINLINE void push_free_(thread_state &st, const std::uint32_t cls, void *p) noexcept {
+        set_next_(p, st.free[cls]);
+        st.free[cls] = p;
+    }
+
+    static RB_FORCEINLINE void bump_(std::atomic<size_type> &c) noexcept {
+        c.store(c.load(std::memory_order_relaxed) + 1u, std::memory_order_relaxed);
+    }
+
+    size_type stat_(const size_type t, std::atomic<size_type> thread_state::*m) const noexcept {
+        SPSC_ASSERT(t < threads_);
+        return (state_[t].*m).load(std::memory_order_relaxed);
+    }
+
+    static void *large_alloc_(const size_type bytes) noexcept {
+        if (RB_UNLIKELY(bytes > (npos - kHeader))) {
+            return nullptr;
+        }
+        auto *raw = static_cast<std::byte *>(
+            ::operator new(bytes + kHeader, std::align_val_t(kAlign), std::nothrow));
+        if (RB_UNLIKELY(!raw)) {
+            return nullptr;
+        }
+        const header h{kLargeOwner, 0u};
+        std::memcpy(raw, &h, sizeof(h));
+        return raw + kHeader;
+    }
+
+    // Slab layout: [next slab ptr | pad to kHeader][hdr|block|pad][hdr|block|pad]...
+    // (each [hdr|block|pad] is stride_(cls) bytes).
+    bool carve_(const size_type self, const size_type cls) noexcept {
+        thread_state &st = state_[self];
+        auto *slab = static_cast<std::byte *>(::operator new(SlabBytes, std::align_val_t(kAlign), std::nothrow));
+        if (RB_UNLIKELY(!slab)) {
+            return false;
+        }
+        std::memcpy(slab, &st.slab_list, sizeof(void *));
+        st.slab_list = slab;
+        bump_(st.slabs);
+
+        const size_type stride = stride_(cls);
+        const header h{static_cast<std::uint32_t>(self), static_cast<std::uint32_t>(cls)};
+        for (size_type off = kHeader; off + stride <= SlabBytes; off += stride) {
+            std::byte *blk = slab + off;
+            std::memcpy(blk, &h, sizeof(h));
+            push_free_(st, static_cast<std::uint32_t>(cls), blk + kHeader);
+        }
+        return true;
+    }
+
+    void flush_lane_(const size_type self, const size_type owner) noexcept {
+        void *&park = parked_[self * threads_ + owner];
+        return_ring &ring = rings_[owner * threads_ + self];
+        while (park) {
+            void *next = next_of_(park);
+            if (!ring.try_push(park)) {
+                return;
+            }
+            park = next;
+        }
+    }
+
+    void release_() noexcept {
+        for (size_type t = 0; t < threads_; ++t) {
+            void *s = state_[t].slab_list;
+            while (s) {
+                void *next;
+                std::memcpy(&next, s, sizeof(void *));
+                ::operator delete(s, std::align_val_t(kAlign));
+                s = next;
+            }
+        }
+        threads_ = 0u;
+        state_.reset();
+        rings_.reset();
+        parked_.reset();
+    }
+
+    size_type threads_{0u};
+    std::unique_ptr<thread_state[]> state_{};
+    std::unique_ptr<return_ring[]>  rings_{};   // [owner * T + freeing thread]
+    std::unique_ptr<void *[]>       parked_{};  // [freeing thread * T + owner], freeing-thread-owned
+};
+
+} // namespace spsc::alloc
+
+#endif /* SPSC_REMOTE_ALLOC_HPP_ */
@@ -0,0 +1,388 @@
+/*
+ * scan.hpp
+ *
+ * Delimiter / pattern scanners for byte rings (frame decoders).
+ *
+ * Works on the two contiguous segments of a ring:
+ * - claim_read(::spsc::unsafe) result of fifo / fifo_view of 1-byte elements,
+ * - snapshot / const_snapshot of the same,
+ * - a plain (ptr, count) range (e.g. one chunk of chunk_fifo<std::byte>).
+ *
+ * All results are ring-relative offsets (0 == current tail), so one frame is
+ * consumed with q.pop(off + 1). "Not found" returns total (like std::find
+ * returning end()). Patterns split across the wrap point are found.
+ *
+ * Kernels:
+ * - find_byte    : memchr per segment (the libc one is vectorised on every
+ *                  mainstream target).
+ * - find_any_of  : SSE2 compare/or/movemask over 16 bytes when available and
+ *                  the set has <= byte_set::kSimdMax members; otherwise a
+ *                  256-bit membership table.
+ * - find_pattern : memchr for the first byte + memcmp, seam candidates are
+ *                  compared piecewise.
+ *
+ * Build toggle:
+ *   - SPSC_SCAN_SIMD (default: 1 when SSE2 is available, else 0)
+ */
+
+#ifndef SPSC_SCAN_HPP_
+#define SPSC_SCAN_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>          // std::memchr, std::memcmp, std::memcpy
+#include <initializer_list>
+#include <type_traits>
+
+#include "base/spsc_regions.hpp"  // ::spsc::bulk::region_pair
+#include "base/spsc_snapshot.hpp" // ::spsc::snapshot_view, ::spsc::const_snapshot_view
+#include "base/spsc_tools.hpp"    // RB_FORCEINLINE, RB_LIKELY
+
+#ifndef SPSC_SCAN_SIMD
+#  if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#    define SPSC_SCAN_SIMD 1
+#  else
+#    define SPSC_SCAN_SIMD 0
+#  endif
+#endif /* SPSC_SCAN_SIMD */
+
+#if SPSC_SCAN_SIMD
+#  include <emmintrin.h>
+#  if defined(_MSC_VER) && !defined(__clang__)
+#    include <intrin.h>     // _BitScanForward
+#  endif
+#endif /* SPSC_SCAN_SIMD */
+
+namespace spsc::scan {
+
+/* =======================================================================
+ * byte_set: up to 256 delimiter values
+ *
+ * The first kSimdMax values are also kept as a list for the SIMD kernel.
+ * ======================================================================= */
+class byte_set {
+public:
+    static constexpr std::size_t kSimdMax = 8u;
+
+    constexpr byte_set() noexcept = default;
+
+    constexpr byte_set(std::initializer_list<unsigned char> values) noexcept {
+        for (const unsigned char v : values) {
+            insert(v);
+        }
+    }
+
+    constexpr void insert(const unsigned char v) noexcept {
+        if (contains(v)) {
+            return;
+        }
+        bits_[v >> 5u] |= (std::uint32_t{1u} << (v & 31u));
+        if (count_ < kSimdMax) {
+            list_[count_] = v;
+        }
+        ++count_;
+    }
+
+    [[nodiscard]] constexpr bool contains(const unsigned char v) const noexcept {
+        return (bits_[v >> 5u] >> (v & 31u)) & 1u;
+    }
+
+    [[nodiscard]] constexpr std::size_t size() const noexcept { return count_; }
+    [[nodiscard]] constexpr bool simd_ok() const noexcept { return count_ <= kSimdMax; }
+    [[nodiscard]] constexpr unsigned char at(const std::size_t i) const noexcept { return list_[i]; }
+
+private:
+    std::uint32_t bits_[8]{};
+    unsigned char list_[kSimdMax]{};
+    std::size_t   count_{0u};
+};
+
+/* =======================================================================
+ * segments: the (at most) two contiguous runs of a ring, oldest first
+ * ======================================================================= */
+template <class SizeT>
+struct segments {
+    const unsigned char *ptr[2]{nullptr, nullptr};
+    SizeT                count[2]{0u, 0u};
+    SizeT                total{0u};
+
+    // Byte at ring-relative offset k (precondition: k < total).
+    [[nodiscard]] RB_FORCEINLINE unsigned char operator[](const SizeT k) const noexcept {
+        return (k < count[0]) ? ptr[0][k] : ptr[1][k - count[0]];
+    }
+};
+
+namespace detail {
+
+template <class T>
+inline constexpr bool is_byte_like_v =
+    (sizeof(T) == 1u) && std::is_trivially_copyable_v<T>;
+
+template <class T>
+[[nodiscard]] RB_FORCEINLINE const unsigned char *as_bytes(const T *p) noexcept {
+    static_assert(is_byte_like_v<T>, "[spsc::scan]: element type must be 1 byte (std::byte, char, uint8_t)");
+    return reinterpret_cast<const unsigned char *>(p);
+}
+
+#if SPSC_SCAN_SIMD
+[[nodiscard]] RB_FORCEINLINE std::size_t lowest_bit(const unsigned mask) noexcept {
+#  if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long idx = 0u;
+    _BitScanForward(&idx, mask);
+    return static_cast<std::size_t>(idx);
+#  else
+    return static_cast<std::size_t>(__builtin_ctz(mask));
+#  endif
+}
+#endif /* SPSC_SCAN_SIMD */
+
+// ---------------------------------------------------------------------------------------------
+// Contiguous kernels (return n if not found)
+// ---------------------------------------------------------------------------------------------
+[[nodiscard]] inline std::size_t find_byte(const unsigned char *p, const std::size_t n,
+                                           const unsigned char b) noexcept {
+    if (n == 0u) {
+        return 0u;
+    }
+    const void *hit = std::memchr(p, b, n);
+    return hit ? static_cast<std::size_t>(static_cast<const unsigned char *>(hit) - p) : n;
+}
+
+[[nodiscard]] inline std::size_t find_any_table(const unsigned char *p, const std::size_t n,
+                                                const byte_set &set) noexcept {
+    for (std::size_t i = 0u; i < n; ++i) {
+        if (set.contains(p[i])) {
+            return i;
+        }
+    }
+    return n;
+}
+
+[[nodiscard]] inline std::size_t find_any(const unsigned char *p, const std::size_t n,
+                                          const byte_set &set) noexcept {
+    if (set.size() == 0u) {
+        return n;
+    }
+    if (set.size() == 1u) {
+        return find_byte(p, n, set.at(0u));
+    }
+#if SPSC_SCAN_SIMD
+    if (set.simd_ok() && n >= 16u) {
+        __m128i needles[byte_set::kSimdMax];
+        const std::size_t k = set.size();
+        for (std::size_t j = 0u; j < k; ++j) {
+            needles[j] = _mm_set1_epi8(static_cast<char>(set.at(j)));
+        }
+
+        std::size_t i = 0u;
+        for (; i + 16u <= n; i += 16u) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+            __m128i hit = _mm_cmpeq_epi8(v, needles[0]);
+            for (std::size_t j = 1u; j < k; ++j) {
+                hit = _mm_or_si128(hit, _mm_cmpeq_epi8(v, needles[j]));
+            }
+            const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hit));
+            if (mask != 0u) {
+                return i + lowest_bit(mask);
+            }
+        }
+        return i + find_any_table(p + i, n - i, set);
+    }
+#endif /* SPSC_SCAN_SIMD */
+    return find_any_table(p, n, set);
+}
+
+// ---------------------------------------------------------------------------------------------
+// Segment helpers
+// ---------------------------------------------------------------------------------------------
+template <class SizeT>
+[[nodiscard]] inline bool equal_at(const segments<SizeT> &s, const SizeT off,
+                                   const unsigned char *pat, const SizeT m) noexcept {
+    if (off < s.count[0]) {
+        const SizeT a = (m <= s.count[0] - off) ? m : static_cast<SizeT>(s.count[0] - off);
+        if (std::memcmp(s.ptr[0] + off, pat, a) != 0) {
+            return false;
+        }
+        return (a == m) || (std::memcmp(s.ptr[1], pat + a, m - a) == 0);
+    }
+    return std::memcmp(s.ptr[1] + (off - s.count[0]), pat, m) == 0;
+}
+
+// Runs Kernel(ptr, n) -> index over [from, total) segment by segment.
+template <class SizeT, class Kernel>
+[[nodiscard]] inline SizeT find_seg(const segments<SizeT> &s, SizeT from, Kernel &&kernel) noexcept {
+    SizeT base = 0u;
+    for (unsigned i = 0u; i < 2u; ++i) {
+        const SizeT n = s.count[i];
+        if (from < base + n) {
+            const SizeT start = static_cast<SizeT>(from - base);
+            const std::size_t r = kernel(s.ptr[i] + start, static_cast<std::size_t>(n - start));
+            if (r < static_cast<std::size_t>(n - start)) {
+                return static_cast<SizeT>(base + start + r);
+            }
+            from = static_cast<SizeT>(base + n);
+        }
+        base = static_cast<SizeT>(base + n);
+    }
+    return s.total;
+}
+
+} // namespace detail
+
+// ------------------------------------------------------------------------------------------
+// Building segments
+// ------------------------------------------------------------------------------------------
+
+/* claim_read(::spsc::unsafe) result (any region_pair with ptr/count regions). */
+template <class Region, class SizeT>
+[[nodiscard]] inline segments<SizeT>
+segments_of(const ::spsc::bulk::region_pair<Region, SizeT> &r) noexcept {
+    segments<SizeT> s{};
+    s.ptr[0]   = detail::as_bytes(r.first.ptr);
+    s.ptr[1]   = detail::as_bytes(r.second.ptr);
+    s.count[0] = r.first.count;
+    s.count[1] = r.second.count;
+    s.total    = r.total;
+    return s;
+}
+
+/* Snapshot of a byte fifo: split [tail, head) at the end of storage. */
+template <class Snapshot>
+[[nodiscard]] inline auto segments_of_snapshot(const Snapshot &snap) noexcept {
+    using size_type = typename Snapshot::size_type;
+    segments<size_type> s{};
+    const auto b = snap.begin();
+    const size_type n = snap.size();
+    if (n == 0u) {
+        return s;
+    }
+    const size_type cap = static_cast<size_type>(b.mask() + 1u);
+    const size_type idx = static_cast<size_type>(b.index() & b.mask());
+    const size_type run = static_cast<size_type>(cap - idx);
+
+    s.ptr[0]   = detail::as_bytes(b.data() + idx);
+    s.count[0] = (n < run) ? n : run;
+    s.ptr[1]   = detail::as_bytes(b.data());
+    s.count[1] = static_cast<size_type>(n - s.count[0]);
+    s.total    = n;
+    return s;
+}
+
+template <class T, class Size>
+[[nodiscard]] inline segments<Size> segments_of(const ::spsc::snapshot_view<T, Size> &snap) noexcept {
+    return segments_of_snapshot(snap);
+}
+
+template <class T, class Size>
+[[nodiscard]] inline segments<Size> segments_of(const ::spsc::const_snapshot_view<T, Size> &snap) noexcept {
+    return segments_of_snapshot(snap);
+}
+
+/* Plain contiguous range (e.g. chunk.data(), chunk.size()). */
+template <class T>
+[[nodiscard]] inline segments<std::size_t> segments_of(const T *p, const std::size_t n) noexcept {
+    segments<std::size_t> s{};
+    s.ptr[0]   = detail::as_bytes(p);
+    s.count[0] = n;
+    s.total    = n;
+    return s;
+}
+
+template <class SizeT>
+[[nodiscard]] inline const segments<SizeT> &segments_of(const segments<SizeT> &s) noexcept {
+    return s;
+}
+
+// ------------------------------------------------------------------------------------------
+// Scanners (Src: claim_read regions, snapshot, or segments)
+// ------------------------------------------------------------------------------------------
+
+/* First offset >= from holding value; total if none. */
+template <class Src, class V>
+[[nodiscard]] inline auto find_byte(const Src &src, const V value, const std::size_t from = 0u) noexcept {
+    const auto &s = segments_of(src);
+    using size_type = std::decay_t<decltype(s.total)>;
+    if (from >= s.total) {
+        return s.total;
+    }
+    const unsigned char b = static_cast<unsigned char>(value);
+    return detail::find_seg(s, static_cast<size_type>(from),
+                            [b](const unsigned char *p, std::size_t n) noexcept {
+                                return detail::find_byte(p, n, b);
+                            });
+}
+
+/* First offset >= from holding any member of set; total if none. */
+template <class Src>
+[[nodiscard]] inline auto find_any_of(const Src &src, const byte_set &set, const std::size_t from = 0u) noexcept {
+    const auto &s = segments_of(src);
+    using size_type = std::decay_t<decltype(s.total)>;
+    if (from >= s.total) {
+        return s.total;
+    }
+    return detail::find_seg(s, static_cast<size_type>(from),
+                            [&set](const unsigned char *p, std::size_t n) noexcept {
+                                return detail::find_any(p, n, set);
+                            });
+}
+
+/* First offset >= from where pattern[0..m) starts (may straddle the wrap);
+ * total if none. An empty pattern matches at from.
+ */
+template <class Src, class P>
+[[nodiscard]] inline auto find_pattern(const Src &src, const P *pattern, const std::size_t m,
+                                       const std::size_t from = 0u) noexcept {
+    const auto &s = segments_of(src);
+    using size_type = std::decay_t<decltype(s.total)>;
+    const unsigned char *pat = detail::as_bytes(pattern);
+
+    if (from > s.total || m > static_cast<std::size_t>(s.total - from)) {
+        return s.total;
+    }
+    if (m == 0u) {
+        return static_cast<size_type>(from);
+    }
+
+    const size_type last = static_cast<size_type>(s.total - m); // last valid start
+    size_type off = static_cast<size_type>(from);
+    while (off <= last) {
+        const size_type c = detail::find_seg(s, off, [pat](const unsigned char *p, std::size_t n) noexcept {
+            return detail::find_byte(p, n, pat[0]);
+        });
+        if (c > last) {
+            break;
+        }
+        if (detail::equal_at(s, c, pat, static_cast<size_type>(m))) {
+            return c;
+        }
+        off = static_cast<size_type>(c + 1u);
+    }
+    return s.total;
+}
+
+/* Copy n bytes starting at ring offset off (e.g. a length prefix split by
+ * the wrap). Returns false if [off, off + n) is not fully published.
+ */
+template <class Src>
+[[nodiscard]] inline bool peek_bytes(const Src &src, const std::size_t off, void *dst, const std::size_t n) noexcept {
+    const auto &s = segments_of(src);
+    if (off > s.total || n > static_cast<std::size_t>(s.total - off)) {
+        return false;
+    }
+    unsigned char *out = static_cast<unsigned char *>(dst);
+    std::size_t done = 0u;
+    if (off < s.count[0]) {
+        const std::size_t a = static_cast<std::size_t>(s.count[0] - off);
+        done = (n < a) ? n : a;
+        std::memcpy(out, s.ptr[0] + off, done);
+    }
+    if (done < n) {
+        const std::size_t start = (off > s.count[0]) ? static_cast<std::size_t>(off - s.count[0]) : 0u;
+        std::memcpy(out + done, s.ptr[1] + start, n - done);
+    }
+    return true;
+}
+
+} // namespace spsc::scan
+
+#endif /* SPSC_SCAN_HPP_ */
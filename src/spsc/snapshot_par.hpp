@@ -0,0 +1,259 @@
+/*
+ * snapshot_par.hpp
+ *
+ * Split one snapshot across worker threads, then consume it once.
+ *
+ * Batch analytics over a large backlog (10M elements) are bound by one core
+ * when the consumer walks the snapshot alone. The snapshot iterators are
+ * random access, so a snapshot splits into contiguous parts in O(1):
+ *
+ *   auto snap = q.make_snapshot();
+ *   spsc::par::for_each_part(snap, 8u, [&](const auto& p) {
+ *       local_sum[p.index] = std::accumulate(p.first, p.last, 0ull);
+ *   });
+ *   q.try_consume(snap);
+ *
+ * or in one call: spsc::par::process_and_consume(q, 8u, fn).
+ *
+ * Workers:
+ * - for_each_part(s, parts, fn)                 : parts - 1 std::threads,
+ *                                                 part 0 on the calling thread.
+ * - for_each_part(s, ex, submitter, parts, fn)  : parts go to an
+ *                                                 ::spsc::executor (worker pool);
+ *                                                 a part that does not fit the
+ *                                                 lanes runs on the calling thread.
+ *
+ * Contract:
+ * - Only the consumer thread may call these (the snapshot is consumer state).
+ *   The producer keeps pushing into free slots meanwhile; the parts never
+ *   touch them.
+ * - fn(part) runs concurrently on disjoint ranges and must not throw.
+ * - The executor overload must not be called from one of that executor's
+ *   own workers (the caller waits for every part).
+ */
+
+#ifndef SPSC_SNAPSHOT_PAR_HPP_
+#define SPSC_SNAPSHOT_PAR_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>      // std::unique_ptr
+#include <new>         // std::nothrow
+#include <thread>
+#include <type_traits>
+#include <utility>     // std::declval, std::forward
+
+#include "base/spsc_tools.hpp" // RB_UNLIKELY
+#include "executor.hpp"        // ::spsc::task
+
+namespace spsc::par {
+
+/* =======================================================================
+ * part<Snap>: one contiguous piece of a snapshot
+ * ======================================================================= */
+template<class Snap>
+struct part {
+    using iterator = decltype(std::declval<Snap&>().begin());
+
+    iterator    first{};
+    iterator    last{};
+    std::size_t offset{0u}; // index of 'first' from the snapshot tail
+    std::size_t index{0u};  // part number, [0, parts)
+
+    [[nodiscard]] std::size_t size() const noexcept { return static_cast<std::size_t>(last - first); }
+};
+
+// Number of parts actually used: at most max_parts, at least min_part
+// elements each (the last one may be larger), 0 for an empty snapshot.
+[[nodiscard]] constexpr std::size_t part_count(const std::size_t size, const std::size_t max_parts,
+                                               const std::size_t min_part = 1u) noexcept {
+    if ((size == 0u) || (max_parts == 0u)) {
+        return 0u;
+    }
+    const std::size_t by_size = size / ((min_part == 0u) ? 1u : min_part);
+    const std::size_t n = (by_size < max_parts) ? by_size : max_parts;
+    return (n == 0u) ? 1u : n;
+}
+
+// Part i of 'parts' equal pieces; the first size % parts pieces get one more.
+template<class Snap>
+[[nodiscard]] part<Snap> split(Snap& s, const std::size_t parts, const std::size_t i) noexcept {
+    SPSC_ASSERT(parts != 0u && i < parts);
+    const std::size_t n    = static_cast<std::size_t>(s.size());
+    const std::size_t base = n / parts;
+    const std::size_t rem  = n % parts;
+    const std::size_t lo   = i * base + ((i < rem) ? i : rem);
+    const std::size_t len  = base + ((i < rem) ? 1u : 0u);
+
+    using diff = typename part<Snap>::iterator::difference_type;
+    part<Snap> p;
+    p.first  = s.begin() + static_cast<diff>(lo);
+    p.last   = p.first + static_cast<diff>(len);
+    p.offset = lo;
+    p.index  = i;
+    return p;
+}
+
+// ------------------------------------------------------------------------------------------
+// std::thread workers
+// ------------------------------------------------------------------------------------------
+namespace detail {
+
+// std::thread reports a failed spawn (EAGAIN, thread limits) by throwing
+// std::system_error whatever SPSC_ENABLE_EXCEPTIONS says, so this catch is
+// keyed on the compiler, not on the library switch. Returns false on failure.
+template<class F>
+bool try_spawn(std::thread& t, F&& f) noexcept {
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || (defined(_MSC_VER) && defined(_CPPUNWIND))
+    try {
+        t = std::thread(std::forward<F>(f));
+    } catch (...) {
+        return false;
+    }
+#else
+    t = std::thread(std::forward<F>(f));
+#endif
+    return true;
+}
+
+} // namespace detail
+
+/*
+ * for_each_part(s, max_parts, fn)
+ * Runs fn(part) for every part, part 0 on the calling thread. Returns the
+ * number of parts (0 for an empty snapshot). Parts that get no thread
+ * (table allocation or std::thread spawn failed) run on the calling thread;
+ * the threads already started are joined either way.
+ */
+template<class Snap, class Fn>
+std::size_t for_each_part(Snap& s, const std::size_t max_parts, Fn&& fn) {
+    const std::size_t parts = part_count(static_cast<std::size_t>(s.size()), max_parts);
+    if (parts == 0u) {
+        return 0u;
+    }
+
+    std::unique_ptr<std::thread[]> th;
+    if (parts > 1u) {
+        th.reset(new (std::nothrow) std::thread[parts - 1u]);
+    }
+    // th[i - 1] runs part i for i in [1, started]; stop at the first failed spawn.
+    std::size_t started = 0u;
+    if (th) {
+        for (std::size_t i = 1u; i < parts; ++i) {
+            if (!detail::try_spawn(th[i - 1u], [&s, &fn, parts, i]() noexcept { fn(split(s, parts, i)); })) {
+                break;
+            }
+            started = i;
+        }
+    }
+
+    fn(split(s, parts, 0u));
+    for (std::size_t i = started + 1u; i < parts; ++i) {
+        fn(split(s, parts, i));
+    }
+
+    for (std::size_t i = 0u; i < started; ++i) {
+        th[i].join();
+    }
+    return parts;
+}
+
+// ------------------------------------------------------------------------------------------
+// Executor workers
+// ------------------------------------------------------------------------------------------
+namespace detail {
+
+template<class Snap, class Fn>
+struct part_job {
+    Snap*                     snap{nullptr};
+    Fn*                       fn{nullptr};
+    std::size_t               parts{0u};
+    std::size_t               index{0u};
+    std::atomic<std::size_t>* done{nullptr};
+
+    static void run(void* p) noexcept {
+        auto* j = static_cast<part_job*>(p);
+        (*j->fn)(split(*j->snap, j->parts, j->index));
+        j->done->fetch_add(1u, std::memory_order_release);
+    }
+};
+
+} // namespace detail
+
+/*
+ * for_each_part(s, ex, submitter, max_parts, fn)
+ * Same as above, but parts 1..n-1 are submitted to 'ex' as ::spsc::task
+ * through lane 'submitter' (owned by the calling thread). The caller runs
+ * part 0 and every part the lanes did not accept, then waits for the rest.
+ */
+template<class Snap, class Exec, class Fn>
+std::size_t for_each_part(Snap& s, Exec& ex, const typename Exec::size_type submitter,
+                          const std::size_t max_parts, Fn&& fn) {
+    static_assert(std::is_constructible_v<typename Exec::value_type, ::spsc::task>,
+                  "[spsc::par]: executor tasks must be constructible from ::spsc::task");
+    using Fun = std::remove_reference_t<Fn>;
+    using job = detail::part_job<Snap, Fun>;
+
+    const std::size_t parts = part_count(static_cast<std::size_t>(s.size()), max_parts);
+    if (parts == 0u) {
+        return 0u;
+    }
+
+    std::atomic<std::size_t> done{0u};
+    std::unique_ptr<job[]> jobs(new (std::nothrow) job[parts]);
+    if (RB_UNLIKELY(!jobs || !ex.running())) {
+        for (std::size_t i = 0u; i < parts; ++i) {
+            fn(split(s, parts, i));
+        }
+        return parts;
+    }
+
+    for (std::size_t i = 0u; i < parts; ++i) {
+        jobs[i] = job{&s, &fn, parts, i, &done};
+    }
+    for (std::size_t i = 1u; i < parts; ++i) {
+        if (!ex.try_submit(submitter, ::spsc::task{&job::run, &jobs[i]})) {
+            job::run(&jobs[i]);
+        }
+    }
+    job::run(&jobs[0]);
+
+    while (done.load(std::memory_order_acquire) != parts) {
+        std::this_thread::yield();
+    }
+    return parts;
+}
+
+// ------------------------------------------------------------------------------------------
+// Snapshot + process + single consume
+// ------------------------------------------------------------------------------------------
+/*
+ * process_and_consume(q, max_parts, fn)
+ * Takes a snapshot of 'q', processes it in parallel and releases all of it
+ * with one try_consume(). Returns false if the snapshot was empty or the
+ * consume was rejected (tail moved, e.g. by another pop() in fn).
+ */
+template<class Ring, class Fn>
+[[nodiscard]] bool process_and_consume(Ring& q, const std::size_t max_parts, Fn&& fn) {
+    auto snap = q.make_snapshot();
+    if (snap.empty()) {
+        return false;
+    }
+    (void)for_each_part(snap, max_parts, fn);
+    return q.try_consume(snap);
+}
+
+template<class Ring, class Exec, class Fn>
+[[nodiscard]] bool process_and_consume(Ring& q, Exec& ex, const typename Exec::size_type submitter,
+                                       const std::size_t max_parts, Fn&& fn) {
+    auto snap = q.make_snapshot();
+    if (snap.empty()) {
+        return false;
+    }
+    (void)for_each_part(snap, ex, submitter, max_parts, fn);
+    return q.try_consume(snap);
+}
+
+} // namespace spsc::par
+
+#endif /* SPSC_SNAPSHOT_PAR_HPP_ */
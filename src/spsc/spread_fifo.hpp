@@ -0,0 +1,298 @@
+/*
+ * spread_fifo.hpp
+ *
+ * SPSC FIFO for small T with a slot-index permutation that puts consecutive
+ * sequence numbers on different cache lines.
+ *
+ * With a plain ring and sizeof(T) << cache line, a nearly empty queue has the
+ * producer writing slot k while the consumer reads slot k-1 on the same line:
+ * false sharing on the payload, which no counter padding can remove.
+ * spread_fifo maps the masked index through a compile-time bit rotation:
+ *
+ *   L    = elements per cache line (pow2), s = log2(L), b = log2(Capacity)
+ *   phys = rotr_b(i, s) = (i >> s) | ((i & (L - 1)) << (b - s))
+ *
+ * so sequence numbers i .. i+L-1 land on L different lines, and every line
+ * is still filled completely (the map is a bijection on [0, Capacity)).
+ *
+ * Costs / limits:
+ * - Static Capacity only (the rotation is compile-time); Capacity >= L*L for
+ *   the full spread. Smaller rings rotate less; a ring that fits into one
+ *   line keeps the identity map.
+ * - Storage is no longer contiguous in sequence order: claim_read()/claim_write()
+ *   degrade to one element per call. write(src, n)/read(dst, max) still copy a
+ *   batch slot by slot and publish/pop it with one index update.
+ * - Sequential streaming touches L lines per L elements instead of one; use
+ *   this for near-empty, latency-bound queues, not for bulk throughput.
+ *
+ * Spread = false keeps the identity map (same class, for A/B comparisons).
+ */
+
+#ifndef SPSC_SPREAD_FIFO_HPP_
+#define SPSC_SPREAD_FIFO_HPP_
+
+#include <limits>
+#include <type_traits>
+#include <utility>     // std::forward, std::move
+
+#include "base/SPSCbase.hpp"       // ::spsc::SPSCbase<Capacity, Policy>, reg
+#include "base/spsc_cacheline.hpp" // SPSC_CACHELINE_BYTES
+#include "base/spsc_regions.hpp"   // ::spsc::unsafe_t, ::spsc::bulk::regions
+#include "base/spsc_tools.hpp"     // RB_FORCEINLINE, RB_UNLIKELY
+
+namespace spsc {
+
+namespace detail {
+
+[[nodiscard]] constexpr unsigned spread_log2(reg v) noexcept {
+    unsigned r = 0u;
+    while (v > 1u) {
+        v >>= 1u;
+        ++r;
+    }
+    return r;
+}
+
+/* Compile-time rotation of the masked index (see file header). */
+template <reg Capacity, reg ElemBytes, bool Enable>
+struct spread_map {
+    static constexpr unsigned kIndexBits = spread_log2(Capacity);
+
+    static constexpr reg kPerLine =
+        (ElemBytes == 0u || ElemBytes > SPSC_CACHELINE_BYTES / 2u)
+            ? reg(1u)
+            : (reg(1u) << spread_log2(static_cast<reg>(SPSC_CACHELINE_BYTES / ElemBytes)));
+
+    // Rotated neighbours are Capacity >> s slots apart; keep that >= one line.
+    static constexpr unsigned kLineBits = spread_log2(kPerLine);
+    static constexpr unsigned kShift = !Enable ? 0u
+        : (kIndexBits <= kLineBits) ? 0u
+        : ((kLineBits <= kIndexBits - kLineBits) ? kLineBits : kIndexBits - kLineBits);
+
+    static constexpr reg kLow = (reg(1u) << kShift) - 1u;
+
+    [[nodiscard]] static RB_FORCEINLINE constexpr reg map(const reg i) noexcept {
+        if constexpr (kShift == 0u) {
+            return i;
+        } else {
+            return static_cast<reg>((i >> kShift) | ((i & kLow) << (kIndexBits - kShift)));
+        }
+    }
+};
+
+} // namespace detail
+
+/* =======================================================================
+ * spread_fifo<T, Capacity, Policy, Spread>
+ *
+ * T        : default-constructible, assignable (same as fifo).
+ * Capacity : static, pow2, >= 2.
+ * Spread   : enable the index rotation (default true).
+ * ======================================================================= */
+template <class T,
+         reg Capacity,
+         typename Policy = ::spsc::policy::default_policy,
+         bool Spread = true>
+class spread_fifo : private ::spsc::SPSCbase<Capacity, Policy> {
+    using Base = ::spsc::SPSCbase<Capacity, Policy>;
+
+    static_assert(Capacity >= 2u && ::spsc::cap::rb_is_pow2(Capacity),
+                  "[spsc::spread_fifo]: Capacity must be a static power of two >= 2");
+    static_assert(std::is_default_constructible_v<T>,
+                  "[spsc::spread_fifo]: T must be default-constructible");
+
+public:
+    // ------------------------------------------------------------------------------------------
+    // Type Definitions
+    // ------------------------------------------------------------------------------------------
+    using value_type      = T;
+    using pointer         = value_type *;
+    using const_pointer   = const value_type *;
+    using reference       = value_type &;
+    using const_reference = const value_type &;
+    using size_type       = reg;
+    using policy_type     = Policy;
+
+    using region  = ::spsc::bulk::region<pointer, size_type>;
+    using regions = ::spsc::bulk::regions<pointer, size_type>;
+
+    using map_type = ::spsc::detail::spread_map<Capacity, sizeof(T), Spread>;
+
+    /* Elements per cache line that the rotation separates (1 = identity map). */
+    static constexpr size_type kSpread = size_type(1u) << map_type::kShift;
+
+    spread_fifo() = default;
+
+    spread_fifo(const spread_fifo &) = delete;
+    spread_fifo &operator=(const spread_fifo &) = delete;
+
+    // ------------------------------------------------------------------------------------------
+    // State
+    // ------------------------------------------------------------------------------------------
+    using Base::capacity;
+
+    [[nodiscard]] RB_FORCEINLINE size_type size() const noexcept { return Base::size(); }
+    [[nodiscard]] RB_FORCEINLINE bool empty() const noexcept { return Base::empty(); }
+    [[nodiscard]] RB_FORCEINLINE bool full() const noexcept { return Base::full(); }
+    [[nodiscard]] RB_FORCEINLINE size_type free() const noexcept { return Base::free(); }
+    [[nodiscard]] RB_FORCEINLINE bool can_write(const size_type n = 1u) const noexcept { return Base::can_write(n); }
+    [[nodiscard]] RB_FORCEINLINE bool can_read(const size_type n = 1u) const noexcept { return Base::can_read(n); }
+
+    /* Physical slot of masked index i (exposed for tests / layout inspection). */
+    [[nodiscard]] static RB_FORCEINLINE constexpr size_type slot_of(const size_type i) noexcept {
+        return map_type::map(static_cast<size_type>(i & (Capacity - 1u)));
+    }
+
+    // ------------------------------------------------------------------------------------------
+    // Producer Operations
+    // ------------------------------------------------------------------------------------------
+    template <class U, typename = std::enable_if_t<std::is_assignable_v<reference, U &&>>>
+    RB_FORCEINLINE void push(U &&v) noexcept(std::is_nothrow_assignable_v<reference, U &&>) {
+        SPSC_ASSERT(!full());
+        at_(Base::write_index()) = std::forward<U>(v);
+        Base::increment_head();
+    }
+
+    template <class U, typename = std::enable_if_t<std::is_assignable_v<reference, U &&>>>
+    [[nodiscard]] RB_FORCEINLINE bool try_push(U &&v) noexcept(std::is_nothrow_assignable_v<reference, U &&>) {
+        if (RB_UNLIKELY(full())) {
+            return false;
+        }
+        at_(Base::write_index()) = std::forward<U>(v);
+        Base::increment_head();
+        return true;
+    }
+
+    [[nodiscard]] RB_FORCEINLINE pointer try_claim() noexcept {
+        if (RB_UNLIKELY(full())) {
+            return nullptr;
+        }
+        return &at_(Base::write_index());
+    }
+
+    RB_FORCEINLINE void publish() noexcept {
+        SPSC_ASSERT(!full());
+        Base::increment_head();
+    }
+
+    RB_FORCEINLINE void publish(const size_type n) noexcept {
+        SPSC_ASSERT(can_write(n));
+        Base::advance_head(n);
+    }
+
+    /* Copy up to n elements slot by slot, publish them with one index update. */
+    size_type write(const T *src, const size_type n) noexcept(std::is_nothrow_copy_assignable_v<T>) {
+        size_type k = Base::free();
+        if (n < k) {
+            k = n;
+        }
+        const size_type head = Base::head();
+        for (size_type i = 0u; i < k; ++i) {
+            at_(static_cast<size_type>(head + i)) = src[i];
+        }
+        if (k != 0u) {
+            Base::advance_head(k);
+        }
+        return k;
+    }
+
+    // ------------------------------------------------------------------------------------------
+    // Consumer Operations
+    // ------------------------------------------------------------------------------------------
+    [[nodiscard]] RB_FORCEINLINE reference front() noexcept {
+        SPSC_ASSERT(!empty());
+        return at_(Base::read_index());
+    }
+
+    [[nodiscard]] RB_FORCEINLINE pointer try_front() noexcept {
+        if (RB_UNLIKELY(empty())) {
+            return nullptr;
+        }
+        return &at_(Base::read_index());
+    }
+
+    RB_FORCEINLINE void pop() noexcept {
+        SPSC_ASSERT(!empty());
+        Base::increment_tail();
+    }
+
+    [[nodiscard]] RB_FORCEINLINE bool try_pop() noexcept {
+        if (RB_UNLIKELY(empty())) {
+            return false;
+        }
+        Base::increment_tail();
+        return true;
+    }
+
+    RB_FORCEINLINE void pop(const size_type n) noexcept {
+        SPSC_ASSERT(can_read(n));
+        Base::advance_tail(n);
+    }
+
+    /* i-th readable element (0 = front). */
+    [[nodiscard]] RB_FORCEINLINE reference operator[](const size_type i) noexcept {
+        SPSC_ASSERT(i < size());
+        return at_(static_cast<size_type>(Base::tail() + i));
+    }
+
+    /* Copy up to max elements slot by slot, pop them with one index update. */
+    size_type read(T *dst, const size_type max) noexcept(std::is_nothrow_copy_assignable_v<T>) {
+        size_type k = Base::size();
+        if (max < k) {
+            k = max;
+        }
+        const size_type tail = Base::tail();
+        for (size_type i = 0u; i < k; ++i) {
+            dst[i] = at_(static_cast<size_type>(tail + i));
+        }
+        if (k != 0u) {
+            Base::advance_tail(k);
+        }
+        return k;
+    }
+
+    // ------------------------------------------------------------------------------------------
+    // Bulk regions (degraded: one element per call while Spread is active)
+    // ------------------------------------------------------------------------------------------
+    [[nodiscard]] regions claim_write(const ::spsc::unsafe_t,
+                                      const size_type max_count = std::numeric_limits<size_type>::max()) noexcept {
+        return claim_(Base::head(), Base::free(), max_count);
+    }
+
+    [[nodiscard]] regions claim_read(const ::spsc::unsafe_t,
+                                     const size_type max_count = std::numeric_limits<size_type>::max()) noexcept {
+        return claim_(Base::tail(), Base::size(), max_count);
+    }
+
+private:
+    [[nodiscard]] RB_FORCEINLINE reference at_(const size_type seq) noexcept {
+        return storage_[slot_of(seq)];
+    }
+
+    [[nodiscard]] regions claim_(const size_type seq, const size_type avail, const size_type max_count) noexcept {
+        size_type total = (max_count < avail) ? max_count : avail;
+        if constexpr (kSpread > 1u) {
+            total = (total != 0u) ? 1u : 0u;
+        }
+        if (total == 0u) {
+            return {};
+        }
+        const size_type idx    = static_cast<size_type>(seq & (Capacity - 1u));
+        const size_type to_end = static_cast<size_type>(Capacity - idx);
+        const size_type first  = (to_end < total) ? to_end : total;
+
+        regions r{};
+        r.first.ptr    = &storage_[slot_of(idx)];
+        r.first.count  = first;
+        r.second.count = static_cast<size_type>(total - first);
+        r.second.ptr   = (r.second.count != 0u) ? &storage_[0] : nullptr;
+        r.total        = total;
+        return r;
+    }
+
+    alignas(SPSC_CACHELINE_BYTES) T storage_[Capacity]{};
+};
+
+} // namespace spsc
+
+#endif /* SPSC_SPREAD_FIFO_HPP_ */
@@ -4,24 +4,44 @@ DEPENDPATH += $$PWD
 HEADERS +=                                  \
     $$PWD/array_fifo.hpp \
     $$PWD/base/SPSCbase.hpp                 \
+    $$PWD/base/spsc_adaptive.hpp            \
     $$PWD/base/spsc_alloc.hpp               \
+    $$PWD/base/spsc_budget.hpp \
     $$PWD/base/spsc_cacheline.hpp           \
     $$PWD/base/spsc_capacity_ctrl.hpp       \
     $$PWD/base/spsc_config.hpp              \
     $$PWD/base/spsc_counter.hpp             \
+    $$PWD/base/spsc_layout.hpp \
     $$PWD/base/spsc_object.hpp              \
     $$PWD/base/spsc_policy.hpp              \
     $$PWD/base/spsc_regions.hpp \
     $$PWD/base/spsc_snapshot.hpp            \
     $$PWD/base/spsc_tools.hpp \
+    $$PWD/base/spsc_trace.hpp \
     $$PWD/chunk.hpp \
     $$PWD/chunk_fifo.hpp \
+    $$PWD/delay.hpp \
+    $$PWD/duplex.hpp \
+    $$PWD/executor.hpp \
     $$PWD/fifo.hpp \
     $$PWD/fifo_view.hpp \
+    $$PWD/flight_recorder.hpp \
+    $$PWD/graveyard.hpp \
+    $$PWD/history.hpp \
     $$PWD/latest.hpp \
+    $$PWD/mesh.hpp \
+    $$PWD/packed_chunk.hpp \
+    $$PWD/packed_fifo.hpp \
     $$PWD/pool.hpp \
     $$PWD/pool_view.hpp \
     $$PWD/queue.hpp \
-    $$PWD/typed_pool.hpp
+    $$PWD/record_fifo.hpp \
+    $$PWD/remote_alloc.hpp \
+    $$PWD/scan.hpp \
+    $$PWD/snapshot_par.hpp \
+    $$PWD/spread_fifo.hpp \
+    $$PWD/ttl.hpp \
+    $$PWD/typed_pool.hpp \
+    $$PWD/window_stats.hpp
 
 SOURCES += \
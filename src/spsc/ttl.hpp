@@ -0,0 +1,181 @@
+/*
+ * ttl.hpp
+ *
+ * Age-based expiry (TTL) for timestamped elements in fifo / fifo_view / queue.
+ *
+ * Model:
+ * - The producer stamps each element with a monotonic (non-decreasing) time
+ *   before publishing it (see stamped<T, Stamp>, or any type + Key functor).
+ * - The consumer owns an expiry<Stamp, Duration> object holding the ring's TTL
+ *   and calls skip_expired(ring, now).
+ * - An element is expired when key(e) < now - ttl.
+ *
+ * Because stamps are monotonic in ring order, expired elements always form a
+ * prefix of the readable range. skip_expired() finds the end of that prefix by
+ * binary search over the claim_read() region_pair (O(log n) key reads) and
+ * releases it with a single pop(n), instead of inspecting one element at a time.
+ *
+ * Contract:
+ * - Consumer-side only (same thread that calls front()/pop()).
+ * - Stamps must be non-decreasing in publish order (hard precondition: the
+ *   binary search is undefined on an unsorted range; debug builds assert it).
+ * - Unsigned stamps must not wrap within the lifetime of the ring.
+ * - queue<T>::pop(n) still runs n destructors for non-trivially destructible T;
+ *   only the search is logarithmic. fifo/fifo_view release is O(1).
+ */
+
+#ifndef SPSC_TTL_HPP_
+#define SPSC_TTL_HPP_
+
+#include <algorithm>   // std::partition_point, std::is_partitioned
+#include <cstdint>
+#include <type_traits>
+
+#include "base/spsc_regions.hpp" // ::spsc::unsafe
+#include "base/spsc_tools.hpp"   // RB_FORCEINLINE, SPSC_ASSERT
+
+namespace spsc::ttl {
+
+/* =======================================================================
+ * stamped<T, Stamp>
+ *
+ * Default timestamped payload: monotonic stamp + value.
+ * ======================================================================= */
+template <class T, class Stamp = std::uint64_t>
+struct stamped {
+    using value_type = T;
+    using stamp_type = Stamp;
+
+    Stamp stamp{};
+    T     value{};
+};
+
+/* Default key: reads `.stamp` (also through pointers, for pointer-valued rings). */
+struct stamp_of {
+    template <class E>
+    [[nodiscard]] RB_FORCEINLINE constexpr decltype(auto) operator()(const E &e) const noexcept {
+        if constexpr (std::is_pointer_v<E>) {
+            return (e->stamp);
+        } else {
+            return (e.stamp);
+        }
+    }
+};
+
+/* =======================================================================
+ * count_prefix(regions, pred)
+ *
+ * Length of the leading run of elements satisfying pred in a
+ * claim_read()/snapshot region_pair. pred must be true for a prefix and
+ * false afterwards (monotonic keys). Reads O(log n) elements; debug builds
+ * check the precondition with an O(n) scan.
+ * ======================================================================= */
+template <class Regions, class Pred>
+[[nodiscard]] auto count_prefix(const Regions &r, Pred pred) noexcept
+    -> decltype(r.total)
+{
+    using size_type = decltype(r.total);
+
+    if (r.first.count == 0u) {
+        return 0u;
+    }
+
+    // Partitioned across both regions: once pred fails it never holds again.
+    SPSC_ASSERT(std::is_partitioned(r.first.ptr, r.first.ptr + r.first.count, pred));
+    SPSC_ASSERT((r.second.count == 0u) ||
+                (std::is_partitioned(r.second.ptr, r.second.ptr + r.second.count, pred) &&
+                 (pred(r.first.ptr[r.first.count - 1u]) || !pred(r.second.ptr[0]))));
+
+    // Whole first region matches -> the boundary (if any) is in the second one.
+    if (pred(r.first.ptr[r.first.count - 1u])) {
+        if (r.second.count == 0u) {
+            return r.first.count;
+        }
+        const auto *const b = r.second.ptr;
+        const auto *const e = std::partition_point(b, b + r.second.count, pred);
+        return static_cast<size_type>(r.first.count + static_cast<size_type>(e - b));
+    }
+
+    const auto *const b = r.first.ptr;
+    const auto *const e = std::partition_point(b, b + r.first.count, pred);
+    return static_cast<size_type>(e - b);
+}
+
+/* =======================================================================
+ * count_expired(regions, cutoff, key)
+ *
+ * Length of the leading run of elements with key(e) < cutoff.
+ * ======================================================================= */
+template <class Regions, class Stamp, class Key = stamp_of>
+[[nodiscard]] auto count_expired(const Regions &r, const Stamp &cutoff, Key key = {}) noexcept
+    -> decltype(r.total)
+{
+    return ::spsc::ttl::count_prefix(r, [&](const auto &e) noexcept { return key(e) < cutoff; });
+}
+
+/* =======================================================================
+ * expiry<Stamp, Duration, Key>
+ *
+ * Consumer-owned per-ring TTL.
+ * Stamp    : stamp type (integral ticks or std::chrono::duration since epoch).
+ * Duration : TTL type (defaults to Stamp).
+ * Key      : extracts the stamp from a ring element.
+ * ======================================================================= */
+template <class Stamp = std::uint64_t, class Duration = Stamp, class Key = stamp_of>
+class expiry {
+public:
+    using stamp_type    = Stamp;
+    using duration_type = Duration;
+    using key_type      = Key;
+
+    expiry() = default;
+    explicit expiry(const Duration ttl, Key key = {}) noexcept : ttl_(ttl), key_(key) {}
+
+    [[nodiscard]] Duration ttl() const noexcept { return ttl_; }
+    void set_ttl(const Duration ttl) noexcept { ttl_ = ttl; }
+
+    // Elements stamped strictly before cutoff(now) are expired.
+    // For unsigned ticks, nothing is expired while now < ttl.
+    [[nodiscard]] Stamp cutoff(const Stamp now) const noexcept {
+        if constexpr (std::is_unsigned_v<Stamp>) {
+            return (now < static_cast<Stamp>(ttl_)) ? Stamp{} : static_cast<Stamp>(now - ttl_);
+        } else {
+            return static_cast<Stamp>(now - ttl_);
+        }
+    }
+
+    template <class E>
+    [[nodiscard]] bool expired(const E &e, const Stamp now) const noexcept {
+        return key_(e) < cutoff(now);
+    }
+
+    // Number of expired elements at the front of the readable range (no release).
+    template <class Ring>
+    [[nodiscard]] auto count_expired(Ring &q, const Stamp now) const noexcept
+        -> typename Ring::size_type
+    {
+        const auto r = q.claim_read(::spsc::unsafe);
+        return ::spsc::ttl::count_expired(r, cutoff(now), key_);
+    }
+
+    // Releases the expired prefix with one pop(n). Returns the number dropped.
+    template <class Ring>
+    auto skip_expired(Ring &q, const Stamp now) const noexcept(noexcept(q.pop(typename Ring::size_type{1u})))
+        -> typename Ring::size_type
+    {
+        const auto r = q.claim_read(::spsc::unsafe);
+        const auto n = ::spsc::ttl::count_expired(r, cutoff(now), key_);
+        if (n != 0u) {
+            q.pop(n);
+        }
+        return n;
+    }
+
+private:
+    Duration ttl_{};
+    Key      key_{};
+};
+
+} // namespace spsc::ttl
+
+#endif /* SPSC_TTL_HPP_ */
@@ -47,10 +47,12 @@
 // Base and utility includes
 #include "base/SPSCbase.hpp"        // ::spsc::SPSCbase<Capacity, Policy>, reg
 #include "base/spsc_alloc.hpp"      // ::spsc::alloc::default_alloc
+#include "base/spsc_layout.hpp"     // ::spsc::layout::report
 #include "base/spsc_object.hpp"     // ::spsc::detail::destroy_at
 #include "base/spsc_snapshot.hpp"   // ::spsc::snapshot_view, ::spsc::snapshot_traits
 #include "base/spsc_regions.hpp"    // ::spsc::bulk::slot_region/slot_regions
 #include "base/spsc_tools.hpp"      // RB_FORCEINLINE, RB_UNLIKELY, SPSC_* macros (also handles <span>)
+#include "base/spsc_trace.hpp"      // SPSC_TRACE (rejection / guard probes)
 
 namespace spsc {
 
@@ -302,6 +304,15 @@ public:
         return base_allocator_type{};
     }
 
+    // Cache-line layout of this instance (see base/spsc_layout.hpp).
+    void describe_layout(::spsc::layout::report& r) const noexcept {
+        if constexpr (!kDynamic) {
+            r.add("allocated", &this->isAllocated_, sizeof(this->isAllocated_), ::spsc::layout::writer::setup);
+        }
+        Base::describe_layout(r);
+        r.add("slots", &slots_, sizeof(slots_), ::spsc::layout::writer::setup);
+    }
+
     [[nodiscard]] RB_FORCEINLINE bool is_valid() const noexcept {
         if constexpr (kDynamic) {
             SPSC_ASSERT((slots_ == nullptr) == (Base::capacity() == 0u));
@@ -686,6 +697,7 @@ public:
         static_assert(std::is_constructible_v<T, Args &&...>,
                       "[typed_pool]: T must be constructible from Args...");
         if (RB_UNLIKELY(full())) {
+            SPSC_TRACE(full, this, size_type(1u), capacity());
             return false;
         }
 
@@ -709,6 +721,7 @@ public:
 
     [[nodiscard]] RB_FORCEINLINE pointer try_claim() noexcept {
         if (RB_UNLIKELY(full())) {
+            SPSC_TRACE(full, this, size_type(1u), capacity());
             return nullptr;
         }
         return data()[Base::write_index()];
@@ -721,6 +734,7 @@ public:
 
     [[nodiscard]] RB_FORCEINLINE bool try_publish() noexcept {
         if (RB_UNLIKELY(full())) {
+            SPSC_TRACE(full, this, size_type(1u), capacity());
             return false;
         }
         Base::increment_head();
@@ -734,6 +748,7 @@ public:
 
     [[nodiscard]] RB_FORCEINLINE bool try_publish(const size_type n) noexcept {
         if (RB_UNLIKELY(!can_write(n))) {
+            SPSC_TRACE(full, this, n, capacity());
             return false;
         }
         Base::advance_head(n);
@@ -756,6 +771,7 @@ public:
 
     [[nodiscard]] RB_FORCEINLINE pointer try_front() noexcept {
         if (RB_UNLIKELY(empty())) {
+            SPSC_TRACE(empty, this, size_type(1u), capacity());
             return nullptr;
         }
         return object_ptr(Base::read_index());
@@ -763,6 +779,7 @@ public:
 
     [[nodiscard]] RB_FORCEINLINE const_pointer try_front() const noexcept {
         if (RB_UNLIKELY(empty())) {
+            SPSC_TRACE(empty, this, size_type(1u), capacity());
             return nullptr;
         }
         return object_ptr(Base::read_index());
@@ -778,6 +795,7 @@ public:
 
     [[nodiscard]] RB_FORCEINLINE bool try_pop() noexcept {
         if (RB_UNLIKELY(empty())) {
+            SPSC_TRACE(empty, this, size_type(1u), capacity());
             return false;
         }
 
@@ -807,6 +825,7 @@ public:
 
     [[nodiscard]] RB_FORCEINLINE bool try_pop(const size_type n) noexcept {
         if (RB_UNLIKELY(!can_read(n))) {
+            SPSC_TRACE(empty, this, n, capacity());
             return false;
         }
 
@@ -1048,15 +1067,13 @@ public:
                 return;
             }
 
-            if (constructed_ == 0u) {
-                return;
-            }
-
-            if (publish_on_destroy_) {
+            if (constructed_ != 0u && publish_on_destroy_) {
                 p_->publish(constructed_);
+                SPSC_TRACE(guard_commit, p_, constructed_, 0u);
                 return;
             }
 
+            SPSC_TRACE(guard_cancel, p_, regs_.total, 0u); // claim dropped
             destroy_constructed_();
         }
 
@@ -1095,11 +1112,15 @@ public:
         void commit() noexcept {
             if (p_ && constructed_ != 0u) {
                 p_->publish(constructed_);
+                SPSC_TRACE(guard_commit, p_, constructed_, 0u);
             }
             reset_();
         }
 
         void cancel() noexcept {
+            if (p_ != nullptr) {
+                SPSC_TRACE(guard_cancel, p_, regs_.total, 0u);
+            }
             if (p_ && constructed_ != 0u) {
                 destroy_constructed_();
             }
@@ -1190,6 +1211,7 @@ public:
         ~bulk_read_guard() noexcept {
             if (active_ && p_) {
                 p_->pop(regs_.total);
+                SPSC_TRACE(guard_commit, p_, regs_.total, 0u);
             }
         }
 
@@ -1207,6 +1229,7 @@ public:
         void commit() noexcept {
             if (active_ && p_) {
                 p_->pop(regs_.total);
+                SPSC_TRACE(guard_commit, p_, regs_.total, 0u);
             }
             active_ = false;
             p_ = nullptr;
@@ -1214,6 +1237,9 @@ public:
         }
 
         void cancel() noexcept {
+            if (active_ && p_) {
+                SPSC_TRACE(guard_cancel, p_, regs_.total, 0u);
+            }
             active_ = false;
             p_ = nullptr;
             regs_ = {};
@@ -1254,7 +1280,12 @@ public:
             if (publish_on_destroy_ && constructed_) {
                 // Object becomes visible to the consumer.
                 p_->publish();
-            } else if (constructed_) {
+                SPSC_TRACE(guard_commit, p_, 1u, 0u);
+                return;
+            }
+
+            SPSC_TRACE(guard_cancel, p_, 1u, 0u); // claim dropped
+            if (constructed_) {
                 // Constructed but not published: destroy safely.
                 ::spsc::detail::destroy_at(std::launder(ptr_));
             }
@@ -1309,6 +1340,7 @@ public:
                 SPSC_ASSERT(constructed_ && "write_guard::commit() publishing an unconstructed slot");
                 if (constructed_) {
                     p_->publish();
+                    SPSC_TRACE(guard_commit, p_, 1u, 0u);
                 }
             }
 
@@ -1320,6 +1352,9 @@ public:
         }
         void cancel() noexcept {
             // Cancel means: do NOT publish, and if constructed -> destroy.
+            if (p_ && ptr_) {
+                SPSC_TRACE(guard_cancel, p_, 1u, 0u);
+            }
             if (p_ && ptr_ && constructed_) {
                 ::spsc::detail::destroy_at(std::launder(ptr_));
             }
@@ -1358,6 +1393,7 @@ public:
         ~read_guard() noexcept {
             if (active_ && p_) {
                 p_->pop();
+                SPSC_TRACE(guard_commit, p_, 1u, 0u);
             }
         }
 
@@ -1372,11 +1408,16 @@ public:
         void commit() noexcept {
             if (active_ && p_) {
                 p_->pop();
+                SPSC_TRACE(guard_commit, p_, 1u, 0u);
+                active_ = false; // not a cancel
             }
             cancel();
         }
 
         void cancel() noexcept {
+            if (active_ && p_) {
+                SPSC_TRACE(guard_cancel, p_, 1u, 0u);
+            }
             active_ = false;
             p_ = nullptr;
             ptr_ = nullptr;
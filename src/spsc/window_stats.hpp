@@ -0,0 +1,411 @@
+/*
+ * window_stats.hpp
+ *
+ * Incremental sliding-window aggregates over the contents of a fifo.
+ *
+ * window_stats<T, Capacity> tracks count / sum / mean / min / max of the
+ * elements currently in [tail, head) of an attached fifo-like ring, updated
+ * as elements become visible (sync) and as they are popped, in O(1)
+ * amortized per element:
+ * - count / sum : running counters (add on arrival, subtract on pop).
+ * - min / max   : monotonic deques of (sequence, value); each element is
+ *                 pushed and removed at most once per deque.
+ *
+ * Threads:
+ * - Owner (the fifo consumer): sync(), pop(), on_push(), on_pop() and the
+ *   window_*() getters. All aggregate state is single-writer.
+ * - Observers (any number of extra threads): read() / try_read() get a
+ *   consistent {count, sum, min, max} record through a seqlock. Observers
+ *   never write shared state and never block the owner.
+ *
+ * Usage with a fifo (consumer thread):
+ *   stats.sync(q);      // fold elements published since the last sync
+ *   stats.pop(q, n);    // evict n front elements and q.pop(n)
+ *
+ * Contract:
+ * - T must be arithmetic. Sums accumulate in acc_type (int64/uint64/double).
+ * - Every pop of the attached ring must go through pop(q, n) (or be reported
+ *   with on_pop(v) in order), otherwise the window drifts.
+ * - At most capacity() elements may be tracked at once (the fifo capacity).
+ * - Floating-point sums are maintained by add/subtract and may accumulate
+ *   rounding error over very long runs; call reset() + sync() to rebase.
+ */
+
+#ifndef SPSC_WINDOW_STATS_HPP_
+#define SPSC_WINDOW_STATS_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>      // std::unique_ptr
+#include <new>         // std::nothrow
+#include <type_traits>
+
+#include "basic_types.h"           // reg
+#include "base/spsc_cacheline.hpp" // SPSC_CACHELINE_BYTES
+#include "base/spsc_regions.hpp"   // ::spsc::unsafe
+#include "base/spsc_tools.hpp"     // RB_FORCEINLINE, RB_LIKELY, RB_UNLIKELY
+
+namespace spsc {
+
+/* =======================================================================
+ * window_record<T, Acc>
+ *
+ * Consistent aggregate snapshot handed to observers.
+ * min/max are meaningful only when count != 0.
+ * ======================================================================= */
+template <class T, class Acc>
+struct window_record {
+    reg count{0u};
+    Acc sum{};
+    T   min{};
+    T   max{};
+
+    [[nodiscard]] double mean() const noexcept {
+        return (count != 0u) ? static_cast<double>(sum) / static_cast<double>(count) : 0.0;
+    }
+};
+
+/* =======================================================================
+ * window_stats<T, Capacity>
+ *
+ * T        : arithmetic element type.
+ * Capacity : max tracked elements (pow2 not required); 0 -> runtime resize().
+ * ======================================================================= */
+template <class T, reg Capacity = 0u>
+class window_stats {
+    static_assert(std::is_arithmetic_v<T>,
+                  "[spsc::window_stats]: T must be arithmetic.");
+
+public:
+    // ------------------------------------------------------------------------------------------
+    // Type Definitions
+    // ------------------------------------------------------------------------------------------
+    using value_type = T;
+    using size_type  = reg;
+    using acc_type   = std::conditional_t<std::is_floating_point_v<T>, double,
+                       std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>>;
+    using record     = window_record<T, acc_type>;
+
+    // ------------------------------------------------------------------------------------------
+    // Constructors / Destructor
+    // ------------------------------------------------------------------------------------------
+    window_stats() noexcept = default;
+
+    explicit window_stats(const size_type capacity) noexcept {
+        static_assert(Capacity == 0u, "[spsc::window_stats]: runtime capacity needs Capacity == 0.");
+        (void)resize(capacity);
+    }
+
+    window_stats(const window_stats &) = delete;
+    window_stats &operator=(const window_stats &) = delete;
+    window_stats(window_stats &&) = delete;
+    window_stats &operator=(window_stats &&) = delete;
+
+    // ------------------------------------------------------------------------------------------
+    // Geometry
+    // ------------------------------------------------------------------------------------------
+
+    /* Dynamic only: (re)allocate deque storage and reset the window.
+     * Returns false on allocation failure (previous storage is kept).
+     */
+    [[nodiscard]] bool resize(const size_type capacity) noexcept {
+        static_assert(Capacity == 0u, "[spsc::window_stats]: resize() needs Capacity == 0.");
+        if (capacity == 0u) {
+            min_buf_.reset();
+            max_buf_.reset();
+            cap_ = 0u;
+            reset();
+            return true;
+        }
+
+        std::unique_ptr<entry[]> mn(new (std::nothrow) entry[capacity]);
+        std::unique_ptr<entry[]> mx(new (std::nothrow) entry[capacity]);
+        if (RB_UNLIKELY(!mn || !mx)) {
+            return false;
+        }
+        min_buf_ = std::move(mn);
+        max_buf_ = std::move(mx);
+        cap_ = capacity;
+        reset();
+        return true;
+    }
+
+    [[nodiscard]] size_type capacity() const noexcept {
+        if constexpr (Capacity != 0u) {
+            return Capacity;
+        } else {
+            return cap_;
+        }
+    }
+
+    [[nodiscard]] bool is_valid() const noexcept { return capacity() != 0u; }
+
+    /* Forget all tracked elements (owner thread, ring must be re-synced). */
+    void reset() noexcept {
+        pushed_ = 0u;
+        popped_ = 0u;
+        sum_    = acc_type{};
+        min_    = deque_{};
+        max_    = deque_{};
+        publish_();
+    }
+
+    // ------------------------------------------------------------------------------------------
+    // Owner: fifo integration
+    // ------------------------------------------------------------------------------------------
+
+    /* Fold elements published since the last sync. Returns how many were added. */
+    template <class Ring>
+    size_type sync(Ring &q) noexcept {
+        const auto r = q.claim_read(::spsc::unsafe);
+        const size_type tracked = size();
+        if (r.total <= tracked) {
+            return 0u;
+        }
+
+        size_type skip = tracked;
+        size_type added = 0u;
+        const auto fold = [&](const auto &reg_) noexcept {
+            size_type i = 0u;
+            if (skip != 0u) {
+                i = (skip < reg_.count) ? skip : reg_.count;
+                skip = static_cast<size_type>(skip - i);
+            }
+            for (; i < reg_.count; ++i) {
+                push_one_(static_cast<T>(reg_.ptr[i]));
+                ++added;
+            }
+        };
+        fold(r.first);
+        fold(r.second);
+
+        publish_();
+        return added;
+    }
+
+    /* Evict the n front elements from the window, then q.pop(n).
+     * Precondition: n <= size() (elements must have been synced).
+     */
+    template <class Ring>
+    void pop(Ring &q, const size_type n = 1u) noexcept {
+        SPSC_ASSERT(n <= size());
+        const auto r = q.claim_read(::spsc::unsafe, n);
+        SPSC_ASSERT(r.total == n);
+
+        for (size_type i = 0; i < r.first.count; ++i) {
+            pop_one_(static_cast<T>(r.first.ptr[i]));
+        }
+        for (size_type i = 0; i < r.second.count; ++i) {
+            pop_one_(static_cast<T>(r.second.ptr[i]));
+        }
+        q.pop(n);
+        publish_();
+    }
+
+    // ------------------------------------------------------------------------------------------
+    // Owner: manual feed (no ring attached, or ring managed elsewhere)
+    // ------------------------------------------------------------------------------------------
+    void on_push(const T v) noexcept {
+        push_one_(v);
+        publish_();
+    }
+
+    /* v must be the oldest tracked value (FIFO order). */
+    void on_pop(const T v) noexcept {
+        pop_one_(v);
+        publish_();
+    }
+
+    // ------------------------------------------------------------------------------------------
+    // Owner: O(1) getters
+    // ------------------------------------------------------------------------------------------
+    [[nodiscard]] size_type size() const noexcept { return static_cast<size_type>(pushed_ - popped_); }
+    [[nodiscard]] bool empty() const noexcept { return pushed_ == popped_; }
+    [[nodiscard]] acc_type window_sum() const noexcept { return sum_; }
+
+    [[nodiscard]] double window_mean() const noexcept {
+        const size_type n = size();
+        return (n != 0u) ? static_cast<double>(sum_) / static_cast<double>(n) : 0.0;
+    }
+
+    /* Precondition: !empty(). */
+    [[nodiscard]] T window_min() const noexcept {
+        SPSC_ASSERT(!empty());
+        return min_.front(min_data_());
+    }
+
+    /* Precondition: !empty(). */
+    [[nodiscard]] T window_max() const noexcept {
+        SPSC_ASSERT(!empty());
+        return max_.front(max_data_());
+    }
+
+    [[nodiscard]] record snapshot() const noexcept {
+        record rec{};
+        rec.count = size();
+        rec.sum   = sum_;
+        if (rec.count != 0u) {
+            rec.min = window_min();
+            rec.max = window_max();
+        }
+        return rec;
+    }
+
+    // ------------------------------------------------------------------------------------------
+    // Observers (any thread): seqlock reads
+    // ------------------------------------------------------------------------------------------
+
+    /* One attempt. Returns false if the owner was publishing concurrently. */
+    [[nodiscard]] bool try_read(record &out) const noexcept {
+        const std::uint32_t s0 = pub_.seq.load(std::memory_order_acquire);
+        if (s0 & 1u) {
+            return false;
+        }
+        record tmp{};
+        tmp.count = pub_.count.load(std::memory_order_relaxed);
+        tmp.sum   = pub_.sum.load(std::memory_order_relaxed);
+        tmp.min   = pub_.min.load(std::memory_order_relaxed);
+        tmp.max   = pub_.max.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (pub_.seq.load(std::memory_order_relaxed) != s0) {
+            return false;
+        }
+        out = tmp;
+        return true;
+    }
+
+    /* Retries until a consistent record is read (owner publishes are short). */
+    [[nodiscard]] record read() const noexcept {
+        record out{};
+        while (!try_read(out)) {
+        }
+        return out;
+    }
+
+    /* Number of completed publishes (even seqlock generations). */
+    [[nodiscard]] std::uint32_t generation() const noexcept {
+        return pub_.seq.load(std::memory_order_acquire) >> 1u;
+    }
+
+private:
+    struct entry {
+        std::uint64_t seq{0u};
+        T             v{};
+    };
+
+    // Bounded double-ended ring of entries (storage supplied by the owner).
+    struct deque_ {
+        size_type head{0u}; // index of front
+        size_type n{0u};
+
+        [[nodiscard]] T front(const entry *d) const noexcept { return d[head].v; }
+
+        template <class Less>
+        RB_FORCEINLINE void push_back(entry *d, const size_type cap, const entry e, Less less) noexcept {
+            // Drop dominated tail entries: they can never be the extreme again.
+            while (n != 0u) {
+                const size_type back = (head + n - 1u) % cap;
+                if (less(d[back].v, e.v)) {
+                    break;
+                }
+                --n;
+            }
+            d[(head + n) % cap] = e;
+            ++n;
+        }
+
+        RB_FORCEINLINE void pop_front_if(const entry *d, const size_type cap, const std::uint64_t seq) noexcept {
+            if ((n != 0u) && (d[head].seq == seq)) {
+                head = static_cast<size_type>((head + 1u) % cap);
+                --n;
+            }
+        }
+    };
+
+    struct min_less { bool operator()(const T a, const T b) const noexcept { return a < b; } };
+    struct max_less { bool operator()(const T a, const T b) const noexcept { return a > b; } };
+
+    [[nodiscard]] entry *min_data_() noexcept {
+        if constexpr (Capacity != 0u) { return min_arr_.data(); } else { return min_buf_.get(); }
+    }
+    [[nodiscard]] const entry *min_data_() const noexcept {
+        if constexpr (Capacity != 0u) { return min_arr_.data(); } else { return min_buf_.get(); }
+    }
+    [[nodiscard]] entry *max_data_() noexcept {
+        if constexpr (Capacity != 0u) { return max_arr_.data(); } else { return max_buf_.get(); }
+    }
+    [[nodiscard]] const entry *max_data_() const noexcept {
+        if constexpr (Capacity != 0u) { return max_arr_.data(); } else { return max_buf_.get(); }
+    }
+
+    RB_FORCEINLINE void push_one_(const T v) noexcept {
+        const size_type cap = capacity();
+        SPSC_ASSERT(cap != 0u && size() < cap);
+        const entry e{pushed_, v};
+        ++pushed_;
+        sum_ = static_cast<acc_type>(sum_ + static_cast<acc_type>(v));
+        min_.push_back(min_data_(), cap, e, min_less{});
+        max_.push_back(max_data_(), cap, e, max_less{});
+    }
+
+    RB_FORCEINLINE void pop_one_(const T v) noexcept {
+        SPSC_ASSERT(!empty());
+        const size_type cap = capacity();
+        const std::uint64_t seq = popped_;
+        ++popped_;
+        sum_ = static_cast<acc_type>(sum_ - static_cast<acc_type>(v));
+        min_.pop_front_if(min_data_(), cap, seq);
+        max_.pop_front_if(max_data_(), cap, seq);
+    }
+
+    void publish_() noexcept {
+        const std::uint32_t s = pub_.seq.load(std::memory_order_relaxed);
+        pub_.seq.store(s + 1u, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        const size_type n = size();
+        pub_.count.store(n, std::memory_order_relaxed);
+        pub_.sum.store(sum_, std::memory_order_relaxed);
+        if (n != 0u) {
+            pub_.min.store(window_min(), std::memory_order_relaxed);
+            pub_.max.store(window_max(), std::memory_order_relaxed);
+        } else {
+            pub_.min.store(T{}, std::memory_order_relaxed);
+            pub_.max.store(T{}, std::memory_order_relaxed);
+        }
+
+        pub_.seq.store(s + 2u, std::memory_order_release);
+    }
+
+    // Seqlock-published record, on its own cache line (observers only read it).
+    struct alignas(SPSC_CACHELINE_BYTES) published_ {
+        std::atomic<std::uint32_t> seq{0u};
+        std::atomic<size_type>     count{0u};
+        std::atomic<acc_type>      sum{acc_type{}};
+        std::atomic<T>             min{T{}};
+        std::atomic<T>             max{T{}};
+    };
+
+    using static_store  = std::array<entry, (Capacity != 0u) ? Capacity : 1u>;
+    using dynamic_store = std::unique_ptr<entry[]>;
+
+    // Owner-only state.
+    std::uint64_t pushed_{0u};
+    std::uint64_t popped_{0u};
+    acc_type      sum_{};
+    deque_        min_{};
+    deque_        max_{};
+    size_type     cap_{0u};
+
+    [[no_unique_address]] std::conditional_t<Capacity != 0u, static_store, char> min_arr_{};
+    [[no_unique_address]] std::conditional_t<Capacity != 0u, static_store, char> max_arr_{};
+    std::conditional_t<Capacity == 0u, dynamic_store, char> min_buf_{};
+    std::conditional_t<Capacity == 0u, dynamic_store, char> max_buf_{};
+
+    published_ pub_{};
+};
+
+} // namespace spsc
+
+#endif /* SPSC_WINDOW_STATS_HPP_ */
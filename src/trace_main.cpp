@@ -0,0 +1,11 @@
+// trace_main.cpp
+// Entry point of spsc_trace_test.pro (see trace_test_config.h).
+
+#include <QCoreApplication>
+
+#include "trace_test.h"
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+    return run_tst_trace_api_paranoid(argc, argv);
+}
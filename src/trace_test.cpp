@@ -0,0 +1,442 @@
+// trace_test.cpp
+// Paranoid API/contract test for the static tracepoints (base/spsc_trace.hpp).
+//
+// Goals:
+//  - SPSC_TRACE_USER routes every probe site into a sink.
+//  - full/empty fire on rejected try_* calls only (the full()/empty()/can_*()
+//    queries stay silent), refresh_tail/refresh_head on shadow reloads,
+//    resize on init().
+//  - Guards: guard_commit on commit() and on scope-exit publish/pop,
+//    guard_cancel on cancel() of a live claim and on a write guard that
+//    drops its claim at scope exit (never from commit()), in fifo, queue, pool,
+//    typed_pool, fifo_view and pool_view.
+//
+// Notes:
+//  - Built by spsc_trace_test.pro, not spsc_test: trace_test_config.h routes
+//    SPSC_TRACE_USER into trace_test_hit() for the whole target.
+
+#include <QtTest/QtTest>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if !defined(SPSC_ASSERT) && !defined(NDEBUG)
+#  define SPSC_ASSERT(expr) do { if(!(expr)) { std::abort(); } } while(0)
+#endif
+
+#include "trace_test.h"
+#include "fifo.hpp"
+#include "fifo_view.hpp"
+#include "pool.hpp"
+#include "pool_view.hpp"
+#include "queue.hpp"
+#include "typed_pool.hpp"
+
+#if !SPSC_TRACE_ENABLED
+#  error "trace_test.cpp must be built by spsc_trace_test.pro"
+#endif
+
+namespace {
+
+struct trace_event {
+    const char*   name;
+    const void*   ring;
+    std::uint64_t a;
+    std::uint64_t b;
+};
+
+constexpr int kMaxEvents = 256;
+
+trace_event g_events[kMaxEvents];
+int         g_count = 0;
+
+} // namespace
+
+void trace_test_hit(const char* name, const void* ring, const std::uint64_t a, const std::uint64_t b) noexcept {
+    if (g_count < kMaxEvents) {
+        g_events[g_count] = trace_event{name, ring, a, b};
+    }
+    ++g_count;
+}
+
+namespace {
+
+using traced_policy = ::spsc::policy::A<>;
+
+using traced_fifo  = ::spsc::fifo<std::uint32_t, 0, traced_policy>;
+using traced_queue = ::spsc::queue<std::uint32_t, 0, traced_policy>;
+using traced_pool  = ::spsc::pool<0, traced_policy>;
+using traced_typed = ::spsc::typed_pool<std::uint32_t, 8, traced_policy>;
+using traced_fview = ::spsc::fifo_view<std::uint32_t, 8, traced_policy>;
+using traced_pview = ::spsc::pool_view<4, traced_policy>;
+
+void reset_events() noexcept { g_count = 0; }
+
+int count_of(const char* name) noexcept {
+    int n = 0;
+    for (int i = 0; (i < g_count) && (i < kMaxEvents); ++i) {
+        n += (std::strcmp(g_events[i].name, name) == 0) ? 1 : 0;
+    }
+    return n;
+}
+
+const trace_event* last_of(const char* name) noexcept {
+    const trace_event* e = nullptr;
+    for (int i = 0; (i < g_count) && (i < kMaxEvents); ++i) {
+        if (std::strcmp(g_events[i].name, name) == 0) {
+            e = &g_events[i];
+        }
+    }
+    return e;
+}
+
+class tst_trace_api_paranoid : public QObject {
+    Q_OBJECT
+
+private slots:
+    void sink_enabled() {
+        QCOMPARE(SPSC_TRACE_ENABLED, 1);
+    }
+
+    void ring_full_empty_refresh() {
+        traced_fifo q;
+        reset_events();
+        QVERIFY(q.resize(8u));
+        QCOMPARE(count_of("resize"), 1);
+        QCOMPARE(last_of("resize")->a, std::uint64_t(8u));
+        QCOMPARE(last_of("resize")->b, std::uint64_t(0u));
+
+        reset_events();
+        for (std::uint32_t i = 0; i < 8u; ++i) {
+            QVERIFY(q.try_push(i));
+        }
+        QCOMPARE(count_of("full"), 0);
+
+        QVERIFY(!q.try_push(99u));
+        QVERIFY(count_of("refresh_tail") >= 1);
+        QCOMPARE(count_of("full"), 1);
+        QCOMPARE(last_of("refresh_tail")->b, std::uint64_t(8u)); // used
+        QCOMPARE(last_of("full")->b, std::uint64_t(8u));         // cap
+        QCOMPARE(last_of("full")->ring, static_cast<const void*>(&q));
+
+        // Queries never report a rejection: pollers do not flood the trace.
+        reset_events();
+        QVERIFY(q.full());
+        QVERIFY(!q.can_write(3u));
+        QCOMPARE(q.write_size(), 0u);
+        QCOMPARE(count_of("full"), 0);
+
+        QVERIFY(!q.try_publish(3u));
+        QCOMPARE(count_of("full"), 1);
+        QCOMPARE(last_of("full")->a, std::uint64_t(3u));
+        QVERIFY(!q.try_publish(9u)); // larger than the ring
+        QCOMPARE(last_of("full")->a, std::uint64_t(9u));
+
+        reset_events();
+        for (std::uint32_t i = 0; i < 8u; ++i) {
+            QVERIFY(q.try_front() != nullptr);
+            q.pop();
+        }
+        QVERIFY(count_of("refresh_head") >= 1);
+        QCOMPARE(count_of("empty"), 0);
+
+        QVERIFY(q.try_front() == nullptr);
+        QCOMPARE(count_of("empty"), 1);
+        QCOMPARE(last_of("refresh_head")->b, std::uint64_t(0u)); // avail
+
+        reset_events();
+        QVERIFY(q.empty());
+        QVERIFY(!q.can_read(1u));
+        QCOMPARE(q.read_size(), 0u);
+        QCOMPARE(count_of("empty"), 0);
+
+        QVERIFY(!q.try_pop(2u));
+        QCOMPARE(count_of("empty"), 1);
+        QCOMPARE(last_of("empty")->a, std::uint64_t(2u));
+        QCOMPARE(last_of("empty")->b, std::uint64_t(8u));
+        QCOMPARE(count_of("full"), 0);
+    }
+
+    void fifo_guards() {
+        traced_fifo q(8u);
+
+        reset_events();
+        {
+            auto g = q.scoped_write();
+            QVERIFY(static_cast<bool>(g));
+            *g = 1u;
+        }
+        QCOMPARE(count_of("guard_commit"), 1);
+        QCOMPARE(last_of("guard_commit")->a, std::uint64_t(1u));
+        QCOMPARE(last_of("guard_commit")->ring, static_cast<const void*>(&q));
+
+        reset_events();
+        {
+            auto g = q.scoped_write(4u);
+            QVERIFY(static_cast<bool>(g));
+            (void)g.write_next(2u);
+            (void)g.write_next(3u);
+            g.commit();
+        }
+        QCOMPARE(count_of("guard_commit"), 1);
+        QCOMPARE(last_of("guard_commit")->a, std::uint64_t(2u));
+        QCOMPARE(count_of("guard_cancel"), 0);
+
+        reset_events();
+        {
+            auto g = q.scoped_write(3u);
+            QVERIFY(static_cast<bool>(g));
+            (void)g.write_next(7u);
+            g.cancel();
+            g.cancel(); // no claim left: silent
+        }
+        QCOMPARE(count_of("guard_commit"), 0);
+        QCOMPARE(count_of("guard_cancel"), 1);
+        QCOMPARE(last_of("guard_cancel")->a, std::uint64_t(3u));
+        QCOMPARE(q.size(), 3u);
+
+        reset_events();
+        {
+            auto r = q.scoped_read();
+            QVERIFY(static_cast<bool>(r));
+            r.cancel();
+        }
+        {
+            auto r = q.scoped_read();
+            r.commit();
+        }
+        {
+            auto r = q.scoped_read(8u);
+            QCOMPARE(r.count(), 2u);
+        }
+        QCOMPARE(count_of("guard_cancel"), 1);
+        QCOMPARE(count_of("guard_commit"), 2);
+        QCOMPARE(last_of("guard_commit")->a, std::uint64_t(2u));
+        QVERIFY(q.empty());
+
+        reset_events();
+        {
+            auto r = q.scoped_read(); // nothing claimed
+            QVERIFY(!static_cast<bool>(r));
+            r.cancel();
+        }
+        QCOMPARE(count_of("guard_cancel"), 0);
+        QCOMPARE(count_of("guard_commit"), 0);
+    }
+
+    void queue_guards() {
+        traced_queue q(8u);
+
+        reset_events();
+        {
+            auto g = q.scoped_write();
+            (void)g.emplace(5u);
+            g.commit();
+        }
+        {
+            auto g = q.scoped_write();
+            (void)g.emplace(6u);
+            g.cancel();
+        }
+        {
+            auto g = q.scoped_write(4u);
+            (void)g.emplace_next(7u);
+            (void)g.emplace_next(8u);
+        }
+        QCOMPARE(count_of("guard_commit"), 2);
+        QCOMPARE(last_of("guard_commit")->a, std::uint64_t(2u));
+        QCOMPARE(count_of("guard_cancel"), 1);
+        QCOMPARE(q.size(), 3u);
+
+        reset_events();
+        {
+            auto r = q.scoped_read();
+            QCOMPARE(*r, 5u);
+            r.commit();
+        }
+        {
+            auto r = q.scoped_read(8u);
+            r.cancel();
+        }
+        QCOMPARE(count_of("guard_commit"), 1);
+        QCOMPARE(count_of("guard_cancel"), 1);
+        QCOMPARE(last_of("guard_cancel")->a, std::uint64_t(2u));
+        QCOMPARE(q.size(), 2u);
+    }
+
+    void pool_guards() {
+        traced_pool p(4u, 32u);
+
+        reset_events();
+        {
+            auto g = p.scoped_write();
+            QVERIFY(g.as<std::uint32_t>() != nullptr);
+        }
+        {
+            auto g = p.scoped_write();
+            g.commit();
+        }
+        {
+            auto g = p.scoped_write();
+            g.cancel();
+        }
+        QCOMPARE(count_of("guard_commit"), 2);
+        QCOMPARE(count_of("guard_cancel"), 1);
+        QCOMPARE(p.size(), 2u);
+
+        reset_events();
+        {
+            auto r = p.scoped_read(4u);
+            QCOMPARE(r.count(), 2u);
+            r.commit();
+        }
+        QCOMPARE(count_of("guard_commit"), 1);
+        QCOMPARE(count_of("guard_cancel"), 0);
+        QCOMPARE(last_of("guard_commit")->ring, static_cast<const void*>(&p));
+        QVERIFY(p.empty());
+    }
+
+    void dropped_claims_trace_cancel() {
+        traced_fifo f(8u);
+        traced_queue q(8u);
+        traced_pool p(4u, 32u);
+
+        reset_events();
+        {
+            auto g = f.scoped_write();
+            QVERIFY(g.peek() != nullptr); // address only: not armed
+        }
+        {
+            auto g = f.scoped_write(3u);
+            (void)g.write_next(1u);
+            g.disarm_publish();
+        }
+        QCOMPARE(count_of("guard_commit"), 0);
+        QCOMPARE(count_of("guard_cancel"), 2);
+        QCOMPARE(last_of("guard_cancel")->a, std::uint64_t(3u));
+        QCOMPARE(last_of("guard_cancel")->ring, static_cast<const void*>(&f));
+        QVERIFY(f.empty());
+
+        reset_events();
+        {
+            auto g = q.scoped_write(); // nothing constructed
+            QVERIFY(static_cast<bool>(g));
+        }
+        {
+            auto g = q.scoped_write(4u);
+            (void)g.emplace_next(9u);
+            g.disarm_publish(); // destroyed, not published
+        }
+        QCOMPARE(count_of("guard_commit"), 0);
+        QCOMPARE(count_of("guard_cancel"), 2);
+        QCOMPARE(last_of("guard_cancel")->a, std::uint64_t(4u));
+        QVERIFY(q.empty());
+
+        reset_events();
+        {
+            auto g = p.scoped_write();
+            QVERIFY(g.get() != nullptr); // raw access does not arm
+        }
+        {
+            auto g = p.scoped_write(2u);
+            QVERIFY(static_cast<bool>(g));
+        }
+        {
+            auto g = p.scoped_write();
+            g.cancel(); // explicit: one event, none from the destructor
+        }
+        QCOMPARE(count_of("guard_commit"), 0);
+        QCOMPARE(count_of("guard_cancel"), 3);
+        QCOMPARE(last_of("guard_cancel")->ring, static_cast<const void*>(&p));
+        QVERIFY(p.empty());
+    }
+
+    void typed_pool_and_view_guards() {
+        traced_typed t;
+
+        reset_events();
+        {
+            auto g = t.scoped_write();
+            (void)g.emplace(1u);
+        }
+        {
+            auto g = t.scoped_write(); // nothing constructed
+            QVERIFY(static_cast<bool>(g));
+        }
+        {
+            auto g = t.scoped_write(4u);
+            (void)g.emplace_next(2u);
+            g.commit();
+        }
+        {
+            auto r = t.scoped_read(8u);
+            QCOMPARE(r.count(), 2u);
+            r.cancel();
+        }
+        QCOMPARE(count_of("guard_commit"), 2);
+        QCOMPARE(count_of("guard_cancel"), 2);
+        QCOMPARE(last_of("guard_cancel")->a, std::uint64_t(2u));
+        QCOMPARE(last_of("guard_commit")->ring, static_cast<const void*>(&t));
+        {
+            auto r = t.scoped_read();
+            QCOMPARE(*r, 1u);
+        }
+        QCOMPARE(count_of("guard_commit"), 3);
+
+        std::uint32_t buf[8] = {};
+        traced_fview v(buf);
+
+        reset_events();
+        {
+            auto g = v.scoped_write();
+            *g = 5u;
+        }
+        {
+            auto g = v.scoped_write(3u);
+            (void)g.write_next(6u);
+            g.disarm_publish();
+        }
+        {
+            auto r = v.scoped_read();
+            r.commit();
+        }
+        QCOMPARE(count_of("guard_commit"), 2);
+        QCOMPARE(count_of("guard_cancel"), 1);
+        QCOMPARE(last_of("guard_cancel")->a, std::uint64_t(3u));
+        QCOMPARE(last_of("guard_cancel")->ring, static_cast<const void*>(&v));
+        QVERIFY(v.try_front() == nullptr);
+        QCOMPARE(count_of("empty"), 1);
+
+        std::uint32_t store[4][8] = {};
+        void* table[4] = {store[0], store[1], store[2], store[3]};
+        traced_pview pv(table, sizeof(store[0]));
+
+        reset_events();
+        {
+            auto g = pv.scoped_write();
+            QVERIFY(g.as<std::uint32_t>() != nullptr);
+        }
+        {
+            auto g = pv.scoped_write();
+            QVERIFY(g.get() != nullptr); // raw access does not arm
+        }
+        {
+            auto r = pv.scoped_read(4u);
+            QCOMPARE(r.count(), 1u);
+        }
+        QCOMPARE(count_of("guard_commit"), 2);
+        QCOMPARE(count_of("guard_cancel"), 1);
+        QCOMPARE(last_of("guard_commit")->ring, static_cast<const void*>(&pv));
+        QVERIFY(pv.empty());
+    }
+};
+
+} // namespace
+
+int run_tst_trace_api_paranoid(int argc, char** argv) {
+    tst_trace_api_paranoid tc;
+    return QTest::qExec(&tc, argc, argv);
+}
+
+#include "trace_test.moc"
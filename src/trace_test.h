@@ -0,0 +1,6 @@
+#ifndef TRACE_TEST_H_
+#define TRACE_TEST_H_
+
+int run_tst_trace_api_paranoid(int argc, char** argv);
+
+#endif /* TRACE_TEST_H_ */
@@ -0,0 +1,17 @@
+#ifndef TRACE_TEST_CONFIG_H_
+#define TRACE_TEST_CONFIG_H_
+
+/*
+ * SPSC_CONFIG_USER_HEADER of spsc_trace_test.pro.
+ * Every translation unit of that target routes the trace sites into
+ * trace_test_hit() (trace_test.cpp), so all inline definitions agree.
+ */
+
+#include <cstdint>
+
+void trace_test_hit(const char* name, const void* ring, std::uint64_t a, std::uint64_t b) noexcept;
+
+#define SPSC_TRACE_USER(name, ring, a, b) \
+    trace_test_hit(#name, static_cast<const void*>(ring), std::uint64_t(a), std::uint64_t(b))
+
+#endif /* TRACE_TEST_CONFIG_H_ */
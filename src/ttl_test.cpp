@@ -0,0 +1,237 @@
+// ttl_test.cpp
+// Paranoid API/contract test for spsc::ttl (age-based expiry).
+//
+// Goals:
+//  - skip_expired() drops exactly the expired prefix on fifo, fifo_view and queue.
+//  - Correct across the wrap split (boundary in first region, in second region,
+//    whole range expired, nothing expired).
+//  - Key reads are logarithmic in the readable range (release builds; debug
+//    builds add the O(n) sorted-stamps precondition check).
+//  - Unsigned cutoff never underflows; std::chrono stamps work.
+//  - Concurrent producer/consumer: survivors are always fresh and in order.
+
+#include <QtTest/QtTest>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+#if !defined(SPSC_ASSERT) && !defined(NDEBUG)
+#  define SPSC_ASSERT(expr) do { if(!(expr)) { std::abort(); } } while(0)
+#endif
+
+#include "fifo.hpp"
+#include "fifo_view.hpp"
+#include "queue.hpp"
+#include "ttl.hpp"
+
+namespace {
+
+using Item = spsc::ttl::stamped<std::uint32_t, std::uint64_t>;
+
+// Counts key reads to check the O(log n) bound.
+struct counting_key {
+    std::uint32_t* reads{nullptr};
+
+    std::uint64_t operator()(const Item& e) const noexcept {
+        ++*reads;
+        return e.stamp;
+    }
+};
+
+static unsigned log2_ceil(unsigned v) {
+    unsigned r = 0u;
+    while ((1u << r) < v) {
+        ++r;
+    }
+    return r;
+}
+
+// Fills q with stamps base, base+1, ... and rotates it first so the data wraps.
+template <class Q>
+static void fill_wrapped(Q& q, const std::uint64_t base, const unsigned n, const unsigned rotate) {
+    for (unsigned i = 0; i < rotate; ++i) {
+        q.push(Item{0u, 0u});
+    }
+    q.pop(static_cast<reg>(rotate));
+    for (unsigned i = 0; i < n; ++i) {
+        q.push(Item{base + i, static_cast<std::uint32_t>(i)});
+    }
+}
+
+class tst_ttl_api_paranoid : public QObject {
+    Q_OBJECT
+
+private slots:
+    void cutoff_unsigned_no_underflow() {
+        spsc::ttl::expiry<> ex(100u);
+        QCOMPARE(ex.ttl(), std::uint64_t(100u));
+        QCOMPARE(ex.cutoff(50u), std::uint64_t(0u));
+        QCOMPARE(ex.cutoff(100u), std::uint64_t(0u));
+        QCOMPARE(ex.cutoff(250u), std::uint64_t(150u));
+        QVERIFY(!ex.expired(Item{0u, 0u}, 50u));
+        QVERIFY(ex.expired(Item{149u, 0u}, 250u));
+        QVERIFY(!ex.expired(Item{150u, 0u}, 250u));
+
+        ex.set_ttl(10u);
+        QCOMPARE(ex.cutoff(250u), std::uint64_t(240u));
+    }
+
+    void empty_ring_is_noop() {
+        spsc::fifo<Item, 16> q;
+        spsc::ttl::expiry<> ex(5u);
+        QCOMPARE(ex.skip_expired(q, 1000u), reg(0u));
+
+        spsc::fifo<Item, 0> d; // unallocated dynamic ring
+        QCOMPARE(ex.skip_expired(d, 1000u), reg(0u));
+    }
+
+    void fifo_boundary_everywhere() {
+        constexpr unsigned kCap = 64u;
+        // Every rotation x every boundary position, including 0 and "all".
+        for (unsigned rot = 0; rot < kCap; rot += 7u) {
+            for (unsigned k = 0; k <= 40u; ++k) {
+                spsc::fifo<Item, kCap> q;
+                fill_wrapped(q, 1000u, 40u, rot);
+
+                spsc::ttl::expiry<> ex(10u);
+                // cutoff = now - ttl = 1000 + k -> stamps [1000, 1000+k) expire.
+                const std::uint64_t now = 1000u + k + 10u;
+                QCOMPARE(ex.count_expired(q, now), reg(k));
+                QCOMPARE(q.size(), reg(40u)); // count_expired() does not release
+
+                QCOMPARE(ex.skip_expired(q, now), reg(k));
+                QCOMPARE(q.size(), reg(40u - k));
+                if (k < 40u) {
+                    QCOMPARE(q.front().stamp, std::uint64_t(1000u + k));
+                    QCOMPARE(q.front().value, std::uint32_t(k));
+                }
+                QCOMPARE(ex.skip_expired(q, now), reg(0u)); // idempotent
+            }
+        }
+    }
+
+    void logarithmic_key_reads() {
+        constexpr unsigned kCap = 4096u;
+        spsc::fifo<Item, kCap> q;
+        fill_wrapped(q, 0u, kCap - 1u, kCap / 3u);
+
+        for (unsigned k : {0u, 1u, 17u, 1365u, 2730u, 2731u, 4000u, kCap - 1u}) {
+            std::uint32_t reads = 0u;
+            const auto r = q.claim_read(spsc::unsafe);
+            const auto n = spsc::ttl::count_expired(r, std::uint64_t(k), counting_key{&reads});
+            QCOMPARE(n, reg(k));
+#if defined(NDEBUG)
+            QVERIFY2(reads <= 2u * (log2_ceil(kCap) + 2u), "count_expired() is not logarithmic");
+#else
+            // SPSC_ASSERT(std::is_partitioned(...)) reads every key once more.
+            QVERIFY2(reads <= 2u * (log2_ceil(kCap) + 2u) + 2u * kCap, "count_expired() is not logarithmic");
+#endif
+        }
+    }
+
+    void fifo_view_and_queue() {
+        std::array<Item, 32> storage{};
+        spsc::fifo_view<Item, 32> v(storage);
+        QVERIFY(v.is_valid());
+        fill_wrapped(v, 500u, 20u, 25u);
+
+        spsc::ttl::expiry<> ex(0u);
+        QCOMPARE(ex.skip_expired(v, 512u), reg(12u));
+        QCOMPARE(v.front().stamp, std::uint64_t(512u));
+
+        using Msg = spsc::ttl::stamped<std::string, std::uint64_t>;
+        spsc::queue<Msg, 16> q;
+        for (unsigned i = 0; i < 11u; ++i) {
+            QVERIFY(q.try_emplace(Msg{0u, "warmup"}));
+        }
+        q.pop(reg(11u));
+        for (unsigned i = 0; i < 12u; ++i) {
+            QVERIFY(q.try_emplace(Msg{100u + i, std::string(40u, char('a' + i))}));
+        }
+        QCOMPARE(ex.skip_expired(q, 105u), reg(5u));
+        QCOMPARE(q.size(), reg(7u));
+        QCOMPARE(q.front().stamp, std::uint64_t(105u));
+        QCOMPARE(q.front().value, std::string(40u, 'f'));
+        QCOMPARE(ex.skip_expired(q, 1000u), reg(7u));
+        QVERIFY(q.empty());
+    }
+
+    void chrono_stamps() {
+        using clock = std::chrono::steady_clock;
+        using stamp = clock::duration; // time_since_epoch(): nothrow default-constructible
+        using CItem = spsc::ttl::stamped<int, stamp>;
+
+        spsc::fifo<CItem, 8> q;
+        const stamp t0 = clock::now().time_since_epoch();
+        for (int i = 0; i < 6; ++i) {
+            q.push(CItem{t0 + std::chrono::milliseconds(i * 10), i});
+        }
+
+        spsc::ttl::expiry<stamp> ex(std::chrono::milliseconds(20));
+        QCOMPARE(ex.skip_expired(q, t0 + std::chrono::milliseconds(45)), reg(3u));
+        QCOMPARE(q.front().value, 3);
+    }
+
+    void concurrent_producer_consumer() {
+        using Q = spsc::fifo<Item, 1024, spsc::policy::A<>>;
+        Q q;
+        std::atomic<std::uint64_t> clock{0u};
+        std::atomic<bool> done{false};
+        constexpr std::uint32_t kN = 200000u;
+        constexpr std::uint64_t kTtl = 64u;
+
+        std::thread producer([&]() {
+            for (std::uint32_t i = 0; i < kN; ++i) {
+                const std::uint64_t now = clock.fetch_add(1u, std::memory_order_relaxed) + 1u;
+                while (!q.try_push(Item{now, i})) {
+                    std::this_thread::yield();
+                }
+            }
+            done.store(true, std::memory_order_release);
+        });
+
+        spsc::ttl::expiry<> ex(kTtl);
+        std::uint32_t last = 0u;
+        bool first = true;
+        bool ok = true;
+        reg dropped = 0u;
+        reg seen = 0u;
+        for (;;) {
+            const bool fin = done.load(std::memory_order_acquire);
+            const std::uint64_t now = clock.load(std::memory_order_relaxed);
+            dropped += ex.skip_expired(q, now);
+            while (const Item* p = q.try_front()) {
+                ok = ok && (first || p->value > last);
+                first = false;
+                last = p->value;
+                ++seen;
+                q.pop();
+                if ((seen & 63u) == 0u) {
+                    std::this_thread::yield(); // let the producer age the backlog
+                    break;
+                }
+            }
+            if (fin && q.empty()) {
+                break;
+            }
+        }
+        producer.join();
+
+        QVERIFY(ok);
+        QCOMPARE(dropped + seen, reg(kN));
+    }
+};
+
+} // namespace
+
+int run_tst_ttl_api_paranoid(int argc, char** argv) {
+    tst_ttl_api_paranoid tc;
+    return QTest::qExec(&tc, argc, argv);
+}
+
+#include "ttl_test.moc"
@@ -0,0 +1,6 @@
+#ifndef TTL_TEST_H_
+#define TTL_TEST_H_
+
+int run_tst_ttl_api_paranoid(int argc, char** argv);
+
+#endif /* TTL_TEST_H_ */
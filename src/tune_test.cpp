@@ -0,0 +1,156 @@
+// tune_test.cpp
+// Paranoid API/contract test for the spsc_tune selection model
+// (tools/spsc_tune/tune_report.hpp).
+//
+// Goals:
+//  - Variant grid covers every knob combination once (shift only with heuristic).
+//  - Probe lines parse; logs, blanks and zero throughput are rejected.
+//  - choose() ranks variants by geometric mean over common cells, ignores
+//    variants that produced nothing, and picks policies per element size.
+//  - Generated headers carry the winning macros and aliases.
+
+#include <QtTest/QtTest>
+
+#include <cmath>
+#include <cstdlib>
+#include <set>
+#include <string>
+#include <vector>
+
+#if !defined(SPSC_ASSERT) && !defined(NDEBUG)
+#  define SPSC_ASSERT(expr) do { if(!(expr)) { std::abort(); } } while(0)
+#endif
+
+#include "../tools/spsc_tune/tune_report.hpp"
+
+namespace {
+
+using ::spsc::tune::sample;
+
+sample mk(std::size_t v, const char* pol, unsigned long elem, unsigned long depth, double mops) {
+    sample s;
+    s.variant = v;
+    s.policy  = pol;
+    s.elem    = elem;
+    s.depth   = depth;
+    s.mops    = mops;
+    return s;
+}
+
+class tst_tune_api_paranoid : public QObject {
+    Q_OBJECT
+
+private slots:
+    void variant_grid() {
+        const auto v = ::spsc::tune::default_variants();
+        QCOMPARE(v.size(), std::size_t(10u));
+        std::set<std::string> names;
+        for (const auto& x : v) {
+            names.insert(x.name());
+            QVERIFY(x.heuristic == 0 || x.shadow == 1);
+        }
+        QCOMPARE(names.size(), v.size());
+        QCOMPARE(::spsc::tune::default_variants({64u}).size(), std::size_t(5u));
+
+        const std::string d = v.back().defines();
+        QVERIFY(d.find("-DSPSC_FORCE_CACHELINE=128") != std::string::npos);
+        QVERIFY(d.find("-DSPSC_SHADOW_REFRESH_FRAC_SHIFT=3") != std::string::npos);
+    }
+
+    void parse_probe_lines() {
+        sample s;
+        QVERIFY(::spsc::tune::parse_line("R CFA<> 64 1024 42.5\n", 3u, s));
+        QCOMPARE(s.variant, std::size_t(3u));
+        QCOMPARE(s.policy, std::string("CFA<>"));
+        QCOMPARE(s.elem, 64ul);
+        QCOMPARE(s.depth, 1024ul);
+        QCOMPARE(s.mops, 42.5);
+
+        QVERIFY(!::spsc::tune::parse_line("# cacheline=64", 0u, s));
+        QVERIFY(!::spsc::tune::parse_line("", 0u, s));
+        QVERIFY(!::spsc::tune::parse_line("R A<> 8 64", 0u, s));
+        QVERIFY(!::spsc::tune::parse_line("R A<> 8 64 0.000", 0u, s)); // failed cell
+        QVERIFY(!::spsc::tune::parse_line("X A<> 8 64 1.0", 0u, s));
+    }
+
+    void choose_by_geomean() {
+        std::vector<sample> s;
+        // Variant 0: uniformly decent. Variant 1: one huge cell, one awful cell.
+        s.push_back(mk(0u, "A<>", 8u, 64u, 10.0));
+        s.push_back(mk(0u, "A<>", 8u, 1024u, 10.0));
+        s.push_back(mk(1u, "A<>", 8u, 64u, 40.0));
+        s.push_back(mk(1u, "A<>", 8u, 1024u, 1.0));  // arithmetic mean would pick v1
+        // Variant 2 produced nothing (build failed) and must not matter.
+        const auto c = ::spsc::tune::choose(3u, s);
+        QVERIFY(c.valid);
+        QCOMPARE(c.variant, std::size_t(0u));
+        QVERIFY(std::abs(c.score - 10.0) < 1e-9);
+    }
+
+    void choose_ignores_partial_cells() {
+        std::vector<sample> s;
+        s.push_back(mk(0u, "A<>", 8u, 64u, 10.0));
+        s.push_back(mk(1u, "A<>", 8u, 64u, 12.0));
+        s.push_back(mk(0u, "A<>", 8u, 1024u, 1000.0)); // only v0 measured this cell
+        const auto c = ::spsc::tune::choose(2u, s);
+        QVERIFY(c.valid);
+        QCOMPARE(c.variant, std::size_t(1u));
+
+        QVERIFY(!::spsc::tune::choose(2u, {}).valid);
+        QVERIFY(!::spsc::tune::choose(0u, s).valid);
+    }
+
+    void choose_policies_per_elem() {
+        std::vector<sample> s;
+        for (unsigned long d : {64ul, 1024ul}) {
+            s.push_back(mk(0u, "A<>",   8u,   d, 5.0));
+            s.push_back(mk(0u, "CFA<>", 8u,   d, 9.0));
+            s.push_back(mk(0u, "A<>",   256u, d, 7.0));
+            s.push_back(mk(0u, "CFA<>", 256u, d, 3.0));
+            s.push_back(mk(1u, "FA<>",  8u,   d, 1.0)); // losing variant's policies are ignored
+            s.push_back(mk(1u, "FA<>",  256u, d, 1.0));
+        }
+        const auto c = ::spsc::tune::choose(2u, s);
+        QVERIFY(c.valid);
+        QCOMPARE(c.variant, std::size_t(0u));
+        QCOMPARE(c.per_elem.size(), std::size_t(2u));
+        QCOMPARE(c.per_elem[0].first, 8ul);
+        QCOMPARE(c.per_elem[0].second, std::string("CFA<>"));
+        QCOMPARE(c.per_elem[1].first, 256ul);
+        QCOMPARE(c.per_elem[1].second, std::string("A<>"));
+        QCOMPARE(c.policy, std::string("A<>")); // geomean 5.92 (A) vs 5.20 (CFA)
+    }
+
+    void emitted_headers() {
+        std::vector<sample> s;
+        s.push_back(mk(0u, "CA<>", 8u, 64u, 3.0));
+        s.push_back(mk(0u, "FA<>", 64u, 64u, 4.0));
+        const auto c = ::spsc::tune::choose(1u, s);
+        QVERIFY(c.valid);
+        const ::spsc::tune::variant v{1, 1, 3, 128u};
+
+        const std::string cfg = ::spsc::tune::emit_config(v, c, "c++ -O2");
+        QVERIFY(cfg.find("#define SPSC_ENABLE_SHADOW_INDICES 1\n") != std::string::npos);
+        QVERIFY(cfg.find("#define SPSC_SHADOW_REFRESH_HEURISTIC 1\n") != std::string::npos);
+        QVERIFY(cfg.find("#define SPSC_SHADOW_REFRESH_FRAC_SHIFT 3\n") != std::string::npos);
+        QVERIFY(cfg.find("#define SPSC_FORCE_CACHELINE 128\n") != std::string::npos);
+        QVERIFY(cfg.find("#endif /* SPSC_TUNED_CONFIG_H_ */") != std::string::npos);
+
+        const std::string pol = ::spsc::tune::emit_policy(c);
+        QVERIFY(pol.find("using policy = ::spsc::policy::FA<>;") != std::string::npos);
+        QVERIFY(pol.find("ElemBytes > 0u && ElemBytes <= 8u)>> { using type = ::spsc::policy::CA<>;")
+                != std::string::npos);
+        QVERIFY(pol.find("ElemBytes > 8u && ElemBytes <= 64u)>> { using type = ::spsc::policy::FA<>;")
+                != std::string::npos);
+        QVERIFY(pol.find("#include \"spsc_tuned_config.h\"") != std::string::npos);
+    }
+};
+
+} // namespace
+
+int run_tst_tune_api_paranoid(int argc, char** argv) {
+    tst_tune_api_paranoid tc;
+    return QTest::qExec(&tc, argc, argv);
+}
+
+#include "tune_test.moc"
@@ -0,0 +1,6 @@
+#ifndef TUNE_TEST_H_
+#define TUNE_TEST_H_
+
+int run_tst_tune_api_paranoid(int argc, char** argv);
+
+#endif /* TUNE_TEST_H_ */
@@ -0,0 +1,255 @@
+// window_stats_test.cpp
+// Paranoid API/contract test for spsc::window_stats.
+//
+// Goals:
+//  - Aggregates always equal a brute-force recomputation over the fifo contents
+//    (random push/pop mix, wrap-around, static and dynamic capacity).
+//  - Monotonic deques stay bounded and O(1) amortized (never exceed capacity).
+//  - An observer thread reading through the seqlock never sees a torn record
+//    while producer and consumer run concurrently.
+
+#include <QtTest/QtTest>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <thread>
+
+#if !defined(SPSC_ASSERT) && !defined(NDEBUG)
+#  define SPSC_ASSERT(expr) do { if(!(expr)) { std::abort(); } } while(0)
+#endif
+
+#include "fifo.hpp"
+#include "window_stats.hpp"
+
+namespace {
+
+#if defined(NDEBUG)
+constexpr int kOps = 400000;
+#else
+constexpr int kOps = 40000;
+#endif
+
+template <class Fifo, class Stats>
+static bool matches_brute_force(Fifo& q, const Stats& st) {
+    const auto r = q.claim_read(spsc::unsafe);
+    if (r.total != st.size()) {
+        return false;
+    }
+    if (r.total == 0u) {
+        return st.empty() && st.window_sum() == 0;
+    }
+
+    typename Stats::acc_type sum{};
+    auto mn = r.first.ptr[0];
+    auto mx = r.first.ptr[0];
+    const auto visit = [&](const auto& reg_) {
+        for (reg i = 0; i < reg_.count; ++i) {
+            sum += reg_.ptr[i];
+            mn = std::min(mn, reg_.ptr[i]);
+            mx = std::max(mx, reg_.ptr[i]);
+        }
+    };
+    visit(r.first);
+    visit(r.second);
+    return sum == st.window_sum() && mn == st.window_min() && mx == st.window_max();
+}
+
+template <class Fifo, class Stats>
+static bool random_mix(Fifo& q, Stats& st, const unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> val(-1000, 1000);
+    for (int op = 0; op < kOps; ++op) {
+        const unsigned k = rng() % 4u;
+        if (k < 2u) {
+            const unsigned burst = 1u + rng() % 8u;
+            for (unsigned i = 0; i < burst && !q.full(); ++i) {
+                q.push(val(rng));
+            }
+            st.sync(q);
+        } else if (!st.empty()) {
+            const reg n = 1u + static_cast<reg>(rng() % std::min<reg>(st.size(), 6u));
+            st.pop(q, n);
+        }
+        if (!matches_brute_force(q, st)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+class tst_window_stats_api_paranoid : public QObject {
+    Q_OBJECT
+
+private slots:
+    void empty_window() {
+        spsc::window_stats<int, 8> st;
+        QVERIFY(st.is_valid());
+        QVERIFY(st.empty());
+        QCOMPARE(st.size(), reg(0u));
+        QCOMPARE(st.window_sum(), std::int64_t(0));
+        QCOMPARE(st.window_mean(), 0.0);
+
+        const auto rec = st.read();
+        QCOMPARE(rec.count, reg(0u));
+        QCOMPARE(rec.mean(), 0.0);
+
+        spsc::window_stats<int> dyn;
+        QVERIFY(!dyn.is_valid());
+        QVERIFY(dyn.resize(16u));
+        QCOMPARE(dyn.capacity(), reg(16u));
+        QVERIFY(dyn.resize(0u));
+        QVERIFY(!dyn.is_valid());
+    }
+
+    void manual_feed() {
+        spsc::window_stats<int, 8> st;
+        for (int v : {5, 1, 7, 3}) {
+            st.on_push(v);
+        }
+        QCOMPARE(st.size(), reg(4u));
+        QCOMPARE(st.window_sum(), std::int64_t(16));
+        QCOMPARE(st.window_mean(), 4.0);
+        QCOMPARE(st.window_min(), 1);
+        QCOMPARE(st.window_max(), 7);
+
+        st.on_pop(5);
+        st.on_pop(1);
+        QCOMPARE(st.window_min(), 3);
+        QCOMPARE(st.window_max(), 7);
+        st.on_pop(7);
+        QCOMPARE(st.window_min(), 3);
+        QCOMPARE(st.window_max(), 3);
+
+        const auto rec = st.read();
+        QCOMPARE(rec.count, reg(1u));
+        QCOMPARE(rec.sum, std::int64_t(3));
+        QCOMPARE(rec.min, 3);
+        QCOMPARE(rec.max, 3);
+
+        st.reset();
+        QVERIFY(st.empty());
+        QCOMPARE(st.read().count, reg(0u));
+    }
+
+    void sync_is_incremental() {
+        spsc::fifo<std::uint32_t, 16> q;
+        spsc::window_stats<std::uint32_t, 16> st;
+        for (std::uint32_t i = 1; i <= 5; ++i) {
+            q.push(i);
+        }
+        QCOMPARE(st.sync(q), reg(5u));
+        QCOMPARE(st.sync(q), reg(0u)); // nothing new
+        q.push(10u);
+        QCOMPARE(st.sync(q), reg(1u));
+        QCOMPARE(st.window_sum(), std::uint64_t(25u));
+        QCOMPARE(st.window_max(), 10u);
+        st.pop(q, 2u);
+        QCOMPARE(q.size(), reg(4u));
+        QCOMPARE(st.window_min(), 3u);
+        QCOMPARE(st.window_sum(), std::uint64_t(22u));
+    }
+
+    void random_static_matches_brute_force() {
+        spsc::fifo<int, 64> q;
+        spsc::window_stats<int, 64> st;
+        QVERIFY(random_mix(q, st, 1u));
+    }
+
+    void random_dynamic_matches_brute_force() {
+        spsc::fifo<int, 0> q(128u);
+        spsc::window_stats<int> st(q.capacity());
+        QVERIFY(st.is_valid());
+        QVERIFY(random_mix(q, st, 7u));
+    }
+
+    void floating_point() {
+        spsc::fifo<double, 32> q;
+        spsc::window_stats<double, 32> st;
+        for (double v : {0.5, -2.25, 4.0, 1.0}) {
+            q.push(v);
+        }
+        st.sync(q);
+        QCOMPARE(st.window_sum(), 3.25);
+        QCOMPARE(st.window_min(), -2.25);
+        QCOMPARE(st.window_max(), 4.0);
+        st.pop(q, 2u);
+        QCOMPARE(st.window_min(), 1.0);
+        QCOMPARE(st.window_mean(), 2.5);
+    }
+
+    void observer_sees_consistent_records() {
+        // Values are consecutive integers, so every consistent window [a, a+n)
+        // satisfies max == min + n - 1 and sum == n * (min + max) / 2.
+        using Fifo = spsc::fifo<std::uint32_t, 256, spsc::policy::A<>>;
+        Fifo q;
+        spsc::window_stats<std::uint32_t, 256> st;
+        std::atomic<bool> done{false};
+        std::atomic<bool> torn{false};
+        std::atomic<std::uint64_t> reads{0u};
+        constexpr std::uint32_t kN = static_cast<std::uint32_t>(kOps) * 5u;
+
+        std::thread producer([&]() {
+            for (std::uint32_t i = 0; i < kN; ++i) {
+                while (!q.try_push(i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        std::thread observer([&]() {
+            std::uint64_t n = 0u;
+            while (!done.load(std::memory_order_acquire)) {
+                const auto rec = st.read();
+                ++n;
+                if (rec.count == 0u) {
+                    continue;
+                }
+                const std::uint64_t mn = rec.min;
+                const std::uint64_t mx = rec.max;
+                if (mx != mn + rec.count - 1u || 2u * rec.sum != rec.count * (mn + mx) ||
+                    rec.count > 256u) {
+                    torn.store(true, std::memory_order_relaxed);
+                }
+                if ((n & 31u) == 0u) {
+                    std::this_thread::yield();
+                }
+            }
+            reads.store(n, std::memory_order_relaxed);
+        });
+
+        std::uint32_t consumed = 0u;
+        while (consumed < kN) {
+            st.sync(q);
+            if (st.size() > 3u) {
+                const reg n = st.size() / 2u;
+                st.pop(q, n);
+                consumed += static_cast<std::uint32_t>(n);
+            } else if (st.size() != 0u && q.size() == st.size()) {
+                st.pop(q, st.size() > 1u ? 1u : st.size());
+                consumed += 1u;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        done.store(true, std::memory_order_release);
+        producer.join();
+        observer.join();
+
+        QVERIFY(!torn.load());
+        QVERIFY(reads.load() > 0u);
+        QVERIFY(st.empty());
+        QVERIFY(st.generation() > 0u);
+    }
+};
+
+} // namespace
+
+int run_tst_window_stats_api_paranoid(int argc, char** argv) {
+    tst_window_stats_api_paranoid tc;
+    return QTest::qExec(&tc, argc, argv);
+}
+
+#include "window_stats_test.moc"
@@ -0,0 +1,6 @@
+#ifndef WINDOW_STATS_TEST_H_
+#define WINDOW_STATS_TEST_H_
+
+int run_tst_window_stats_api_paranoid(int argc, char** argv);
+
+#endif /* WINDOW_STATS_TEST_H_ */
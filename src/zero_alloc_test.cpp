@@ -0,0 +1,618 @@
+// zero_alloc_test.cpp
+// Hot-path allocation certification for every SPSC container.
+//
+// Goals:
+//  - Install a global operator new/delete interceptor for the whole binary.
+//  - Run each container's steady-state producer/consumer loops under P, V,
+//    A<>, CA<> policies: value ops, claim/publish, RAII guards, snapshots and
+//    bulk regions.
+//  - Fail if ANY allocation or deallocation happens after warm-up.
+//
+// Notes:
+//  - Construction, resize() and destruction are allowed to allocate; they run
+//    outside the armed window.
+//  - The interceptor is disarmed by default so other suites in this binary are
+//    not affected. Nothing inside an armed window may log (qDebug allocates).
+//  - The threaded check arms the interceptor for both sides at once: a
+//    malloc anywhere in the process during the run counts as a failure.
+
+#include <QtTest/QtTest>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <thread>
+#include <type_traits>
+
+#if !defined(SPSC_ASSERT) && !defined(NDEBUG)
+#  define SPSC_ASSERT(expr) do { if(!(expr)) { std::abort(); } } while(0)
+#endif
+
+#include "array_fifo.hpp"
+#include "chunk_fifo.hpp"
+#include "fifo.hpp"
+#include "fifo_view.hpp"
+#include "latest.hpp"
+#include "pool.hpp"
+#include "pool_view.hpp"
+#include "queue.hpp"
+#include "typed_pool.hpp"
+
+// =====================================================================================
+// Global allocation interceptor
+// =====================================================================================
+namespace spsc_zero_alloc_detail {
+
+static std::atomic<bool>        g_armed{false};
+static std::atomic<std::size_t> g_allocs{0u};
+static std::atomic<std::size_t> g_deallocs{0u};
+
+static inline void note_alloc() noexcept {
+    if (g_armed.load(std::memory_order_relaxed)) {
+        g_allocs.fetch_add(1u, std::memory_order_relaxed);
+    }
+}
+
+static inline void note_dealloc() noexcept {
+    if (g_armed.load(std::memory_order_relaxed)) {
+        g_deallocs.fetch_add(1u, std::memory_order_relaxed);
+    }
+}
+
+static void* raw_alloc(std::size_t size) noexcept {
+    return std::malloc(size ? size : 1u);
+}
+
+// Over-aligned: over-allocate and stash the raw pointer right before payload.
+static void* raw_alloc_aligned(std::size_t size, std::size_t align) noexcept {
+    if (align < alignof(void*)) {
+        align = alignof(void*);
+    }
+    void* raw = std::malloc(size + align + sizeof(void*));
+    if (!raw) {
+        return nullptr;
+    }
+    const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*);
+    const std::uintptr_t up   = (base + (align - 1u)) & ~static_cast<std::uintptr_t>(align - 1u);
+    void** const hdr = reinterpret_cast<void**>(up - sizeof(void*));
+    *hdr = raw;
+    return reinterpret_cast<void*>(up);
+}
+
+static void raw_free_aligned(void* p) noexcept {
+    if (p) {
+        std::free(*(reinterpret_cast<void**>(p) - 1));
+    }
+}
+
+// RAII window: counters are reset on entry and sampled on exit.
+class HotPathWindow {
+public:
+    HotPathWindow() noexcept {
+        g_allocs.store(0u, std::memory_order_relaxed);
+        g_deallocs.store(0u, std::memory_order_relaxed);
+        g_armed.store(true, std::memory_order_seq_cst);
+    }
+    ~HotPathWindow() noexcept { close(); }
+
+    void close() noexcept { g_armed.store(false, std::memory_order_seq_cst); }
+
+    [[nodiscard]] std::size_t allocs() const noexcept { return g_allocs.load(); }
+    [[nodiscard]] std::size_t deallocs() const noexcept { return g_deallocs.load(); }
+};
+
+} // namespace spsc_zero_alloc_detail
+
+void* operator new(std::size_t n) {
+    spsc_zero_alloc_detail::note_alloc();
+    if (void* p = spsc_zero_alloc_detail::raw_alloc(n)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t n) { return ::operator new(n); }
+void* operator new(std::size_t n, const std::nothrow_t&) noexcept {
+    spsc_zero_alloc_detail::note_alloc();
+    return spsc_zero_alloc_detail::raw_alloc(n);
+}
+void* operator new[](std::size_t n, const std::nothrow_t& t) noexcept { return ::operator new(n, t); }
+
+void* operator new(std::size_t n, std::align_val_t a) {
+    spsc_zero_alloc_detail::note_alloc();
+    if (void* p = spsc_zero_alloc_detail::raw_alloc_aligned(n, static_cast<std::size_t>(a))) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t n, std::align_val_t a) { return ::operator new(n, a); }
+void* operator new(std::size_t n, std::align_val_t a, const std::nothrow_t&) noexcept {
+    spsc_zero_alloc_detail::note_alloc();
+    return spsc_zero_alloc_detail::raw_alloc_aligned(n, static_cast<std::size_t>(a));
+}
+void* operator new[](std::size_t n, std::align_val_t a, const std::nothrow_t& t) noexcept {
+    return ::operator new(n, a, t);
+}
+
+void operator delete(void* p) noexcept {
+    if (p) {
+        spsc_zero_alloc_detail::note_dealloc();
+        std::free(p);
+    }
+}
+void operator delete[](void* p) noexcept { ::operator delete(p); }
+void operator delete(void* p, std::size_t) noexcept { ::operator delete(p); }
+void operator delete[](void* p, std::size_t) noexcept { ::operator delete(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { ::operator delete(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { ::operator delete(p); }
+
+void operator delete(void* p, std::align_val_t) noexcept {
+    if (p) {
+        spsc_zero_alloc_detail::note_dealloc();
+        spsc_zero_alloc_detail::raw_free_aligned(p);
+    }
+}
+void operator delete[](void* p, std::align_val_t a) noexcept { ::operator delete(p, a); }
+void operator delete(void* p, std::size_t, std::align_val_t a) noexcept { ::operator delete(p, a); }
+void operator delete[](void* p, std::size_t, std::align_val_t a) noexcept { ::operator delete(p, a); }
+void operator delete(void* p, std::align_val_t a, const std::nothrow_t&) noexcept { ::operator delete(p, a); }
+void operator delete[](void* p, std::align_val_t a, const std::nothrow_t&) noexcept { ::operator delete(p, a); }
+
+namespace {
+
+using spsc_zero_alloc_detail::HotPathWindow;
+
+#if defined(NDEBUG)
+constexpr int kIters = 20000;
+#else
+constexpr int kIters = 2000;
+#endif
+
+constexpr reg kCap       = 64u;
+constexpr reg kBulk      = 8u;
+constexpr reg kBufBytes  = 32u;
+constexpr int kWarmup    = 2;
+
+// Non-trivial payload: exercises placement-new/destroy paths without allocating.
+struct Msg {
+    std::uint64_t seq{0u};
+    std::uint32_t tag{0u};
+
+    Msg() noexcept = default;
+    explicit Msg(std::uint64_t s) noexcept : seq(s), tag(0xA5A5u) {}
+    Msg(const Msg&) noexcept = default;
+    Msg& operator=(const Msg&) noexcept = default;
+    ~Msg() noexcept { tag = 0u; }
+};
+
+// queue snapshots yield objects, typed_pool snapshots yield slot pointers.
+static std::uint64_t seq_of(const Msg& m) noexcept { return m.seq; }
+static std::uint64_t seq_of(const Msg* m) noexcept { return m->seq; }
+
+// Runs 'cycle' kWarmup times unarmed, then kIters times armed.
+template <class Fn>
+static void certify(const char* name, Fn&& cycle) {
+    for (int i = 0; i < kWarmup; ++i) {
+        cycle(static_cast<std::uint64_t>(i));
+    }
+
+    HotPathWindow w;
+    for (int i = 0; i < kIters; ++i) {
+        cycle(static_cast<std::uint64_t>(i));
+    }
+    w.close();
+
+    QVERIFY2(w.allocs() == 0u, name);
+    QVERIFY2(w.deallocs() == 0u, name);
+}
+
+// -------------------------------------------------------------------------------------
+// fifo / fifo_view / chunk_fifo / array_fifo (assignment-based rings)
+// -------------------------------------------------------------------------------------
+template <class Q>
+static void fifo_like_cycles(Q& q, const char* name) {
+    QVERIFY2(q.is_valid(), name);
+
+    certify(name, [&](std::uint64_t i) {
+        // Value ops.
+        q.push(Msg(i));
+        (void)q.try_push(Msg(i + 1u));
+        q.emplace(i + 2u);
+        (void)q.try_emplace(i + 3u);
+        while (Msg* p = q.try_front()) {
+            (void)p;
+            q.pop();
+        }
+
+        // Claim / publish.
+        q.claim() = Msg(i);
+        q.publish();
+        if (Msg* p = q.try_claim()) {
+            *p = Msg(i);
+            (void)q.try_publish();
+        }
+        (void)q.front();
+        q.pop();
+        (void)q.try_pop();
+
+        // RAII guards.
+        {
+            auto wg = q.scoped_write();
+            if (wg) {
+                wg.ref() = Msg(i);
+            }
+        }
+        {
+            auto bw = q.scoped_write(kBulk);
+            while (bw.remaining() != 0u) {
+                (void)bw.write_next(Msg(i));
+            }
+            bw.commit();
+        }
+        {
+            auto rg = q.scoped_read();
+            rg.commit();
+        }
+        {
+            auto br = q.scoped_read(kBulk);
+            br.commit();
+        }
+
+        // Snapshots.
+        for (reg k = 0; k < kBulk; ++k) {
+            (void)q.try_push(Msg(i + k));
+        }
+        {
+            auto snap = q.make_snapshot();
+            std::uint64_t acc = 0u;
+            for (const Msg& m : snap) {
+                acc += m.seq;
+            }
+            (void)acc;
+            (void)q.try_consume(snap);
+        }
+
+        // Bulk regions.
+        auto wr = q.claim_write(::spsc::unsafe, kBulk);
+        for (reg k = 0; k < wr.first.count; ++k)  { wr.first.ptr[k]  = Msg(i + k); }
+        for (reg k = 0; k < wr.second.count; ++k) { wr.second.ptr[k] = Msg(i + k); }
+        q.publish(wr.total);
+        auto rr = q.claim_read(::spsc::unsafe, kBulk);
+        q.pop(rr.total);
+
+        q.consume_all();
+    });
+}
+
+template <class Q>
+static void block_fifo_cycles(Q& q, const char* name) {
+    QVERIFY2(q.is_valid(), name);
+
+    certify(name, [&](std::uint64_t i) {
+        for (reg k = 0; k < kBulk; ++k) {
+            auto* c = q.try_claim();
+            if (!c) {
+                break;
+            }
+            (*c)[0] = static_cast<typename std::decay_t<decltype((*c)[0])>>(i + k);
+            q.publish();
+        }
+        {
+            auto snap = q.make_snapshot();
+            (void)q.try_consume(snap);
+        }
+        while (q.try_front()) {
+            q.pop();
+        }
+    });
+}
+
+template <class Policy>
+static void run_fifo_family() {
+    {
+        spsc::fifo<Msg, kCap, Policy> q;
+        fifo_like_cycles(q, "fifo<static>");
+    }
+    {
+        spsc::fifo<Msg, 0, Policy> q;
+        QVERIFY(q.resize(kCap));
+        fifo_like_cycles(q, "fifo<dynamic>");
+    }
+    {
+        std::array<Msg, kCap> buf{};
+        spsc::fifo_view<Msg, kCap, Policy> q(buf);
+        fifo_like_cycles(q, "fifo_view<static>");
+    }
+    {
+        spsc::array_fifo<std::uint8_t, 16u, kCap, Policy> q;
+        block_fifo_cycles(q, "array_fifo");
+    }
+    {
+        spsc::chunk_fifo<std::int32_t, 16u, kCap, Policy> q;
+        certify("chunk_fifo", [&](std::uint64_t i) {
+            for (reg k = 0; k < kBulk; ++k) {
+                auto* c = q.try_claim();
+                if (!c) {
+                    break;
+                }
+                c->clear();
+                (void)c->try_push(static_cast<std::int32_t>(i + k));
+                q.publish();
+            }
+            while (auto* c = q.try_front()) {
+                (void)c->size();
+                q.pop();
+            }
+        });
+    }
+}
+
+// -------------------------------------------------------------------------------------
+// queue / typed_pool (placement-new rings)
+// -------------------------------------------------------------------------------------
+template <class Q>
+static void object_ring_cycles(Q& q, const char* name) {
+    QVERIFY2(q.is_valid(), name);
+
+    certify(name, [&](std::uint64_t i) {
+        q.push(Msg(i));
+        (void)q.try_push(Msg(i + 1u));
+        q.emplace(i + 2u);
+        (void)q.try_emplace(i + 3u);
+        while (q.try_front()) {
+            q.pop();
+        }
+
+        {
+            auto wg = q.scoped_write();
+            if (wg) {
+                (void)wg.emplace(i);
+                wg.commit();
+            }
+        }
+        {
+            auto bw = q.scoped_write(kBulk);
+            while (bw.remaining() != 0u) {
+                (void)bw.emplace_next(i);
+            }
+            bw.commit();
+        }
+        {
+            auto rg = q.scoped_read();
+            rg.commit();
+        }
+        {
+            auto br = q.scoped_read(kBulk);
+            br.commit();
+        }
+
+        for (reg k = 0; k < kBulk; ++k) {
+            (void)q.try_emplace(i + k);
+        }
+        {
+            auto snap = q.make_snapshot();
+            std::uint64_t acc = 0u;
+            for (const auto& m : snap) {
+                acc += seq_of(m);
+            }
+            (void)acc;
+            (void)q.try_consume(snap);
+        }
+
+        q.consume_all();
+    });
+}
+
+template <class Policy>
+static void run_object_family() {
+    {
+        spsc::queue<Msg, kCap, Policy> q;
+        object_ring_cycles(q, "queue<static>");
+
+        // Bulk regions (uninit write / init read).
+        certify("queue<regions>", [&](std::uint64_t i) {
+            auto wr = q.claim_write(::spsc::unsafe, kBulk);
+            for (reg k = 0; k < wr.first.count; ++k)  { ::new (wr.first.ptr_uninit() + k) Msg(i); }
+            for (reg k = 0; k < wr.second.count; ++k) { ::new (wr.second.ptr_uninit() + k) Msg(i); }
+            q.publish(wr.total);
+            auto rr = q.claim_read(::spsc::unsafe, kBulk);
+            q.pop(rr.total);
+        });
+    }
+    {
+        spsc::queue<Msg, 0, Policy> q;
+        QVERIFY(q.resize(kCap));
+        object_ring_cycles(q, "queue<dynamic>");
+    }
+    {
+        spsc::typed_pool<Msg, kCap, Policy> q;
+        object_ring_cycles(q, "typed_pool<static>");
+    }
+    {
+        spsc::typed_pool<Msg, 0, Policy> q(kCap);
+        object_ring_cycles(q, "typed_pool<dynamic>");
+    }
+}
+
+// -------------------------------------------------------------------------------------
+// pool / pool_view (raw byte slots) and latest
+// -------------------------------------------------------------------------------------
+template <class Q>
+static void byte_pool_cycles(Q& q, const char* name) {
+    QVERIFY2(q.is_valid(), name);
+
+    const std::uint8_t src[kBufBytes] = {1u, 2u, 3u};
+    certify(name, [&](std::uint64_t i) {
+        q.push(static_cast<const void*>(src), kBufBytes);
+        (void)q.try_push(static_cast<const void*>(src), kBufBytes);
+        (void)q.try_push(i);
+        while (q.try_front()) {
+            q.pop();
+        }
+
+        if (void* p = q.try_claim()) {
+            std::memcpy(p, src, kBufBytes);
+            q.publish();
+        }
+        {
+            auto wg = q.scoped_write();
+            if (wg) {
+                std::memcpy(wg.get(), src, kBufBytes);
+                wg.commit();
+            }
+        }
+        {
+            auto bw = q.scoped_write(kBulk);
+            while (bw.remaining() != 0u) {
+                (void)bw.write_next(static_cast<const void*>(src), kBufBytes);
+            }
+            bw.commit();
+        }
+        {
+            auto rg = q.scoped_read();
+            rg.commit();
+        }
+        {
+            auto snap = q.make_snapshot();
+            (void)q.try_consume(snap);
+        }
+        {
+            auto br = q.scoped_read(kBulk);
+            br.commit();
+        }
+        q.consume_all();
+    });
+}
+
+template <class Policy>
+static void run_pool_family() {
+    {
+        spsc::pool<kCap, Policy> q(kBufBytes);
+        byte_pool_cycles(q, "pool<static>");
+    }
+    {
+        spsc::pool<0, Policy> q(kCap, kBufBytes);
+        byte_pool_cycles(q, "pool<dynamic>");
+    }
+    {
+        alignas(16) std::uint8_t storage[kCap][kBufBytes]{};
+        std::array<void*, kCap> slot_ptrs{};
+        for (reg k = 0; k < kCap; ++k) {
+            slot_ptrs[k] = storage[k];
+        }
+        spsc::pool_view<kCap, Policy> q(slot_ptrs, kBufBytes);
+        byte_pool_cycles(q, "pool_view<static>");
+    }
+    {
+        spsc::latest<Msg, 8u, Policy> q;
+        QVERIFY(q.is_valid());
+        certify("latest<static>", [&](std::uint64_t i) {
+            q.push(Msg(i));
+            (void)q.try_push(Msg(i + 1u));
+            if (Msg* p = q.try_claim()) {
+                *p = Msg(i);
+                (void)q.try_publish();
+            }
+            if (const Msg* p = q.try_front()) {
+                (void)p->seq;
+                q.pop();
+            }
+            q.consume_all();
+        });
+    }
+}
+
+// -------------------------------------------------------------------------------------
+// Threaded steady state: both sides armed at the same time.
+// -------------------------------------------------------------------------------------
+template <class Policy>
+static void run_threaded_window() {
+    spsc::queue<Msg, kCap, Policy> q;
+    QVERIFY(q.is_valid());
+
+    std::atomic<bool> go{false};
+    std::atomic<bool> release{false};
+    std::atomic<int>  finished{0};
+    std::uint64_t consumed = 0u;
+
+    // std::thread creation and teardown allocate/free: spawn first, arm, and
+    // keep both threads parked until the window is closed.
+    auto park = [&]() {
+        finished.fetch_add(1, std::memory_order_acq_rel);
+        while (!release.load(std::memory_order_acquire)) { std::this_thread::yield(); }
+    };
+
+    std::thread prod([&]() {
+        while (!go.load(std::memory_order_acquire)) { std::this_thread::yield(); }
+        for (int i = 0; i < kIters; ++i) {
+            while (!q.try_emplace(static_cast<std::uint64_t>(i))) {}
+        }
+        park();
+    });
+    std::thread cons([&]() {
+        while (!go.load(std::memory_order_acquire)) { std::this_thread::yield(); }
+        while (consumed < static_cast<std::uint64_t>(kIters)) {
+            auto snap = q.make_snapshot();
+            consumed += snap.size();
+            q.consume(snap);
+        }
+        park();
+    });
+
+    HotPathWindow w;
+    go.store(true, std::memory_order_release);
+    while (finished.load(std::memory_order_acquire) != 2) { std::this_thread::yield(); }
+    w.close();
+
+    release.store(true, std::memory_order_release);
+    prod.join();
+    cons.join();
+
+    QCOMPARE(consumed, static_cast<std::uint64_t>(kIters));
+    QVERIFY2(w.allocs() == 0u, "threaded queue hot path allocated");
+    QVERIFY2(w.deallocs() == 0u, "threaded queue hot path deallocated");
+}
+
+class tst_zero_alloc_api_paranoid : public QObject {
+    Q_OBJECT
+
+private slots:
+    void interceptor_self_check() {
+        HotPathWindow w;
+        void* volatile p = ::operator new(16u);
+        ::operator delete(p);
+        w.close();
+        QCOMPARE(w.allocs(), std::size_t(1u));
+        QCOMPARE(w.deallocs(), std::size_t(1u));
+    }
+
+    void fifo_plain_P()    { run_fifo_family<spsc::policy::P>(); }
+    void fifo_volatile_V() { run_fifo_family<spsc::policy::V>(); }
+    void fifo_atomic_A()   { run_fifo_family<spsc::policy::A<>>(); }
+    void fifo_cached_CA()  { run_fifo_family<spsc::policy::CA<>>(); }
+
+    void object_plain_P()    { run_object_family<spsc::policy::P>(); }
+    void object_volatile_V() { run_object_family<spsc::policy::V>(); }
+    void object_atomic_A()   { run_object_family<spsc::policy::A<>>(); }
+    void object_cached_CA()  { run_object_family<spsc::policy::CA<>>(); }
+
+    void pool_plain_P()    { run_pool_family<spsc::policy::P>(); }
+    void pool_volatile_V() { run_pool_family<spsc::policy::V>(); }
+    void pool_atomic_A()   { run_pool_family<spsc::policy::A<>>(); }
+    void pool_cached_CA()  { run_pool_family<spsc::policy::CA<>>(); }
+
+    void threaded_atomic_A()  { run_threaded_window<spsc::policy::A<>>(); }
+    void threaded_cached_CA() { run_threaded_window<spsc::policy::CA<>>(); }
+};
+
+} // namespace
+
+int run_tst_zero_alloc_api_paranoid(int argc, char** argv) {
+    tst_zero_alloc_api_paranoid tc;
+    return QTest::qExec(&tc, argc, argv);
+}
+
+#include "zero_alloc_test.moc"
@@ -0,0 +1,6 @@
+#ifndef ZERO_ALLOC_TEST_H_
+#define ZERO_ALLOC_TEST_H_
+
+int run_tst_zero_alloc_api_paranoid(int argc, char** argv);
+
+#endif /* ZERO_ALLOC_TEST_H_ */
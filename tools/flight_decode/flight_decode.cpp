@@ -0,0 +1,82 @@
+/*
+ * flight_decode.cpp
+ *
+ * Offline decoder for spsc::fr::recorder dumps (flight_recorder.hpp).
+ *
+ * Prints one line per record, oldest first, for every recorder section in the
+ * image:
+ *
+ *   [tag] seq stamp id len | payload hex
+ *
+ * Records that break the sequence (torn by a racing writer during the dump)
+ * are marked with '!'.
+ *
+ * Build and run (from the repository root):
+ *   g++ -std=c++17 -O2 -Isrc/spsc -I. tools/flight_decode/flight_decode.cpp -o flight_decode
+ *   ./flight_decode crash.fr [--max-payload N]
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "flight_recorder.hpp"
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <dump> [--max-payload N]\n", argv[0]);
+        return 2;
+    }
+    std::size_t max_payload = 32u;
+    for (int i = 2; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], "--max-payload") == 0) {
+            max_payload = static_cast<std::size_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+    }
+
+    std::FILE* f = std::fopen(argv[1], "rb");
+    if (!f) {
+        std::perror(argv[1]);
+        return 1;
+    }
+    std::vector<unsigned char> image;
+    unsigned char buf[4096];
+    std::size_t got = 0u;
+    while ((got = std::fread(buf, 1u, sizeof(buf), f)) != 0u) {
+        image.insert(image.end(), buf, buf + got);
+    }
+    std::fclose(f);
+
+    spsc::fr::decoder dec(image.data(), image.size());
+    spsc::fr::section s;
+    unsigned sections = 0u;
+    unsigned torn = 0u;
+    while (dec.next(s)) {
+        ++sections;
+        std::printf("# recorder tag=%u capacity=%u record=%uB head=%llu count=%u\n",
+                    s.header.thread_tag, s.header.capacity, s.header.record_bytes,
+                    static_cast<unsigned long long>(s.header.head), s.header.count);
+        for (std::uint32_t i = 0; i < s.header.count; ++i) {
+            const spsc::fr::decoded_record r = spsc::fr::decoder::at(s, i);
+            torn += r.in_sequence ? 0u : 1u;
+            std::printf("%c[%u] %llu %llu %u %u |", r.in_sequence ? ' ' : '!', s.header.thread_tag,
+                        static_cast<unsigned long long>(r.hdr.seq),
+                        static_cast<unsigned long long>(r.hdr.stamp), r.hdr.id, r.hdr.len);
+            const std::size_t cap = s.header.record_bytes - sizeof(spsc::fr::record_header);
+            std::size_t n = (r.hdr.len < cap) ? r.hdr.len : cap;
+            n = (n < max_payload) ? n : max_payload;
+            for (std::size_t k = 0; k < n; ++k) {
+                std::printf(" %02x", r.data[k]);
+            }
+            std::printf("\n");
+        }
+    }
+    if (dec.error()) {
+        std::fprintf(stderr, "%s: malformed image after %u section(s)\n", argv[1], sections);
+        return 1;
+    }
+    std::fprintf(stderr, "%u section(s), %u torn record(s)\n", sections, torn);
+    return 0;
+}
@@ -0,0 +1,692 @@
+/*
+ * bench_driver.cpp
+ *
+ * spsc_bench: threaded component benchmarks, each against the closest
+ * non-SPSC (or non-specialised) alternative. The unit suites only check
+ * behaviour; every timing that used to be printed from them lives here.
+ *
+ * Output, one line per measurement:
+ *
+ *   T <bench> <variant> <value> <unit>
+ *
+ * Numbers depend on the host scheduler and core count; nothing here gates on
+ * a ratio. Compare two runs of the same binary on the same host.
+ *
+ * Build and run (from the repository root):
+ *   g++ -std=c++20 -O2 -pthread -Isrc/spsc -I. tools/spsc_bench/bench_driver.cpp -o spsc_bench
+ *   ./spsc_bench > bench.txt
+ *
+ * Options:
+ *   --only <bench>   run one benchmark only (names below)
+ *   --scale <n>      divide every iteration count by n (default: 1)
+ *
+ * Benchmarks:
+ *   executor    executor<> vs. mutex + condvar pool, fine-grained tasks
+ *   duplex      duplex round trip vs. a pair of queues
+ *   remote_heap remote_heap pipeline vs. global new/delete
+ *   scan        find_any_of vs. a ring_iterator loop
+ *   packed      packed_chunk<int16_t> decode rate
+ *   graveyard   consumer pop time, inline destruction vs. offloaded
+ *   delay       playout lateness behind the due time
+ *   spread      near-empty ping-pong: spread_fifo vs. identity layout vs. fifo
+ *   flight      recorder::record_value() cost
+ *   mesh        3 x 2 all-to-all throughput
+ *   record      40-byte runtime records: record_fifo vs. pool
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "delay.hpp"
+#include "duplex.hpp"
+#include "executor.hpp"
+#include "fifo.hpp"
+#include "flight_recorder.hpp"
+#include "graveyard.hpp"
+#include "mesh.hpp"
+#include "packed_fifo.hpp"
+#include "pool.hpp"
+#include "queue.hpp"
+#include "record_fifo.hpp"
+#include "remote_alloc.hpp"
+#include "scan.hpp"
+#include "spread_fifo.hpp"
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+struct options {
+    std::string only;
+    std::uint32_t scale{1u};
+};
+
+bool parse_args(int argc, char** argv, options& o) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string k = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+        const std::string v = argv[++i];
+        if (k == "--only") { o.only = v; }
+        else if (k == "--scale") { o.scale = static_cast<std::uint32_t>(std::strtoul(v.c_str(), nullptr, 10)); }
+        else { return false; }
+    }
+    return o.scale != 0u;
+}
+
+double seconds_since(const clock_type::time_point t0) {
+    return std::chrono::duration<double>(clock_type::now() - t0).count();
+}
+
+void emit(const char* bench, const char* variant, const double value, const char* unit) {
+    std::printf("T %s %s %.3f %s\n", bench, variant, value, unit);
+    std::fflush(stdout);
+}
+
+void spin_wait(unsigned& spins) {
+    if (++spins > 64u) {
+        spins = 0u;
+        std::this_thread::yield();
+    }
+}
+
+/* =======================================================================
+ * executor
+ * ======================================================================= */
+std::atomic<std::uint64_t> g_counter{0u};
+
+void bump(void*) noexcept {
+    g_counter.fetch_add(1u, std::memory_order_relaxed);
+}
+
+// Reference: classic mutex + condvar pool (one shared deque, N workers).
+class mutex_pool {
+public:
+    explicit mutex_pool(const unsigned n) {
+        for (unsigned i = 0; i < n; ++i) {
+            threads_.emplace_back([this]() { loop_(); });
+        }
+    }
+
+    ~mutex_pool() { stop(); }
+
+    void submit(std::function<void()> f) {
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            q_.push_back(std::move(f));
+        }
+        cv_.notify_one();
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for (auto& t : threads_) {
+            if (t.joinable()) {
+                t.join();
+            }
+        }
+    }
+
+private:
+    void loop_() {
+        for (;;) {
+            std::function<void()> f;
+            {
+                std::unique_lock<std::mutex> lk(m_);
+                cv_.wait(lk, [this]() { return stop_ || !q_.empty(); });
+                if (q_.empty()) {
+                    return;
+                }
+                f = std::move(q_.front());
+                q_.pop_front();
+            }
+            f();
+        }
+    }
+
+    std::mutex m_;
+    std::condition_variable cv_;
+    std::deque<std::function<void()>> q_;
+    std::vector<std::thread> threads_;
+    bool stop_{false};
+};
+
+void bench_executor(const options& o) {
+    constexpr reg kWorkers = 4u;
+    const std::uint32_t n = 2000000u / o.scale;
+
+    g_counter.store(0u, std::memory_order_relaxed);
+    auto t0 = clock_type::now();
+    {
+        ::spsc::executor<> ex(kWorkers, 1u);
+        for (std::uint32_t i = 0; i < n; ++i) {
+            while (!ex.try_submit(0u, ::spsc::task{&bump, nullptr})) {
+                std::this_thread::yield();
+            }
+        }
+        ex.stop();
+    }
+    const double spsc_s = seconds_since(t0);
+
+    g_counter.store(0u, std::memory_order_relaxed);
+    t0 = clock_type::now();
+    {
+        mutex_pool mp(static_cast<unsigned>(kWorkers));
+        for (std::uint32_t i = 0; i < n; ++i) {
+            mp.submit([]() { bump(nullptr); });
+        }
+        mp.stop();
+    }
+    const double mutex_s = seconds_since(t0);
+
+    emit("executor", "executor", n / spsc_s, "tasks/s");
+    emit("executor", "mutex_condvar", n / mutex_s, "tasks/s");
+}
+
+/* =======================================================================
+ * duplex
+ * ======================================================================= */
+struct Req { std::uint32_t a; std::uint32_t b; };
+struct Resp { std::uint64_t sum; };
+
+void bench_duplex(const options& o) {
+    const std::uint32_t n = 50000u / o.scale;
+
+    double t_duplex = 0.0;
+    {
+        ::spsc::duplex<Req, Resp, 8> d;
+        std::atomic<bool> stop{false};
+        std::thread callee([&]() {
+            unsigned idle = 0u;
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (d.serve_one([](Req& q) { return Resp{q.a}; })) {
+                    idle = 0u;
+                } else {
+                    spin_wait(idle);
+                }
+            }
+        });
+        const auto t0 = clock_type::now();
+        for (std::uint32_t i = 0; i < n; ++i) {
+            Resp out{};
+            (void)d.call(out, Req{i, 0u});
+        }
+        t_duplex = seconds_since(t0);
+        stop.store(true, std::memory_order_relaxed);
+        callee.join();
+    }
+
+    double t_queues = 0.0;
+    {
+        ::spsc::queue<Req, 8, ::spsc::policy::CA<>> to;
+        ::spsc::queue<Resp, 8, ::spsc::policy::CA<>> back;
+        std::atomic<bool> stop{false};
+        std::thread callee([&]() {
+            unsigned idle = 0u;
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (Req* q = to.try_front()) {
+                    const Resp r{q->a};
+                    to.pop();
+                    while (!back.try_emplace(r)) {
+                        std::this_thread::yield();
+                    }
+                    idle = 0u;
+                } else {
+                    spin_wait(idle);
+                }
+            }
+        });
+        const auto t0 = clock_type::now();
+        for (std::uint32_t i = 0; i < n; ++i) {
+            (void)to.try_emplace(Req{i, 0u});
+            unsigned spins = 0u;
+            while (!back.try_front()) {
+                spin_wait(spins);
+            }
+            back.pop();
+        }
+        t_queues = seconds_since(t0);
+        stop.store(true, std::memory_order_relaxed);
+        callee.join();
+    }
+
+    emit("duplex", "duplex", t_duplex * 1e9 / n, "ns/round_trip");
+    emit("duplex", "two_queues", t_queues * 1e9 / n, "ns/round_trip");
+}
+
+/* =======================================================================
+ * remote_heap
+ * ======================================================================= */
+struct Msg {
+    std::uint64_t seq{0u};
+    std::uint8_t  payload[40]{};
+
+    explicit Msg(const std::uint64_t s) noexcept : seq(s) {
+        std::memset(payload, static_cast<int>(s & 0xFFu), sizeof(payload));
+    }
+};
+
+template <class Make, class Kill>
+double msg_pipeline(const std::uint32_t n, Make make, Kill kill) {
+    ::spsc::queue<Msg*, 1024, ::spsc::policy::CA<>> q;
+    const auto t0 = clock_type::now();
+    std::thread consumer([&]() {
+        for (std::uint32_t i = 0; i < n; ++i) {
+            Msg* const* pp = nullptr;
+            while (!(pp = q.try_front())) {
+                std::this_thread::yield();
+            }
+            Msg* m = *pp;
+            q.pop();
+            kill(m);
+        }
+    });
+    for (std::uint32_t i = 0; i < n; ++i) {
+        Msg* m = make(i);
+        while (!q.try_push(m)) {
+            std::this_thread::yield();
+        }
+    }
+    consumer.join();
+    return seconds_since(t0);
+}
+
+void bench_remote_heap(const options& o) {
+    const std::uint32_t n = 2000000u / o.scale;
+
+    ::spsc::alloc::remote_heap<> h(2u);
+    const double heap_s = msg_pipeline(n,
+                                       [&](std::uint32_t i) {
+                                           Msg* m = nullptr;
+                                           while (!(m = h.make<Msg>(0u, i))) {}
+                                           return m;
+                                       },
+                                       [&](Msg* m) { h.destroy(1u, m); });
+    const double new_s = msg_pipeline(n, [](std::uint32_t i) { return new Msg(i); },
+                                      [](Msg* m) { delete m; });
+
+    emit("remote_heap", "remote_heap", n / heap_s, "msgs/s");
+    emit("remote_heap", "new_delete", n / new_s, "msgs/s");
+}
+
+/* =======================================================================
+ * scan
+ * ======================================================================= */
+void bench_scan(const options& o) {
+    const int rounds = static_cast<int>(4000u / o.scale);
+    ::spsc::fifo<std::uint8_t, 4096> q;
+    for (int i = 0; i < 1000; ++i) { // move the wrap point into the buffer
+        q.push(0u);
+        q.pop();
+    }
+    while (!q.full()) {
+        q.push(static_cast<std::uint8_t>('a' + (q.size() % 26u)));
+    }
+    const ::spsc::scan::byte_set set{'\n', 0x7Eu};
+    volatile std::size_t sink = 0u;
+
+    const auto t0 = clock_type::now();
+    for (int round = 0; round < rounds; ++round) {
+        std::size_t i = 0u;
+        for (auto it = q.begin(); it != q.end() && !set.contains(*it); ++it) {
+            ++i;
+        }
+        sink = sink + i;
+    }
+    const double loop_s = seconds_since(t0);
+
+    const auto t1 = clock_type::now();
+    for (int round = 0; round < rounds; ++round) {
+        sink = sink + ::spsc::scan::find_any_of(q.claim_read(::spsc::unsafe), set);
+    }
+    const double scan_s = seconds_since(t1);
+
+    const double mb = double(rounds) * double(q.size()) / 1e6;
+    emit("scan", "ring_iterator", mb / loop_s, "MB/s");
+    emit("scan", SPSC_SCAN_SIMD ? "find_any_of_simd" : "find_any_of", mb / scan_s, "MB/s");
+}
+
+/* =======================================================================
+ * packed
+ * ======================================================================= */
+// Slowly varying ADC-like signal: sine + small noise.
+std::vector<std::int16_t> adc_signal(const std::size_t n, const unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> noise(-3, 3);
+    std::vector<std::int16_t> v(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const double s = 1000.0 * std::sin(static_cast<double>(i) * 0.001);
+        v[i] = static_cast<std::int16_t>(static_cast<long long>(s) + noise(rng));
+    }
+    return v;
+}
+
+void bench_packed(const options& o) {
+    const int rounds = static_cast<int>(std::max<std::uint32_t>(8u / o.scale, 1u));
+    const auto sig = adc_signal(std::size_t(1u) << 20, 4u);
+    std::vector<::spsc::packed_chunk<std::int16_t, 1024, 512>> chunks;
+    std::size_t pos = 0u;
+    while (pos < sig.size()) {
+        chunks.emplace_back();
+        pos += chunks.back().pack(sig.data() + pos, static_cast<reg>(sig.size() - pos));
+    }
+    std::vector<std::int16_t> out(1024);
+    volatile std::int64_t sink = 0;
+
+    const auto t0 = clock_type::now();
+    for (int round = 0; round < rounds; ++round) {
+        for (const auto& c : chunks) {
+            const reg n = c.unpack(out.data());
+            sink = sink + out[n - 1u];
+        }
+    }
+    const double s = seconds_since(t0);
+
+    emit("packed", "decode_int16", double(rounds) * double(sig.size()) / s / 1e6, "Msamples/s");
+    emit("packed", "ratio_int16", double(sig.size()) * sizeof(std::int16_t) /
+                                      (double(chunks.size()) * sizeof(chunks[0])), "x");
+}
+
+/* =======================================================================
+ * graveyard
+ * ======================================================================= */
+// Heavy payload: a vector of many small heap nodes.
+struct Heavy {
+    std::vector<std::unique_ptr<std::uint32_t>> nodes;
+    std::uint32_t seq{0u};
+
+    Heavy() noexcept = default;
+    Heavy(std::uint32_t s, std::uint32_t n) : seq(s) {
+        nodes.reserve(n);
+        for (std::uint32_t i = 0; i < n; ++i) {
+            nodes.emplace_back(new std::uint32_t(s + i));
+        }
+    }
+    Heavy(Heavy&&) noexcept = default;
+    Heavy& operator=(Heavy&&) noexcept = default;
+};
+
+// Seconds the consumer spends in pop / pop_from.
+double graveyard_run(const std::uint32_t n, const bool offload) {
+    ::spsc::queue<Heavy, 256, ::spsc::policy::CA<>> q;
+    ::spsc::graveyard<Heavy, 4096> g;
+    if (offload) {
+        (void)g.start();
+    }
+    std::thread producer([&]() {
+        for (std::uint32_t i = 0; i < n; ++i) {
+            while (!q.try_emplace(i, 32u)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    double busy = 0.0;
+    for (std::uint32_t i = 0; i < n; ++i) {
+        while (!q.try_front()) {
+            std::this_thread::yield();
+        }
+        const auto t0 = clock_type::now();
+        if (offload) {
+            (void)g.pop_from(q);
+        } else {
+            q.pop();
+        }
+        busy += seconds_since(t0);
+    }
+    producer.join();
+    g.stop();
+    return busy;
+}
+
+void bench_graveyard(const options& o) {
+    const std::uint32_t n = 200000u / o.scale;
+    emit("graveyard", "inline", graveyard_run(n, false) * 1e9 / n, "ns/pop");
+    emit("graveyard", "offloaded", graveyard_run(n, true) * 1e9 / n, "ns/pop");
+}
+
+/* =======================================================================
+ * delay
+ * ======================================================================= */
+void bench_delay(const options& o) {
+    using Stamp = clock_type::duration;
+    using TItem = ::spsc::ttl::stamped<std::uint32_t, Stamp>;
+    const std::uint32_t n = std::max<std::uint32_t>(2000u / o.scale, 1u);
+    const auto delay = std::chrono::milliseconds(2);
+
+    ::spsc::fifo<TItem, 64, ::spsc::policy::A<>> q;
+    ::spsc::delay::playout<Stamp> po(delay);
+    std::thread producer([&]() {
+        for (std::uint32_t i = 0; i < n; ++i) {
+            const TItem it{clock_type::now().time_since_epoch(), i};
+            while (!q.try_push(it)) {
+                std::this_thread::yield();
+            }
+            if ((i & 15u) == 0u) {
+                std::this_thread::sleep_for(std::chrono::microseconds(200)); // bursty input
+            }
+        }
+    });
+
+    double late_sum = 0.0;
+    double late_max = 0.0;
+    for (std::uint32_t i = 0; i < n; ++i) {
+        TItem* p = po.wait_front(q, clock_type::now() + std::chrono::seconds(10));
+        if (!p) {
+            break;
+        }
+        const auto now = clock_type::now().time_since_epoch();
+        const double late = std::chrono::duration<double, std::micro>(now - (p->stamp + delay)).count();
+        late_sum += late;
+        late_max = (late > late_max) ? late : late_max;
+        q.pop();
+    }
+    producer.join();
+
+    emit("delay", "lateness_avg", late_sum / n, "us");
+    emit("delay", "lateness_max", late_max, "us");
+}
+
+/* =======================================================================
+ * spread
+ * ======================================================================= */
+template <class Q>
+double ping_pong_ns(const std::uint32_t n) {
+    Q q;
+    std::atomic<std::uint32_t> acked{0u};
+    std::thread consumer([&]() {
+        std::uint32_t expect = 0u;
+        while (expect < n) {
+            if (!q.try_front()) {
+                std::this_thread::yield();
+                continue;
+            }
+            q.pop();
+            ++expect;
+            acked.store(expect, std::memory_order_release);
+        }
+    });
+    const auto t0 = clock_type::now();
+    for (std::uint32_t i = 0; i < n; ++i) {
+        while (!q.try_push(i)) {
+            std::this_thread::yield();
+        }
+        // Keep the ring nearly empty: at most two in flight.
+        while (i >= acked.load(std::memory_order_acquire) + 2u) {
+            std::this_thread::yield();
+        }
+    }
+    consumer.join();
+    return seconds_since(t0) * 1e9 / n;
+}
+
+void bench_spread(const options& o) {
+    using A = ::spsc::policy::CA<>;
+    const std::uint32_t n = 2000000u / o.scale;
+    emit("spread", "spread_fifo", ping_pong_ns<::spsc::spread_fifo<std::uint32_t, 256, A, true>>(n), "ns/msg");
+    emit("spread", "identity", ping_pong_ns<::spsc::spread_fifo<std::uint32_t, 256, A, false>>(n), "ns/msg");
+    emit("spread", "fifo", ping_pong_ns<::spsc::fifo<std::uint32_t, 256, A>>(n), "ns/msg");
+}
+
+/* =======================================================================
+ * flight
+ * ======================================================================= */
+void bench_flight(const options& o) {
+    static ::spsc::fr::recorder<64, 4096> rec;
+    const std::uint32_t n = 10000000u / o.scale;
+    const auto t0 = clock_type::now();
+    for (std::uint32_t i = 0; i < n; ++i) {
+        rec.record_value(i & 15u, i);
+    }
+    emit("flight", "record_value", seconds_since(t0) * 1e9 / n, "ns/record");
+}
+
+/* =======================================================================
+ * mesh
+ * ======================================================================= */
+struct lane_msg {
+    std::uint32_t src{0u};
+    std::uint32_t seq{0u};
+};
+
+void bench_mesh(const options& o) {
+    constexpr reg N = 3u;
+    constexpr reg M = 2u;
+    const std::uint32_t per_lane = 200000u / o.scale;
+    using Mesh = ::spsc::mesh<lane_msg, 64>;
+    Mesh m(N, M, Mesh::placement::first_touch);
+    std::atomic<reg> attached{0u};
+
+    std::vector<std::thread> th;
+    const auto t0 = clock_type::now();
+    for (reg r = 0; r < M; ++r) {
+        th.emplace_back([&, r]() {
+            (void)m.attach(r);
+            attached.fetch_add(1u);
+            std::uint64_t total = 0u;
+            unsigned spins = 0u;
+            while (total < std::uint64_t(N) * per_lane) {
+                const reg k = m.poll(r, [](reg, lane_msg&) {}, 32u);
+                total += k;
+                if (k == 0u) {
+                    spin_wait(spins);
+                }
+            }
+        });
+    }
+    for (reg s = 0; s < N; ++s) {
+        th.emplace_back([&, s]() {
+            while (attached.load() != M) {
+                std::this_thread::yield();
+            }
+            typename Mesh::sender tx(m, s);
+            unsigned spins = 0u;
+            for (std::uint32_t i = 0; i < per_lane; ++i) {
+                for (reg d = 0; d < M; ++d) {
+                    while (!tx.send(d, lane_msg{static_cast<std::uint32_t>(s), i})) {
+                        spin_wait(spins);
+                    }
+                }
+            }
+        });
+    }
+    for (auto& t : th) {
+        t.join();
+    }
+    emit("mesh", "3x2", double(N) * M * per_lane / seconds_since(t0) / 1e6, "Mmsg/s");
+}
+
+/* =======================================================================
+ * record
+ * ======================================================================= */
+template <class Ring>
+double record_pair_ns(Ring& q, const reg bytes, const std::uint32_t n) {
+    const auto t0 = clock_type::now();
+    std::thread consumer([&]() {
+        std::uint32_t expect = 0u;
+        unsigned spins = 0u;
+        while (expect < n) {
+            if (!q.try_front()) {
+                spin_wait(spins);
+                continue;
+            }
+            q.pop();
+            ++expect;
+        }
+    });
+    unsigned spins = 0u;
+    for (std::uint32_t i = 0; i < n; ++i) {
+        void* p = nullptr;
+        while ((p = q.try_claim()) == nullptr) {
+            spin_wait(spins);
+        }
+        std::memset(p, static_cast<int>(i & 0xFFu), bytes);
+        q.publish();
+    }
+    consumer.join();
+    return seconds_since(t0) * 1e9 / n;
+}
+
+void bench_record(const options& o) {
+    using A = ::spsc::policy::CA<>;
+    const reg bytes = 40u; // chosen at runtime
+    const std::uint32_t n = 2000000u / o.scale;
+    ::spsc::record_fifo<0, A> rq(1024u, bytes);
+    ::spsc::pool<0, A> pq(1024u, bytes);
+    emit("record", "record_fifo", record_pair_ns(rq, bytes, n), "ns/record");
+    emit("record", "pool", record_pair_ns(pq, bytes, n), "ns/record");
+}
+
+struct bench_entry {
+    const char* name;
+    void (*run)(const options&);
+};
+
+constexpr bench_entry kBenches[] = {
+    {"executor", &bench_executor},   {"duplex", &bench_duplex},   {"remote_heap", &bench_remote_heap},
+    {"scan", &bench_scan},           {"packed", &bench_packed},   {"graveyard", &bench_graveyard},
+    {"delay", &bench_delay},         {"spread", &bench_spread},   {"flight", &bench_flight},
+    {"mesh", &bench_mesh},           {"record", &bench_record},
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    options o;
+    if (!parse_args(argc, argv, o)) {
+        std::fprintf(stderr, "spsc_bench: bad arguments (see bench_driver.cpp header)\n");
+        return 2;
+    }
+    bool any = false;
+    for (const auto& b : kBenches) {
+        if (o.only.empty() || o.only == b.name) {
+            b.run(o);
+            any = true;
+        }
+    }
+    if (!any) {
+        std::fprintf(stderr, "spsc_bench: unknown benchmark %s\n", o.only.c_str());
+        return 2;
+    }
+    return 0;
+}
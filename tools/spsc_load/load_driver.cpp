@@ -0,0 +1,173 @@
+/*
+ * load_driver.cpp
+ *
+ * spsc_load: open-loop latency-vs-throughput sweeps (see load_gen.hpp).
+ *
+ * For every container / policy and every arrival pattern, the offered rate is
+ * raised step by step until the ring saturates. Each point prints one line:
+ *
+ *   L <label> <pattern> <offered/s> <achieved/s> <mean_ns> <p50_ns> <p90_ns> <p99_ns> <p999_ns> <max_ns>
+ *
+ * Keep the output of a run and pass it as --baseline next time; every
+ * matching point then also prints the p99 change.
+ *
+ * Build and run (from the repository root):
+ *   g++ -std=c++17 -O2 -pthread -Isrc/spsc -I. tools/spsc_load/load_driver.cpp -o spsc_load
+ *   ./spsc_load --rates 100k,300k,1M,3M,10M --ms 200 > load.txt
+ *
+ * Options:
+ *   --rates a,b,c       offered rates, msgs/s, k/M suffixes (default: 100k,300k,1M,3M,10M,30M)
+ *   --patterns a,b      constant, poisson, burst (default: all three)
+ *   --burst <n>         messages per burst (default: 32)
+ *   --ms <n>            duration of one point (default: 200)
+ *   --only <label>      run one container only (labels below)
+ *   --baseline <file>   earlier output to compare against
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "fifo.hpp"
+#include "queue.hpp"
+#include "load_gen.hpp"
+
+namespace {
+
+constexpr reg kDepth = 1024u;
+
+struct options {
+    std::string rates    = "100k,300k,1M,3M,10M,30M";
+    std::string patterns = "constant,poisson,burst";
+    std::string burst    = "32";
+    std::string ms       = "200";
+    std::string only     = "";
+    std::string baseline = "";
+};
+
+std::vector<std::string> split(const std::string& s) {
+    std::vector<std::string> out;
+    std::string cur;
+    for (const char c : s) {
+        if (c == ',') {
+            if (!cur.empty()) {
+                out.push_back(cur);
+            }
+            cur.clear();
+        } else {
+            cur += c;
+        }
+    }
+    if (!cur.empty()) {
+        out.push_back(cur);
+    }
+    return out;
+}
+
+double parse_rate(const std::string& s) {
+    char* end = nullptr;
+    double v = std::strtod(s.c_str(), &end);
+    if (end && (*end == 'k' || *end == 'K')) { v *= 1e3; }
+    if (end && (*end == 'm' || *end == 'M')) { v *= 1e6; }
+    return v;
+}
+
+bool parse_args(int argc, char** argv, options& o) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string k = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+        const std::string v = argv[++i];
+        if (k == "--rates") { o.rates = v; }
+        else if (k == "--patterns") { o.patterns = v; }
+        else if (k == "--burst") { o.burst = v; }
+        else if (k == "--ms") { o.ms = v; }
+        else if (k == "--only") { o.only = v; }
+        else if (k == "--baseline") { o.baseline = v; }
+        else { return false; }
+    }
+    return true;
+}
+
+std::vector<::spsc::load::result_line> read_baseline(const std::string& path) {
+    std::vector<::spsc::load::result_line> out;
+    std::ifstream f(path);
+    std::string line;
+    while (std::getline(f, line)) {
+        ::spsc::load::result_line r;
+        if (::spsc::load::parse_line(line, r)) {
+            out.push_back(r);
+        }
+    }
+    return out;
+}
+
+template <class Ring>
+void run_curve(const char* label, const options& o, const std::vector<double>& rates,
+               const std::vector<::spsc::load::result_line>& base) {
+    if (!o.only.empty() && o.only != label) {
+        return;
+    }
+    for (const auto& ps : split(o.patterns)) {
+        ::spsc::load::run_config cfg;
+        if (!::spsc::load::parse_pattern(ps, cfg.sched.shape)) {
+            std::fprintf(stderr, "spsc_load: unknown pattern %s\n", ps.c_str());
+            continue;
+        }
+        cfg.sched.burst = static_cast<unsigned>(std::strtoul(o.burst.c_str(), nullptr, 10));
+        cfg.duration = std::chrono::milliseconds(std::strtoul(o.ms.c_str(), nullptr, 10));
+
+        const auto pts = ::spsc::load::sweep([]() { return std::make_unique<Ring>(); }, cfg, rates);
+        for (const auto& pt : pts) {
+            const std::string line = ::spsc::load::format_line(label, cfg.sched.shape, pt);
+            std::printf("%s\n", line.c_str());
+            ::spsc::load::result_line cur;
+            if (::spsc::load::parse_line(line, cur)) {
+                if (const auto* b = ::spsc::load::find_baseline(base, cur)) {
+                    std::fprintf(stderr, "  %s %s %.0f/s p99 %llu -> %llu ns (%+.1f%%)\n", label, ps.c_str(),
+                                 pt.offered, static_cast<unsigned long long>(b->pt.p99),
+                                 static_cast<unsigned long long>(pt.p99),
+                                 b->pt.p99 ? 100.0 * (double(pt.p99) - double(b->pt.p99)) / double(b->pt.p99) : 0.0);
+                }
+            }
+            if (pt.saturated) {
+                std::fprintf(stderr, "  %s %s saturated at %.0f/s (achieved %.0f/s)\n",
+                             label, ps.c_str(), pt.offered, pt.achieved);
+            }
+        }
+        std::fflush(stdout);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    options o;
+    if (!parse_args(argc, argv, o)) {
+        std::fprintf(stderr, "spsc_load: bad arguments (see load_driver.cpp header)\n");
+        return 2;
+    }
+    std::vector<double> rates;
+    for (const auto& s : split(o.rates)) {
+        const double r = parse_rate(s);
+        if (r > 0.0) {
+            rates.push_back(r);
+        }
+    }
+    if (rates.empty()) {
+        std::fprintf(stderr, "spsc_load: no rates\n");
+        return 2;
+    }
+    const auto base = o.baseline.empty() ? std::vector<::spsc::load::result_line>{} : read_baseline(o.baseline);
+
+    using namespace ::spsc::policy;
+    run_curve<::spsc::fifo<std::uint64_t, kDepth, A<>>>("fifo/A", o, rates, base);
+    run_curve<::spsc::fifo<std::uint64_t, kDepth, CA<>>>("fifo/CA", o, rates, base);
+    run_curve<::spsc::queue<std::uint64_t, kDepth, A<>>>("queue/A", o, rates, base);
+    run_curve<::spsc::queue<std::uint64_t, kDepth, CA<>>>("queue/CA", o, rates, base);
+    return 0;
+}
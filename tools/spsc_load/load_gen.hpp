@@ -0,0 +1,390 @@
+/*
+ * load_gen.hpp
+ *
+ * Open-loop load generator for SPSC rings: latency without coordinated omission.
+ *
+ * Closed-loop tests (spin on try_push(), yield, retry) let a stalled consumer
+ * slow the producer down, so the queueing delay never shows up in the numbers.
+ * Here the producer follows a fixed schedule instead:
+ *
+ * - schedule   : intended send times for a target rate (constant, Poisson or
+ *                bursts), fixed before the run and independent of the ring.
+ * - producer   : waits for the intended time of message i and pushes the
+ *                intended time itself. A full ring delays the push, not the
+ *                stamp, so the delay is charged to the message.
+ * - consumer   : latency = consume time - intended send time (histogram).
+ * - sweep      : raise the offered rate until the ring can no longer keep up
+ *                (achieved < saturation * offered) -> latency/throughput curve.
+ *
+ * Result lines (one per point, stable for comparisons over time):
+ *
+ *   L <label> <pattern> <offered/s> <achieved/s> <mean_ns> <p50_ns> <p90_ns> <p99_ns> <p999_ns> <max_ns>
+ *
+ * Host-only tool code: std::string / std::vector / std::function are fine here.
+ */
+
+#ifndef SPSC_LOAD_GEN_HPP_
+#define SPSC_LOAD_GEN_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace spsc::load {
+
+using clock = std::chrono::steady_clock;
+
+// ------------------------------------------------------------------------------------------
+// Schedules
+// ------------------------------------------------------------------------------------------
+enum class pattern { constant, poisson, burst };
+
+[[nodiscard]] inline const char *pattern_name(const pattern p) noexcept {
+    switch (p) {
+    case pattern::constant: return "constant";
+    case pattern::poisson:  return "poisson";
+    case pattern::burst:    return "burst";
+    }
+    return "?";
+}
+
+[[nodiscard]] inline bool parse_pattern(const std::string &s, pattern &out) noexcept {
+    for (const pattern p : {pattern::constant, pattern::poisson, pattern::burst}) {
+        if (s == pattern_name(p)) {
+            out = p;
+            return true;
+        }
+    }
+    return false;
+}
+
+struct schedule_config {
+    pattern       shape{pattern::constant};
+    double        rate{1e6};        // mean messages per second
+    unsigned      burst{32u};       // messages per burst (pattern::burst)
+    std::uint64_t seed{0x9e3779b97f4a7c15ull};
+};
+
+/* Intended send offsets (ns from the start), deterministic for a given config.
+ * Every pattern has the same mean rate:
+ * - constant : one message every 1/rate,
+ * - poisson  : exponential gaps with mean 1/rate,
+ * - burst    : `burst` messages at once every burst/rate.
+ */
+class schedule {
+public:
+    explicit schedule(const schedule_config &c) noexcept
+        : cfg_(c), gap_ns_(1e9 / c.rate), rng_(c.seed) {}
+
+    [[nodiscard]] std::uint64_t next() noexcept {
+        std::uint64_t t = 0u;
+        switch (cfg_.shape) {
+        case pattern::constant:
+            t = static_cast<std::uint64_t>(static_cast<double>(i_) * gap_ns_);
+            break;
+        case pattern::poisson:
+            t = static_cast<std::uint64_t>(acc_);
+            acc_ += -std::log(uniform_()) * gap_ns_;
+            break;
+        case pattern::burst: {
+            const unsigned b = (cfg_.burst == 0u) ? 1u : cfg_.burst;
+            t = static_cast<std::uint64_t>(static_cast<double>(i_ / b) * b * gap_ns_);
+            break;
+        }
+        }
+        ++i_;
+        return t;
+    }
+
+private:
+    // splitmix64 -> (0, 1]
+    [[nodiscard]] double uniform_() noexcept {
+        std::uint64_t z = (rng_ += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        z ^= z >> 31;
+        return (static_cast<double>(z >> 11) + 1.0) * (1.0 / 9007199254740992.0);
+    }
+
+    schedule_config cfg_;
+    double          gap_ns_;
+    std::uint64_t   rng_;
+    std::uint64_t   i_{0u};
+    double          acc_{0.0};
+};
+
+// ------------------------------------------------------------------------------------------
+// Latency histogram (log-linear buckets, ~3% relative error)
+// ------------------------------------------------------------------------------------------
+class histogram {
+public:
+    static constexpr unsigned kSubBits = 5u;                 // 32 sub-buckets per power of two
+    static constexpr unsigned kSub     = 1u << kSubBits;
+    static constexpr unsigned kBuckets = (64u - kSubBits + 1u) * kSub;
+
+    histogram() : counts_(kBuckets, 0u) {}
+
+    void record(const std::uint64_t ns) noexcept {
+        ++counts_[index_of(ns)];
+        ++count_;
+        sum_ += static_cast<double>(ns);
+        max_ = (ns > max_) ? ns : max_;
+    }
+
+    void merge(const histogram &o) noexcept {
+        for (unsigned i = 0; i < kBuckets; ++i) {
+            counts_[i] += o.counts_[i];
+        }
+        count_ += o.count_;
+        sum_ += o.sum_;
+        max_ = (o.max_ > max_) ? o.max_ : max_;
+    }
+
+    [[nodiscard]] std::uint64_t count() const noexcept { return count_; }
+    [[nodiscard]] std::uint64_t max() const noexcept { return max_; }
+    [[nodiscard]] double mean() const noexcept { return count_ ? sum_ / static_cast<double>(count_) : 0.0; }
+
+    /* Upper bound of the bucket holding quantile q (0..1), capped at max(). */
+    [[nodiscard]] std::uint64_t percentile(const double q) const noexcept {
+        if (count_ == 0u) {
+            return 0u;
+        }
+        const double want = q * static_cast<double>(count_);
+        std::uint64_t rank = static_cast<std::uint64_t>(std::ceil(want));
+        rank = (rank == 0u) ? 1u : rank;
+        std::uint64_t seen = 0u;
+        for (unsigned i = 0; i < kBuckets; ++i) {
+            seen += counts_[i];
+            if (seen >= rank) {
+                const std::uint64_t hi = upper_of(i);
+                return (hi < max_) ? hi : max_;
+            }
+        }
+        return max_;
+    }
+
+    [[nodiscard]] static unsigned index_of(const std::uint64_t v) noexcept {
+        if (v < kSub) {
+            return static_cast<unsigned>(v);
+        }
+        unsigned msb = 63u;
+        while (!(v >> msb)) {
+            --msb;
+        }
+        const unsigned shift = msb - kSubBits;
+        return (shift + 1u) * kSub + static_cast<unsigned>((v >> shift) & (kSub - 1u));
+    }
+
+    [[nodiscard]] static std::uint64_t upper_of(const unsigned idx) noexcept {
+        if (idx < kSub) {
+            return idx;
+        }
+        const unsigned shift = idx / kSub - 1u;
+        const std::uint64_t base = (std::uint64_t(kSub) + (idx % kSub)) << shift;
+        return base + ((std::uint64_t(1u) << shift) - 1u);
+    }
+
+private:
+    std::vector<std::uint64_t> counts_;
+    std::uint64_t count_{0u};
+    double        sum_{0.0};
+    std::uint64_t max_{0u};
+};
+
+// ------------------------------------------------------------------------------------------
+// One open-loop run
+// ------------------------------------------------------------------------------------------
+struct point {
+    double        offered{0.0};   // msgs/s requested
+    double        achieved{0.0};  // msgs/s consumed
+    std::uint64_t sent{0u};
+    std::uint64_t received{0u};
+    double        mean{0.0};
+    std::uint64_t p50{0u};
+    std::uint64_t p90{0u};
+    std::uint64_t p99{0u};
+    std::uint64_t p999{0u};
+    std::uint64_t max{0u};
+    bool          in_order{true};
+    bool          saturated{false};
+};
+
+struct run_config {
+    schedule_config           sched{};
+    std::chrono::nanoseconds  duration{std::chrono::milliseconds(200)};
+    double                    saturation{0.95}; // achieved < saturation * offered -> saturated
+    std::function<void(std::uint64_t)> on_consume{}; // test hook: called after message i
+};
+
+namespace detail {
+
+/* Spin-yield until t; sleep through most of a long wait. */
+inline void wait_until(const clock::time_point t) {
+    const auto now = clock::now();
+    if (t - now > std::chrono::microseconds(200)) {
+        std::this_thread::sleep_until(t - std::chrono::microseconds(100));
+    }
+    while (clock::now() < t) {
+        std::this_thread::yield();
+    }
+}
+
+[[nodiscard]] inline std::uint64_t ns_since(const clock::time_point t0) noexcept {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - t0).count());
+}
+
+} // namespace detail
+
+/* Run one open-loop point over q (value_type constructible from uint64_t stamps).
+ * The calling thread produces, a helper thread consumes.
+ */
+template <class Ring>
+[[nodiscard]] point run_open_loop(Ring &q, const run_config &cfg) {
+    using value_type = typename Ring::value_type;
+
+    std::atomic<std::uint64_t> sent_total{~std::uint64_t(0)};
+    histogram hist;
+    std::uint64_t received = 0u;
+    std::uint64_t last_ns = 0u;
+    bool in_order = true;
+
+    const clock::time_point t0 = clock::now();
+    std::thread consumer([&]() {
+        std::uint64_t prev = 0u;
+        unsigned spins = 0u;
+        for (;;) {
+            auto *p = q.try_front();
+            if (!p) {
+                if (received == sent_total.load(std::memory_order_acquire)) {
+                    break;
+                }
+                if (++spins > 64u) {
+                    spins = 0u;
+                    std::this_thread::yield();
+                }
+                continue;
+            }
+            const std::uint64_t intended = static_cast<std::uint64_t>(*p);
+            q.pop();
+            const std::uint64_t now = detail::ns_since(t0);
+            in_order = in_order && (intended >= prev);
+            prev = intended;
+            hist.record((now > intended) ? now - intended : 0u);
+            last_ns = now;
+            if (cfg.on_consume) {
+                cfg.on_consume(received);
+            }
+            ++received;
+        }
+    });
+
+    schedule sched(cfg.sched);
+    const std::uint64_t end_ns = static_cast<std::uint64_t>(cfg.duration.count());
+    std::uint64_t sent = 0u;
+    for (;;) {
+        const std::uint64_t intended = sched.next();
+        // A saturated producer falls behind its schedule: stop at the wall-clock
+        // end too (the shortfall shows up as achieved < offered).
+        if (intended >= end_ns || ((sent & 63u) == 0u && detail::ns_since(t0) >= end_ns)) {
+            break;
+        }
+        detail::wait_until(t0 + std::chrono::nanoseconds(intended));
+        // Full ring: retry with the same stamp, the wait counts as latency.
+        unsigned spins = 0u;
+        while (!q.try_push(value_type(intended))) {
+            if (++spins > 64u) {
+                spins = 0u;
+                std::this_thread::yield();
+            }
+        }
+        ++sent;
+    }
+    sent_total.store(sent, std::memory_order_release);
+    consumer.join();
+
+    point r;
+    r.offered  = cfg.sched.rate;
+    r.sent     = sent;
+    r.received = received;
+    r.achieved = (last_ns != 0u) ? static_cast<double>(received) * 1e9 / static_cast<double>(last_ns) : 0.0;
+    r.mean     = hist.mean();
+    r.p50      = hist.percentile(0.50);
+    r.p90      = hist.percentile(0.90);
+    r.p99      = hist.percentile(0.99);
+    r.p999     = hist.percentile(0.999);
+    r.max      = hist.max();
+    r.in_order = in_order;
+    r.saturated = r.achieved < cfg.saturation * r.offered;
+    return r;
+}
+
+/* Run every rate in ascending order on a fresh ring from make(); stops after
+ * the first saturated point. */
+template <class MakeRing>
+[[nodiscard]] std::vector<point> sweep(MakeRing &&make, run_config cfg, const std::vector<double> &rates) {
+    std::vector<point> out;
+    for (const double rate : rates) {
+        cfg.sched.rate = rate;
+        auto ring = make();
+        out.push_back(run_open_loop(*ring, cfg));
+        if (out.back().saturated) {
+            break;
+        }
+    }
+    return out;
+}
+
+// ------------------------------------------------------------------------------------------
+// Result lines
+// ------------------------------------------------------------------------------------------
+struct result_line {
+    std::string label{};
+    std::string pattern{};
+    point       pt{};
+};
+
+[[nodiscard]] inline std::string format_line(const std::string &label, const pattern p, const point &pt) {
+    std::ostringstream os;
+    os.setf(std::ios::fixed);
+    os.precision(0);
+    os << "L " << label << ' ' << pattern_name(p) << ' ' << pt.offered << ' ' << pt.achieved << ' '
+       << pt.mean << ' ' << pt.p50 << ' ' << pt.p90 << ' ' << pt.p99 << ' ' << pt.p999 << ' ' << pt.max;
+    return os.str();
+}
+
+[[nodiscard]] inline bool parse_line(const std::string &line, result_line &out) {
+    std::istringstream is(line);
+    std::string tag;
+    result_line r{};
+    if (!(is >> tag >> r.label >> r.pattern >> r.pt.offered >> r.pt.achieved >> r.pt.mean
+             >> r.pt.p50 >> r.pt.p90 >> r.pt.p99 >> r.pt.p999 >> r.pt.max) ||
+        tag != "L" || !(r.pt.offered > 0.0)) {
+        return false;
+    }
+    out = r;
+    return true;
+}
+
+/* Baseline entry for the same label / pattern / offered rate, or nullptr. */
+[[nodiscard]] inline const result_line *find_baseline(const std::vector<result_line> &base,
+                                                      const result_line &cur) noexcept {
+    for (const result_line &b : base) {
+        if (b.label == cur.label && b.pattern == cur.pattern &&
+            std::fabs(b.pt.offered - cur.pt.offered) <= 1e-6 * cur.pt.offered) {
+            return &b;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace spsc::load
+
+#endif /* SPSC_LOAD_GEN_HPP_ */
@@ -0,0 +1,166 @@
+/*
+ * micro_bench.cpp
+ *
+ * Single-thread microbenchmarks of the fifo primitives (built and run by
+ * micro_driver.cpp). For every policy each primitive is compiled into one
+ * non-inlined function spsc_micro_<primitive>_<policy> over
+ * fifo<std::uint64_t, 1024, Policy>; the same function is timed here and
+ * disassembled by the driver.
+ *
+ * Output, one line per cell (see micro_model.hpp):
+ *
+ *   B <policy> <primitive> <cycles/op>
+ *
+ * Cycles are TSC ticks on x86 (steady_clock ns elsewhere, see the "# clock"
+ * line), best of --reps batches of kBatch calls, call overhead included.
+ *
+ * Usage: micro_bench [reps]
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#if defined(__x86_64__) || defined(__i386__)
+#  include <x86intrin.h> // __rdtsc
+#  define SPSC_MICRO_TSC 1
+#elif defined(_M_X64) || defined(_M_IX86)
+#  include <intrin.h>    // __rdtsc
+#  define SPSC_MICRO_TSC 1
+#else
+#  define SPSC_MICRO_TSC 0
+#endif
+
+#if defined(_MSC_VER)
+#  define SPSC_MICRO_NOINLINE __declspec(noinline)
+#else
+#  define SPSC_MICRO_NOINLINE __attribute__((noinline))
+#endif
+
+#include "fifo.hpp"               // ::spsc::fifo
+#include "base/spsc_policy.hpp"   // ::spsc::policy::P, V, A, CA
+
+namespace {
+
+constexpr reg kDepth = 1024u;
+constexpr reg kBatch = kDepth;
+
+inline std::uint64_t ticks() noexcept {
+#if SPSC_MICRO_TSC
+    return static_cast<std::uint64_t>(__rdtsc());
+#else
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+template <class Policy>
+using ring = ::spsc::fifo<std::uint64_t, kDepth, Policy>;
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------
+// Hot functions (disassembled by the driver; keep the names stable)
+// ------------------------------------------------------------------------------------------
+#define SPSC_MICRO_DEFINE(tag, ...)                                                             \
+    extern "C" SPSC_MICRO_NOINLINE void spsc_micro_push_##tag(ring<__VA_ARGS__>& q,              \
+                                                              std::uint64_t v) noexcept {       \
+        q.push(v);                                                                              \
+    }                                                                                           \
+    extern "C" SPSC_MICRO_NOINLINE bool spsc_micro_try_push_##tag(ring<__VA_ARGS__>& q,          \
+                                                                  std::uint64_t v) noexcept {   \
+        return q.try_push(v);                                                                   \
+    }                                                                                           \
+    extern "C" SPSC_MICRO_NOINLINE std::uint64_t spsc_micro_front_##tag(ring<__VA_ARGS__>& q) noexcept { \
+        return q.front();                                                                       \
+    }                                                                                           \
+    extern "C" SPSC_MICRO_NOINLINE void spsc_micro_pop_##tag(ring<__VA_ARGS__>& q) noexcept {     \
+        q.pop();                                                                                \
+    }                                                                                           \
+    extern "C" SPSC_MICRO_NOINLINE reg spsc_micro_claim_write_##tag(ring<__VA_ARGS__>& q) noexcept { \
+        return q.claim_write(::spsc::unsafe, 8u).total;                                         \
+    }                                                                                           \
+    extern "C" SPSC_MICRO_NOINLINE void spsc_micro_publish_##tag(ring<__VA_ARGS__>& q) noexcept { \
+        q.publish();                                                                            \
+    }
+
+SPSC_MICRO_DEFINE(P,  ::spsc::policy::P)
+SPSC_MICRO_DEFINE(V,  ::spsc::policy::V)
+SPSC_MICRO_DEFINE(A,  ::spsc::policy::A<>)
+SPSC_MICRO_DEFINE(CA, ::spsc::policy::CA<>)
+
+#undef SPSC_MICRO_DEFINE
+
+namespace {
+
+template <class Q>
+void fill(Q& q) {
+    q.clear();
+    for (reg i = 0; i < kBatch; ++i) {
+        q.push(std::uint64_t(i));
+    }
+}
+
+// Best-of-reps ticks per call of 'op'; 'setup' runs untimed before each batch.
+template <class Setup, class Op>
+double measure(const unsigned reps, Setup&& setup, Op&& op) {
+    double best = 1e30;
+    for (unsigned r = 0; r < reps; ++r) {
+        setup();
+        const std::uint64_t t0 = ticks();
+        for (reg i = 0; i < kBatch; ++i) {
+            op(i);
+        }
+        const std::uint64_t t1 = ticks();
+        const double per = static_cast<double>(t1 - t0) / static_cast<double>(kBatch);
+        best = (per < best) ? per : best;
+    }
+    return best;
+}
+
+volatile std::uint64_t g_sink = 0u;
+
+template <class Q, class Fns>
+void run_policy(const char* name, const unsigned reps, const Fns& f) {
+    static Q q; // static: CA<> rings are over-aligned
+    const auto print = [name](const char* prim, double c) {
+        std::printf("B %s %s %.2f\n", name, prim, c);
+    };
+
+    print("push", measure(reps, [&] { q.clear(); }, [&](reg i) { f.push(q, i); }));
+    print("try_push", measure(reps, [&] { q.clear(); }, [&](reg i) { g_sink = g_sink + f.try_push(q, i); }));
+    print("front", measure(reps, [&] { fill(q); }, [&](reg) { g_sink = g_sink + f.front(q); }));
+    print("pop", measure(reps, [&] { fill(q); }, [&](reg) { f.pop(q); }));
+    print("claim_write", measure(reps, [&] { q.clear(); }, [&](reg) { g_sink = g_sink + f.claim_write(q); }));
+    print("publish", measure(reps, [&] { q.clear(); }, [&](reg) { f.publish(q); }));
+    std::fflush(stdout);
+}
+
+template <class Q>
+struct fns {
+    void (*push)(Q&, std::uint64_t) noexcept;
+    bool (*try_push)(Q&, std::uint64_t) noexcept;
+    std::uint64_t (*front)(Q&) noexcept;
+    void (*pop)(Q&) noexcept;
+    reg (*claim_write)(Q&) noexcept;
+    void (*publish)(Q&) noexcept;
+};
+
+#define SPSC_MICRO_RUN(tag, ...)                                                                \
+    run_policy<ring<__VA_ARGS__>>(#tag, reps, fns<ring<__VA_ARGS__>>{                           \
+        &spsc_micro_push_##tag, &spsc_micro_try_push_##tag, &spsc_micro_front_##tag,            \
+        &spsc_micro_pop_##tag, &spsc_micro_claim_write_##tag, &spsc_micro_publish_##tag})
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const unsigned reps = (argc > 1) ? static_cast<unsigned>(std::strtoul(argv[1], nullptr, 10)) : 200u;
+    std::printf("# clock=%s depth=%u batch=%u reps=%u\n", SPSC_MICRO_TSC ? "tsc" : "ns",
+                unsigned(kDepth), unsigned(kBatch), reps);
+    SPSC_MICRO_RUN(P,  ::spsc::policy::P);
+    SPSC_MICRO_RUN(V,  ::spsc::policy::V);
+    SPSC_MICRO_RUN(A,  ::spsc::policy::A<>);
+    SPSC_MICRO_RUN(CA, ::spsc::policy::CA<>);
+    return 0;
+}
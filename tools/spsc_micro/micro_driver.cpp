@@ -0,0 +1,199 @@
+/*
+ * micro_driver.cpp
+ *
+ * spsc_micro: primitive microbenchmarks + codegen regression check.
+ *
+ * Compiles micro_bench.cpp with the given compiler/flags, runs it (cycles per
+ * push / try_push / front / pop / claim_write / publish for P, V, A<>, CA<>),
+ * then disassembles the binary and counts instructions and fences of every
+ * spsc_micro_* hot function (see micro_model.hpp).
+ *
+ * Output on stdout:
+ *   B <policy> <primitive> <cycles/op>
+ *   C <function> <instructions> <fences>
+ *
+ * With --baseline, the C lines are compared with a stored file; the exit
+ * code is 1 when any function gained a fence or grew past --tolerance.
+ * The cycle numbers are informational only (too noisy to gate on).
+ *
+ * Build and run (from the repository root):
+ *   g++ -std=c++17 -O2 tools/spsc_micro/micro_driver.cpp -o spsc_micro
+ *   ./spsc_micro --write-baseline tools/spsc_micro/baseline_x86_64_gcc.txt
+ *   ./spsc_micro --baseline tools/spsc_micro/baseline_x86_64_gcc.txt
+ *
+ * Options:
+ *   --cxx <compiler>        (default: c++)
+ *   --flags "<flags>"       (default: -std=c++17 -O2)
+ *   --inc a,b               include dirs (default: src/spsc,. for basic_types.h)
+ *   --bench <file>          bench source (default: tools/spsc_micro/micro_bench.cpp)
+ *   --objdump <tool>        (default: objdump)
+ *   --reps <n>              timed batches per cell, best one wins (default: 200)
+ *   --baseline <file>       stored C lines to check against
+ *   --write-baseline <file> store this build's C lines
+ *   --tolerance <pct>       allowed instruction growth (default: 10)
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "micro_model.hpp"
+
+namespace {
+
+struct options {
+    std::string cxx       = "c++";
+    std::string flags     = "-std=c++17 -O2";
+    std::string inc       = "src/spsc,.";
+    std::string bench     = "tools/spsc_micro/micro_bench.cpp";
+    std::string objdump   = "objdump";
+    std::string reps      = "200";
+    std::string baseline  = "";
+    std::string write     = "";
+    std::string tolerance = "10";
+};
+
+std::vector<std::string> split(const std::string& s) {
+    std::vector<std::string> out;
+    std::string cur;
+    for (const char c : s) {
+        if (c == ',') {
+            if (!cur.empty()) {
+                out.push_back(cur);
+            }
+            cur.clear();
+        } else {
+            cur += c;
+        }
+    }
+    if (!cur.empty()) {
+        out.push_back(cur);
+    }
+    return out;
+}
+
+bool parse_args(int argc, char** argv, options& o) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string k = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+        const std::string v = argv[++i];
+        if (k == "--cxx") { o.cxx = v; }
+        else if (k == "--flags") { o.flags = v; }
+        else if (k == "--inc") { o.inc = v; }
+        else if (k == "--bench") { o.bench = v; }
+        else if (k == "--objdump") { o.objdump = v; }
+        else if (k == "--reps") { o.reps = v; }
+        else if (k == "--baseline") { o.baseline = v; }
+        else if (k == "--write-baseline") { o.write = v; }
+        else if (k == "--tolerance") { o.tolerance = v; }
+        else { return false; }
+    }
+    return true;
+}
+
+bool read_command(const std::string& cmd, std::string& out) {
+    FILE* p = popen(cmd.c_str(), "r");
+    if (!p) {
+        return false;
+    }
+    char buf[4096];
+    std::size_t n = 0u;
+    while ((n = std::fread(buf, 1u, sizeof(buf), p)) != 0u) {
+        out.append(buf, n);
+    }
+    return pclose(p) == 0;
+}
+
+std::vector<::spsc::micro::codegen> read_baseline(const std::string& path) {
+    std::vector<::spsc::micro::codegen> out;
+    std::ifstream f(path);
+    std::string line;
+    while (std::getline(f, line)) {
+        ::spsc::micro::codegen c;
+        if (::spsc::micro::parse_codegen(line, c)) {
+            out.push_back(c);
+        }
+    }
+    return out;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    options o;
+    if (!parse_args(argc, argv, o)) {
+        std::fprintf(stderr, "spsc_micro: bad arguments (see micro_driver.cpp header)\n");
+        return 2;
+    }
+
+    std::string inc_args;
+    for (const auto& d : split(o.inc)) {
+        inc_args += " -I" + d;
+    }
+    const std::string exe = "spsc_micro_bench.bin";
+    const std::string build = o.cxx + " " + o.flags + inc_args + " " + o.bench + " -o " + exe;
+    if (std::system(build.c_str()) != 0) {
+        std::fprintf(stderr, "spsc_micro: build failed: %s\n", build.c_str());
+        return 1;
+    }
+
+    std::string bench_out;
+    if (!read_command("./" + exe + " " + o.reps, bench_out)) {
+        std::fprintf(stderr, "spsc_micro: bench run failed\n");
+        std::remove(exe.c_str());
+        return 1;
+    }
+    std::fputs(bench_out.c_str(), stdout);
+
+    std::string dis;
+    const bool dis_ok = read_command(o.objdump + " -d --no-show-raw-insn " + exe, dis);
+    std::remove(exe.c_str());
+    auto cur = ::spsc::micro::parse_objdump(dis, "spsc_micro_");
+    std::sort(cur.begin(), cur.end(),
+              [](const ::spsc::micro::codegen& a, const ::spsc::micro::codegen& b) { return a.fn < b.fn; });
+    if (!dis_ok || cur.empty()) {
+        std::fprintf(stderr, "spsc_micro: no hot functions found in the disassembly (%s)\n", o.objdump.c_str());
+        return 1;
+    }
+
+    std::string lines;
+    for (const auto& c : cur) {
+        lines += ::spsc::micro::format_codegen(c) + "\n";
+    }
+    std::fputs(lines.c_str(), stdout);
+    std::fflush(stdout);
+
+    if (!o.write.empty()) {
+        std::ofstream f(o.write, std::ios::binary | std::ios::trunc);
+        f << "# " << o.cxx << " " << o.flags << "\n" << lines;
+        if (!f) {
+            std::fprintf(stderr, "spsc_micro: cannot write %s\n", o.write.c_str());
+            return 1;
+        }
+    }
+
+    if (o.baseline.empty()) {
+        return 0;
+    }
+    const auto base = read_baseline(o.baseline);
+    if (base.empty()) {
+        std::fprintf(stderr, "spsc_micro: empty baseline %s\n", o.baseline.c_str());
+        return 1;
+    }
+    const auto tol = static_cast<unsigned>(std::strtoul(o.tolerance.c_str(), nullptr, 10));
+    const auto regs = ::spsc::micro::compare(base, cur, tol);
+    for (const auto& r : regs) {
+        std::fprintf(stderr, "REGRESSION %s %s: insns %u -> %u, fences %u -> %u\n", r.fn.c_str(), r.what,
+                     r.base.insns, r.cur.insns, r.base.fences, r.cur.fences);
+    }
+    if (!regs.empty()) {
+        return 1;
+    }
+    std::fprintf(stderr, "spsc_micro: %zu functions within baseline\n", base.size());
+    return 0;
+}
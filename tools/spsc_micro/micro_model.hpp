@@ -0,0 +1,243 @@
+/*
+ * micro_model.hpp
+ *
+ * Model for spsc_micro: result lines, disassembly parsing and the codegen
+ * regression check.
+ *
+ * micro_bench.cpp prints one line per (policy, primitive):
+ *
+ *   B <policy> <primitive> <cycles/op>
+ *
+ * Every measured primitive is also compiled into one non-inlined function
+ * spsc_micro_<primitive>_<policy>. The driver disassembles the binary
+ * (objdump -d) and counts per function:
+ *
+ *   C <function> <instructions> <fences>
+ *
+ * A fence is any instruction with ordering cost: x86 mfence/lfence/sfence,
+ * lock-prefixed RMW and xchg with memory; AArch64 dmb/dsb/isb and
+ * acquire/release loads/stores (ldar*, ldapr*, ldaxr*, stlr*, stlxr*).
+ * Alignment padding (nop, int3) is not counted.
+ *
+ * Regression: more fences than the baseline, or more instructions than the
+ * baseline plus a tolerance. A function missing from the build also fails.
+ *
+ * Host-only tool code: std::string / std::vector are fine here.
+ */
+
+#ifndef SPSC_MICRO_MODEL_HPP_
+#define SPSC_MICRO_MODEL_HPP_
+
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace spsc::micro {
+
+// ------------------------------------------------------------------------------------------
+// Result lines
+// ------------------------------------------------------------------------------------------
+struct bench_line {
+    std::string policy;
+    std::string primitive;
+    double      cycles{0.0};
+};
+
+struct codegen {
+    std::string fn;
+    unsigned    insns{0u};
+    unsigned    fences{0u};
+};
+
+[[nodiscard]] inline std::string format_bench(const bench_line& b) {
+    std::ostringstream os;
+    os.setf(std::ios::fixed);
+    os.precision(2);
+    os << "B " << b.policy << ' ' << b.primitive << ' ' << b.cycles;
+    return os.str();
+}
+
+[[nodiscard]] inline bool parse_bench(const std::string& line, bench_line& out) {
+    std::istringstream is(line);
+    std::string tag;
+    bench_line b;
+    if (!(is >> tag >> b.policy >> b.primitive >> b.cycles) || tag != "B" || b.cycles < 0.0) {
+        return false;
+    }
+    out = b;
+    return true;
+}
+
+[[nodiscard]] inline std::string format_codegen(const codegen& c) {
+    std::ostringstream os;
+    os << "C " << c.fn << ' ' << c.insns << ' ' << c.fences;
+    return os.str();
+}
+
+[[nodiscard]] inline bool parse_codegen(const std::string& line, codegen& out) {
+    std::istringstream is(line);
+    std::string tag;
+    codegen c;
+    if (!(is >> tag >> c.fn >> c.insns >> c.fences) || tag != "C" || c.insns == 0u) {
+        return false;
+    }
+    out = c;
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------
+// Instruction classification
+// ------------------------------------------------------------------------------------------
+namespace detail {
+
+[[nodiscard]] inline bool starts_with(const std::string& s, const char* p) {
+    return s.rfind(p, 0u) == 0u;
+}
+
+[[nodiscard]] inline std::string trim(const std::string& s) {
+    const auto b = s.find_first_not_of(" \t\r\n");
+    if (b == std::string::npos) {
+        return {};
+    }
+    const auto e = s.find_last_not_of(" \t\r\n");
+    return s.substr(b, e - b + 1u);
+}
+
+// Raw-byte column: "48 83 07 01" (x86) or "f9400001" (AArch64).
+[[nodiscard]] inline bool is_raw_bytes(const std::string& s) {
+    std::istringstream is(s);
+    std::string tok;
+    bool any = false;
+    while (is >> tok) {
+        if (((tok.size() != 2u) && (tok.size() != 8u)) ||
+            (tok.find_first_not_of("0123456789abcdef") != std::string::npos)) {
+            return false;
+        }
+        any = true;
+    }
+    return any;
+}
+
+} // namespace detail
+
+// 'text' is the instruction part of an objdump line ("lock addq $0x1,(%rax)").
+[[nodiscard]] inline bool is_padding(const std::string& text) {
+    using detail::starts_with;
+    return starts_with(text, "nop") || starts_with(text, "data16") ||
+           starts_with(text, "cs nop") || starts_with(text, "int3") ||
+           starts_with(text, "xchg   %ax,%ax") || text == "...";
+}
+
+[[nodiscard]] inline bool is_fence(const std::string& text) {
+    using detail::starts_with;
+    // x86
+    if (starts_with(text, "mfence") || starts_with(text, "lfence") || starts_with(text, "sfence") ||
+        starts_with(text, "lock")) {
+        return true;
+    }
+    if (starts_with(text, "xchg")) {
+        // xchg with a memory operand is implicitly locked (AT&T "(", Intel "[").
+        return (text.find('(') != std::string::npos) || (text.find('[') != std::string::npos);
+    }
+    // AArch64
+    return starts_with(text, "dmb") || starts_with(text, "dsb") || starts_with(text, "isb") ||
+           starts_with(text, "ldar") || starts_with(text, "ldapr") || starts_with(text, "ldaxr") ||
+           starts_with(text, "stlr") || starts_with(text, "stlxr");
+}
+
+/*
+ * parse_objdump(text, prefix)
+ * Counts instructions and fences of every function whose symbol starts with
+ * 'prefix' in `objdump -d --no-show-raw-insn` output (AT&T or Intel syntax).
+ */
+[[nodiscard]] inline std::vector<codegen> parse_objdump(const std::string& text, const std::string& prefix) {
+    std::vector<codegen> out;
+    std::istringstream is(text);
+    std::string line;
+    codegen* cur = nullptr;
+    while (std::getline(is, line)) {
+        // "0000000000401130 <spsc_micro_push_A>:"
+        const auto lt = line.find(" <");
+        if ((lt != std::string::npos) && (line.size() > 2u) && (line.compare(line.size() - 2u, 2u, ">:") == 0) &&
+            (line.find_first_not_of("0123456789abcdef") == lt)) {
+            const std::string name = line.substr(lt + 2u, line.size() - lt - 4u);
+            if (detail::starts_with(name, prefix.c_str())) {
+                out.push_back(codegen{name, 0u, 0u});
+                cur = &out.back();
+            } else {
+                cur = nullptr;
+            }
+            continue;
+        }
+        if (!cur) {
+            continue;
+        }
+        // "  401136:\tmov    %rdi,%rax"; with raw bytes: "  401136:\t48 89 f8 \tmov ..."
+        const auto colon = line.find(":\t");
+        if (colon == std::string::npos) {
+            continue;
+        }
+        std::string ins = line.substr(colon + 2u);
+        const auto tab = ins.find('\t');
+        if ((tab != std::string::npos) && detail::is_raw_bytes(ins.substr(0u, tab))) {
+            ins = ins.substr(tab + 1u);
+        }
+        ins = detail::trim(ins);
+        if (ins.empty() || is_padding(ins) || detail::is_raw_bytes(ins)) {
+            continue;
+        }
+        ++cur->insns;
+        if (is_fence(ins)) {
+            ++cur->fences;
+        }
+    }
+    return out;
+}
+
+// ------------------------------------------------------------------------------------------
+// Regression check
+// ------------------------------------------------------------------------------------------
+struct regression {
+    std::string fn;
+    codegen     base;
+    codegen     cur;
+    const char* what{""}; // "fences", "insns", "missing"
+};
+
+/*
+ * compare(base, cur, tolerance_pct)
+ * Every baseline function must exist in 'cur' with no more fences than the
+ * baseline and at most base.insns * (100 + tolerance_pct) / 100 instructions.
+ * Functions that are new in 'cur' are not checked.
+ */
+[[nodiscard]] inline std::vector<regression> compare(const std::vector<codegen>& base,
+                                                     const std::vector<codegen>& cur,
+                                                     const unsigned tolerance_pct = 10u) {
+    std::vector<regression> out;
+    for (const auto& b : base) {
+        const codegen* c = nullptr;
+        for (const auto& x : cur) {
+            if (x.fn == b.fn) {
+                c = &x;
+                break;
+            }
+        }
+        if (!c) {
+            out.push_back(regression{b.fn, b, codegen{}, "missing"});
+            continue;
+        }
+        if (c->fences > b.fences) {
+            out.push_back(regression{b.fn, b, *c, "fences"});
+        }
+        const unsigned long limit = (static_cast<unsigned long>(b.insns) * (100u + tolerance_pct)) / 100u;
+        if (c->insns > limit) {
+            out.push_back(regression{b.fn, b, *c, "insns"});
+        }
+    }
+    return out;
+}
+
+} // namespace spsc::micro
+
+#endif /* SPSC_MICRO_MODEL_HPP_ */
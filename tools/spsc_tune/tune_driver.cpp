@@ -0,0 +1,171 @@
+/*
+ * tune_driver.cpp
+ *
+ * spsc_tune: host calibration of the compile-time knobs.
+ *
+ * For every variant of SPSC_ENABLE_SHADOW_INDICES / SPSC_SHADOW_REFRESH_HEURISTIC /
+ * SPSC_SHADOW_REFRESH_FRAC_SHIFT / SPSC_FORCE_CACHELINE it compiles tune_probe.cpp
+ * with the variant's -D flags, runs it, and collects the throughput of every
+ * policy / element size / depth cell. The winner is written as two headers:
+ *
+ *   <out>/spsc_tuned_config.h   : macro overrides
+ *                                 (-DSPSC_CONFIG_USER_HEADER='"spsc_tuned_config.h"')
+ *   <out>/spsc_tuned_policy.hpp : spsc::tuned::policy, spsc::tuned::policy_for_t<T>
+ *
+ * Build and run (from the repository root):
+ *   g++ -std=c++17 -O2 tools/spsc_tune/tune_driver.cpp -o spsc_tune
+ *   ./spsc_tune --elems 8,64,256 --depths 64,1024 --ms 200 --out .
+ *
+ * Options:
+ *   --cxx <compiler>     (default: c++)
+ *   --flags "<flags>"    (default: -std=c++17 -O2 -pthread)
+ *   --inc a,b            include dirs (default: src/spsc,. for basic_types.h)
+ *   --probe <file>       probe source (default: tools/spsc_tune/tune_probe.cpp)
+ *   --out <dir>          where the headers go (default: .)
+ *   --elems a,b,c        element sizes in bytes (default: 8,64,256)
+ *   --depths a,b,c       ring depths (default: 64,1024,16384)
+ *   --ms <n>             duration of one cell (default: 200)
+ *   --cachelines a,b     SPSC_FORCE_CACHELINE candidates (default: 64,128)
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "tune_report.hpp"
+
+namespace {
+
+struct options {
+    std::string cxx    = "c++";
+    std::string flags  = "-std=c++17 -O2 -pthread";
+    std::string inc    = "src/spsc,.";
+    std::string probe  = "tools/spsc_tune/tune_probe.cpp";
+    std::string out    = ".";
+    std::string elems  = "8,64,256";
+    std::string depths = "64,1024,16384";
+    std::string ms     = "200";
+    std::string cachelines = "64,128";
+};
+
+std::vector<std::string> split(const std::string& s) {
+    std::vector<std::string> out;
+    std::string cur;
+    for (const char c : s) {
+        if (c == ',') {
+            if (!cur.empty()) {
+                out.push_back(cur);
+            }
+            cur.clear();
+        } else {
+            cur += c;
+        }
+    }
+    if (!cur.empty()) {
+        out.push_back(cur);
+    }
+    return out;
+}
+
+bool parse_args(int argc, char** argv, options& o) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string k = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+        const std::string v = argv[++i];
+        if (k == "--cxx") { o.cxx = v; }
+        else if (k == "--flags") { o.flags = v; }
+        else if (k == "--inc") { o.inc = v; }
+        else if (k == "--probe") { o.probe = v; }
+        else if (k == "--out") { o.out = v; }
+        else if (k == "--elems") { o.elems = v; }
+        else if (k == "--depths") { o.depths = v; }
+        else if (k == "--ms") { o.ms = v; }
+        else if (k == "--cachelines") { o.cachelines = v; }
+        else { return false; }
+    }
+    return true;
+}
+
+bool write_file(const std::string& path, const std::string& text) {
+    std::ofstream f(path, std::ios::binary | std::ios::trunc);
+    f << text;
+    return static_cast<bool>(f);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    options o;
+    if (!parse_args(argc, argv, o)) {
+        std::fprintf(stderr, "spsc_tune: bad arguments (see tune_driver.cpp header)\n");
+        return 2;
+    }
+
+    std::vector<unsigned> cls;
+    for (const auto& s : split(o.cachelines)) {
+        cls.push_back(static_cast<unsigned>(std::strtoul(s.c_str(), nullptr, 10)));
+    }
+    const auto variants = ::spsc::tune::default_variants(cls);
+
+    std::string depth_args;
+    for (const auto& d : split(o.depths)) {
+        depth_args += " " + d;
+    }
+
+    std::string inc_args;
+    for (const auto& d : split(o.inc)) {
+        inc_args += " -I" + d;
+    }
+
+    const std::string exe = o.out + "/spsc_tune_probe.bin";
+    std::vector<::spsc::tune::sample> samples;
+    for (std::size_t vi = 0; vi < variants.size(); ++vi) {
+        const auto& v = variants[vi];
+        std::fprintf(stderr, "[%zu/%zu] %s\n", vi + 1u, variants.size(), v.name().c_str());
+
+        const std::string build = o.cxx + " " + o.flags + " " + v.defines() +
+                                  " -DTUNE_ELEMS=" + o.elems +
+                                  inc_args + " " + o.probe + " -o " + exe;
+        if (std::system(build.c_str()) != 0) {
+            std::fprintf(stderr, "  build failed, variant skipped\n");
+            continue;
+        }
+
+        FILE* p = popen((exe + " " + o.ms + depth_args).c_str(), "r");
+        if (!p) {
+            std::fprintf(stderr, "  run failed, variant skipped\n");
+            continue;
+        }
+        char line[256];
+        while (std::fgets(line, sizeof(line), p)) {
+            ::spsc::tune::sample s;
+            if (::spsc::tune::parse_line(line, vi, s)) {
+                std::fprintf(stderr, "  %-6s elem=%-5lu depth=%-6lu %9.3f Mops/s\n",
+                             s.policy.c_str(), s.elem, s.depth, s.mops);
+                samples.push_back(s);
+            }
+        }
+        (void)pclose(p);
+    }
+    std::remove(exe.c_str());
+
+    const auto c = ::spsc::tune::choose(variants.size(), samples);
+    if (!c.valid) {
+        std::fprintf(stderr, "spsc_tune: no usable measurements\n");
+        return 1;
+    }
+
+    const std::string host = o.cxx + " " + o.flags;
+    if (!write_file(o.out + "/spsc_tuned_config.h", ::spsc::tune::emit_config(variants[c.variant], c, host)) ||
+        !write_file(o.out + "/spsc_tuned_policy.hpp", ::spsc::tune::emit_policy(c))) {
+        std::fprintf(stderr, "spsc_tune: cannot write into %s\n", o.out.c_str());
+        return 1;
+    }
+    std::fprintf(stderr, "winner: %s, policy %s (%.3f Mops/s geomean)\n",
+                 variants[c.variant].name().c_str(), c.policy.c_str(), c.score);
+    return 0;
+}
@@ -0,0 +1,122 @@
+/*
+ * tune_probe.cpp
+ *
+ * One measurement binary per knob variant (built by tune_driver with the
+ * variant's -D flags). Runs a producer/consumer pair over a dynamic
+ * fifo<blob<N>, 0, Policy>(depth) for every policy, element size and depth,
+ * and prints one line per cell:
+ *
+ *   R <policy> <elem_bytes> <depth> <Mops/s>
+ *
+ * Element sizes are compile-time (-DTUNE_ELEMS=8,64,256);
+ * depths and duration are runtime: tune_probe <ms> <depth> [depth ...].
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "fifo.hpp"               // ::spsc::fifo
+#include "base/spsc_policy.hpp"   // ::spsc::policy::A, FA, CA, CFA
+
+#ifndef TUNE_ELEMS
+#  define TUNE_ELEMS 8, 64, 256
+#endif /* TUNE_ELEMS */
+
+namespace {
+
+template <reg N>
+struct blob {
+    unsigned char bytes[N];
+};
+
+template <reg N, class Policy>
+double run_cell(const reg depth, const unsigned ms) {
+    using Q = ::spsc::fifo<blob<N>, 0, Policy>;
+    Q q(depth);
+    if (!q.is_valid()) {
+        return 0.0;
+    }
+
+    std::atomic<bool> stop{false};
+    std::thread producer([&]() {
+        blob<N> b{};
+        unsigned spins = 0u;
+        while (!stop.load(std::memory_order_relaxed)) {
+            if (q.try_push(b)) {
+                ++b.bytes[0];
+                spins = 0u;
+            } else if (++spins > 64u) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    using clock = std::chrono::steady_clock;
+    const auto t0  = clock::now();
+    const auto end = t0 + std::chrono::milliseconds(ms);
+    std::uint64_t popped = 0u;
+    unsigned char sink = 0u;
+    unsigned spins = 0u;
+    while (clock::now() < end) {
+        for (int burst = 0; burst < 256; ++burst) {
+            const blob<N>* p = q.try_front();
+            if (!p) {
+                if (++spins > 64u) {
+                    std::this_thread::yield();
+                }
+                break;
+            }
+            sink = static_cast<unsigned char>(sink ^ p->bytes[0]);
+            q.pop();
+            ++popped;
+            spins = 0u;
+        }
+    }
+    const double s = std::chrono::duration<double>(clock::now() - t0).count();
+    stop.store(true, std::memory_order_relaxed);
+    producer.join();
+    if (sink == 0xA5u) {
+        std::fputs("", stderr); // keep the reads observable
+    }
+    return static_cast<double>(popped) / s / 1e6;
+}
+
+template <reg N>
+void run_elem(const std::vector<reg>& depths, const unsigned ms) {
+    for (const reg d : depths) {
+        std::printf("R A<> %u %u %.3f\n",   unsigned(N), unsigned(d), run_cell<N, ::spsc::policy::A<>>(d, ms));
+        std::printf("R FA<> %u %u %.3f\n",  unsigned(N), unsigned(d), run_cell<N, ::spsc::policy::FA<>>(d, ms));
+        std::printf("R CA<> %u %u %.3f\n",  unsigned(N), unsigned(d), run_cell<N, ::spsc::policy::CA<>>(d, ms));
+        std::printf("R CFA<> %u %u %.3f\n", unsigned(N), unsigned(d), run_cell<N, ::spsc::policy::CFA<>>(d, ms));
+        std::fflush(stdout);
+    }
+}
+
+template <reg... Ns>
+void run_all(const std::vector<reg>& depths, const unsigned ms) {
+    (run_elem<Ns>(depths, ms), ...);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::fprintf(stderr, "usage: %s <ms> <depth> [depth ...]\n", argv[0]);
+        return 2;
+    }
+    const unsigned ms = static_cast<unsigned>(std::strtoul(argv[1], nullptr, 10));
+    std::vector<reg> depths;
+    for (int i = 2; i < argc; ++i) {
+        depths.push_back(static_cast<reg>(std::strtoul(argv[i], nullptr, 10)));
+    }
+    std::printf("# cacheline=%u shadow=%d heuristic=%d shift=%d\n",
+                unsigned(SPSC_CACHELINE_BYTES), int(SPSC_ENABLE_SHADOW_INDICES),
+                int(SPSC_SHADOW_REFRESH_HEURISTIC), int(SPSC_SHADOW_REFRESH_FRAC_SHIFT));
+    run_all<TUNE_ELEMS>(depths, ms);
+    return 0;
+}
@@ -0,0 +1,282 @@
+/*
+ * tune_report.hpp
+ *
+ * Host calibration model for spsc_tune: build variants, result parsing,
+ * selection and generation of the override headers.
+ *
+ * A variant is one combination of compile-time knobs (spsc_config.hpp /
+ * spsc_cacheline.hpp). Every variant is compiled into its own probe binary
+ * (tune_probe.cpp) that prints one line per measurement:
+ *
+ *   R <policy> <elem_bytes> <depth> <Mops/s>
+ *
+ * Selection:
+ * - cell score   : best policy throughput for one (elem_bytes, depth) pair,
+ * - variant score: geometric mean of its cell scores (cells missing in any
+ *                  variant are ignored, so a crashed probe cannot win),
+ * - policies     : under the winning variant, per element size and overall,
+ *                  the policy with the best geometric mean over depths.
+ *
+ * Host-only tool code: std::string / std::vector are fine here.
+ */
+
+#ifndef SPSC_TUNE_REPORT_HPP_
+#define SPSC_TUNE_REPORT_HPP_
+
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace spsc::tune {
+
+// ------------------------------------------------------------------------------------------
+// Variants
+// ------------------------------------------------------------------------------------------
+struct variant {
+    int      shadow{1};      // SPSC_ENABLE_SHADOW_INDICES
+    int      heuristic{0};   // SPSC_SHADOW_REFRESH_HEURISTIC
+    int      frac_shift{2};  // SPSC_SHADOW_REFRESH_FRAC_SHIFT
+    unsigned cacheline{64u}; // SPSC_FORCE_CACHELINE
+
+    [[nodiscard]] std::string defines() const {
+        std::ostringstream os;
+        os << "-DSPSC_ENABLE_SHADOW_INDICES=" << shadow
+           << " -DSPSC_SHADOW_REFRESH_HEURISTIC=" << heuristic
+           << " -DSPSC_SHADOW_REFRESH_FRAC_SHIFT=" << frac_shift
+           << " -DSPSC_FORCE_CACHELINE=" << cacheline;
+        return os.str();
+    }
+
+    [[nodiscard]] std::string name() const {
+        std::ostringstream os;
+        os << "shadow=" << shadow << " heuristic=" << heuristic
+           << " shift=" << frac_shift << " cacheline=" << cacheline;
+        return os.str();
+    }
+};
+
+/* Cartesian product of the knobs worth measuring. The refresh shift only
+ * matters with the heuristic on, so it is not multiplied out otherwise.
+ */
+[[nodiscard]] inline std::vector<variant> default_variants(const std::vector<unsigned> &cachelines = {64u, 128u}) {
+    std::vector<variant> out;
+    for (const unsigned cl : cachelines) {
+        out.push_back(variant{0, 0, 2, cl});
+        out.push_back(variant{1, 0, 2, cl});
+        for (const int shift : {1, 2, 3}) {
+            out.push_back(variant{1, 1, shift, cl});
+        }
+    }
+    return out;
+}
+
+// ------------------------------------------------------------------------------------------
+// Measurements
+// ------------------------------------------------------------------------------------------
+struct sample {
+    std::size_t   variant{0u};
+    std::string   policy{};
+    unsigned long elem{0u};
+    unsigned long depth{0u};
+    double        mops{0.0};
+};
+
+/* Parse one probe output line; returns false for anything else (logs, blanks). */
+[[nodiscard]] inline bool parse_line(const std::string &line, const std::size_t variant_index, sample &out) {
+    std::istringstream is(line);
+    std::string tag;
+    sample s{};
+    s.variant = variant_index;
+    if (!(is >> tag >> s.policy >> s.elem >> s.depth >> s.mops) || tag != "R" || !(s.mops > 0.0)) {
+        return false;
+    }
+    out = s;
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------
+// Selection
+// ------------------------------------------------------------------------------------------
+struct choice {
+    bool        valid{false};
+    std::size_t variant{0u};
+    double      score{0.0};                         // geometric-mean Mops/s of the winner
+    std::string policy{};                           // best overall policy
+    std::vector<std::pair<unsigned long, std::string>> per_elem{}; // elem bytes -> policy
+};
+
+namespace detail {
+
+using cell_key = std::pair<unsigned long, unsigned long>; // (elem, depth)
+
+[[nodiscard]] inline double geomean(const std::vector<double> &v) {
+    if (v.empty()) {
+        return 0.0;
+    }
+    double acc = 0.0;
+    for (const double x : v) {
+        acc += std::log(x);
+    }
+    return std::exp(acc / static_cast<double>(v.size()));
+}
+
+} // namespace detail
+
+[[nodiscard]] inline choice choose(const std::size_t variant_count, const std::vector<sample> &samples) {
+    using detail::cell_key;
+    choice out{};
+    if (variant_count == 0u || samples.empty()) {
+        return out;
+    }
+
+    // best[variant][cell] = best Mops/s over policies
+    std::vector<std::map<cell_key, double>> best(variant_count);
+    for (const sample &s : samples) {
+        if (s.variant >= variant_count) {
+            continue;
+        }
+        double &b = best[s.variant][cell_key{s.elem, s.depth}];
+        if (s.mops > b) {
+            b = s.mops;
+        }
+    }
+
+    // Cells measured by every variant that produced anything.
+    std::set<cell_key> common;
+    bool first = true;
+    for (const auto &m : best) {
+        if (m.empty()) {
+            continue;
+        }
+        std::set<cell_key> keys;
+        for (const auto &kv : m) {
+            keys.insert(kv.first);
+        }
+        if (first) {
+            common = keys;
+            first = false;
+        } else {
+            std::set<cell_key> both;
+            for (const auto &k : common) {
+                if (keys.count(k) != 0u) {
+                    both.insert(k);
+                }
+            }
+            common.swap(both);
+        }
+    }
+    if (common.empty()) {
+        return out;
+    }
+
+    for (std::size_t v = 0; v < variant_count; ++v) {
+        if (best[v].empty()) {
+            continue;
+        }
+        std::vector<double> cells;
+        for (const auto &k : common) {
+            cells.push_back(best[v].at(k));
+        }
+        const double score = detail::geomean(cells);
+        if (!out.valid || score > out.score) {
+            out.valid   = true;
+            out.variant = v;
+            out.score   = score;
+        }
+    }
+
+    // Policies under the winning variant.
+    std::map<std::string, std::vector<double>> overall;
+    std::map<unsigned long, std::map<std::string, std::vector<double>>> by_elem;
+    for (const sample &s : samples) {
+        if (s.variant != out.variant || common.count(cell_key{s.elem, s.depth}) == 0u) {
+            continue;
+        }
+        overall[s.policy].push_back(s.mops);
+        by_elem[s.elem][s.policy].push_back(s.mops);
+    }
+    const auto pick = [](const std::map<std::string, std::vector<double>> &m) {
+        std::string name;
+        double top = -1.0;
+        for (const auto &kv : m) {
+            const double g = detail::geomean(kv.second);
+            if (g > top) {
+                top = g;
+                name = kv.first;
+            }
+        }
+        return name;
+    };
+    out.policy = pick(overall);
+    for (const auto &kv : by_elem) {
+        out.per_elem.emplace_back(kv.first, pick(kv.second));
+    }
+    return out;
+}
+
+// ------------------------------------------------------------------------------------------
+// Header generation
+// ------------------------------------------------------------------------------------------
+
+/* Macro overrides; include before any spsc header (or via -include). */
+[[nodiscard]] inline std::string emit_config(const variant &v, const choice &c, const std::string &host) {
+    std::ostringstream os;
+    os << "/*\n"
+       << " * spsc_tuned_config.h\n"
+       << " *\n"
+       << " * Generated by spsc_tune, probes built with: " << host << "\n"
+       << " * Winner: " << v.name() << " (" << c.score << " Mops/s geomean)\n"
+       << " *\n"
+       << " * Include before any spsc header, or pass -include spsc_tuned_config.h.\n"
+       << " */\n\n"
+       << "#ifndef SPSC_TUNED_CONFIG_H_\n"
+       << "#define SPSC_TUNED_CONFIG_H_\n\n"
+       << "#define SPSC_ENABLE_SHADOW_INDICES " << v.shadow << "\n"
+       << "#define SPSC_SHADOW_REFRESH_HEURISTIC " << v.heuristic << "\n"
+       << "#define SPSC_SHADOW_REFRESH_FRAC_SHIFT " << v.frac_shift << "\n"
+       << "#define SPSC_FORCE_CACHELINE " << v.cacheline << "\n\n"
+       << "#endif /* SPSC_TUNED_CONFIG_H_ */\n";
+    return os.str();
+}
+
+/* Policy aliases (spsc::tuned::policy, spsc::tuned::policy_for<ElemBytes>). */
+[[nodiscard]] inline std::string emit_policy(const choice &c) {
+    std::ostringstream os;
+    os << "/*\n"
+       << " * spsc_tuned_policy.hpp\n"
+       << " *\n"
+       << " * Generated by spsc_tune: measured policy choices for this host.\n"
+       << " */\n\n"
+       << "#ifndef SPSC_TUNED_POLICY_HPP_\n"
+       << "#define SPSC_TUNED_POLICY_HPP_\n\n"
+       << "#include <type_traits>\n\n"
+       << "#include \"spsc_tuned_config.h\"\n"
+       << "#include \"base/spsc_policy.hpp\"\n\n"
+       << "namespace spsc::tuned {\n\n"
+       << "using policy = ::spsc::policy::" << c.policy << ";\n\n"
+       << "// Best policy for elements up to N bytes (falls back to `policy`).\n"
+       << "template <reg ElemBytes, class = void>\n"
+       << "struct policy_for { using type = policy; };\n";
+    unsigned long prev = 0u;
+    for (const auto &kv : c.per_elem) {
+        os << "\ntemplate <reg ElemBytes>\n"
+           << "struct policy_for<ElemBytes, std::enable_if_t<(ElemBytes > " << prev
+           << "u && ElemBytes <= " << kv.first << "u)>> { using type = ::spsc::policy::"
+           << kv.second << "; };\n";
+        prev = kv.first;
+    }
+    os << "\ntemplate <class T>\n"
+       << "using policy_for_t = typename policy_for<sizeof(T)>::type;\n\n"
+       << "} // namespace spsc::tuned\n\n"
+       << "#endif /* SPSC_TUNED_POLICY_HPP_ */\n";
+    return os.str();
+}
+
+} // namespace spsc::tune
+
+#endif /* SPSC_TUNE_REPORT_HPP_ */